@@ -24,7 +24,7 @@ fih_ret
 boot_image_validate_encrypted(struct boot_loader_state *state,
                               const struct flash_area *fa_p,
                               struct image_header *hdr, uint8_t *buf,
-                              uint16_t buf_size
+                              uint32_t buf_size
 );
 
 /**
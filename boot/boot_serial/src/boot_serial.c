@@ -68,6 +68,7 @@
 #include "boot_serial_priv.h"
 #include "mcuboot_config/mcuboot_config.h"
 #include "../src/bootutil_priv.h"
+#include "../src/bootutil_scratch.h"
 
 #ifdef MCUBOOT_ENC_IMAGES
 #include "boot_serial/boot_serial_encryption.h"
@@ -284,19 +285,156 @@ bs_list_img_ver(char *dst, int maxlen, struct image_version *ver)
 }
 #endif /* !MCUBOOT_USE_SNPRINTF */
 
+/*
+ * What the image list shows of a slot.
+ */
+struct bs_list_slot {
+    struct image_header hdr;
+    bool valid;
+#ifdef MCUBOOT_SERIAL_IMG_GRP_HASH
+    int hash_rc;
+    uint8_t hash[IMAGE_HASH_SIZE];
+#endif
+#ifdef MCUBOOT_SERIAL_IMG_LIST_CACHE
+    bool cached;
+    uint32_t start_off;
+#endif
+};
+
+#ifdef MCUBOOT_SERIAL_IMG_LIST_CACHE
+/*
+ * Clients poll the image list during recovery, so the slots are only read
+ * and validated again once they have been written to or their state changed.
+ */
+static struct bs_list_slot bs_list_cache[BOOT_IMAGE_NUMBER][BOOT_NUM_SLOTS];
+
+static void
+bs_list_cache_invalidate(int area_id)
+{
+    int image;
+    int slot;
+
+    for (image = 0; image < BOOT_IMAGE_NUMBER; image++) {
+        for (slot = 0; slot < BOOT_NUM_SLOTS; slot++) {
+            if (flash_area_id_from_multi_image_slot(image, slot) == area_id) {
+                bs_list_cache[image][slot].cached = false;
+            }
+        }
+    }
+}
+#endif
+
+/*
+ * Read the header of the image in a slot and validate it, then get its hash.
+ */
+static void
+bs_list_read_slot(struct boot_loader_state *state, uint8_t image_index, uint32_t slot,
+                  const struct flash_area *fap, uint32_t start_off, struct bs_list_slot *ls)
+{
+    FIH_DECLARE(fih_rc, FIH_FAILURE);
+    struct image_header *hdr = &ls->hdr;
+    uint8_t *scratch;
+    size_t scratch_sz;
+    int rc;
+
+    (void)start_off;
+    ls->valid = false;
+
+    rc = BOOT_HOOK_CALL(boot_read_image_header_hook,
+                        BOOT_HOOK_REGULAR, image_index, slot, hdr);
+    if (rc == BOOT_HOOK_REGULAR)
+    {
+        flash_area_read(fap, start_off, hdr, sizeof(*hdr));
+    }
+
+    if (hdr->ih_magic != IMAGE_MAGIC) {
+        return;
+    }
+
+    BOOT_HOOK_CALL_FIH(boot_image_check_hook,
+                       FIH_BOOT_HOOK_REGULAR,
+                       fih_rc, image_index, slot);
+    if (FIH_EQ(fih_rc, FIH_BOOT_HOOK_REGULAR))
+    {
+        fih_rc = FIH_FAILURE;
+        scratch = boot_scratch_begin(BOOT_SCRATCH_SERIAL, &scratch_sz);
+        if (scratch != NULL) {
+#if defined(MCUBOOT_ENC_IMAGES)
+#if !defined(MCUBOOT_SINGLE_APPLICATION_SLOT)
+            if (IS_ENCRYPTED(hdr) && MUST_DECRYPT(fap, image_index, hdr)) {
+                FIH_CALL(boot_image_validate_encrypted, fih_rc, state, fap,
+                         hdr, scratch, scratch_sz);
+            } else {
+#endif
+                if (IS_ENCRYPTED(hdr)) {
+                    /*
+                     * There is an image present which has an encrypted flag set but is
+                     * not encrypted, therefore remove the flag from the header and run a
+                     * normal image validation on it.
+                     */
+                    hdr->ih_flags &= ~ENCRYPTIONFLAGS;
+                }
+#endif
+                FIH_CALL(bootutil_img_validate, fih_rc, state, hdr,
+                         fap, scratch, scratch_sz, NULL, 0, NULL);
+#if defined(MCUBOOT_ENC_IMAGES) && !defined(MCUBOOT_SINGLE_APPLICATION_SLOT)
+            }
+#endif
+            boot_scratch_end(BOOT_SCRATCH_SERIAL);
+        }
+    }
+
+    if (FIH_NOT_EQ(fih_rc, FIH_SUCCESS)) {
+        return;
+    }
+
+    ls->valid = true;
+
+#ifdef MCUBOOT_SERIAL_IMG_GRP_HASH
+    /* Retrieve hash of image for identification */
+#ifdef MCUBOOT_SWAP_USING_OFFSET
+    ls->hash_rc = boot_serial_get_hash(hdr, fap, ls->hash, start_off);
+#else
+    ls->hash_rc = boot_serial_get_hash(hdr, fap, ls->hash);
+#endif
+#endif
+}
+
+/*
+ * Get what the image list shows of a slot, from the cache if it is there.
+ */
+static struct bs_list_slot *
+bs_list_slot(struct boot_loader_state *state, uint8_t image_index, uint32_t slot,
+             const struct flash_area *fap, uint32_t start_off, struct bs_list_slot *buf)
+{
+#ifdef MCUBOOT_SERIAL_IMG_LIST_CACHE
+    struct bs_list_slot *ls = &bs_list_cache[image_index][slot];
+
+    (void)buf;
+
+    /* With swap using offset, the secondary slot image moves with the swap type. */
+    if (!ls->cached || ls->start_off != start_off) {
+        bs_list_read_slot(state, image_index, slot, fap, start_off, ls);
+        ls->cached = true;
+        ls->start_off = start_off;
+    }
+
+    return ls;
+#else
+    bs_list_read_slot(state, image_index, slot, fap, start_off, buf);
+    return buf;
+#endif
+}
+
 /*
  * List images.
  */
 static void
 bs_list(struct boot_loader_state *state, char *buf, int len)
 {
-    struct image_header hdr;
     uint32_t slot;
     const struct flash_area *fap;
     uint8_t image_index;
-#ifdef MCUBOOT_SERIAL_IMG_GRP_HASH
-    uint8_t hash[IMAGE_HASH_SIZE];
-#endif
 
     zcbor_map_start_encode(cbor_state, 1);
     zcbor_tstr_put_lit_cast(cbor_state, "images");
@@ -310,8 +448,9 @@ bs_list(struct boot_loader_state *state, char *buf, int len)
         (void) image_index; /* Might be unused depending on the configuration */
 
         for (slot = 0; slot < BOOT_NUM_SLOTS; slot++) {
-            FIH_DECLARE(fih_rc, FIH_FAILURE);
-            int rc;
+            struct bs_list_slot ls_buf;
+            struct bs_list_slot *ls;
+            uint32_t start_off = 0;
             uint8_t tmpbuf[64];
 
 #ifdef MCUBOOT_SERIAL_IMG_GRP_IMAGE_STATE
@@ -321,10 +460,6 @@ bs_list(struct boot_loader_state *state, char *buf, int len)
             bool permanent = false;
 #endif
 
-#ifdef MCUBOOT_SWAP_USING_OFFSET
-            uint32_t start_off = 0;
-#endif
-
             fap = BOOT_IMG_AREA(state, slot);
             if (fap == NULL) {
                 continue;
@@ -337,61 +472,11 @@ bs_list(struct boot_loader_state *state, char *buf, int len)
             }
 #endif
 
-            rc = BOOT_HOOK_CALL(boot_read_image_header_hook,
-                                BOOT_HOOK_REGULAR, image_index, slot, &hdr);
-            if (rc == BOOT_HOOK_REGULAR)
-            {
-#ifdef MCUBOOT_SWAP_USING_OFFSET
-                flash_area_read(fap, start_off, &hdr, sizeof(hdr));
-#else
-                flash_area_read(fap, 0, &hdr, sizeof(hdr));
-#endif
-            }
-
-            if (hdr.ih_magic == IMAGE_MAGIC)
-            {
-                BOOT_HOOK_CALL_FIH(boot_image_check_hook,
-                                   FIH_BOOT_HOOK_REGULAR,
-                                   fih_rc, image_index, slot);
-                if (FIH_EQ(fih_rc, FIH_BOOT_HOOK_REGULAR))
-                {
-#if defined(MCUBOOT_ENC_IMAGES)
-#if !defined(MCUBOOT_SINGLE_APPLICATION_SLOT)
-                    if (IS_ENCRYPTED(&hdr) && MUST_DECRYPT(fap, image_index, &hdr)) {
-                        FIH_CALL(boot_image_validate_encrypted, fih_rc, state, fap,
-                                 &hdr, tmpbuf, sizeof(tmpbuf));
-                    } else {
-#endif
-                        if (IS_ENCRYPTED(&hdr)) {
-                            /*
-                             * There is an image present which has an encrypted flag set but is
-                             * not encrypted, therefore remove the flag from the header and run a
-                             * normal image validation on it.
-                             */
-                            hdr.ih_flags &= ~ENCRYPTIONFLAGS;
-                        }
-#endif
-                        FIH_CALL(bootutil_img_validate, fih_rc, state, &hdr,
-                                 fap, tmpbuf, sizeof(tmpbuf), NULL, 0, NULL);
-#if defined(MCUBOOT_ENC_IMAGES) && !defined(MCUBOOT_SINGLE_APPLICATION_SLOT)
-                    }
-#endif
-                }
-            }
-
-            if (FIH_NOT_EQ(fih_rc, FIH_SUCCESS)) {
+            ls = bs_list_slot(state, image_index, slot, fap, start_off, &ls_buf);
+            if (!ls->valid) {
                 continue;
             }
 
-#ifdef MCUBOOT_SERIAL_IMG_GRP_HASH
-            /* Retrieve hash of image for identification */
-#ifdef MCUBOOT_SWAP_USING_OFFSET
-            rc = boot_serial_get_hash(&hdr, fap, hash, start_off);
-#else
-            rc = boot_serial_get_hash(&hdr, fap, hash);
-#endif
-#endif
-
             zcbor_map_start_encode(cbor_state, 20);
 
 #if (BOOT_IMAGE_NUMBER > 1)
@@ -426,7 +511,7 @@ bs_list(struct boot_loader_state *state, char *buf, int len)
                 }
             }
 
-            if (!(hdr.ih_flags & IMAGE_F_NON_BOOTABLE)) {
+            if (!(ls->hdr.ih_flags & IMAGE_F_NON_BOOTABLE)) {
                 zcbor_tstr_put_lit_cast(cbor_state, "bootable");
                 zcbor_bool_put(cbor_state, true);
             }
@@ -456,15 +541,15 @@ bs_list(struct boot_loader_state *state, char *buf, int len)
             zcbor_uint32_put(cbor_state, slot);
 
 #ifdef MCUBOOT_SERIAL_IMG_GRP_HASH
-            if (rc == 0) {
+            if (ls->hash_rc == 0) {
                 zcbor_tstr_put_lit_cast(cbor_state, "hash");
-                zcbor_bstr_encode_ptr(cbor_state, hash, sizeof(hash));
+                zcbor_bstr_encode_ptr(cbor_state, ls->hash, sizeof(ls->hash));
             }
 #endif
 
             zcbor_tstr_put_lit_cast(cbor_state, "version");
 
-            bs_list_img_ver((char *)tmpbuf, sizeof(tmpbuf), &hdr.ih_ver);
+            bs_list_img_ver((char *)tmpbuf, sizeof(tmpbuf), &ls->hdr.ih_ver);
 
             zcbor_tstr_encode_ptr(cbor_state, (char *)tmpbuf, strlen((char *)tmpbuf));
             zcbor_map_end_encode(cbor_state, 20);
@@ -537,13 +622,10 @@ bs_set(struct boot_loader_state *state, char *buf, int len)
             (void) image_index; /* Might be unused depending on the configuration */
 
             for (slot = 0; slot < BOOT_NUM_SLOTS; slot++) {
-                struct image_header hdr;
                 const struct flash_area *fap;
-                uint8_t tmpbuf[64];
-
-#ifdef MCUBOOT_SWAP_USING_OFFSET
+                struct bs_list_slot ls_buf;
+                struct bs_list_slot *ls;
                 uint32_t start_off = 0;
-#endif
 
                 fap = BOOT_IMG_AREA(state, slot);
                 if (fap == NULL) {
@@ -557,53 +639,13 @@ bs_set(struct boot_loader_state *state, char *buf, int len)
                 }
 #endif
 
-                rc = BOOT_HOOK_CALL(boot_read_image_header_hook,
-                                    BOOT_HOOK_REGULAR, image_index, slot, &hdr);
-                if (rc == BOOT_HOOK_REGULAR)
-                {
-#ifdef MCUBOOT_SWAP_USING_OFFSET
-                    flash_area_read(fap, start_off, &hdr, sizeof(hdr));
-#else
-                    flash_area_read(fap, 0, &hdr, sizeof(hdr));
-#endif
-                }
-
-                if (hdr.ih_magic == IMAGE_MAGIC)
-                {
-                    FIH_DECLARE(fih_rc, FIH_FAILURE);
-
-                    BOOT_HOOK_CALL_FIH(boot_image_check_hook,
-                                       FIH_BOOT_HOOK_REGULAR,
-                                       fih_rc, image_index, slot);
-                    if (FIH_EQ(fih_rc, FIH_BOOT_HOOK_REGULAR))
-                    {
-#ifdef MCUBOOT_ENC_IMAGES
-                        if (IS_ENCRYPTED(&hdr)) {
-                            FIH_CALL(boot_image_validate_encrypted, fih_rc, state, fap,
-                                     &hdr, tmpbuf, sizeof(tmpbuf));
-                        } else {
-#endif
-                            FIH_CALL(bootutil_img_validate, fih_rc, state, &hdr,
-                                     fap, tmpbuf, sizeof(tmpbuf), NULL, 0, NULL);
-#ifdef MCUBOOT_ENC_IMAGES
-                        }
-#endif
-                    }
-
-                    if (FIH_NOT_EQ(fih_rc, FIH_SUCCESS)) {
-                        continue;
-                    }
+                ls = bs_list_slot(state, image_index, slot, fap, start_off, &ls_buf);
+                if (!ls->valid) {
+                    continue;
                 }
 
-#ifdef MCUBOOT_SERIAL_IMG_GRP_HASH
-                /* Retrieve hash of image for identification */
-#ifdef MCUBOOT_SWAP_USING_OFFSET
-                rc = boot_serial_get_hash(&hdr, fap, hash, start_off);
-#else
-                rc = boot_serial_get_hash(&hdr, fap, hash);
-#endif
-#endif
-                if (rc == 0 && memcmp(hash, img_hash.value, sizeof(hash)) == 0) {
+                if (ls->hash_rc == 0 &&
+                    memcmp(ls->hash, img_hash.value, sizeof(ls->hash)) == 0) {
                     /* Hash matches, set this slot for test or confirmation */
                     found = true;
                     goto set_image_state;
@@ -623,6 +665,12 @@ bs_set(struct boot_loader_state *state, char *buf, int len)
 set_image_state:
     rc = boot_set_pending_multi(image_index, confirm);
 
+#ifdef MCUBOOT_SERIAL_IMG_LIST_CACHE
+    for (slot = 0; slot < BOOT_NUM_SLOTS; slot++) {
+        bs_list_cache_invalidate(flash_area_id_from_multi_image_slot(image_index, slot));
+    }
+#endif
+
 out:
     if (rc == 0) {
         /* Success - return updated list of images */
@@ -983,6 +1031,11 @@ bs_upload(char *buf, int len)
         goto out;
     }
 
+#ifdef MCUBOOT_SERIAL_IMG_LIST_CACHE
+    /* The slot is about to be erased or written. */
+    bs_list_cache_invalidate(flash_area_get_id(fap));
+#endif
+
     if (img_chunk_off == 0) {
         /* Receiving chunk with 0 offset resets the upload state; this basically
          * means that upload has started from beginning.
@@ -22,7 +22,7 @@ fih_ret
 boot_image_validate_encrypted(struct boot_loader_state *state,
                               const struct flash_area *fa_p,
                               struct image_header *hdr, uint8_t *buf,
-                              uint16_t buf_size)
+                              uint32_t buf_size)
 {
     FIH_DECLARE(fih_rc, FIH_FAILURE);
 
@@ -45,6 +45,7 @@ boot_image_validate_encrypted(struct boot_loader_state *state,
              hdr, fa_p, buf, buf_size, NULL, 0, NULL);
 
     boot_enc_zeroize(BOOT_CURR_ENC(state));
+    boot_enc_cache_zeroize(state);
 
     FIH_RET(fih_rc);
 }
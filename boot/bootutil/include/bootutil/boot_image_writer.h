@@ -0,0 +1,113 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright (c) 2026 Linaro LTD
+ */
+
+#ifndef H_BOOTUTIL_BOOT_IMAGE_WRITER_
+#define H_BOOTUTIL_BOOT_IMAGE_WRITER_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <flash_map_backend/flash_map_backend.h>
+
+#include "bootutil/bootutil_public.h"
+#include "bootutil/image.h"
+#include "bootutil/crypto/sha.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Size of the buffer in which small writes are gathered, a multiple of the
+ * largest write alignment.
+ */
+#ifdef MCUBOOT_IMAGE_WRITER_BUF_SZ
+#define BOOT_IMAGE_WRITER_BUF_SZ MCUBOOT_IMAGE_WRITER_BUF_SZ
+#else
+#define BOOT_IMAGE_WRITER_BUF_SZ 128
+#endif
+
+/**
+ * Writer staging an update image into the secondary slot of an image, as it
+ * is received.
+ *
+ * The slot is erased one sector at a time, just ahead of the data written,
+ * and the data is gathered until whole write blocks can be written.  The
+ * hash of the image is computed on the way, and checked against the hash TLV
+ * of the image when the writer is finished, along with the layout of the
+ * header and TLVs.  Only then is the trailer erased and the image marked as
+ * pending, so that an image which was not fully received is never booted.
+ *
+ * The image is bounded by the size the bootloader allows for it, which leaves
+ * room in the slots for the swap status and the encryption keys, and not only
+ * by the trailer of the secondary slot.  The record left by
+ * boot_pre_erase_multi() is written back if the writer erased it, since the
+ * range it covers is not written to.
+ */
+struct boot_image_writer {
+    const struct flash_area *fap;
+    uint32_t start;             /* Offset of the image in the slot */
+    uint32_t received;          /* Bytes of the image received so far */
+    uint32_t written;           /* Bytes of the image written to flash */
+    uint32_t erased_to;         /* Offset up to which the slot is erased */
+    uint32_t trailer_off;       /* Offset of the trailer */
+    uint32_t max_size;          /* Largest image the bootloader accepts */
+    uint32_t hashed_sz;         /* Size of the hashed part of the image, once known */
+    struct boot_pre_erased pre_erased; /* Record of boot_pre_erase_multi(), if any */
+    uint16_t buf_len;
+    struct image_header hdr;
+    bootutil_sha_context sha;
+    uint8_t buf[BOOT_IMAGE_WRITER_BUF_SZ];
+};
+
+/**
+ * Start writing an image to the secondary slot of an image.
+ *
+ * Nothing is erased yet, and the previous contents of the slot are left as
+ * they are until the data written reaches them.
+ *
+ * @param writer       Writer to initialize.
+ * @param image_index  Index of the image to update.
+ *
+ * @return 0 on success; BOOT_EFLASH if the slot could not be opened.
+ */
+int boot_image_writer_open(struct boot_image_writer *writer, int image_index);
+
+/**
+ * Write the next bytes of the image.
+ *
+ * @return 0 on success; BOOT_EBADIMAGE if the image header is invalid or
+ *         the image does not fit in the slot; BOOT_EFLASH on flash errors.
+ *         On errors, the writer must be aborted.
+ */
+int boot_image_writer_write(struct boot_image_writer *writer, const void *data,
+                            size_t len);
+
+/**
+ * Write the end of the image, check it and mark it as pending.  The writer
+ * is closed whatever the result.
+ *
+ * The hash is not checked for encrypted images, whose hash TLV is the one of
+ * the decrypted image.
+ *
+ * @param permanent  Whether the image should be used permanently or only
+ *                   tested once, as for boot_set_pending_multi().
+ *
+ * @return 0 on success; BOOT_EBADIMAGE if the image is incomplete, its TLVs
+ *         are malformed or its hash does not match; BOOT_EFLASH on flash
+ *         errors.
+ */
+int boot_image_writer_finish(struct boot_image_writer *writer, int permanent);
+
+/**
+ * Close the writer without marking the image as pending.
+ */
+void boot_image_writer_abort(struct boot_image_writer *writer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* H_BOOTUTIL_BOOT_IMAGE_WRITER_ */
@@ -0,0 +1,136 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright (c) 2026 Linaro LTD
+ */
+
+/*
+ * Binary boot log.
+ *
+ * With MCUBOOT_LOG_BINARY, the BOOT_LOG_ERR/WRN/INF/DBG messages aren't
+ * formatted: each of them is stored as a record holding the address of its
+ * format string and its arguments, in a ring buffer which overwrites the
+ * oldest records when full.  Logging then only costs a few word writes, and
+ * the records are turned back into text later on, by the application or on the
+ * host with scripts/boot_log_decode.py, which looks the format strings up in
+ * the ELF file of the bootloader.
+ *
+ * The buffer starts with a struct boot_log_binary, followed by the ring of
+ * words.  A record is a header word, made of its level, its number of
+ * arguments and its sequence number, followed by the address of its format
+ * string and its arguments, each one word long.
+ */
+
+#ifndef H_BOOT_LOG_BINARY_
+#define H_BOOT_LOG_BINARY_
+
+#include <stdint.h>
+
+#include "bootutil/ignore.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BOOT_LOG_BINARY_MAGIC   0x424c4f47
+#define BOOT_LOG_BINARY_VERSION 1
+
+#define BOOT_LOG_BINARY_LEVEL_ERROR   1
+#define BOOT_LOG_BINARY_LEVEL_WARNING 2
+#define BOOT_LOG_BINARY_LEVEL_INFO    3
+#define BOOT_LOG_BINARY_LEVEL_DEBUG   4
+
+/* Fields of the header word of a record. */
+#define BOOT_LOG_BINARY_REC_LEVEL(w) ((uint32_t)(w) & 0xff)
+#define BOOT_LOG_BINARY_REC_NARGS(w) (((uint32_t)(w) >> 8) & 0xff)
+#define BOOT_LOG_BINARY_REC_SEQ(w)   (((uint32_t)(w) >> 16) & 0xffff)
+
+struct boot_log_binary {
+    uint32_t magic;
+    uint8_t version;
+    /** Size of the words of the ring and of the records, in bytes. */
+    uint8_t word_size;
+    /** Sequence number of the next record. */
+    uint16_t seq;
+    /** Size of the ring, in words. */
+    uint32_t size;
+    /** Index of the word where the next record is written. */
+    uint32_t head;
+    /** Number of words used by the records, which end at head. */
+    uint32_t used;
+    /** Number of records overwritten or too large for the ring. */
+    uint32_t dropped;
+};
+
+/**
+ * Empty the log.  It is done by the first record written otherwise, so that
+ * each boot starts with an empty log.
+ */
+void boot_log_binary_init(void);
+
+/**
+ * Append a record to the log.
+ *
+ * @param level  The BOOT_LOG_BINARY_LEVEL_* of the message.
+ * @param words  The address of the format string, followed by the arguments.
+ * @param count  The number of words, 1 more than the number of arguments.
+ */
+void boot_log_binary_write(uint8_t level, const uintptr_t *words, uint32_t count);
+
+/**
+ * The log buffer, followed by its ring of words.
+ */
+const struct boot_log_binary *boot_log_binary_get(void);
+
+#ifndef MCUBOOT_LOG_BINARY_LEVEL
+#define MCUBOOT_LOG_BINARY_LEVEL BOOT_LOG_BINARY_LEVEL_DEBUG
+#endif
+
+#define BOOT_LOG_BIN_1(X) (uintptr_t)(X)
+#define BOOT_LOG_BIN_2(X, ...) (uintptr_t)(X), BOOT_LOG_BIN_1(__VA_ARGS__)
+#define BOOT_LOG_BIN_3(X, ...) (uintptr_t)(X), BOOT_LOG_BIN_2(__VA_ARGS__)
+#define BOOT_LOG_BIN_4(X, ...) (uintptr_t)(X), BOOT_LOG_BIN_3(__VA_ARGS__)
+#define BOOT_LOG_BIN_5(X, ...) (uintptr_t)(X), BOOT_LOG_BIN_4(__VA_ARGS__)
+#define BOOT_LOG_BIN_6(X, ...) (uintptr_t)(X), BOOT_LOG_BIN_5(__VA_ARGS__)
+#define BOOT_LOG_BIN_7(X, ...) (uintptr_t)(X), BOOT_LOG_BIN_6(__VA_ARGS__)
+#define BOOT_LOG_BIN_8(X, ...) (uintptr_t)(X), BOOT_LOG_BIN_7(__VA_ARGS__)
+#define BOOT_LOG_BIN_9(X, ...) (uintptr_t)(X), BOOT_LOG_BIN_8(__VA_ARGS__)
+#define BOOT_LOG_BIN_10(X, ...) (uintptr_t)(X), BOOT_LOG_BIN_9(__VA_ARGS__)
+#define BOOT_LOG_BIN_11(X, ...) (uintptr_t)(X), BOOT_LOG_BIN_10(__VA_ARGS__)
+#define BOOT_LOG_BIN_12(X, ...) (uintptr_t)(X), BOOT_LOG_BIN_11(__VA_ARGS__)
+#define BOOT_LOG_BIN_13(X, ...) (uintptr_t)(X), BOOT_LOG_BIN_12(__VA_ARGS__)
+#define BOOT_LOG_BIN_14(X, ...) (uintptr_t)(X), BOOT_LOG_BIN_13(__VA_ARGS__)
+#define BOOT_LOG_BIN_15(X, ...) (uintptr_t)(X), BOOT_LOG_BIN_14(__VA_ARGS__)
+#define BOOT_LOG_BIN_16(X, ...) (uintptr_t)(X), BOOT_LOG_BIN_15(__VA_ARGS__)
+#define BOOT_LOG_BIN_17(X, ...) (uintptr_t)(X), BOOT_LOG_BIN_16(__VA_ARGS__)
+#define BOOT_LOG_BIN_18(X, ...) (uintptr_t)(X), BOOT_LOG_BIN_17(__VA_ARGS__)
+#define BOOT_LOG_BIN_19(X, ...) (uintptr_t)(X), BOOT_LOG_BIN_18(__VA_ARGS__)
+#define BOOT_LOG_BIN_20(X, ...) (uintptr_t)(X), BOOT_LOG_BIN_19(__VA_ARGS__)
+
+/*
+ * Record a message, the format string and each argument being cast to a word.
+ * The messages above MCUBOOT_LOG_BINARY_LEVEL are left out at compile time.
+ */
+#define BOOT_LOG_BINARY(level, ...)                                              \
+    do {                                                                         \
+        if ((level) <= MCUBOOT_LOG_BINARY_LEVEL) {                               \
+            const uintptr_t _words[] = {                                         \
+                GET_MACRO(__VA_ARGS__, BOOT_LOG_BIN_20, BOOT_LOG_BIN_19,         \
+                          BOOT_LOG_BIN_18, BOOT_LOG_BIN_17, BOOT_LOG_BIN_16,     \
+                          BOOT_LOG_BIN_15, BOOT_LOG_BIN_14, BOOT_LOG_BIN_13,     \
+                          BOOT_LOG_BIN_12, BOOT_LOG_BIN_11, BOOT_LOG_BIN_10,     \
+                          BOOT_LOG_BIN_9, BOOT_LOG_BIN_8, BOOT_LOG_BIN_7,        \
+                          BOOT_LOG_BIN_6, BOOT_LOG_BIN_5, BOOT_LOG_BIN_4,        \
+                          BOOT_LOG_BIN_3, BOOT_LOG_BIN_2,                        \
+                          BOOT_LOG_BIN_1)(__VA_ARGS__)                           \
+            };                                                                   \
+            boot_log_binary_write((level), _words,                               \
+                                  sizeof(_words) / sizeof(_words[0]));           \
+        }                                                                        \
+    } while (0)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* H_BOOT_LOG_BINARY_ */
@@ -0,0 +1,103 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright (c) 2026 Linaro LTD
+ */
+
+#ifndef H_BOOTUTIL_BOOT_REQUEST_LOG_
+#define H_BOOTUTIL_BOOT_REQUEST_LOG_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <flash_map_backend/flash_map_backend.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Largest write alignment supported for the log area.  Each record takes
+ * the size of one record rounded up to the write alignment of the area.
+ */
+#define BOOT_REQUEST_LOG_MAX_ALIGN 32
+
+/**
+ * Append-only store for boot request entries.
+ *
+ * The flash area is split into two equal pages, each of which must be a
+ * whole number of erase units.  The active page starts with a header record
+ * holding a sequence number, followed by one record per entry update.  Each
+ * record carries its own checksum, so a record that was only partially
+ * written is ignored.  The current value of every entry is rebuilt by
+ * scanning the active page once, in boot_request_log_init().
+ *
+ * Updates only program a new record into erased space.  When the active
+ * page is full, the current values are compacted into the other page, which
+ * is erased first and only becomes active once its header is written, so a
+ * reset at any point leaves either the old or the new state.
+ */
+struct boot_request_log {
+    const struct flash_area *fap;
+    uint8_t *values;            /* Current value of each entry, owned by the caller */
+    size_t num_values;
+    uint32_t page_size;
+    uint32_t rec_size;
+    uint32_t capacity;          /* Number of entry records that fit in a page */
+    uint32_t next;              /* Index of the next free record in the active page */
+    uint16_t seq;
+    uint8_t page;
+    uint8_t erased_val;
+};
+
+/**
+ * Open the log stored in a flash area and load the current entry values.
+ *
+ * Entries that were never written read as the erased value of the flash.
+ * If neither page holds a valid log, the area is formatted.
+ *
+ * @param log        Log to initialize.
+ * @param fap        Flash area holding the log.
+ * @param values     Buffer for the entry values, must stay valid while the
+ *                   log is used.
+ * @param num_values Number of entries.
+ *
+ * @return 0 on success; BOOT_EBADARGS if the area is too small or its
+ *         alignment is not supported; BOOT_EFLASH on flash errors.
+ */
+int boot_request_log_init(struct boot_request_log *log, const struct flash_area *fap,
+                          uint8_t *values, size_t num_values);
+
+/**
+ * Read the current value of an entry.
+ *
+ * @return 0 on success; BOOT_EBADARGS if the entry is out of range.
+ */
+int boot_request_log_read(const struct boot_request_log *log, size_t entry,
+                          uint8_t *value);
+
+/**
+ * Set the value of an entry.  Nothing is written if the value does not
+ * change.
+ *
+ * @return 0 on success; BOOT_EBADARGS if the entry is out of range;
+ *         BOOT_EFLASH on flash errors.
+ */
+int boot_request_log_write(struct boot_request_log *log, size_t entry,
+                           uint8_t value);
+
+/**
+ * Reset all entries to the erased value, except the ones listed in @p keep.
+ * The clear is stored as a single record, so it is applied either fully or
+ * not at all.  Only the first 16 entries can be kept.
+ *
+ * @return 0 on success; BOOT_EBADARGS if an entry to keep is out of range;
+ *         BOOT_EFLASH on flash errors.
+ */
+int boot_request_log_clear(struct boot_request_log *log, const size_t *keep,
+                           size_t keep_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* H_BOOTUTIL_BOOT_REQUEST_LOG_ */
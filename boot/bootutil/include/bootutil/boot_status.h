@@ -124,6 +124,7 @@ extern "C" {
 #define BLINFO_SECURITY_COUNTER_IMAGE_2 0x12
 #define BLINFO_SECURITY_COUNTER_IMAGE_3 0x13
 #define BLINFO_SECURITY_COUNTER_IMAGE_4 0x14
+#define BLINFO_BOOT_LOG             0x20 /* Address of the binary boot log, in retained RAM */
 
 enum mcuboot_mode {
     MCUBOOT_MODE_SINGLE_SLOT,
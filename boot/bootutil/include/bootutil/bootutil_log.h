@@ -52,6 +52,21 @@ extern "C" {
 
 #endif /* MCUBOOT_HAVE_LOGGING */
 
+#ifdef MCUBOOT_LOG_BINARY
+#include "bootutil/boot_log_binary.h"
+
+#undef BOOT_LOG_ERR
+#undef BOOT_LOG_WRN
+#undef BOOT_LOG_INF
+#undef BOOT_LOG_DBG
+
+#define BOOT_LOG_ERR(...) BOOT_LOG_BINARY(BOOT_LOG_BINARY_LEVEL_ERROR, __VA_ARGS__)
+#define BOOT_LOG_WRN(...) BOOT_LOG_BINARY(BOOT_LOG_BINARY_LEVEL_WARNING, __VA_ARGS__)
+#define BOOT_LOG_INF(...) BOOT_LOG_BINARY(BOOT_LOG_BINARY_LEVEL_INFO, __VA_ARGS__)
+#define BOOT_LOG_DBG(...) BOOT_LOG_BINARY(BOOT_LOG_BINARY_LEVEL_DEBUG, __VA_ARGS__)
+
+#endif /* MCUBOOT_LOG_BINARY */
+
 #ifdef __cplusplus
 }
 #endif
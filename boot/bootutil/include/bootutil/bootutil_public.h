@@ -156,6 +156,22 @@ struct boot_swap_state {
     uint8_t image_num;  /* Boot status belongs to this image */
 };
 
+/*
+ * Record written by boot_pre_erase_multi() at the start of the swap status
+ * area of the secondary slot, which the swaps do not use, telling the
+ * bootloader that a range of a flash area is erased.  The write unit after it
+ * is programmed once the range is used, which voids the record.
+ */
+#define BOOT_PRE_ERASED_MAGIC 0x45524550
+
+struct boot_pre_erased {
+    uint32_t magic;     /* BOOT_PRE_ERASED_MAGIC */
+    uint32_t off;       /* Offset of the erased range in the flash area */
+    uint32_t size;      /* Size of the erased range */
+    uint8_t fa_id;      /* Flash area holding the erased range */
+    uint8_t pad[3];
+};
+
 /**
  * @brief Determines the action, if any, that mcuboot will take on a image pair.
  *
@@ -212,6 +228,10 @@ int boot_set_pending(int permanent);
  * system will continue booting into the image in the primary slot until told to
  * boot from a different slot.
  *
+ * With MCUBOOT_SWAP_OFFSET_PERM_NO_BACKUP, confirming an image which a test
+ * upgrade swapped in also reclaims the secondary slot, which held the previous
+ * image to revert to, as boot_pre_erase_multi() does.
+ *
  * @param image_index       Image pair index.
  *
  * @return                  0 on success; nonzero on failure.
@@ -228,6 +248,36 @@ int boot_set_confirmed_multi(int image_index);
  */
 int boot_set_confirmed(void);
 
+/**
+ * Erases, ahead of the next upgrade of the image with the given index, the
+ * flash which the previous upgrade left behind: the trailer of the secondary
+ * slot, its first sector with swap using offset, and the scratch area with
+ * swap using scratch.  It is meant to be called when the device is idle, once
+ * the image is confirmed.  Once the erases are done, the scratch area (swap
+ * using scratch with a single image) or the first sector of the secondary slot
+ * (swap using offset) is recorded as erased in the secondary slot, so that a
+ * bootloader built with MCUBOOT_SKIP_PRE_ERASED does not erase it again at the
+ * start of the next upgrade.  The previous image, left in the secondary slot
+ * by the swap, can no longer be swapped back in afterwards.
+ *
+ * @param image_index       Image pair index.
+ *
+ * @return                  0 on success; BOOT_EBADSTATUS if the image in the
+ *                          primary slot is not confirmed yet or an upgrade is
+ *                          pending; BOOT_EFLASH on flash errors.
+ */
+int boot_pre_erase_multi(int image_index);
+
+/**
+ * Erases, ahead of the next upgrade of the image with index 0, the flash which
+ * the previous upgrade left behind.  Note that this API is kept for consistency
+ * with the other single image APIs. The boot_pre_erase_multi() API is
+ * recommended.
+ *
+ * @return                  0 on success; nonzero on failure.
+ */
+int boot_pre_erase(void);
+
 /**
  * @brief Get offset of the swap info field in the image trailer.
  *
@@ -54,6 +54,9 @@ uint32_t bootutil_get_caps(void);
 #define BOOTUTIL_CAP_HW_ROLLBACK_PROT       (1<<18)
 #define BOOTUTIL_CAP_ECDSA_P384             (1<<19)
 #define BOOTUTIL_CAP_SWAP_USING_OFFSET      (1<<20)
+#define BOOTUTIL_CAP_SWAP_STATUS_PACKED     (1<<21)
+#define BOOTUTIL_CAP_SWAP_OFFSET_NO_BACKUP  (1<<22)
+#define BOOTUTIL_CAP_SKIP_PRE_ERASED        (1<<23)
 
 /*
  * Query the number of images this bootloader is configured for.  This
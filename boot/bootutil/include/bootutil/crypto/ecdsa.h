@@ -43,6 +43,7 @@
 #if defined(MCUBOOT_USE_TINYCRYPT)
     #include <tinycrypt/ecc_dsa.h>
     #include <tinycrypt/constants.h>
+    #include "bootutil/crypto/ecdsa_comb.h"
 #endif /* MCUBOOT_USE_TINYCRYPT */
 
 #if defined(MCUBOOT_USE_CC310)
@@ -248,6 +249,41 @@ static inline int bootutil_ecdsa_parse_public_key(bootutil_ecdsa_context *ctx,
     (void)ctx;
     return bootutil_import_key(cp, end);
 }
+
+#if defined(MCUBOOT_ECDSA_COMB_TABLES)
+/*
+ * Verify using the comb table of the key, falling back to the generic
+ * verification if there is no table for the key, or if it was generated for
+ * another key.
+ */
+static inline int bootutil_ecdsa_verify_comb(bootutil_ecdsa_context *ctx,
+                                             uint8_t *pk, size_t pk_len,
+                                             const uint8_t *comb, size_t comb_len,
+                                             uint8_t *hash, size_t hash_len,
+                                             uint8_t *sig, size_t sig_len)
+{
+    uint8_t signature[2 * NUM_ECC_BYTES];
+    int rc;
+
+    if (comb == NULL || comb_len != BOOTUTIL_ECDSA_COMB_SIZE ||
+        pk_len != 2 * NUM_ECC_BYTES + 1 || pk[0] != 0x04 ||
+        hash_len != BOOTUTIL_CRYPTO_ECDSA_P256_HASH_SIZE) {
+        return bootutil_ecdsa_verify(ctx, pk, pk_len, hash, hash_len, sig, sig_len);
+    }
+
+    rc = bootutil_decode_sig(signature, sig, sig + sig_len);
+    if (rc) {
+        return -1;
+    }
+
+    rc = bootutil_ecdsa_comb_verify(pk + 1, comb, hash, signature);
+    if (rc == BOOTUTIL_ECDSA_COMB_MISMATCH) {
+        return bootutil_ecdsa_verify(ctx, pk, pk_len, hash, hash_len, sig, sig_len);
+    }
+
+    return rc == 0 ? 0 : -1;
+}
+#endif /* MCUBOOT_ECDSA_COMB_TABLES */
 #endif /* MCUBOOT_USE_TINYCRYPT */
 
 #if defined(MCUBOOT_USE_CC310)
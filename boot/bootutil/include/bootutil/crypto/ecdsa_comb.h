@@ -0,0 +1,66 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright (c) 2026 Linaro LTD
+ */
+
+/*
+ * Fixed-base ECDSA P-256 verification, using precomputed comb tables for
+ * both the generator and the embedded public keys.
+ *
+ * A comb table for a point P holds, for each i from 1 to 2^TEETH - 1, the
+ * sum of 2^(d * t) * P over the bits t set in i, where d = 256 / TEETH.
+ * u1 * G + u2 * Q then only takes d doublings, instead of one per bit of the
+ * scalars.  Each entry is stored as the big-endian x and y coordinates, and
+ * the table for a key is generated by "imgtool getpub -e lang-c-comb".
+ */
+
+#ifndef __BOOTUTIL_CRYPTO_ECDSA_COMB_H_
+#define __BOOTUTIL_CRYPTO_ECDSA_COMB_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "mcuboot_config/mcuboot_config.h"
+
+#if defined(MCUBOOT_ECDSA_COMB_TABLES)
+#if !defined(MCUBOOT_SIGN_EC256) || !defined(MCUBOOT_USE_TINYCRYPT)
+#error "MCUBOOT_ECDSA_COMB_TABLES requires ECDSA P-256 signatures with TinyCrypt"
+#endif
+#if defined(MCUBOOT_HW_KEY) || defined(MCUBOOT_BUILTIN_KEY)
+#error "MCUBOOT_ECDSA_COMB_TABLES requires public keys embedded in the bootloader"
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of teeth of the comb; imgtool uses the same value. */
+#define BOOTUTIL_ECDSA_COMB_TEETH   4
+
+/* Size in bytes of the comb table of one point. */
+#define BOOTUTIL_ECDSA_COMB_SIZE    (((1 << BOOTUTIL_ECDSA_COMB_TEETH) - 1) * 64)
+
+/* The comb table does not belong to the public key. */
+#define BOOTUTIL_ECDSA_COMB_MISMATCH    (-2)
+
+/**
+ * Verify an ECDSA P-256 signature using comb tables.
+ *
+ * @param pubkey     Uncompressed public key, x and y without the 0x04 prefix.
+ * @param comb       Comb table of the public key, BOOTUTIL_ECDSA_COMB_SIZE
+ *                   bytes long.
+ * @param hash       SHA-256 hash of the signed data.
+ * @param signature  Raw signature, r and s as 32-byte big-endian integers.
+ *
+ * @return 0 if the signature is valid; BOOTUTIL_ECDSA_COMB_MISMATCH if the
+ *         table was not generated for this public key; -1 otherwise.
+ */
+int bootutil_ecdsa_comb_verify(const uint8_t *pubkey, const uint8_t *comb,
+                               const uint8_t *hash, const uint8_t *signature);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BOOTUTIL_CRYPTO_ECDSA_COMB_H_ */
@@ -0,0 +1,73 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright (c) 2026 Linaro LTD
+ */
+
+/*
+ * RSA public key operation using precomputed Montgomery parameters of the
+ * embedded public keys.
+ *
+ * The table of a key holds, as little-endian integers of the size of the
+ * modulus N, N itself and R^2 mod N, where R = 2^(32 * limbs), followed by
+ * -N^-1 mod 2^32 as a 32-bit little-endian integer.  With these, the
+ * signature can be brought into Montgomery form directly, and only the
+ * public exponent 65537 is supported, which takes 16 squarings and a single
+ * multiplication.  The table for a key is generated by
+ * "imgtool getpub -e lang-c-table".
+ */
+
+#ifndef __BOOTUTIL_CRYPTO_RSA_MONT_H_
+#define __BOOTUTIL_CRYPTO_RSA_MONT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "mcuboot_config/mcuboot_config.h"
+
+#if defined(MCUBOOT_RSA_KEY_TABLES)
+#if !defined(MCUBOOT_SIGN_RSA) || defined(MCUBOOT_USE_PSA_CRYPTO)
+#error "MCUBOOT_RSA_KEY_TABLES requires RSA signatures with Mbed TLS"
+#endif
+#if defined(MCUBOOT_HW_KEY) || defined(MCUBOOT_BUILTIN_KEY)
+#error "MCUBOOT_RSA_KEY_TABLES requires public keys embedded in the bootloader"
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Size in bytes of the modulus. */
+#define BOOTUTIL_RSA_MONT_LEN           (MCUBOOT_SIGN_RSA_LEN / 8)
+
+/* Size in bytes of the table of one key. */
+#define BOOTUTIL_RSA_MONT_TABLE_SIZE    (2 * BOOTUTIL_RSA_MONT_LEN + 4)
+
+/* The table does not belong to the public key, or the exponent isn't 65537. */
+#define BOOTUTIL_RSA_MONT_MISMATCH      (-2)
+
+/**
+ * Compute sig^65537 mod N, with N the modulus of a public key.
+ *
+ * @param key        DER encoded RSAPublicKey, as in bootutil_keys[].
+ * @param key_len    Length of @p key.
+ * @param table      Table of the public key.
+ * @param table_len  Length of @p table.
+ * @param sig        Signature, as a big-endian integer.
+ * @param slen       Length of @p sig, must be BOOTUTIL_RSA_MONT_LEN.
+ * @param em         Result, as a big-endian integer of BOOTUTIL_RSA_MONT_LEN
+ *                   bytes.
+ *
+ * @return 0 on success; BOOTUTIL_RSA_MONT_MISMATCH if the table can't be
+ *         used with this key; -1 if the signature is not smaller than N or
+ *         has the wrong length.
+ */
+int bootutil_rsa_mont_public(const uint8_t *key, size_t key_len,
+                             const uint8_t *table, size_t table_len,
+                             const uint8_t *sig, size_t slen, uint8_t *em);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BOOTUTIL_CRYPTO_RSA_MONT_H_ */
@@ -76,6 +76,48 @@
     #include <tinycrypt/constants.h>
 #endif /* MCUBOOT_USE_TINYCRYPT */
 
+/*
+ * With TinyCrypt, the hash can use an optimized compression kernel instead of
+ * TinyCrypt's own, see sha_kernels.c:
+ *  - MCUBOOT_SHA_KERNEL_UNROLLED: fully unrolled portable C.
+ *  - MCUBOOT_SHA_KERNEL_SHA_NI: x86 SHA extensions for SHA-256, checked for at
+ *    run time, with the unrolled kernel as fallback.
+ *  - MCUBOOT_SHA_KERNEL_ARMV8_CE: Armv8 crypto extension for SHA-256.
+ * SHA-512 always uses the unrolled kernel.
+ */
+#if (defined(MCUBOOT_SHA_KERNEL_UNROLLED) + \
+     defined(MCUBOOT_SHA_KERNEL_SHA_NI) + \
+     defined(MCUBOOT_SHA_KERNEL_ARMV8_CE)) > 1
+    #error "Only one of MCUBOOT_SHA_KERNEL_UNROLLED/SHA_NI/ARMV8_CE can be defined"
+#endif
+
+#if defined(MCUBOOT_SHA_KERNEL_UNROLLED) || defined(MCUBOOT_SHA_KERNEL_SHA_NI) || \
+    defined(MCUBOOT_SHA_KERNEL_ARMV8_CE)
+#if !defined(MCUBOOT_USE_TINYCRYPT)
+    #error "MCUBOOT_SHA_KERNEL_* requires MCUBOOT_USE_TINYCRYPT"
+#endif
+#define MCUBOOT_SHA_KERNEL
+#endif
+
+#if defined(MCUBOOT_SHA_KERNEL)
+    #include <tinycrypt/sha256.h>
+#endif /* MCUBOOT_SHA_KERNEL */
+
+/*
+ * With MCUBOOT_SHA_FLASH_RANGE, the image is hashed straight from the flash
+ * by bootutil_sha_update_flash(), which the port provides, instead of being
+ * read into a buffer first, except for the encrypted parts.  This lets a
+ * crypto engine fetch the data itself, by DMA from memory-mapped flash.
+ * MCUBOOT_HASH_STORAGE_DIRECTLY selects the implementation of bootutil, which
+ * hands the address of the mapped flash to bootutil_sha_update().
+ */
+#if defined(MCUBOOT_HASH_STORAGE_DIRECTLY)
+#if defined(MCUBOOT_SHA_FLASH_RANGE)
+    #error "MCUBOOT_HASH_STORAGE_DIRECTLY provides MCUBOOT_SHA_FLASH_RANGE, define only one"
+#endif
+#define MCUBOOT_SHA_FLASH_RANGE
+#endif
+
 #if defined(MCUBOOT_USE_CC310)
     #include <cc310_glue.h>
 #endif /* MCUBOOT_USE_CC310 */
@@ -198,6 +240,18 @@ static inline int bootutil_sha_finish(bootutil_sha_context *ctx,
 
 #endif /* MCUBOOT_USE_MBED_TLS */
 
+#if defined(MCUBOOT_SHA_KERNEL)
+/* Same as tc_sha256_update() and tc_sha256_final(), on the same state. */
+int bootutil_tc_sha256_update(TCSha256State_t s, const uint8_t *data, size_t datalen);
+int bootutil_tc_sha256_final(uint8_t *digest, TCSha256State_t s);
+
+#if defined(MCUBOOT_SHA512)
+/* Same as tc_sha512_update() and tc_sha512_final(), on the same state. */
+int bootutil_tc_sha512_update(TCSha512State_t s, const uint8_t *data, size_t datalen);
+int bootutil_tc_sha512_final(uint8_t *digest, TCSha512State_t s);
+#endif
+#endif /* MCUBOOT_SHA_KERNEL */
+
 #if defined(MCUBOOT_USE_TINYCRYPT)
 #if defined(MCUBOOT_SHA512)
 typedef struct tc_sha512_state_struct bootutil_sha_context;
@@ -225,7 +279,11 @@ static inline int bootutil_sha_update(bootutil_sha_context *ctx,
                                       const void *data,
                                       uint32_t data_len)
 {
-#if defined(MCUBOOT_SHA512)
+#if defined(MCUBOOT_SHA_KERNEL) && defined(MCUBOOT_SHA512)
+    return bootutil_tc_sha512_update(ctx, data, data_len);
+#elif defined(MCUBOOT_SHA_KERNEL)
+    return bootutil_tc_sha256_update(ctx, data, data_len);
+#elif defined(MCUBOOT_SHA512)
     return tc_sha512_update(ctx, data, data_len);
 #else
     return tc_sha256_update(ctx, data, data_len);
@@ -235,7 +293,11 @@ static inline int bootutil_sha_update(bootutil_sha_context *ctx,
 static inline int bootutil_sha_finish(bootutil_sha_context *ctx,
                                       uint8_t *output)
 {
-#if defined(MCUBOOT_SHA512)
+#if defined(MCUBOOT_SHA_KERNEL) && defined(MCUBOOT_SHA512)
+    return bootutil_tc_sha512_final(output, ctx);
+#elif defined(MCUBOOT_SHA_KERNEL)
+    return bootutil_tc_sha256_final(output, ctx);
+#elif defined(MCUBOOT_SHA512)
     return tc_sha512_final(output, ctx);
 #else
     return tc_sha256_final(output, ctx);
@@ -341,6 +403,22 @@ static inline int bootutil_sha_finish(bootutil_sha_context *ctx,
 
 #endif /* MCUBOOT_USE_NRF_OBERON */
 
+#if defined(MCUBOOT_SHA_FLASH_RANGE)
+struct flash_area;
+
+/**
+ * Add len bytes of a flash area, from offset off, to the hash.
+ *
+ * The engine may work on its own while the data is fetched, but the range
+ * must be fully hashed when the function returns.
+ *
+ * @return 0 on success; a non-zero value if the flash could not be read.
+ */
+int bootutil_sha_update_flash(bootutil_sha_context *ctx,
+                              const struct flash_area *fap,
+                              uint32_t off, uint32_t len);
+#endif /* MCUBOOT_SHA_FLASH_RANGE */
+
 #ifdef __cplusplus
 }
 #endif
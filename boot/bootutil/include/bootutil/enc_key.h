@@ -44,6 +44,19 @@ struct enc_key_data {
     bootutil_aes_ctr_context aes_ctr;
 };
 
+/* Number of digest octets used to identify a cached encryption TLV. */
+#define BOOT_ENC_KEY_CACHE_DIGEST_SIZE 32
+
+/*
+ * Plain key unwrapped from an encryption TLV during the current boot,
+ * identified by a digest of that TLV. See boot_enc_unwrap_key().
+ */
+struct boot_enc_key_cache {
+    uint8_t valid;
+    uint8_t tlv_digest[BOOT_ENC_KEY_CACHE_DIGEST_SIZE];
+    uint8_t key[BOOT_ENC_KEY_SIZE];
+};
+
 /**
  * Retrieve the private key for image encryption.
  *
@@ -67,6 +80,13 @@ int boot_enc_set_key(struct enc_key_data *enc_state, const uint8_t *key);
 int boot_enc_load(struct boot_loader_state *state, int slot,
                   const struct image_header *hdr, const struct flash_area *fap,
                   struct boot_status *bs);
+int boot_enc_unwrap_key(struct boot_loader_state *state, int slot,
+                        const uint8_t *tlv, uint8_t *enckey);
+void boot_enc_cache_zeroize(struct boot_loader_state *state);
+#if defined(__BOOTSIM__)
+/* Number of keys actually unwrapped by the boots run on the current thread. */
+uint32_t boot_enc_unwrap_count(void);
+#endif
 bool boot_enc_valid(const struct enc_key_data *enc_state);
 void boot_enc_encrypt(struct enc_key_data *enc_state,
         uint32_t off, uint32_t sz, uint32_t blk_off, uint8_t *buf);
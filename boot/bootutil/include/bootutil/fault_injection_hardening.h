@@ -52,6 +52,11 @@
  * Note that any function called by FIH_CALL must only return using FIH_RETURN,
  * as otherwise the CFI counter will not be decremented and the CFI check will
  * fail causing a panic.
+ *
+ * MCUBOOT_FIH_PROFILING reports every FIH_CALL and fih_delay to the
+ * fih_profile_call and fih_profile_delay hooks, with the call site, so that the
+ * cost of a profile can be measured. It is meant for the simulator and
+ * benchmarks, not for production builds.
  */
 
 #include "mcuboot_config/mcuboot_config.h"
@@ -187,6 +192,24 @@ int fih_delay(void)
 }
 #endif /* FIH_ENABLE_DELAY */
 
+#ifdef MCUBOOT_FIH_PROFILING
+/* Called before each FIH_CALL and fih_delay, with the call site. */
+void fih_profile_call(const char *func, const char *file, int line);
+void fih_profile_delay(const char *file, int line);
+
+__attribute__((always_inline)) inline
+int fih_delay_profiled(const char *file, int line)
+{
+    fih_profile_delay(file, line);
+    return fih_delay();
+}
+
+#define fih_delay() fih_delay_profiled(__FILE__, __LINE__)
+#define FIH_PROFILE_CALL(f) fih_profile_call(#f, __FILE__, __LINE__)
+#else
+#define FIH_PROFILE_CALL(f)
+#endif /* MCUBOOT_FIH_PROFILING */
+
 #ifdef FIH_ENABLE_DOUBLE_VARS
 
 __attribute__((always_inline)) inline
@@ -266,7 +289,13 @@ fih_ret fih_ret_encode_zero_equality(int x)
 }
 
 #ifdef FIH_ENABLE_CFI
-extern fih_int _fih_cfi_ctr;
+#if defined(__BOOTSIM__)
+/* The simulator runs several boots at once, each on its own thread. */
+#define FIH_CFI_CTR_STORAGE __thread
+#else
+#define FIH_CFI_CTR_STORAGE
+#endif
+extern FIH_CFI_CTR_STORAGE fih_int _fih_cfi_ctr;
 #endif /* FIH_ENABLE_CFI */
 
 fih_int fih_cfi_get_and_increment(void);
@@ -306,6 +335,7 @@ void fih_cfi_decrement(void);
     do { \
         FIH_LABEL("FIH_CALL_START", l, c);        \
         FIH_CFI_PRECALL_BLOCK; \
+        FIH_PROFILE_CALL(f); \
         ret = FIH_FAILURE; \
         if (fih_delay()) { \
             ret = f(__VA_ARGS__); \
@@ -320,6 +350,7 @@ void fih_cfi_decrement(void);
     do { \
         FIH_LABEL("FIH_CALL_START"); \
         FIH_CFI_PRECALL_BLOCK; \
+        FIH_PROFILE_CALL(f); \
         ret = FIH_FAILURE; \
         if (fih_delay()) { \
             ret = f(__VA_ARGS__); \
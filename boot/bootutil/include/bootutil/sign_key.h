@@ -64,6 +64,33 @@ int boot_retrieve_public_key_hash(uint8_t image_index,
 
 extern const int bootutil_key_cnt;
 
+#if defined(MCUBOOT_ECDSA_COMB_TABLES)
+/*
+ * Comb tables of the keys in bootutil_keys[], at the same index, see
+ * bootutil/crypto/ecdsa_comb.h.  An entry with a NULL key falls back to
+ * the generic verification.
+ */
+extern const struct bootutil_key bootutil_ecdsa_combs[];
+#endif
+
+#if defined(MCUBOOT_ED25519_KEY_TABLES)
+/*
+ * Precomputed tables of the keys in bootutil_keys[], at the same index, from
+ * "imgtool getpub -e lang-c-table".  An entry with a NULL key falls back to
+ * the generic verification.
+ */
+extern const struct bootutil_key bootutil_ed25519_tables[];
+#endif
+
+#if defined(MCUBOOT_RSA_KEY_TABLES)
+/*
+ * Montgomery parameters of the keys in bootutil_keys[], at the same index,
+ * see bootutil/crypto/rsa_mont.h.  An entry with a NULL key falls back to
+ * the generic verification.
+ */
+extern const struct bootutil_key bootutil_rsa_tables[];
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,622 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright (c) 2026 Linaro LTD
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "sysflash/sysflash.h"
+#include "flash_map_backend/flash_map_backend.h"
+
+#include "bootutil/boot_image_writer.h"
+#include "bootutil/bootutil_log.h"
+#include "bootutil/bootutil_macros.h"
+#include "bootutil_priv.h"
+#include "bootutil_misc.h"
+
+#ifdef CONFIG_MCUBOOT
+BOOT_LOG_MODULE_DECLARE(mcuboot);
+#else
+BOOT_LOG_MODULE_DECLARE(mcuboot_util);
+#endif
+
+#ifndef MIN
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#endif
+
+#ifndef MAX
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+#endif
+
+#if (BOOT_IMAGE_WRITER_BUF_SZ % BOOT_MAX_ALIGN) != 0
+#error "BOOT_IMAGE_WRITER_BUF_SZ must be a multiple of BOOT_MAX_ALIGN"
+#endif
+
+#if defined(MCUBOOT_SWAP_USING_MOVE) || defined(MCUBOOT_SWAP_USING_OFFSET)
+/* Number of sectors of an area. */
+static int
+boot_image_writer_num_sectors(const struct flash_area *fap, uint32_t *count)
+{
+    struct flash_sector sector;
+    uint32_t off;
+
+    *count = 0;
+    for (off = 0; off < flash_area_get_size(fap); off += flash_sector_get_size(&sector)) {
+        if (flash_area_get_sector(fap, off, &sector) != 0) {
+            return BOOT_EFLASH;
+        }
+        (*count)++;
+    }
+
+    return 0;
+}
+
+/*
+ * Size of the slots less the trailers and the sector the image is moved by,
+ * as app_max_size() of swap-move and swap-offset finds it.
+ */
+static int
+boot_image_writer_max_size_move(const struct flash_area *fap_pri,
+                                const struct flash_area *fap_sec, uint32_t *max_size)
+{
+    struct flash_sector sector;
+    uint32_t trailer_sz;
+    uint32_t sector_sz;
+    uint32_t num_pri;
+    uint32_t num_sec;
+    uint32_t pri_sz;
+    uint32_t sec_sz;
+
+    if (flash_area_get_sector(fap_pri, 0, &sector) != 0 ||
+        boot_image_writer_num_sectors(fap_pri, &num_pri) != 0 ||
+        boot_image_writer_num_sectors(fap_sec, &num_sec) != 0) {
+        return BOOT_EFLASH;
+    }
+
+    sector_sz = flash_sector_get_size(&sector);
+    trailer_sz = ALIGN_UP(boot_trailer_sz(flash_area_align(fap_pri)), sector_sz);
+
+    /* The slot the image is moved within needs a sector of padding. */
+#if defined(MCUBOOT_SWAP_USING_MOVE)
+    pri_sz = num_pri * sector_sz - trailer_sz - sector_sz;
+    sec_sz = num_sec * sector_sz - trailer_sz;
+#else
+    pri_sz = num_pri * sector_sz - trailer_sz;
+    sec_sz = num_sec * sector_sz - trailer_sz - sector_sz;
+#endif
+
+    *max_size = MIN(pri_sz, sec_sz);
+    return 0;
+}
+#endif
+
+#if defined(MCUBOOT_SWAP_USING_SCRATCH)
+/* Move end past the sector of an area starting there. */
+static int
+boot_image_writer_next_sector(const struct flash_area *fap, uint32_t *end)
+{
+    struct flash_sector sector;
+
+    if (flash_area_get_sector(fap, *end, &sector) != 0) {
+        return BOOT_EFLASH;
+    }
+
+    *end += flash_sector_get_size(&sector);
+    return 0;
+}
+
+/* End of the first sector of an area holding part of a trailer of size sz. */
+static int
+boot_image_writer_trailer_sector_end(const struct flash_area *fap, uint32_t sz, uint32_t *end)
+{
+    struct flash_sector sector;
+    uint32_t size = flash_area_get_size(fap);
+    uint32_t off = size;
+
+    do {
+        if (off == 0 || flash_area_get_sector(fap, off - 1, &sector) != 0) {
+            return BOOT_EFLASH;
+        }
+        off = flash_sector_get_off(&sector);
+    } while (size - off < sz);
+
+    *end = off + flash_sector_get_size(&sector);
+    return 0;
+}
+
+/*
+ * Size of the part of the slots swapped through the scratch area, as
+ * app_max_size() of swap-scratch finds it, less the trailers.
+ */
+static int
+boot_image_writer_max_size_scratch(const struct flash_area *fap_pri,
+                                   const struct flash_area *fap_sec, uint32_t *max_size)
+{
+    const struct flash_area *fap_scratch;
+    uint32_t scratch_sz;
+    uint32_t write_sz;
+    uint32_t trailer_sz;
+    uint32_t trailer_off;
+    uint32_t in_sector;
+    uint32_t padding;
+    uint32_t slot_sz = 0;
+    uint32_t end_pri = 0;
+    uint32_t end_sec = 0;
+    int smaller = 0;
+    int rc = 0;
+
+    if (flash_area_open(FLASH_AREA_IMAGE_SCRATCH, &fap_scratch) != 0) {
+        return BOOT_EFLASH;
+    }
+    scratch_sz = flash_area_get_size(fap_scratch);
+    write_sz = MAX(flash_area_align(fap_pri), flash_area_align(fap_scratch));
+    flash_area_close(fap_scratch);
+
+    /*
+     * Pair the sectors of the slots, as the swap goes, each group of which must
+     * fit in the scratch area.
+     */
+    while (end_pri < flash_area_get_size(fap_pri) && end_sec < flash_area_get_size(fap_sec)) {
+        if (end_pri == end_sec) {
+            rc = boot_image_writer_next_sector(fap_pri, &end_pri);
+            if (rc == 0) {
+                rc = boot_image_writer_next_sector(fap_sec, &end_sec);
+            }
+        } else if (end_pri < end_sec) {
+            if (smaller == 2) {
+                goto incompatible;
+            }
+            smaller = 1;
+            rc = boot_image_writer_next_sector(fap_pri, &end_pri);
+        } else {
+            if (smaller == 1) {
+                goto incompatible;
+            }
+            smaller = 2;
+            rc = boot_image_writer_next_sector(fap_sec, &end_sec);
+        }
+
+        if (rc != 0) {
+            return rc;
+        }
+
+        if (end_pri == end_sec) {
+            if (end_pri - slot_sz > scratch_sz) {
+                goto incompatible;
+            }
+            slot_sz = end_pri;
+            smaller = 0;
+        }
+    }
+
+    trailer_sz = boot_trailer_sz(write_sz);
+    if (slot_sz < trailer_sz ||
+        boot_image_writer_trailer_sector_end(fap_pri, trailer_sz, &end_pri) != 0 ||
+        boot_image_writer_trailer_sector_end(fap_sec, trailer_sz, &end_sec) != 0) {
+        return BOOT_EFLASH;
+    }
+
+    /*
+     * The last sector swapped must leave room in the scratch area for its
+     * trailer, as app_max_size_adjust_to_trailer() pads the image for.
+     */
+    trailer_off = slot_sz - trailer_sz;
+    in_sector = MAX(end_pri, end_sec) - trailer_off;
+    padding = boot_scratch_trailer_sz(write_sz);
+    padding = padding > in_sector ? padding - in_sector : 0;
+
+    *max_size = trailer_off > padding ? trailer_off - padding : 0;
+    return 0;
+
+incompatible:
+    BOOT_LOG_ERR("Image writer: slots cannot be swapped");
+    *max_size = 0;
+    return 0;
+}
+#endif
+
+/*
+ * Largest image the bootloader accepts in the secondary slot, as
+ * bootutil_max_image_size() computes it.  The swap modes leave room in both
+ * slots for the swap status and the encryption keys, and for the sector
+ * swap-move and swap-offset shift the image by.
+ */
+static int
+boot_image_writer_max_size(const struct boot_image_writer *writer, int image_index,
+                           uint32_t *max_size)
+{
+#if defined(MCUBOOT_SWAP_USING_MOVE) || defined(MCUBOOT_SWAP_USING_OFFSET) || \
+    defined(MCUBOOT_SWAP_USING_SCRATCH)
+    const struct flash_area *fap_pri;
+    int rc;
+
+    if (flash_area_open(FLASH_AREA_IMAGE_PRIMARY(image_index), &fap_pri) != 0) {
+        return BOOT_EFLASH;
+    }
+
+#if defined(MCUBOOT_SWAP_USING_SCRATCH)
+    rc = boot_image_writer_max_size_scratch(fap_pri, writer->fap, max_size);
+#else
+    rc = boot_image_writer_max_size_move(fap_pri, writer->fap, max_size);
+#endif
+
+    flash_area_close(fap_pri);
+    return rc;
+#elif defined(MCUBOOT_SINGLE_APPLICATION_SLOT) || defined(MCUBOOT_FIRMWARE_LOADER)
+    (void)image_index;
+    *max_size = flash_area_get_size(writer->fap) -
+                boot_trailer_sz(flash_area_align(writer->fap));
+    return 0;
+#else
+    (void)image_index;
+    *max_size = boot_swap_info_off(writer->fap);
+    return 0;
+#endif
+}
+
+/* Erase the sectors of the slot up to the one holding the byte before end. */
+static int
+boot_image_writer_erase_to(struct boot_image_writer *writer, uint32_t end)
+{
+    struct flash_sector sector;
+    uint32_t off;
+    uint32_t size;
+
+    while (writer->erased_to < end) {
+        if (flash_area_get_sector(writer->fap, writer->erased_to, &sector) != 0) {
+            return BOOT_EFLASH;
+        }
+
+        off = flash_sector_get_off(&sector);
+        size = flash_sector_get_size(&sector);
+        if (device_requires_erase(writer->fap) &&
+            flash_area_erase(writer->fap, off, size) != 0) {
+            return BOOT_EFLASH;
+        }
+
+        writer->erased_to = off + size;
+    }
+
+    return 0;
+}
+
+/* Write whole write blocks at the end of the data already written. */
+static int
+boot_image_writer_program(struct boot_image_writer *writer, const uint8_t *data, uint32_t len)
+{
+    uint32_t off = writer->start + writer->written;
+    int rc;
+
+    if (len > writer->trailer_off - off) {
+        BOOT_LOG_ERR("Image writer: image overlaps the trailer");
+        return BOOT_EBADIMAGE;
+    }
+
+    rc = boot_image_writer_erase_to(writer, off + len);
+    if (rc != 0) {
+        return rc;
+    }
+
+    if (flash_area_write(writer->fap, off, data, len) != 0) {
+        return BOOT_EFLASH;
+    }
+
+    writer->written += len;
+    return 0;
+}
+
+/*
+ * Keep the header as it goes by, to learn the size of the hashed part of the
+ * image, and hash the data which is part of it.
+ */
+static int
+boot_image_writer_hash(struct boot_image_writer *writer, const uint8_t *data, uint32_t len)
+{
+    struct image_header *hdr = &writer->hdr;
+    uint32_t n;
+
+    if (writer->received < sizeof(*hdr)) {
+        n = MIN(len, sizeof(*hdr) - writer->received);
+        memcpy((uint8_t *)hdr + writer->received, data, n);
+
+        if (writer->received + n == sizeof(*hdr)) {
+            if (hdr->ih_magic != IMAGE_MAGIC || hdr->ih_hdr_size < sizeof(*hdr) ||
+                !boot_u32_safe_add(&n, hdr->ih_hdr_size, hdr->ih_img_size) ||
+                !boot_u32_safe_add(&n, n, hdr->ih_protect_tlv_size) ||
+                n > writer->max_size) {
+                BOOT_LOG_ERR("Image writer: bad image header");
+                return BOOT_EBADIMAGE;
+            }
+
+            writer->hashed_sz = n;
+        }
+    }
+
+    if (writer->received < writer->hashed_sz) {
+        n = MIN(len, writer->hashed_sz - writer->received);
+        bootutil_sha_update(&writer->sha, data, n);
+    }
+
+    writer->received += len;
+    return 0;
+}
+
+/* Check the TLVs of the image, which is entirely written, against its hash. */
+static int
+boot_image_writer_check(struct boot_image_writer *writer)
+{
+    uint8_t hash[IMAGE_HASH_SIZE];
+    uint8_t tlv_hash[IMAGE_HASH_SIZE];
+    struct image_tlv_info info;
+    struct image_tlv tlv;
+    bool found = false;
+    uint32_t off;
+    uint32_t end;
+
+    if (writer->received < sizeof(writer->hdr)) {
+        BOOT_LOG_ERR("Image writer: incomplete image");
+        return BOOT_EBADIMAGE;
+    }
+
+    bootutil_sha_finish(&writer->sha, hash);
+
+    off = writer->start + BOOT_TLV_OFF(&writer->hdr);
+    if (flash_area_read(writer->fap, off, &info, sizeof(info)) != 0) {
+        return BOOT_EFLASH;
+    }
+
+    if (info.it_magic == IMAGE_TLV_PROT_INFO_MAGIC) {
+        if (info.it_tlv_tot != writer->hdr.ih_protect_tlv_size) {
+            goto bad;
+        }
+        off += info.it_tlv_tot;
+        if (flash_area_read(writer->fap, off, &info, sizeof(info)) != 0) {
+            return BOOT_EFLASH;
+        }
+    } else if (writer->hdr.ih_protect_tlv_size != 0) {
+        goto bad;
+    }
+
+    if (info.it_magic != IMAGE_TLV_INFO_MAGIC ||
+        off + info.it_tlv_tot > writer->start + writer->received) {
+        goto bad;
+    }
+
+    end = off + info.it_tlv_tot;
+    off += sizeof(info);
+    while (off + sizeof(tlv) <= end) {
+        if (flash_area_read(writer->fap, off, &tlv, sizeof(tlv)) != 0) {
+            return BOOT_EFLASH;
+        }
+        off += sizeof(tlv);
+
+        if (tlv.it_type == EXPECTED_HASH_TLV) {
+            if (tlv.it_len != IMAGE_HASH_SIZE || off + tlv.it_len > end) {
+                goto bad;
+            }
+            if (flash_area_read(writer->fap, off, tlv_hash, sizeof(tlv_hash)) != 0) {
+                return BOOT_EFLASH;
+            }
+            found = true;
+        }
+
+        off += tlv.it_len;
+    }
+
+    if (off != end) {
+        goto bad;
+    }
+
+    /* The hash of an encrypted image is the one of the decrypted image. */
+    if (IS_ENCRYPTED(&writer->hdr)) {
+        return 0;
+    }
+
+#if defined(MCUBOOT_SIGN_PURE)
+    if (!found) {
+        return 0;
+    }
+#endif
+
+    if (!found || memcmp(hash, tlv_hash, sizeof(hash)) != 0) {
+        BOOT_LOG_ERR("Image writer: image hash mismatch");
+        return BOOT_EBADIMAGE;
+    }
+
+    return 0;
+
+bad:
+    BOOT_LOG_ERR("Image writer: bad image TLVs");
+    return BOOT_EBADIMAGE;
+}
+
+/*
+ * Clear the trailer, skipping the sectors between the end of the image and
+ * the trailer, which the bootloader does not look at.
+ */
+static int
+boot_image_writer_clear_trailer(struct boot_image_writer *writer)
+{
+    struct flash_sector sector;
+    uint32_t size = flash_area_get_size(writer->fap);
+    uint32_t off;
+    uint32_t len;
+
+    if (!device_requires_erase(writer->fap)) {
+        memset(writer->buf, flash_area_erased_val(writer->fap), sizeof(writer->buf));
+        for (off = writer->trailer_off; off < size; off += len) {
+            len = MIN(size - off, sizeof(writer->buf));
+            if (flash_area_write(writer->fap, off, writer->buf, len) != 0) {
+                return BOOT_EFLASH;
+            }
+        }
+        return 0;
+    }
+
+    if (writer->erased_to < writer->trailer_off) {
+        if (flash_area_get_sector(writer->fap, writer->trailer_off, &sector) != 0) {
+            return BOOT_EFLASH;
+        }
+        writer->erased_to = flash_sector_get_off(&sector);
+    }
+
+    return boot_image_writer_erase_to(writer, size);
+}
+
+#if defined(MCUBOOT_SWAP_USING_SCRATCH) || defined(MCUBOOT_SWAP_USING_OFFSET)
+/*
+ * Write back the record of boot_pre_erase_multi() when the writer erased it
+ * along with the image or the trailer, as the range it covers was left alone.
+ */
+static int
+boot_image_writer_keep_pre_erased(struct boot_image_writer *writer)
+{
+    struct boot_pre_erased rec;
+    int rc;
+
+    if (writer->pre_erased.magic != BOOT_PRE_ERASED_MAGIC) {
+        return 0;
+    }
+
+    rc = boot_read_pre_erased(writer->fap, &rec);
+    if (rc == 1 && bootutil_buffer_is_erased(writer->fap, &rec, sizeof(rec))) {
+        rc = boot_write_pre_erased(writer->fap, &writer->pre_erased);
+    }
+
+    return rc == BOOT_EFLASH ? BOOT_EFLASH : 0;
+}
+#endif
+
+int
+boot_image_writer_open(struct boot_image_writer *writer, int image_index)
+{
+#if defined(MCUBOOT_SWAP_USING_OFFSET)
+    struct flash_sector sector;
+#endif
+
+    memset(writer, 0, sizeof(*writer));
+
+    if (flash_area_open(FLASH_AREA_IMAGE_SECONDARY(image_index), &writer->fap) != 0) {
+        writer->fap = NULL;
+        return BOOT_EFLASH;
+    }
+
+#if defined(MCUBOOT_SWAP_USING_OFFSET)
+    /* The update image starts at the second sector of the slot. */
+    if (flash_area_get_sector(writer->fap, 0, &sector) != 0) {
+        flash_area_close(writer->fap);
+        writer->fap = NULL;
+        return BOOT_EFLASH;
+    }
+    writer->start = flash_sector_get_size(&sector);
+#endif
+
+    writer->trailer_off = ALIGN_DOWN(boot_swap_size_off(writer->fap), BOOT_MAX_ALIGN);
+    if (boot_image_writer_max_size(writer, image_index, &writer->max_size) != 0) {
+        flash_area_close(writer->fap);
+        writer->fap = NULL;
+        return BOOT_EFLASH;
+    }
+    writer->max_size = MIN(writer->max_size, writer->trailer_off - writer->start);
+    writer->hashed_sz = UINT32_MAX;
+#if defined(MCUBOOT_SWAP_USING_SCRATCH) || defined(MCUBOOT_SWAP_USING_OFFSET)
+    if (boot_read_pre_erased(writer->fap, &writer->pre_erased) != 0) {
+        writer->pre_erased.magic = 0;
+    }
+#endif
+    bootutil_sha_init(&writer->sha);
+
+    return 0;
+}
+
+int
+boot_image_writer_write(struct boot_image_writer *writer, const void *data, size_t len)
+{
+    const uint8_t *p = data;
+    uint32_t align = flash_area_align(writer->fap);
+    uint32_t n;
+    int rc;
+
+    if (len > writer->max_size - writer->received) {
+        BOOT_LOG_ERR("Image writer: image larger than the slot allows");
+        return BOOT_EBADIMAGE;
+    }
+
+    rc = boot_image_writer_hash(writer, p, len);
+    if (rc != 0) {
+        return rc;
+    }
+
+    while (len > 0) {
+        if (writer->buf_len == 0 && len >= sizeof(writer->buf)) {
+            /* Large writes go straight to the flash, but for their tail. */
+            n = len - (len % align);
+            rc = boot_image_writer_program(writer, p, n);
+        } else {
+            n = MIN(len, sizeof(writer->buf) - writer->buf_len);
+            memcpy(&writer->buf[writer->buf_len], p, n);
+            writer->buf_len += n;
+            if (writer->buf_len == sizeof(writer->buf)) {
+                rc = boot_image_writer_program(writer, writer->buf, writer->buf_len);
+                writer->buf_len = 0;
+            }
+        }
+
+        if (rc != 0) {
+            return rc;
+        }
+
+        p += n;
+        len -= n;
+    }
+
+    return 0;
+}
+
+int
+boot_image_writer_finish(struct boot_image_writer *writer, int permanent)
+{
+    uint32_t len;
+    int rc = 0;
+
+    if (writer->buf_len > 0) {
+        len = ALIGN_UP(writer->buf_len, flash_area_align(writer->fap));
+        memset(&writer->buf[writer->buf_len], flash_area_erased_val(writer->fap),
+               len - writer->buf_len);
+        rc = boot_image_writer_program(writer, writer->buf, len);
+        writer->buf_len = 0;
+    }
+
+    if (rc == 0) {
+        rc = boot_image_writer_check(writer);
+    }
+
+    if (rc == 0) {
+        rc = boot_image_writer_clear_trailer(writer);
+    }
+
+#if defined(MCUBOOT_SWAP_USING_SCRATCH) || defined(MCUBOOT_SWAP_USING_OFFSET)
+    if (rc == 0) {
+        rc = boot_image_writer_keep_pre_erased(writer);
+    }
+#endif
+
+    if (rc == 0) {
+        rc = boot_set_next(writer->fap, false, permanent != 0);
+    }
+
+    boot_image_writer_abort(writer);
+    return rc;
+}
+
+void
+boot_image_writer_abort(struct boot_image_writer *writer)
+{
+    if (writer->fap != NULL) {
+        bootutil_sha_drop(&writer->sha);
+        flash_area_close(writer->fap);
+        writer->fap = NULL;
+    }
+}
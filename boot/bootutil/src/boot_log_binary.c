@@ -0,0 +1,118 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright (c) 2026 Linaro LTD
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "mcuboot_config/mcuboot_config.h"
+
+#ifdef MCUBOOT_LOG_BINARY
+
+#include "bootutil/boot_log_binary.h"
+
+#ifndef MCUBOOT_LOG_BINARY_SIZE
+#define MCUBOOT_LOG_BINARY_SIZE 1024
+#endif
+
+#if MCUBOOT_LOG_BINARY_SIZE < 64 || (MCUBOOT_LOG_BINARY_SIZE % 8) != 0
+#error "MCUBOOT_LOG_BINARY_SIZE must be a multiple of 8, of at least 64 bytes"
+#endif
+
+#define BOOT_LOG_BINARY_RING_WORDS \
+    ((MCUBOOT_LOG_BINARY_SIZE - sizeof(struct boot_log_binary)) / sizeof(uintptr_t))
+
+/*
+ * The simulator runs several boots at once, each on its own thread, so each
+ * of them has its own log.
+ */
+#if defined(__BOOTSIM__)
+#define BOOT_LOG_BINARY_STORAGE static __thread
+#else
+#define BOOT_LOG_BINARY_STORAGE static
+#endif
+
+/*
+ * The log is either at a fixed address, in RAM retained across the jump to the
+ * application, or in the RAM of the bootloader, in which case the application
+ * finds it through the shared data.
+ */
+#if defined(MCUBOOT_LOG_BINARY_ADDRESS)
+#define boot_log ((struct boot_log_binary *)MCUBOOT_LOG_BINARY_ADDRESS)
+#else
+BOOT_LOG_BINARY_STORAGE uintptr_t boot_log_storage[MCUBOOT_LOG_BINARY_SIZE / sizeof(uintptr_t)];
+#define boot_log ((struct boot_log_binary *)boot_log_storage)
+#endif
+
+#define boot_log_ring ((uintptr_t *)(boot_log + 1))
+
+BOOT_LOG_BINARY_STORAGE bool boot_log_ready;
+
+void
+boot_log_binary_init(void)
+{
+    boot_log->magic = BOOT_LOG_BINARY_MAGIC;
+    boot_log->version = BOOT_LOG_BINARY_VERSION;
+    boot_log->word_size = sizeof(uintptr_t);
+    boot_log->seq = 0;
+    boot_log->size = BOOT_LOG_BINARY_RING_WORDS;
+    boot_log->head = 0;
+    boot_log->used = 0;
+    boot_log->dropped = 0;
+    boot_log_ready = true;
+}
+
+void
+boot_log_binary_write(uint8_t level, const uintptr_t *words, uint32_t count)
+{
+    uint32_t size = BOOT_LOG_BINARY_RING_WORDS;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t i;
+
+    if (!boot_log_ready) {
+        boot_log_binary_init();
+    }
+
+    if (count + 1 > size) {
+        boot_log->dropped++;
+        return;
+    }
+
+    /* Make room by dropping the oldest records. */
+    while (boot_log->used + count + 1 > size) {
+        tail = (boot_log->head + size - boot_log->used) % size;
+        boot_log->used -= BOOT_LOG_BINARY_REC_NARGS(boot_log_ring[tail]) + 2;
+        boot_log->dropped++;
+    }
+
+    head = boot_log->head;
+    boot_log_ring[head] = level | ((count - 1) << 8) | ((uint32_t)boot_log->seq << 16);
+    for (i = 0; i < count; i++) {
+        if (++head == size) {
+            head = 0;
+        }
+        boot_log_ring[head] = words[i];
+    }
+    if (++head == size) {
+        head = 0;
+    }
+
+    boot_log->head = head;
+    boot_log->used += count + 1;
+    boot_log->seq++;
+}
+
+const struct boot_log_binary *
+boot_log_binary_get(void)
+{
+    if (!boot_log_ready) {
+        boot_log_binary_init();
+    }
+
+    return boot_log;
+}
+
+#endif /* MCUBOOT_LOG_BINARY */
@@ -27,6 +27,9 @@
 #ifdef MCUBOOT_HW_ROLLBACK_PROT
 #include "bootutil/security_cnt.h"
 #endif
+#ifdef MCUBOOT_LOG_BINARY
+#include "bootutil/boot_log_binary.h"
+#endif
 
 #if defined(MCUBOOT_MEASURED_BOOT) || defined(MCUBOOT_DATA_SHARING)
 #include "bootutil/boot_record.h"
@@ -385,6 +388,18 @@ int boot_save_shared_data(const struct image_header *hdr, const struct flash_are
     }
 #endif
 
+#if defined(MCUBOOT_LOG_BINARY) && defined(MCUBOOT_LOG_BINARY_ADDRESS)
+    /* Only a log in retained RAM is still there once the application runs. */
+    if (!rc) {
+        uint32_t boot_log = (uint32_t)(uintptr_t)boot_log_binary_get();
+
+        rc = boot_add_data_to_shared_area(TLV_MAJOR_BLINFO,
+                                          BLINFO_BOOT_LOG,
+                                          sizeof(boot_log),
+                                          (void *)&boot_log);
+    }
+#endif
+
     if (!rc) {
         saved_bootinfo = true;
     }
@@ -0,0 +1,343 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright (c) 2026 Linaro LTD
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "bootutil/boot_request_log.h"
+#include "bootutil/bootutil_public.h"
+#include "bootutil/bootutil_macros.h"
+
+#ifdef __ZEPHYR__
+#include <zephyr/sys/crc.h>
+#endif
+
+#define BOOT_REQUEST_LOG_MAGIC      0x5a
+#define BOOT_REQUEST_LOG_HEADER     0x01
+#define BOOT_REQUEST_LOG_ENTRY      0x02
+#define BOOT_REQUEST_LOG_CLEAR      0x03
+
+/* Entries that a clear record can keep, one bit each in its argument. */
+#define BOOT_REQUEST_LOG_KEEP_BITS  16
+
+/** Record as stored in flash, padded to the write alignment. */
+struct boot_request_log_record {
+    uint8_t magic;
+    uint8_t type;
+    uint16_t arg;       /* Sequence number, entry index or mask of kept entries */
+    uint8_t value;
+    uint8_t pad;
+    uint16_t crc;       /* CRC-16/CCITT of the fields above */
+};
+
+/* CRC-16/CCITT-FALSE, which Zephyr provides as crc16_itu_t() seeded with 0xffff. */
+static uint16_t
+boot_request_log_crc(const struct boot_request_log_record *rec)
+{
+#ifdef __ZEPHYR__
+    return crc16_itu_t(0xffff, (const uint8_t *)rec,
+                       offsetof(struct boot_request_log_record, crc));
+#else
+    const uint8_t *p = (const uint8_t *)rec;
+    uint16_t crc = 0xffff;
+    size_t i;
+    int bit;
+
+    for (i = 0; i < offsetof(struct boot_request_log_record, crc); i++) {
+        crc ^= (uint16_t)p[i] << 8;
+        for (bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+
+    return crc;
+#endif
+}
+
+static uint32_t
+boot_request_log_off(const struct boot_request_log *log, uint8_t page, uint32_t idx)
+{
+    return page * log->page_size + idx * log->rec_size;
+}
+
+/*
+ * Read a record.  Returns 1 if the record is valid, 0 if it is invalid and -1
+ * if the record slot is still erased.
+ */
+static int
+boot_request_log_read_rec(const struct boot_request_log *log, uint8_t page, uint32_t idx,
+                          struct boot_request_log_record *rec)
+{
+    const uint8_t *p = (const uint8_t *)rec;
+    size_t i;
+
+    if (flash_area_read(log->fap, boot_request_log_off(log, page, idx), rec,
+                        sizeof(*rec)) != 0) {
+        return 0;
+    }
+
+    for (i = 0; i < sizeof(*rec); i++) {
+        if (p[i] != log->erased_val) {
+            break;
+        }
+    }
+    if (i == sizeof(*rec)) {
+        return -1;
+    }
+
+    return rec->magic == BOOT_REQUEST_LOG_MAGIC && rec->crc == boot_request_log_crc(rec);
+}
+
+static int
+boot_request_log_write_rec(const struct boot_request_log *log, uint8_t page, uint32_t idx,
+                           uint8_t type, uint16_t arg, uint8_t value)
+{
+    uint8_t buf[BOOT_REQUEST_LOG_MAX_ALIGN];
+    struct boot_request_log_record rec;
+
+    rec.magic = BOOT_REQUEST_LOG_MAGIC;
+    rec.type = type;
+    rec.arg = arg;
+    rec.value = value;
+    rec.pad = log->erased_val;
+    rec.crc = boot_request_log_crc(&rec);
+
+    memset(buf, log->erased_val, log->rec_size);
+    memcpy(buf, &rec, sizeof(rec));
+
+    if (flash_area_write(log->fap, boot_request_log_off(log, page, idx), buf,
+                         log->rec_size) != 0) {
+        return BOOT_EFLASH;
+    }
+
+    return 0;
+}
+
+/*
+ * Start a new page holding only the current values.  The header is written
+ * last, so the new page is ignored until it is complete.
+ */
+static int
+boot_request_log_compact(struct boot_request_log *log, uint16_t seq)
+{
+    uint8_t page = log->page ^ 1;
+    uint32_t idx = 1;
+    size_t i;
+    int rc;
+
+    if (flash_area_erase(log->fap, boot_request_log_off(log, page, 0), log->page_size) != 0) {
+        return BOOT_EFLASH;
+    }
+
+    for (i = 0; i < log->num_values; i++) {
+        if (log->values[i] == log->erased_val) {
+            continue;
+        }
+        rc = boot_request_log_write_rec(log, page, idx, BOOT_REQUEST_LOG_ENTRY,
+                                        (uint16_t)i, log->values[i]);
+        if (rc != 0) {
+            return rc;
+        }
+        idx++;
+    }
+
+    rc = boot_request_log_write_rec(log, page, 0, BOOT_REQUEST_LOG_HEADER, seq, 0);
+    if (rc != 0) {
+        return rc;
+    }
+
+    log->page = page;
+    log->seq = seq;
+    log->next = idx;
+    return 0;
+}
+
+/*
+ * Rebuild the entry values by replaying the records of the active page, and
+ * find the first free record.
+ */
+static void
+boot_request_log_load(struct boot_request_log *log)
+{
+    struct boot_request_log_record rec;
+    uint32_t idx;
+    size_t i;
+    int rc;
+
+    memset(log->values, log->erased_val, log->num_values);
+    log->next = log->capacity + 1;
+
+    for (idx = 1; idx <= log->capacity; idx++) {
+        rc = boot_request_log_read_rec(log, log->page, idx, &rec);
+        if (rc < 0) {
+            log->next = idx;
+            break;
+        }
+        if (rc != 1) {
+            continue;
+        }
+        if (rec.type == BOOT_REQUEST_LOG_ENTRY && rec.arg < log->num_values) {
+            log->values[rec.arg] = rec.value;
+        } else if (rec.type == BOOT_REQUEST_LOG_CLEAR) {
+            for (i = 0; i < log->num_values; i++) {
+                if (i >= BOOT_REQUEST_LOG_KEEP_BITS || !(rec.arg & (1u << i))) {
+                    log->values[i] = log->erased_val;
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Append a record for an update that is already applied to the values,
+ * compacting the log instead if the active page is full.
+ */
+static int
+boot_request_log_append(struct boot_request_log *log, uint8_t type, uint16_t arg,
+                        uint8_t value)
+{
+    int rc;
+
+    if (log->next > log->capacity) {
+        return boot_request_log_compact(log, log->seq + 1);
+    }
+
+    rc = boot_request_log_write_rec(log, log->page, log->next, type, arg, value);
+    if (rc == 0) {
+        log->next++;
+    }
+
+    return rc;
+}
+
+int
+boot_request_log_init(struct boot_request_log *log, const struct flash_area *fap,
+                      uint8_t *values, size_t num_values)
+{
+    struct boot_request_log_record hdr[2];
+    bool valid[2];
+    uint32_t align;
+    uint8_t page;
+
+    align = flash_area_align(fap);
+    if (align == 0 || align > BOOT_REQUEST_LOG_MAX_ALIGN) {
+        return BOOT_EBADARGS;
+    }
+
+    log->fap = fap;
+    log->values = values;
+    log->num_values = num_values;
+    log->erased_val = flash_area_erased_val(fap);
+    log->rec_size = ALIGN_UP(sizeof(struct boot_request_log_record), align);
+    log->page_size = flash_area_get_size(fap) / 2;
+    log->capacity = log->page_size / log->rec_size - 1;
+
+    /* A compacted page must leave room for at least one more update. */
+    if (log->page_size < log->rec_size || log->capacity < num_values + 1 ||
+        num_values > UINT16_MAX) {
+        return BOOT_EBADARGS;
+    }
+
+    for (page = 0; page < 2; page++) {
+        valid[page] = boot_request_log_read_rec(log, page, 0, &hdr[page]) == 1 &&
+                      hdr[page].type == BOOT_REQUEST_LOG_HEADER;
+    }
+
+    if (!valid[0] && !valid[1]) {
+        /* Nothing stored yet, or both pages are damaged: start over. */
+        memset(values, log->erased_val, num_values);
+        log->page = 1;
+        return boot_request_log_compact(log, 0);
+    }
+
+    if (valid[0] && valid[1]) {
+        page = ((int16_t)(hdr[1].arg - hdr[0].arg) > 0) ? 1 : 0;
+    } else {
+        page = valid[0] ? 0 : 1;
+    }
+
+    log->page = page;
+    log->seq = hdr[page].arg;
+    boot_request_log_load(log);
+
+    return 0;
+}
+
+int
+boot_request_log_read(const struct boot_request_log *log, size_t entry, uint8_t *value)
+{
+    if (entry >= log->num_values) {
+        return BOOT_EBADARGS;
+    }
+
+    *value = log->values[entry];
+    return 0;
+}
+
+int
+boot_request_log_write(struct boot_request_log *log, size_t entry, uint8_t value)
+{
+    uint8_t old;
+    int rc;
+
+    if (entry >= log->num_values) {
+        return BOOT_EBADARGS;
+    }
+
+    if (log->values[entry] == value) {
+        return 0;
+    }
+
+    old = log->values[entry];
+    log->values[entry] = value;
+
+    rc = boot_request_log_append(log, BOOT_REQUEST_LOG_ENTRY, (uint16_t)entry, value);
+    if (rc != 0) {
+        log->values[entry] = old;
+    }
+
+    return rc;
+}
+
+int
+boot_request_log_clear(struct boot_request_log *log, const size_t *keep, size_t keep_count)
+{
+    uint16_t mask = 0;
+    bool changed = false;
+    size_t i;
+    int rc;
+
+    for (i = 0; i < keep_count; i++) {
+        if (keep[i] >= BOOT_REQUEST_LOG_KEEP_BITS) {
+            return BOOT_EBADARGS;
+        }
+        mask |= 1u << keep[i];
+    }
+
+    for (i = 0; i < log->num_values; i++) {
+        if ((i >= BOOT_REQUEST_LOG_KEEP_BITS || !(mask & (1u << i))) &&
+            log->values[i] != log->erased_val) {
+            log->values[i] = log->erased_val;
+            changed = true;
+        }
+    }
+
+    if (!changed) {
+        return 0;
+    }
+
+    /*
+     * A single record clears all of the entries, so a reset can't leave the
+     * clear half done.
+     */
+    rc = boot_request_log_append(log, BOOT_REQUEST_LOG_CLEAR, mask, 0);
+    if (rc != 0) {
+        /* Resynchronize with whatever made it to flash. */
+        boot_request_log_load(log);
+    }
+
+    return rc;
+}
@@ -34,7 +34,11 @@
 #endif
 #include "bootutil/bootutil_log.h"
 
+#ifdef CONFIG_MCUBOOT
 BOOT_LOG_MODULE_DECLARE(mcuboot);
+#else
+BOOT_LOG_MODULE_DECLARE(mcuboot_util);
+#endif
 
 #if !defined(MCUBOOT_OVERWRITE_ONLY) && \
     !defined(MCUBOOT_SWAP_USING_MOVE) && \
@@ -74,26 +78,42 @@ boot_trailer_info_sz(void)
 }
 
 /**
- * Amount of space used to maintain progress information for a single swap
- * operation.
+ * Amount of space used to maintain progress information for a number of
+ * swap states.
  */
 static inline uint32_t
-boot_status_entry_sz(uint32_t min_write_sz)
+boot_status_states_sz(uint32_t states, uint32_t min_write_sz)
 {
 #if defined(MCUBOOT_SINGLE_APPLICATION_SLOT) ||      \
     defined(MCUBOOT_FIRMWARE_LOADER) ||              \
     defined(MCUBOOT_SINGLE_APPLICATION_SLOT_RAM_LOAD)
     /* Single image MCUboot modes do not have a swap status fields */
+    (void)states;
+    (void)min_write_sz;
     return 0;
+#elif defined(MCUBOOT_SWAP_STATUS_PACKED)
+    /* One bit per state, in whole write units. */
+    return ALIGN_UP((states + 7) / 8, min_write_sz);
 #else
-    return BOOT_STATUS_STATE_COUNT * min_write_sz;
+    return states * min_write_sz;
 #endif
 }
 
+/**
+ * Amount of space used to maintain progress information for a single swap
+ * operation.
+ */
+static inline uint32_t
+boot_status_entry_sz(uint32_t min_write_sz)
+{
+    return boot_status_states_sz(BOOT_STATUS_STATE_COUNT, min_write_sz);
+}
+
 uint32_t
 boot_status_sz(uint32_t min_write_sz)
 {
-    return BOOT_STATUS_MAX_ENTRIES * boot_status_entry_sz(min_write_sz);
+    return boot_status_states_sz(BOOT_STATUS_MAX_ENTRIES * BOOT_STATUS_STATE_COUNT,
+                                 min_write_sz);
 }
 
 uint32_t
@@ -200,6 +220,43 @@ boot_trailer_scramble_offset(const struct flash_area *fa, size_t alignment, size
     return ret;
 }
 
+#if defined(MCUBOOT_SKIP_PRE_ERASED)
+/*
+ * The simulator runs several boots at once, each on its own thread, so each
+ * of them has its own range.
+ */
+#if defined(__BOOTSIM__)
+static __thread struct boot_pre_erased boot_pre_erased_range;
+#else
+static struct boot_pre_erased boot_pre_erased_range;
+#endif
+
+void
+boot_set_pre_erased(uint8_t fa_id, uint32_t off, uint32_t size)
+{
+    boot_pre_erased_range.fa_id = fa_id;
+    boot_pre_erased_range.off = off;
+    boot_pre_erased_range.size = size;
+}
+
+/* Whether an erase can be skipped, dropping the range when it is used. */
+static bool
+boot_erase_skipped(const struct flash_area *fa, uint32_t off, uint32_t size)
+{
+    struct boot_pre_erased *range = &boot_pre_erased_range;
+    bool skip;
+
+    if (range->size == 0 || range->fa_id != flash_area_get_id(fa) ||
+        off >= range->off + range->size || off + size <= range->off) {
+        return false;
+    }
+
+    skip = off >= range->off && off + size <= range->off + range->size;
+    range->size = 0;
+    return skip;
+}
+#endif
+
 int
 boot_erase_region(const struct flash_area *fa, uint32_t off, uint32_t size, bool backwards)
 {
@@ -211,6 +268,10 @@ boot_erase_region(const struct flash_area *fa, uint32_t off, uint32_t size, bool
     if (off >= flash_area_get_size(fa) || (flash_area_get_size(fa) - off) < size) {
         rc = -1;
         goto end;
+#if defined(MCUBOOT_SKIP_PRE_ERASED)
+    } else if (boot_erase_skipped(fa, off, size)) {
+        BOOT_LOG_DBG("boot_erase_region: erased ahead by the application");
+#endif
     } else if (device_requires_erase(fa)) {
         uint32_t end_offset = 0;
         struct flash_sector sector;
@@ -50,6 +50,16 @@
 #define BOOT_MAX_IMG_SECTORS            MCUBOOT_MAX_IMG_SECTORS
 #define BOOT_STATUS_MAX_ENTRIES         BOOT_MAX_IMG_SECTORS
 
+/**
+ * Maximum number of runs of same-size sectors in an image slot or the
+ * scratch area.
+ */
+#ifdef MCUBOOT_MAX_SECTOR_RUNS
+#define BOOT_MAX_SECTOR_RUNS            MCUBOOT_MAX_SECTOR_RUNS
+#else
+#define BOOT_MAX_SECTOR_RUNS            8
+#endif
+
 #define BOOT_STATUS_SOURCE_NONE         0
 #define BOOT_STATUS_SOURCE_SCRATCH      1
 #define BOOT_STATUS_SOURCE_PRIMARY_SLOT 2
@@ -105,9 +115,19 @@ uint32_t boot_scratch_trailer_sz(uint32_t min_write_sz);
  */
 int boot_trailer_scramble_offset(const struct flash_area *fa, size_t alignment, size_t *off);
 
+#if defined(MCUBOOT_SKIP_PRE_ERASED)
+/**
+ * Lets the next boot_erase_region() call within a range of a flash area,
+ * which boot_pre_erase_multi() erased, skip the erase.  The range is dropped
+ * by that call, by any other erase overlapping it, and when size == 0.
+ */
+void boot_set_pre_erased(uint8_t fa_id, uint32_t off, uint32_t size);
+#endif
+
 /**
  * Erases a region of device that requires erase prior to write; does
- * nothing on devices without erase.
+ * nothing on devices without erase, or within the range given to
+ * boot_set_pre_erased().
  *
  * @param fa         The flash_area containing the region to erase.
  * @param off        The offset within the flash area to start the erase.
@@ -0,0 +1,300 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright (c) 2026 Linaro LTD
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "bootutil/bootutil_log.h"
+#include "bootutil/bootutil_public.h"
+#include "bootutil_depends.h"
+#include "bootutil_loader.h"
+
+BOOT_LOG_MODULE_DECLARE(mcuboot);
+
+#if (BOOT_IMAGE_NUMBER > 1)
+
+/* Index of the lowest image in a non-empty set. */
+static uint8_t
+boot_deps_first(boot_deps_mask_t set)
+{
+    uint8_t image = 0;
+
+    while (!(set & 1)) {
+        set >>= 1;
+        image++;
+    }
+
+    return image;
+}
+
+void
+boot_deps_init(struct boot_deps *deps, uint8_t num_images)
+{
+    assert(num_images <= BOOT_DEPS_MAX_IMAGES);
+
+    memset(deps, 0, sizeof(*deps));
+    deps->num_images = num_images;
+    deps->active = (num_images == 32) ? ~(boot_deps_mask_t)0 : BOOT_DEPS_BIT(num_images) - 1;
+}
+
+int
+boot_deps_add(struct boot_deps *deps, uint8_t image, uint32_t slot,
+              const struct image_dependency *dep)
+{
+    struct image_version *min_ver;
+
+    if (dep->image_id >= deps->num_images) {
+        return BOOT_EBADARGS;
+    }
+
+    min_ver = &deps->min_ver[image][slot][dep->image_id];
+    if (!(deps->deps[image][slot] & BOOT_DEPS_BIT(dep->image_id)) ||
+        boot_compare_version(&dep->image_min_version, min_ver) > 0) {
+        *min_ver = dep->image_min_version;
+    }
+    deps->deps[image][slot] |= BOOT_DEPS_BIT(dep->image_id);
+
+    return 0;
+}
+
+bool
+boot_deps_satisfied(const struct boot_deps *deps, uint8_t image, uint32_t slot,
+                    const uint8_t *sel)
+{
+    boot_deps_mask_t pending = deps->deps[image][slot];
+    uint8_t dep;
+
+    while (pending != 0) {
+        dep = boot_deps_first(pending);
+        pending &= ~BOOT_DEPS_BIT(dep);
+
+        if (boot_compare_version(&deps->version[dep][sel[dep]],
+                                 &deps->min_ver[image][slot][dep]) < 0) {
+            BOOT_LOG_DBG("Image %d slot %d: dependency on image %d not satisfied",
+                         image, (int)slot, dep);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static uint8_t
+boot_deps_slot(uint8_t swap_type)
+{
+    return BOOT_IS_UPGRADE(swap_type) ? BOOT_SLOT_SECONDARY : BOOT_SLOT_PRIMARY;
+}
+
+void
+boot_deps_solve(struct boot_deps *deps, uint8_t *swap_type, uint8_t *order)
+{
+    uint8_t sel[BOOT_DEPS_MAX_IMAGES];
+    boot_deps_mask_t pending = deps->active;
+    boot_deps_mask_t changed = 0;
+    boot_deps_mask_t remaining;
+    boot_deps_mask_t blocked;
+    uint8_t image;
+    uint8_t other;
+    uint8_t n;
+
+    for (image = 0; image < deps->num_images; image++) {
+        sel[image] = boot_deps_slot(swap_type[image]);
+    }
+
+    while (pending != 0) {
+        image = boot_deps_first(pending);
+        pending &= ~BOOT_DEPS_BIT(image);
+
+        if ((changed & BOOT_DEPS_BIT(image)) ||
+            boot_deps_satisfied(deps, image, sel[image], sel)) {
+            continue;
+        }
+
+        /* Move the image to a version that is older, or held for longer,
+         * which decreases the number of unsatisfied dependencies or leaves it
+         * the same.
+         */
+        switch (swap_type[image]) {
+        case BOOT_SWAP_TYPE_TEST:
+        case BOOT_SWAP_TYPE_PERM:
+            swap_type[image] = BOOT_SWAP_TYPE_NONE;
+            break;
+        case BOOT_SWAP_TYPE_NONE:
+            if (!(deps->slots[image] & BOOT_DEPS_BIT(BOOT_SLOT_SECONDARY))) {
+                continue;
+            }
+            swap_type[image] = BOOT_SWAP_TYPE_REVERT;
+            break;
+        default:
+            continue;
+        }
+
+        BOOT_LOG_INF("Image %d: swap type changed to %d by its dependencies",
+                     image, swap_type[image]);
+        sel[image] = boot_deps_slot(swap_type[image]);
+        changed |= BOOT_DEPS_BIT(image);
+
+        /* Only the images depending on this one can be affected. */
+        for (other = 0; other < deps->num_images; other++) {
+            if ((deps->active & BOOT_DEPS_BIT(other)) &&
+                (deps->deps[other][sel[other]] & BOOT_DEPS_BIT(image))) {
+                pending |= BOOT_DEPS_BIT(other);
+            }
+        }
+    }
+
+    /* Topological order of the chosen slots, taking the lowest image whose
+     * dependencies are all placed, or the lowest image left to break a cycle.
+     */
+    remaining = (deps->num_images == 32) ? ~(boot_deps_mask_t)0
+                                         : BOOT_DEPS_BIT(deps->num_images) - 1;
+    for (n = 0; n < deps->num_images; n++) {
+        image = boot_deps_first(remaining);
+        for (other = image; other < deps->num_images; other++) {
+            if (!(remaining & BOOT_DEPS_BIT(other))) {
+                continue;
+            }
+            blocked = deps->deps[other][sel[other]] & remaining & ~BOOT_DEPS_BIT(other);
+            if (blocked == 0) {
+                image = other;
+                break;
+            }
+        }
+
+        order[n] = image;
+        remaining &= ~BOOT_DEPS_BIT(image);
+    }
+}
+
+void
+boot_deps_setup(struct boot_loader_state *state, struct boot_deps *deps)
+{
+    uint8_t image;
+    uint32_t slot;
+
+    boot_deps_init(deps, BOOT_IMAGE_NUMBER);
+
+    for (image = 0; image < BOOT_IMAGE_NUMBER; image++) {
+        if (state->img_mask[image]) {
+            deps->active &= ~BOOT_DEPS_BIT(image);
+        }
+        for (slot = 0; slot < BOOT_NUM_SLOTS; slot++) {
+            deps->version[image][slot] = state->imgs[image][slot].hdr.ih_ver;
+        }
+    }
+}
+
+int
+boot_deps_read_slot(struct boot_loader_state *state, struct boot_deps *deps,
+                    uint8_t image, uint32_t slot)
+{
+    const struct flash_area *fap;
+    struct image_tlv_iter it;
+    struct image_dependency dep;
+    uint32_t off;
+    uint16_t len;
+    int rc;
+
+    if (deps->slots[image] & BOOT_DEPS_BIT(slot)) {
+        return 0;
+    }
+
+    BOOT_CURR_IMG(state) = image;
+    fap = BOOT_IMG_AREA(state, slot);
+    assert(fap != NULL);
+
+#if defined(MCUBOOT_SWAP_USING_OFFSET)
+    it.start_off = boot_get_state_secondary_offset(state, fap);
+#endif
+
+    rc = bootutil_tlv_iter_begin(&it, boot_img_hdr(state, slot), fap,
+                                 IMAGE_TLV_DEPENDENCY, true);
+    if (rc != 0) {
+        goto done;
+    }
+
+    while (true) {
+        rc = bootutil_tlv_iter_next(&it, &off, &len, NULL);
+        if (rc < 0) {
+            rc = -1;
+            goto done;
+        } else if (rc > 0) {
+            rc = 0;
+            break;
+        }
+
+        if (len != sizeof(dep)) {
+            rc = BOOT_EBADIMAGE;
+            goto done;
+        }
+
+        rc = LOAD_IMAGE_DATA(boot_img_hdr(state, slot), fap, off, &dep, len);
+        if (rc != 0) {
+            BOOT_LOG_DBG("boot_deps_read_slot: error %d reading dependency %p %d %d",
+                         rc, fap, off, len);
+            rc = BOOT_EFLASH;
+            goto done;
+        }
+
+        rc = boot_deps_add(deps, image, slot, &dep);
+        if (rc != 0) {
+            goto done;
+        }
+    }
+
+    deps->slots[image] |= BOOT_DEPS_BIT(slot);
+
+done:
+    if (rc != 0) {
+        /* Don't leave the dependencies read so far. */
+        deps->deps[image][slot] = 0;
+    }
+    return rc;
+}
+
+#if !defined(MCUBOOT_DIRECT_XIP) && !defined(MCUBOOT_RAM_LOAD)
+int
+boot_deps_read(struct boot_loader_state *state, struct boot_deps *deps)
+{
+    uint8_t image;
+    uint8_t swap_type;
+    uint32_t slot;
+    int rc;
+
+    for (image = 0; image < BOOT_IMAGE_NUMBER; image++) {
+        if (!(deps->active & BOOT_DEPS_BIT(image))) {
+            continue;
+        }
+
+        swap_type = state->swap_type[image];
+        slot = boot_deps_slot(swap_type);
+        rc = boot_deps_read_slot(state, deps, image, slot);
+        if (rc != 0) {
+            return rc;
+        }
+
+        /* A cancelled upgrade leaves the primary slot, and an image that
+         * isn't upgraded can be reverted to the secondary one.  If these
+         * can't be read, they just won't be chosen.
+         */
+        if (swap_type == BOOT_SWAP_TYPE_TEST || swap_type == BOOT_SWAP_TYPE_PERM) {
+            slot = BOOT_SLOT_PRIMARY;
+        } else if (swap_type == BOOT_SWAP_TYPE_NONE) {
+            slot = BOOT_SLOT_SECONDARY;
+        } else {
+            continue;
+        }
+
+        if (state->imgs[image][slot].hdr.ih_magic == IMAGE_MAGIC) {
+            (void)boot_deps_read_slot(state, deps, image, slot);
+        }
+    }
+
+    return 0;
+}
+#endif /* !MCUBOOT_DIRECT_XIP && !MCUBOOT_RAM_LOAD */
+
+#endif /* BOOT_IMAGE_NUMBER > 1 */
@@ -0,0 +1,147 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright (c) 2026 Linaro LTD
+ */
+
+/*
+ * Dependency resolution between images.
+ *
+ * The versions and IMAGE_TLV_DEPENDENCY entries of the images are read once
+ * into a graph, with one bit per image for the dependencies of each slot, and
+ * only the highest minimum version kept when an image depends several times on
+ * the same one.  Checking a dependency then doesn't touch the flash anymore,
+ * and when the swap type of an image changes, only the images which depend on
+ * it need to be checked again.
+ */
+
+#ifndef H_BOOTUTIL_DEPENDS_
+#define H_BOOTUTIL_DEPENDS_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "bootutil/image.h"
+#include "bootutil_priv.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Number of images the graph can hold.  It can be made larger than the number
+ * of images handled by the bootloader, so that the resolver can be exercised
+ * with larger graphs in tests.
+ */
+#if defined(MCUBOOT_DEPS_MAX_IMAGES)
+#define BOOT_DEPS_MAX_IMAGES MCUBOOT_DEPS_MAX_IMAGES
+#else
+#define BOOT_DEPS_MAX_IMAGES BOOT_IMAGE_NUMBER
+#endif
+
+#if BOOT_DEPS_MAX_IMAGES > 32 || BOOT_DEPS_MAX_IMAGES < BOOT_IMAGE_NUMBER
+#error "The dependency resolver handles from BOOT_IMAGE_NUMBER up to 32 images"
+#endif
+
+/** Set of images, with bit i set for image i. */
+typedef uint32_t boot_deps_mask_t;
+
+#define BOOT_DEPS_BIT(image) ((boot_deps_mask_t)1 << (image))
+
+struct boot_deps {
+    /** Number of images in the graph. */
+    uint8_t num_images;
+
+    /** Images whose dependencies are checked; the others are only depended on. */
+    boot_deps_mask_t active;
+
+    /** Bit s of slots[i] is set once the dependencies of slot s of image i are known. */
+    uint8_t slots[BOOT_DEPS_MAX_IMAGES];
+
+    /** Version of the image in each slot. */
+    struct image_version version[BOOT_DEPS_MAX_IMAGES][BOOT_NUM_SLOTS];
+
+    /** Images the image in each slot depends on. */
+    boot_deps_mask_t deps[BOOT_DEPS_MAX_IMAGES][BOOT_NUM_SLOTS];
+
+    /** Minimum version of each image in deps[i][s] required by slot s of image i. */
+    struct image_version min_ver[BOOT_DEPS_MAX_IMAGES][BOOT_NUM_SLOTS][BOOT_DEPS_MAX_IMAGES];
+};
+
+/**
+ * Empty the graph, with all images active.
+ */
+void boot_deps_init(struct boot_deps *deps, uint8_t num_images);
+
+/**
+ * Record a dependency of the image in a slot.
+ *
+ * @return 0 on success; BOOT_EBADARGS if the dependency is on an image which
+ *         isn't in the graph.
+ */
+int boot_deps_add(struct boot_deps *deps, uint8_t image, uint32_t slot,
+                  const struct image_dependency *dep);
+
+/**
+ * Check whether all the dependencies of the image in a slot are satisfied.
+ *
+ * @param sel  Slot chosen for each image, which gives the version compared
+ *             against the minimum one.
+ */
+bool boot_deps_satisfied(const struct boot_deps *deps, uint8_t image, uint32_t slot,
+                         const uint8_t *sel);
+
+/**
+ * Adjust the swap types of the active images until their dependencies are
+ * satisfied, as far as possible, and give the order in which to update the
+ * images, with the images depended on before the ones depending on them.
+ *
+ * The slot of an image is the secondary one if its swap type is an upgrade,
+ * the primary one otherwise.  An image whose dependencies aren't satisfied has
+ * its upgrade cancelled, or if it isn't upgraded, is reverted if the
+ * dependencies of its secondary slot are known.  The swap type of an image is
+ * changed at most once.  The dependencies of the slot of each active image
+ * must be known.
+ *
+ * @param swap_type  Swap type of each image, updated in place.
+ * @param order      Filled with the indexes of all the images, in the order
+ *                   in which to update them.  A cycle of dependencies is
+ *                   broken at its lowest image.
+ */
+void boot_deps_solve(struct boot_deps *deps, uint8_t *swap_type, uint8_t *order);
+
+/**
+ * Set up the graph from the loader state: the images are the active ones of
+ * the boot, and the versions are taken from the headers already read.
+ */
+void boot_deps_setup(struct boot_loader_state *state, struct boot_deps *deps);
+
+/**
+ * Read the dependency TLVs of the image in a slot, unless they are already
+ * known.
+ *
+ * @return 0 on success; BOOT_EBADIMAGE if a TLV is malformed; BOOT_EBADARGS
+ *         if it is on an image which doesn't exist; BOOT_EFLASH or -1 if the
+ *         TLVs couldn't be read.
+ */
+int boot_deps_read_slot(struct boot_loader_state *state, struct boot_deps *deps,
+                        uint8_t image, uint32_t slot);
+
+#if !defined(MCUBOOT_DIRECT_XIP) && !defined(MCUBOOT_RAM_LOAD)
+/**
+ * Read the dependencies of every slot boot_deps_solve() may choose for the
+ * active images: the slot given by their swap type, which must be readable,
+ * and the other one if it holds an image that may be used instead.
+ *
+ * @return 0 on success; the error from boot_deps_read_slot() if the
+ *         dependencies of an image in the slot given by its swap type
+ *         couldn't be read.
+ */
+int boot_deps_read(struct boot_loader_state *state, struct boot_deps *deps);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* H_BOOTUTIL_DEPENDS_ */
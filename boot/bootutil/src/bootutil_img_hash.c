@@ -38,6 +38,26 @@
 BOOT_LOG_MODULE_DECLARE(mcuboot);
 
 #ifndef MCUBOOT_SIGN_PURE
+#if defined(MCUBOOT_HASH_STORAGE_DIRECTLY)
+/*
+ * The storage is mapped to the address space, so it is given to the hash
+ * function as it is, which may read it through its own DMA.
+ */
+int
+bootutil_sha_update_flash(bootutil_sha_context *ctx, const struct flash_area *fap,
+                          uint32_t off, uint32_t len)
+{
+    uintptr_t base = 0;
+
+    if (flash_device_base(flash_area_get_device_id(fap), &base) != 0) {
+        base = 0;
+    }
+
+    bootutil_sha_update(ctx, (void *)(base + flash_area_get_off(fap) + off), len);
+    return 0;
+}
+#endif /* MCUBOOT_HASH_STORAGE_DIRECTLY */
+
 /*
  * Compute SHA hash over the image.
  * (SHA384 if ECDSA-P384 is being used,
@@ -55,15 +75,9 @@ bootutil_img_hash(struct boot_loader_state *state,
     uint16_t hdr_size;
     uint32_t blk_off;
     uint32_t tlv_off;
-#if !defined(MCUBOOT_HASH_STORAGE_DIRECTLY)
     int rc;
     uint32_t off;
     uint32_t blk_sz;
-#endif
-#ifdef MCUBOOT_HASH_STORAGE_DIRECTLY
-    uintptr_t base = 0;
-    int fa_ret;
-#endif
 #if defined(MCUBOOT_ENC_IMAGES)
     int image_index;
 #endif
@@ -126,23 +140,33 @@ bootutil_img_hash(struct boot_loader_state *state,
     /* If protected TLVs are present they are also hashed. */
     size += hdr->ih_protect_tlv_size;
 
-#ifdef MCUBOOT_HASH_STORAGE_DIRECTLY
-    /* No chunk loading, storage is mapped to address space and can
-     * be directly given to hashing function.
-     */
-    fa_ret = flash_device_base(flash_area_get_device_id(fap), &base);
-    if (fa_ret != 0) {
-        base = 0;
-    }
-
-    bootutil_sha_update(&sha_ctx, (void *)(base + flash_area_get_off(fap)), size);
-#else /* MCUBOOT_HASH_STORAGE_DIRECTLY */
 #ifdef MCUBOOT_RAM_LOAD
     bootutil_sha_update(&sha_ctx,
                         (void*)(IMAGE_RAM_BASE + hdr->ih_load_addr),
                         size);
 #else
-    for (off = 0; off < size; off += blk_sz) {
+    off = 0;
+#if defined(MCUBOOT_SHA_FLASH_RANGE)
+    /* No chunk loading, unless the payload has to be decrypted. */
+#ifdef MCUBOOT_ENC_IMAGES
+    if (!MUST_DECRYPT(fap, image_index, hdr))
+#endif
+    {
+#if defined(MCUBOOT_SWAP_USING_OFFSET)
+        rc = bootutil_sha_update_flash(&sha_ctx, fap, sector_off, size);
+#else
+        rc = bootutil_sha_update_flash(&sha_ctx, fap, 0, size);
+#endif
+        if (rc) {
+            bootutil_sha_drop(&sha_ctx);
+            BOOT_LOG_DBG("bootutil_img_validate Error %d hashing %p %u",
+                         rc, fap, size);
+            return rc;
+        }
+        off = size;
+    }
+#endif /* MCUBOOT_SHA_FLASH_RANGE */
+    for (; off < size; off += blk_sz) {
         blk_sz = size - off;
         if (blk_sz > tmp_buf_sz) {
             blk_sz = tmp_buf_sz;
@@ -187,7 +211,6 @@ bootutil_img_hash(struct boot_loader_state *state,
         bootutil_sha_update(&sha_ctx, tmp_buf, blk_sz);
     }
 #endif /* MCUBOOT_RAM_LOAD */
-#endif /* MCUBOOT_HASH_STORAGE_DIRECTLY */
     bootutil_sha_finish(&sha_ctx, hash_result);
     bootutil_sha_drop(&sha_ctx);
 
@@ -33,6 +33,7 @@
  */
 
 #include "bootutil_loader.h"
+#include "bootutil_scratch.h"
 #include "bootutil/boot_record.h"
 #include "bootutil/boot_hooks.h"
 #ifdef MCUBOOT_ENC_IMAGES
@@ -186,7 +187,8 @@ boot_read_image_headers(struct boot_loader_state *state, bool require_all, struc
 fih_ret
 boot_check_image(struct boot_loader_state *state, struct boot_status *bs, int slot)
 {
-    TARGET_STATIC uint8_t tmpbuf[BOOT_TMPBUF_SZ];
+    uint8_t *tmpbuf;
+    size_t tmpbuf_sz;
     int rc;
     FIH_DECLARE(fih_rc, FIH_FAILURE);
     const struct flash_area *fap = NULL;
@@ -216,12 +218,17 @@ boot_check_image(struct boot_loader_state *state, struct boot_status *bs, int sl
     }
 #endif
 
+    tmpbuf = boot_scratch_begin(BOOT_SCRATCH_VALIDATE, &tmpbuf_sz);
+    if (tmpbuf == NULL) {
+        FIH_RET(fih_rc);
+    }
+
     for (int i = 1; i <= CONFIG_NCS_MCUBOOT_IMG_VALIDATE_ATTEMPT_COUNT; i++ ) {
 #if CONFIG_NCS_MCUBOOT_IMG_VALIDATE_ATTEMPT_COUNT > 1
       BOOT_LOG_DBG("Image validation attempt %d/%d", i, CONFIG_NCS_MCUBOOT_IMG_VALIDATE_ATTEMPT_COUNT);
 #endif /* CONFIG_NCS_MCUBOOT_IMG_VALIDATE_ATTEMPT_COUNT > 1 */
 
-        FIH_CALL(bootutil_img_validate, fih_rc, state, hdr, fap, tmpbuf, BOOT_TMPBUF_SZ,
+        FIH_CALL(bootutil_img_validate, fih_rc, state, hdr, fap, tmpbuf, tmpbuf_sz,
                 NULL, 0, NULL);
         if (FIH_EQ(fih_rc, FIH_SUCCESS)) {
 #if CONFIG_NCS_MCUBOOT_IMG_VALIDATE_ATTEMPT_COUNT > 1
@@ -247,6 +254,8 @@ boot_check_image(struct boot_loader_state *state, struct boot_status *bs, int sl
         }
     }
 
+    boot_scratch_end(BOOT_SCRATCH_VALIDATE);
+
     FIH_RET(fih_rc);
 }
 
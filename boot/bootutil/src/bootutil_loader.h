@@ -50,6 +50,28 @@
 #define TARGET_STATIC
 #endif
 
+/*
+ * Size of the buffer used to copy image data between slots. Each chunk is
+ * one read followed by one program operation, so larger buffers reduce the
+ * per-command overhead on devices such as QSPI/OSPI flash. For best results
+ * it should be a multiple of the device's program page size.
+ */
+#ifdef MCUBOOT_COPY_BUFFER_SIZE
+#define BOOT_COPY_BUF_SZ MCUBOOT_COPY_BUFFER_SIZE
+#else
+#define BOOT_COPY_BUF_SZ 1024
+#endif
+
+#if BOOT_MAX_ALIGN > BOOT_COPY_BUF_SZ
+#define BUF_SZ BOOT_MAX_ALIGN
+#else
+#define BUF_SZ BOOT_COPY_BUF_SZ
+#endif
+
+#if (BUF_SZ % BOOT_MAX_ALIGN) != 0
+#error "MCUBOOT_COPY_BUFFER_SIZE must be a multiple of the flash write alignment"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -145,6 +145,30 @@ boot_status_off(const struct flash_area *fap)
     return flash_area_get_size(fap) - off_from_end;
 }
 
+int
+boot_read_status_entry(const struct flash_area *fap, uint32_t off, uint32_t entry,
+                       uint32_t elem_sz, bool *erased)
+{
+    uint8_t status;
+    int rc;
+
+#ifdef MCUBOOT_SWAP_STATUS_PACKED
+    (void)elem_sz;
+
+    rc = flash_area_read(fap, off + entry / 8, &status, 1);
+    if (rc == 0) {
+        *erased = !((status ^ flash_area_erased_val(fap)) & (1 << (entry % 8)));
+    }
+#else
+    rc = flash_area_read(fap, off + entry * elem_sz, &status, 1);
+    if (rc == 0) {
+        *erased = bootutil_buffer_is_erased(fap, &status, 1);
+    }
+#endif
+
+    return rc;
+}
+
 #ifdef MCUBOOT_ENC_IMAGES
 static inline uint32_t
 boot_enc_key_off(const struct flash_area *fap, uint8_t slot)
@@ -242,7 +266,8 @@ boot_read_unprotected_tlv_sizes(const struct flash_area *fap, uint16_t *tlv_size
 
 #ifdef MCUBOOT_ENC_IMAGES
 int
-boot_read_enc_key(const struct flash_area *fap, uint8_t slot, struct boot_status *bs)
+boot_read_enc_key(struct boot_loader_state *state, const struct flash_area *fap,
+                  uint8_t slot, struct boot_status *bs)
 {
     uint32_t off;
 #if MCUBOOT_SWAP_SAVE_ENCTLV
@@ -261,10 +286,11 @@ boot_read_enc_key(const struct flash_area *fap, uint8_t slot, struct boot_status
         }
         /* Only try to decrypt non-erased TLV metadata */
         if (i != BOOT_ENC_TLV_ALIGN_SIZE) {
-            rc = boot_decrypt_key(bs->enctlv[slot], bs->enckey[slot]);
+            rc = boot_enc_unwrap_key(state, slot, bs->enctlv[slot], bs->enckey[slot]);
         }
     }
 #else
+    (void)state;
     rc = flash_area_read(fap, off, bs->enckey[slot], BOOT_ENC_KEY_ALIGN_SIZE);
 #endif
 
@@ -466,27 +492,81 @@ done:
 
 #if (!defined(MCUBOOT_DIRECT_XIP) && !defined(MCUBOOT_RAM_LOAD)) || \
 defined(MCUBOOT_SERIAL_IMG_GRP_SLOT_INFO)
+/*
+ * Compress the sector list reported by the flash map backend into runs of
+ * same-size sectors.
+ */
+static int
+boot_build_sector_map(struct boot_sector_map *map, const boot_sector_t *sectors,
+                      uint32_t num_sectors)
+{
+    struct boot_sector_run *run = NULL;
+    uint32_t base;
+    uint32_t off;
+    uint32_t size;
+    uint32_t i;
+
+    map->num_runs = 0;
+    map->num_sectors = 0;
+
+    if (num_sectors == 0) {
+        return BOOT_EFLASH;
+    }
+
+#ifdef MCUBOOT_USE_FLASH_AREA_GET_SECTORS
+    base = flash_sector_get_off(&sectors[0]);
+#else
+    base = flash_area_get_off(&sectors[0]);
+#endif
+
+    for (i = 0; i < num_sectors; i++) {
+#ifdef MCUBOOT_USE_FLASH_AREA_GET_SECTORS
+        off = flash_sector_get_off(&sectors[i]) - base;
+        size = flash_sector_get_size(&sectors[i]);
+#else
+        off = flash_area_get_off(&sectors[i]) - base;
+        size = flash_area_get_size(&sectors[i]);
+#endif
+
+        if (run != NULL && run->size == size &&
+            run->off + (i - run->first) * run->size == off) {
+            continue;
+        }
+
+        if (map->num_runs == BOOT_MAX_SECTOR_RUNS) {
+            BOOT_LOG_ERR("Sector layout needs more than %d runs",
+                         BOOT_MAX_SECTOR_RUNS);
+            return BOOT_EFLASH;
+        }
+
+        run = &map->runs[map->num_runs++];
+        run->first = i;
+        run->off = off;
+        run->size = size;
+    }
+
+    map->num_sectors = num_sectors;
+    return 0;
+}
+
 int
-boot_initialize_area(struct boot_loader_state *state, int flash_area)
+boot_initialize_area(struct boot_loader_state *state, int flash_area,
+                     boot_sector_t *fill)
 {
     uint32_t num_sectors = BOOT_MAX_IMG_SECTORS;
-    boot_sector_t *out_sectors;
-    uint32_t *out_num_sectors;
+    struct boot_sector_map *out_map;
     int rc;
 
     num_sectors = BOOT_MAX_IMG_SECTORS;
 
     if (flash_area == FLASH_AREA_IMAGE_PRIMARY(BOOT_CURR_IMG(state))) {
-        out_sectors = BOOT_IMG(state, BOOT_SLOT_PRIMARY).sectors;
-        out_num_sectors = &BOOT_IMG(state, BOOT_SLOT_PRIMARY).num_sectors;
+        out_map = &BOOT_IMG(state, BOOT_SLOT_PRIMARY).sectors;
 #if BOOT_NUM_SLOTS > 1
     } else if (flash_area == FLASH_AREA_IMAGE_SECONDARY(BOOT_CURR_IMG(state))) {
-        out_sectors = BOOT_IMG(state, BOOT_SLOT_SECONDARY).sectors;
-        out_num_sectors = &BOOT_IMG(state, BOOT_SLOT_SECONDARY).num_sectors;
+        out_map = &BOOT_IMG(state, BOOT_SLOT_SECONDARY).sectors;
 #if MCUBOOT_SWAP_USING_SCRATCH
     } else if (flash_area == FLASH_AREA_IMAGE_SCRATCH) {
-        out_sectors = state->scratch.sectors;
-        out_num_sectors = &state->scratch.num_sectors;
+        out_map = &state->scratch.sectors;
 #endif
 #endif
     } else {
@@ -494,16 +574,16 @@ boot_initialize_area(struct boot_loader_state *state, int flash_area)
     }
 
 #ifdef MCUBOOT_USE_FLASH_AREA_GET_SECTORS
-    rc = flash_area_get_sectors(flash_area, &num_sectors, out_sectors);
+    rc = flash_area_get_sectors(flash_area, &num_sectors, fill);
 #else
     _Static_assert(sizeof(int) <= sizeof(uint32_t), "Fix needed");
-    rc = flash_area_to_sectors(flash_area, (int *)&num_sectors, out_sectors);
+    rc = flash_area_to_sectors(flash_area, (int *)&num_sectors, fill);
 #endif /* defined(MCUBOOT_USE_FLASH_AREA_GET_SECTORS) */
     if (rc != 0) {
         return rc;
     }
-    *out_num_sectors = num_sectors;
-    return 0;
+
+    return boot_build_sector_map(out_map, fill, num_sectors);
 }
 
 static uint32_t
@@ -541,30 +621,30 @@ boot_read_sectors(struct boot_loader_state *state, struct boot_sector_buffer *se
 
     image_index = BOOT_CURR_IMG(state);
 
-    BOOT_IMG(state, BOOT_SLOT_PRIMARY).sectors =
+    BOOT_IMG(state, BOOT_SLOT_PRIMARY).sectors.runs =
         sectors->primary[image_index];
 #if BOOT_NUM_SLOTS > 1
-    BOOT_IMG(state, BOOT_SLOT_SECONDARY).sectors =
+    BOOT_IMG(state, BOOT_SLOT_SECONDARY).sectors.runs =
         sectors->secondary[image_index];
 #if MCUBOOT_SWAP_USING_SCRATCH
-    state->scratch.sectors = sectors->scratch;
+    state->scratch.sectors.runs = sectors->scratch;
 #endif
 #endif
 
-    rc = boot_initialize_area(state, FLASH_AREA_IMAGE_PRIMARY(image_index));
+    rc = boot_initialize_area(state, FLASH_AREA_IMAGE_PRIMARY(image_index), sectors->fill);
     if (rc != 0) {
         return BOOT_EFLASH;
     }
 
 #if BOOT_NUM_SLOTS > 1
-    rc = boot_initialize_area(state, FLASH_AREA_IMAGE_SECONDARY(image_index));
+    rc = boot_initialize_area(state, FLASH_AREA_IMAGE_SECONDARY(image_index), sectors->fill);
     if (rc != 0) {
         /* We need to differentiate from the primary image issue */
         return BOOT_EFLASH_SEC;
     }
 
 #if MCUBOOT_SWAP_USING_SCRATCH
-    rc = boot_initialize_area(state, FLASH_AREA_IMAGE_SCRATCH);
+    rc = boot_initialize_area(state, FLASH_AREA_IMAGE_SCRATCH, sectors->fill);
     if (rc != 0) {
         return BOOT_EFLASH;
     }
@@ -586,12 +666,14 @@ boot_read_sectors_recovery(struct boot_loader_state *state)
 
     image_index = BOOT_CURR_IMG(state);
 
-    rc = boot_initialize_area(state, FLASH_AREA_IMAGE_PRIMARY(image_index));
+    rc = boot_initialize_area(state, FLASH_AREA_IMAGE_PRIMARY(image_index),
+                              sector_buffers.fill);
     if (rc != 0) {
         return BOOT_EFLASH;
     }
 
-    rc = boot_initialize_area(state, FLASH_AREA_IMAGE_SECONDARY(image_index));
+    rc = boot_initialize_area(state, FLASH_AREA_IMAGE_SECONDARY(image_index),
+                              sector_buffers.fill);
     if (rc != 0) {
         /* We need to differentiate from the primary image issue */
         return BOOT_EFLASH_SEC;
@@ -622,11 +704,11 @@ void boot_fetch_slot_state_sizes(void)
 
         image_index = BOOT_CURR_IMG(state);
 
-        BOOT_IMG(state, BOOT_SLOT_PRIMARY).sectors = sector_buffers.primary[image_index];
+        BOOT_IMG(state, BOOT_SLOT_PRIMARY).sectors.runs = sector_buffers.primary[image_index];
 #if BOOT_NUM_SLOTS > 1
-        BOOT_IMG(state, BOOT_SLOT_SECONDARY).sectors = sector_buffers.secondary[image_index];
+        BOOT_IMG(state, BOOT_SLOT_SECONDARY).sectors.runs = sector_buffers.secondary[image_index];
 #if MCUBOOT_SWAP_USING_SCRATCH
-        state->scratch.sectors = sector_buffers.scratch;
+        state->scratch.sectors.runs = sector_buffers.scratch;
 #endif
 #endif
 
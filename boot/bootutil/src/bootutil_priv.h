@@ -87,6 +87,11 @@ struct flash_area;
 #error "MCUBOOT_DIRECT_XIP_REVERT cannot be enabled unless MCUBOOT_DIRECT_XIP is used"
 #endif
 
+#if defined(MCUBOOT_SWAP_OFFSET_PERM_NO_BACKUP) && \
+    !defined(MCUBOOT_SWAP_USING_OFFSET)
+#error "MCUBOOT_SWAP_OFFSET_PERM_NO_BACKUP cannot be enabled unless MCUBOOT_SWAP_USING_OFFSET is used"
+#endif
+
 #if !defined(MCUBOOT_OVERWRITE_ONLY) && \
     !defined(MCUBOOT_SWAP_USING_MOVE) && \
     !defined(MCUBOOT_SWAP_USING_OFFSET) && \
@@ -229,13 +234,29 @@ typedef struct flash_sector boot_sector_t;
 typedef struct flash_area boot_sector_t;
 #endif
 
+/** Run of consecutive sectors of the same size. */
+struct boot_sector_run {
+    uint32_t first;     /* Index of the first sector of the run */
+    uint32_t off;       /* Offset of the first sector from the first sector of the area */
+    uint32_t size;      /* Size of each sector of the run */
+};
+
+/**
+ * Sector layout of an image slot or of the scratch area, stored as runs of
+ * same-size sectors ordered by offset.
+ */
+struct boot_sector_map {
+    struct boot_sector_run *runs;
+    uint32_t num_runs;
+    uint32_t num_sectors;
+};
+
 /** Private state maintained during boot. */
 struct boot_loader_state {
     struct {
         struct image_header hdr;
         const struct flash_area *area;
-        boot_sector_t *sectors;
-        uint32_t num_sectors;
+        struct boot_sector_map sectors;
 #if defined(MCUBOOT_SWAP_USING_OFFSET)
         uint16_t unprotected_tlv_size;
 #endif
@@ -244,8 +265,7 @@ struct boot_loader_state {
 #if MCUBOOT_SWAP_USING_SCRATCH
     struct {
         const struct flash_area *area;
-        boot_sector_t *sectors;
-        uint32_t num_sectors;
+        struct boot_sector_map sectors;
     } scratch;
 #endif
 
@@ -261,6 +281,7 @@ struct boot_loader_state {
 
 #if defined(MCUBOOT_ENC_IMAGES)
     struct enc_key_data enc[BOOT_IMAGE_NUMBER][BOOT_NUM_SLOTS];
+    struct boot_enc_key_cache enc_cache[BOOT_IMAGE_NUMBER][BOOT_NUM_SLOTS];
 #endif
 
 #if (BOOT_IMAGE_NUMBER > 1)
@@ -295,11 +316,15 @@ struct boot_loader_state {
 };
 
 struct boot_sector_buffer {
-    boot_sector_t primary[BOOT_IMAGE_NUMBER][BOOT_MAX_IMG_SECTORS];
-    boot_sector_t secondary[BOOT_IMAGE_NUMBER][BOOT_MAX_IMG_SECTORS];
+    struct boot_sector_run primary[BOOT_IMAGE_NUMBER][BOOT_MAX_SECTOR_RUNS];
+    struct boot_sector_run secondary[BOOT_IMAGE_NUMBER][BOOT_MAX_SECTOR_RUNS];
 #if MCUBOOT_SWAP_USING_SCRATCH
-    boot_sector_t scratch[BOOT_MAX_IMG_SECTORS];
+    struct boot_sector_run scratch[BOOT_MAX_SECTOR_RUNS];
 #endif
+    /* Sector list reported by the flash map backend, only used while the
+     * run-length maps above are being built.
+     */
+    boot_sector_t fill[BOOT_MAX_IMG_SECTORS];
 };
 
 /* The function is intended for verification of image hash against
@@ -321,8 +346,33 @@ const struct flash_area *boot_find_status(const struct boot_loader_state *state,
 int boot_magic_compatible_check(uint8_t tbl_val, uint8_t val);
 int boot_status_entries(int image_index, const struct flash_area *fap);
 uint32_t boot_status_off(const struct flash_area *fap);
+
+/**
+ * Reads whether an entry of the swap status has been written.  An entry takes
+ * a write unit of its own, or a single bit with MCUBOOT_SWAP_STATUS_PACKED.
+ *
+ * @param off       Offset of the swap status in the flash area.
+ * @param entry     Index of the entry, as given by boot_status_internal_off()
+ *                  with an element size of 1.
+ * @param elem_sz   Size of an entry which isn't packed.
+ * @param erased    Set to whether the entry is still erased.
+ *
+ * @return          0 on success; nonzero on failure.
+ */
+int boot_read_status_entry(const struct flash_area *fap, uint32_t off, uint32_t entry,
+                           uint32_t elem_sz, bool *erased);
 int boot_read_swap_state(const struct flash_area *fap,
                          struct boot_swap_state *state);
+
+/**
+ * Reads the record of boot_pre_erase_multi() in a secondary slot.
+ *
+ * @return          0 if the slot holds a record which was not voided yet; 1 if
+ *                  it does not; BOOT_EFLASH on flash errors.
+ */
+int boot_read_pre_erased(const struct flash_area *fap, struct boot_pre_erased *rec);
+int boot_write_pre_erased(const struct flash_area *fap, const struct boot_pre_erased *rec);
+int boot_clear_pre_erased(const struct flash_area *fap);
 int boot_write_magic(const struct flash_area *fap);
 int boot_write_status(const struct boot_loader_state *state, struct boot_status *bs);
 int boot_write_copy_done(const struct flash_area *fap);
@@ -360,7 +410,8 @@ bool boot_status_is_reset(const struct boot_status *bs);
 
 #ifdef MCUBOOT_ENC_IMAGES
 int boot_write_enc_keys(const struct flash_area *fap, const struct boot_status *bs);
-int boot_read_enc_key(const struct flash_area *fap, uint8_t slot,
+int boot_read_enc_key(struct boot_loader_state *state,
+                      const struct flash_area *fap, uint8_t slot,
                       struct boot_status *bs);
 #endif
 
@@ -453,6 +504,7 @@ static inline bool boot_u16_safe_add(uint16_t *dest, uint16_t a, uint16_t b)
 #ifdef MCUBOOT_ENC_IMAGES
 #define BOOT_CURR_ENC(state) ((state)->enc[BOOT_CURR_IMG(state)])
 #define BOOT_CURR_ENC_SLOT(state, slot) (&((state)->enc[BOOT_CURR_IMG(state)][slot]))
+#define BOOT_CURR_ENC_CACHE(state) ((state)->enc_cache[BOOT_CURR_IMG(state)])
 #else
 #define BOOT_CURR_ENC(state) NULL
 #define BOOT_CURR_ENC_SLOT(state, slot) NULL
@@ -478,7 +530,7 @@ boot_img_hdr(struct boot_loader_state *state, size_t slot)
 static inline size_t
 boot_img_num_sectors(const struct boot_loader_state *state, size_t slot)
 {
-    return BOOT_IMG(state, slot).num_sectors;
+    return BOOT_IMG(state, slot).sectors.num_sectors;
 }
 
 /*
@@ -490,13 +542,33 @@ boot_img_slot_off(struct boot_loader_state *state, size_t slot)
     return flash_area_get_off(BOOT_IMG_AREA(state, slot));
 }
 
-#ifndef MCUBOOT_USE_FLASH_AREA_GET_SECTORS
+/*
+ * Run containing the given sector index.
+ */
+static inline const struct boot_sector_run *
+boot_sector_map_run(const struct boot_sector_map *map, size_t sector)
+{
+    uint32_t lo = 0;
+    uint32_t hi = map->num_runs;
+
+    while (hi - lo > 1) {
+        uint32_t mid = lo + (hi - lo) / 2;
+
+        if (map->runs[mid].first <= sector) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return &map->runs[lo];
+}
 
 static inline size_t
 boot_img_sector_size(const struct boot_loader_state *state,
                      size_t slot, size_t sector)
 {
-    return flash_area_get_size(&BOOT_IMG(state, slot).sectors[sector]);
+    return boot_sector_map_run(&BOOT_IMG(state, slot).sectors, sector)->size;
 }
 
 /*
@@ -507,29 +579,37 @@ static inline uint32_t
 boot_img_sector_off(const struct boot_loader_state *state, size_t slot,
                     size_t sector)
 {
-    return flash_area_get_off(&BOOT_IMG(state, slot).sectors[sector]) -
-           flash_area_get_off(&BOOT_IMG(state, slot).sectors[0]);
-}
+    const struct boot_sector_run *run =
+        boot_sector_map_run(&BOOT_IMG(state, slot).sectors, sector);
 
-#else  /* defined(MCUBOOT_USE_FLASH_AREA_GET_SECTORS) */
+    return run->off + (uint32_t)(sector - run->first) * run->size;
+}
 
+/*
+ * Index of the sector containing the given offset from the beginning of the
+ * image. The offset must be within the image.
+ */
 static inline size_t
-boot_img_sector_size(const struct boot_loader_state *state,
-                     size_t slot, size_t sector)
+boot_img_sector_index(const struct boot_loader_state *state, size_t slot,
+                      uint32_t off)
 {
-    return flash_sector_get_size(&BOOT_IMG(state, slot).sectors[sector]);
-}
+    const struct boot_sector_map *map = &BOOT_IMG(state, slot).sectors;
+    uint32_t lo = 0;
+    uint32_t hi = map->num_runs;
+
+    while (hi - lo > 1) {
+        uint32_t mid = lo + (hi - lo) / 2;
+
+        if (map->runs[mid].off <= off) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
 
-static inline uint32_t
-boot_img_sector_off(const struct boot_loader_state *state, size_t slot,
-                    size_t sector)
-{
-    return flash_sector_get_off(&BOOT_IMG(state, slot).sectors[sector]) -
-           flash_sector_get_off(&BOOT_IMG(state, slot).sectors[0]);
+    return map->runs[lo].first + (off - map->runs[lo].off) / map->runs[lo].size;
 }
 
-#endif  /* !defined(MCUBOOT_USE_FLASH_AREA_GET_SECTORS) */
-
 #ifdef MCUBOOT_RAM_LOAD
 #   ifdef __BOOTSIM__
 
@@ -846,6 +846,10 @@ boot_set_pending(int permanent)
  * system will continue booting into the image in the primary slot until told to
  * boot from a different slot.
  *
+ * With MCUBOOT_SWAP_OFFSET_PERM_NO_BACKUP, confirming an image which a test
+ * upgrade swapped in also reclaims the secondary slot, which held the previous
+ * image to revert to, as boot_pre_erase_multi() does.
+ *
  * @param image_index       Image pair index.
  *
  * @return                  0 on success; nonzero on failure.
@@ -854,6 +858,10 @@ int
 boot_set_confirmed_multi(int image_index)
 {
     const struct flash_area *fap = NULL;
+#if defined(MCUBOOT_SWAP_OFFSET_PERM_NO_BACKUP)
+    struct boot_swap_state state;
+    bool reclaim = false;
+#endif
     int rc;
 
     rc = flash_area_open(FLASH_AREA_IMAGE_PRIMARY(image_index), &fap);
@@ -863,9 +871,34 @@ boot_set_confirmed_multi(int image_index)
         return BOOT_EFLASH;
     }
 
+#if defined(MCUBOOT_SWAP_OFFSET_PERM_NO_BACKUP)
+    /*
+     * An image which a test upgrade swapped in still has the previous image
+     * behind it in the secondary slot, to revert to.  Once it is confirmed,
+     * that copy is no longer needed.
+     */
+    if (boot_read_swap_state(fap, &state) == 0 && state.magic == BOOT_MAGIC_GOOD &&
+        state.copy_done == BOOT_FLAG_SET && state.image_ok == BOOT_FLAG_UNSET) {
+        reclaim = true;
+    }
+#endif
+
     rc = boot_set_next(fap, true, true);
 
     flash_area_close(fap);
+
+#if defined(MCUBOOT_SWAP_OFFSET_PERM_NO_BACKUP)
+    /*
+     * The image is committed at this point: failing to reclaim the secondary
+     * slot only leaves its erase to a later boot_pre_erase_multi() call, or to
+     * the next upgrade.
+     */
+    if (rc == 0 && reclaim && boot_pre_erase_multi(image_index) != 0) {
+        BOOT_LOG_WRN("boot_set_confirmed_multi: could not reclaim the secondary slot of"
+                     " image %d", image_index);
+    }
+#endif
+
     return rc;
 }
 
@@ -883,6 +916,251 @@ boot_set_confirmed(void)
     return boot_set_confirmed_multi(0);
 }
 
+#if defined(MCUBOOT_SWAP_USING_SCRATCH) || defined(MCUBOOT_SWAP_USING_MOVE) || \
+    defined(MCUBOOT_SWAP_USING_OFFSET)
+/* Offset of the pre-erased record, at the start of the swap status area. */
+static uint32_t
+boot_pre_erased_off(const struct flash_area *fap)
+{
+    return flash_area_get_size(fap) - boot_trailer_sz(flash_area_align(fap));
+}
+
+/* Size of the record, rounded up to write units, before the unit voiding it. */
+static uint32_t
+boot_pre_erased_sz(const struct flash_area *fap)
+{
+    return ALIGN_UP(sizeof(struct boot_pre_erased), flash_area_align(fap));
+}
+
+int
+boot_read_pre_erased(const struct flash_area *fap, struct boot_pre_erased *rec)
+{
+    uint32_t off = boot_pre_erased_off(fap);
+    uint32_t align = flash_area_align(fap);
+    uint8_t unit[BOOT_MAX_ALIGN];
+
+    if (flash_area_read(fap, off, rec, sizeof(*rec)) != 0 ||
+        flash_area_read(fap, off + boot_pre_erased_sz(fap), unit, align) != 0) {
+        return BOOT_EFLASH;
+    }
+
+    if (rec->magic != BOOT_PRE_ERASED_MAGIC || rec->size == 0 ||
+        !bootutil_buffer_is_erased(fap, unit, align)) {
+        return 1;
+    }
+
+    return 0;
+}
+
+int
+boot_write_pre_erased(const struct flash_area *fap, const struct boot_pre_erased *rec)
+{
+    uint8_t buf[ALIGN_UP(sizeof(struct boot_pre_erased), BOOT_MAX_ALIGN)];
+    uint32_t align = flash_area_align(fap);
+
+    /* The record and the unit voiding it must fit in the swap status area. */
+    if (boot_pre_erased_sz(fap) + align > boot_status_sz(align)) {
+        return BOOT_ENOMEM;
+    }
+
+    memset(buf, flash_area_erased_val(fap), sizeof(buf));
+    memcpy(buf, rec, sizeof(*rec));
+    if (flash_area_write(fap, boot_pre_erased_off(fap), buf, boot_pre_erased_sz(fap)) != 0) {
+        return BOOT_EFLASH;
+    }
+
+    return 0;
+}
+
+int
+boot_clear_pre_erased(const struct flash_area *fap)
+{
+    uint8_t unit[BOOT_MAX_ALIGN];
+    uint32_t align = flash_area_align(fap);
+
+    memset(unit, ~flash_area_erased_val(fap), align);
+    if (flash_area_write(fap, boot_pre_erased_off(fap) + boot_pre_erased_sz(fap), unit,
+                         align) != 0) {
+        return BOOT_EFLASH;
+    }
+
+    return 0;
+}
+
+/* Erase the sectors holding the bytes from off to end in a flash area. */
+static int
+boot_pre_erase_range(const struct flash_area *fap, uint32_t off, uint32_t end)
+{
+    struct flash_sector sector;
+    uint32_t sector_off;
+    uint32_t sector_sz;
+
+    while (off < end) {
+        if (flash_area_get_sector(fap, off, &sector) != 0) {
+            return BOOT_EFLASH;
+        }
+
+        sector_off = flash_sector_get_off(&sector);
+        sector_sz = flash_sector_get_size(&sector);
+        BOOT_LOG_DBG("boot_pre_erase: erasing 0x%x of 0x%x in fa_id=%d",
+                     (unsigned int)sector_off, (unsigned int)sector_sz,
+                     flash_area_get_id(fap));
+        if (flash_area_erase(fap, sector_off, sector_sz) != 0) {
+            return BOOT_EFLASH;
+        }
+
+        off = sector_off + sector_sz;
+    }
+
+    return 0;
+}
+#endif
+
+/**
+ * Erases, ahead of the next upgrade of the image with the given index, the
+ * flash which the previous upgrade left behind: the trailer of the secondary
+ * slot, its first sector with swap using offset, and the scratch area with
+ * swap using scratch.
+ *
+ * Once all of it is erased, the range which the bootloader erases first during
+ * the next upgrade is recorded in the swap status area of the secondary slot,
+ * so that an interrupted call leaves no record behind.  The scratch area is
+ * only recorded with a single image, as the upgrades of all the images share
+ * it.
+ *
+ * The previous image, left in the secondary slot by the swap, can no longer be
+ * swapped back in afterwards.
+ *
+ * @param image_index       Image pair index.
+ *
+ * @return                  0 on success; BOOT_EBADSTATUS if the image in the
+ *                          primary slot is not confirmed yet or an upgrade is
+ *                          pending; BOOT_EFLASH on flash errors.
+ */
+int
+boot_pre_erase_multi(int image_index)
+{
+#if defined(MCUBOOT_SWAP_USING_SCRATCH) || defined(MCUBOOT_SWAP_USING_MOVE) || \
+    defined(MCUBOOT_SWAP_USING_OFFSET)
+    const struct flash_area *fap_pri = NULL;
+    const struct flash_area *fap_sec = NULL;
+    struct boot_swap_state state_pri;
+    struct boot_swap_state state_sec;
+#if defined(MCUBOOT_SWAP_USING_OFFSET) || \
+    (defined(MCUBOOT_SWAP_USING_SCRATCH) && BOOT_IMAGE_NUMBER == 1)
+    struct boot_pre_erased rec;
+#endif
+    struct flash_sector sector;
+    int rc;
+
+    if (flash_area_open(FLASH_AREA_IMAGE_PRIMARY(image_index), &fap_pri) != 0) {
+        return BOOT_EFLASH;
+    }
+
+    if (flash_area_open(FLASH_AREA_IMAGE_SECONDARY(image_index), &fap_sec) != 0) {
+        flash_area_close(fap_pri);
+        return BOOT_EFLASH;
+    }
+
+    if (boot_read_swap_state(fap_pri, &state_pri) != 0 ||
+        boot_read_swap_state(fap_sec, &state_sec) != 0) {
+        rc = BOOT_EFLASH;
+        goto done;
+    }
+
+    /*
+     * Until the image is confirmed, the secondary slot holds the image to
+     * revert to.
+     */
+    if ((state_pri.magic == BOOT_MAGIC_GOOD && state_pri.image_ok != BOOT_FLAG_SET) ||
+        state_sec.magic == BOOT_MAGIC_GOOD) {
+        rc = BOOT_EBADSTATUS;
+        goto done;
+    }
+
+    rc = 0;
+    if (!device_requires_erase(fap_sec)) {
+        goto done;
+    }
+
+    /* The trailer, from the swap status area on, which holds the record. */
+    if (flash_area_get_sector(fap_sec, boot_pre_erased_off(fap_sec), &sector) != 0) {
+        rc = BOOT_EFLASH;
+        goto done;
+    }
+    rc = boot_pre_erase_range(fap_sec, flash_sector_get_off(&sector),
+                              flash_area_get_size(fap_sec));
+
+#if defined(MCUBOOT_SWAP_USING_OFFSET)
+    if (rc == 0) {
+        if (flash_area_get_sector(fap_sec, 0, &sector) != 0) {
+            rc = BOOT_EFLASH;
+        } else {
+            rc = boot_pre_erase_range(fap_sec, 0, flash_sector_get_size(&sector));
+        }
+    }
+
+    if (rc == 0) {
+        memset(&rec, 0, sizeof(rec));
+        rec.magic = BOOT_PRE_ERASED_MAGIC;
+        rec.size = flash_sector_get_size(&sector);
+        rec.fa_id = flash_area_get_id(fap_sec);
+        rc = boot_write_pre_erased(fap_sec, &rec);
+    }
+#endif
+
+#if defined(MCUBOOT_SWAP_USING_SCRATCH)
+    if (rc == 0) {
+        const struct flash_area *fap_scratch = NULL;
+
+        if (flash_area_open(FLASH_AREA_IMAGE_SCRATCH, &fap_scratch) != 0) {
+            rc = BOOT_EFLASH;
+        } else {
+            rc = boot_pre_erase_range(fap_scratch, 0, flash_area_get_size(fap_scratch));
+#if BOOT_IMAGE_NUMBER == 1
+            if (rc == 0) {
+                memset(&rec, 0, sizeof(rec));
+                rec.magic = BOOT_PRE_ERASED_MAGIC;
+                rec.size = flash_area_get_size(fap_scratch);
+                rec.fa_id = flash_area_get_id(fap_scratch);
+                rc = boot_write_pre_erased(fap_sec, &rec);
+            }
+#endif
+            flash_area_close(fap_scratch);
+        }
+    }
+#endif
+
+    /* A record which does not fit only costs the skipped erase. */
+    if (rc == BOOT_ENOMEM) {
+        rc = 0;
+    }
+
+done:
+    flash_area_close(fap_sec);
+    flash_area_close(fap_pri);
+    return rc;
+#else
+    /* Only the swap upgrades leave flash to erase behind them. */
+    (void)image_index;
+    return 0;
+#endif
+}
+
+/**
+ * Erases, ahead of the next upgrade of the image with index 0, the flash which
+ * the previous upgrade left behind.  Note that this API is kept for consistency
+ * with the other single image APIs. The boot_pre_erase_multi() API is
+ * recommended.
+ *
+ * @return                  0 on success; nonzero on failure.
+ */
+int
+boot_pre_erase(void)
+{
+    return boot_pre_erase_multi(0);
+}
+
 int
 boot_image_load_header(const struct flash_area *fa_p,
                        struct image_header *hdr)
@@ -0,0 +1,106 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright (c) 2026 Linaro LTD
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "bootutil/bootutil_log.h"
+#include "bootutil_scratch.h"
+
+BOOT_LOG_MODULE_DECLARE(mcuboot);
+
+/*
+ * The simulator runs several boots at once, each on its own thread, so each
+ * of them has its own arena.
+ */
+#if defined(__BOOTSIM__)
+#define BOOT_SCRATCH_STORAGE static __thread
+#else
+#define BOOT_SCRATCH_STORAGE static
+#endif
+
+#define BOOT_SCRATCH_FREE BOOT_SCRATCH_PHASES
+
+BOOT_SCRATCH_STORAGE uint8_t boot_scratch[BOOT_SCRATCH_SZ] __attribute__((aligned(4)));
+BOOT_SCRATCH_STORAGE uint8_t boot_scratch_owner = BOOT_SCRATCH_FREE;
+
+#ifdef MCUBOOT_SCRATCH_STATS
+#define BOOT_SCRATCH_PAINT 0xa5
+
+BOOT_SCRATCH_STORAGE size_t boot_scratch_hwm[BOOT_SCRATCH_PHASES];
+
+static const char *const boot_scratch_names[BOOT_SCRATCH_PHASES] = {
+    "validate",
+    "copy",
+    "serial",
+};
+#endif
+
+uint8_t *
+boot_scratch_begin(enum boot_scratch_phase phase, size_t *size)
+{
+    assert(phase < BOOT_SCRATCH_PHASES);
+
+    if (boot_scratch_owner != BOOT_SCRATCH_FREE) {
+        BOOT_LOG_ERR("Scratch arena wanted by phase %d, held by phase %d",
+                     (int)phase, (int)boot_scratch_owner);
+        assert(0);
+        return NULL;
+    }
+
+    boot_scratch_owner = (uint8_t)phase;
+#ifdef MCUBOOT_SCRATCH_STATS
+    memset(boot_scratch, BOOT_SCRATCH_PAINT, sizeof(boot_scratch));
+#endif
+
+    *size = sizeof(boot_scratch);
+    return boot_scratch;
+}
+
+void
+boot_scratch_end(enum boot_scratch_phase phase)
+{
+#ifdef MCUBOOT_SCRATCH_STATS
+    size_t used = sizeof(boot_scratch);
+
+    while (used > 0 && boot_scratch[used - 1] == BOOT_SCRATCH_PAINT) {
+        used--;
+    }
+
+    if (used > boot_scratch_hwm[phase]) {
+        boot_scratch_hwm[phase] = used;
+        BOOT_LOG_DBG("Scratch arena: %s used %u of %u bytes", boot_scratch_names[phase],
+                     (unsigned)used, (unsigned)sizeof(boot_scratch));
+    }
+#endif
+
+    assert(boot_scratch_owner == phase);
+    (void)phase;
+    boot_scratch_owner = BOOT_SCRATCH_FREE;
+}
+
+void
+boot_scratch_reset(void)
+{
+    if (boot_scratch_owner != BOOT_SCRATCH_FREE) {
+        BOOT_LOG_DBG("Scratch arena released from phase %d", (int)boot_scratch_owner);
+        boot_scratch_owner = BOOT_SCRATCH_FREE;
+    }
+}
+
+bool
+boot_scratch_held(void)
+{
+    return boot_scratch_owner != BOOT_SCRATCH_FREE;
+}
+
+#ifdef MCUBOOT_SCRATCH_STATS
+size_t
+boot_scratch_high_water(enum boot_scratch_phase phase)
+{
+    return boot_scratch_hwm[phase];
+}
+#endif
@@ -0,0 +1,93 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright (c) 2026 Linaro LTD
+ */
+
+/*
+ * Scratch arena shared by the phases of the boot.
+ *
+ * Validating an image, copying it between slots and validating the slots
+ * listed by serial recovery each need a RAM buffer to go through the flash,
+ * but never at the same time.  They all use the same arena, which is handed
+ * out whole to the running phase, so that each of them reads the flash in the
+ * largest chunks possible.
+ */
+
+#ifndef H_BOOTUTIL_SCRATCH_
+#define H_BOOTUTIL_SCRATCH_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bootutil_priv.h"
+#include "bootutil_loader.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * The arena is as large as the copy buffer when images are copied between
+ * slots, and as the validation buffer otherwise, so that it doesn't take more
+ * RAM than the buffers it replaces.
+ */
+#if !defined(MCUBOOT_SINGLE_APPLICATION_SLOT) && !defined(MCUBOOT_FIRMWARE_LOADER) && \
+    !defined(MCUBOOT_DIRECT_XIP) && !defined(MCUBOOT_RAM_LOAD) && (BUF_SZ > BOOT_TMPBUF_SZ)
+#define BOOT_SCRATCH_SZ BUF_SZ
+#else
+#define BOOT_SCRATCH_SZ BOOT_TMPBUF_SZ
+#endif
+
+#if (BOOT_SCRATCH_SZ % BOOT_MAX_ALIGN) != 0
+#error "The scratch arena must be a multiple of the flash write alignment"
+#endif
+
+enum boot_scratch_phase {
+    BOOT_SCRATCH_VALIDATE,
+    BOOT_SCRATCH_COPY,
+    BOOT_SCRATCH_SERIAL,
+    BOOT_SCRATCH_PHASES,
+};
+
+/**
+ * Take the arena for a phase, until boot_scratch_end() is called.
+ *
+ * @param phase  The phase taking the arena.
+ * @param size   Set to the size of the arena, BOOT_SCRATCH_SZ.
+ *
+ * @return The arena, aligned to 4 bytes; NULL if another phase holds it.
+ */
+uint8_t *boot_scratch_begin(enum boot_scratch_phase phase, size_t *size);
+
+/**
+ * Give the arena back, at the end of a phase.
+ */
+void boot_scratch_end(enum boot_scratch_phase phase);
+
+/**
+ * Give the arena back whichever phase holds it.  Done at the start of a boot,
+ * as a previous one may have been cut short in the middle of a phase.
+ */
+void boot_scratch_reset(void);
+
+/**
+ * Whether a phase holds the arena.
+ */
+bool boot_scratch_held(void);
+
+#ifdef MCUBOOT_SCRATCH_STATS
+/**
+ * Largest number of bytes of the arena used by a phase so far.  The arena is
+ * filled with a pattern when taken, and the high-water mark is the end of the
+ * bytes which no longer hold it when given back, so it may be slightly low.
+ */
+size_t boot_scratch_high_water(enum boot_scratch_phase phase);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* H_BOOTUTIL_SCRATCH_ */
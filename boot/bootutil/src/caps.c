@@ -83,6 +83,15 @@ uint32_t bootutil_get_caps(void)
 #if defined(MCUBOOT_HW_ROLLBACK_PROT)
     res |= BOOTUTIL_CAP_HW_ROLLBACK_PROT;
 #endif
+#if defined(MCUBOOT_SWAP_STATUS_PACKED)
+    res |= BOOTUTIL_CAP_SWAP_STATUS_PACKED;
+#endif
+#if defined(MCUBOOT_SWAP_OFFSET_PERM_NO_BACKUP)
+    res |= BOOTUTIL_CAP_SWAP_OFFSET_NO_BACKUP;
+#endif
+#if defined(MCUBOOT_SKIP_PRE_ERASED)
+    res |= BOOTUTIL_CAP_SKIP_PRE_ERASED;
+#endif
 
     return res;
 }
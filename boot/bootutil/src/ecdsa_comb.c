@@ -0,0 +1,267 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright (c) 2026 Linaro LTD
+ */
+
+#include "mcuboot_config/mcuboot_config.h"
+
+#if defined(MCUBOOT_ECDSA_COMB_TABLES)
+
+#include <stdbool.h>
+#include <string.h>
+
+#include <tinycrypt/ecc.h>
+
+#include "bootutil/crypto/ecdsa_comb.h"
+
+#define COMB_SPACING    (256 / BOOTUTIL_ECDSA_COMB_TEETH)
+#define COMB_ENTRY_SIZE (2 * NUM_ECC_BYTES)
+
+#if BOOTUTIL_ECDSA_COMB_SIZE != ((1 << BOOTUTIL_ECDSA_COMB_TEETH) - 1) * COMB_ENTRY_SIZE
+#error "Comb table size does not match the curve"
+#endif
+
+/*
+ * Comb table of the P-256 generator, as produced by
+ * scripts/imgtool/keys/ecdsa.py:p256_comb_table(P256_GX, P256_GY).
+ */
+static const uint8_t ecdsa_p256_g_comb[BOOTUTIL_ECDSA_COMB_SIZE] = {
+    0x6b, 0x17, 0xd1, 0xf2, 0xe1, 0x2c, 0x42, 0x47,
+    0xf8, 0xbc, 0xe6, 0xe5, 0x63, 0xa4, 0x40, 0xf2,
+    0x77, 0x03, 0x7d, 0x81, 0x2d, 0xeb, 0x33, 0xa0,
+    0xf4, 0xa1, 0x39, 0x45, 0xd8, 0x98, 0xc2, 0x96,
+    0x4f, 0xe3, 0x42, 0xe2, 0xfe, 0x1a, 0x7f, 0x9b,
+    0x8e, 0xe7, 0xeb, 0x4a, 0x7c, 0x0f, 0x9e, 0x16,
+    0x2b, 0xce, 0x33, 0x57, 0x6b, 0x31, 0x5e, 0xce,
+    0xcb, 0xb6, 0x40, 0x68, 0x37, 0xbf, 0x51, 0xf5,
+    0x0f, 0xa8, 0x22, 0xbc, 0x28, 0x11, 0xaa, 0xa5,
+    0x84, 0x92, 0x59, 0x2e, 0x32, 0x6e, 0x25, 0xde,
+    0x29, 0x49, 0x3b, 0xaa, 0xad, 0x65, 0x1f, 0x7e,
+    0x90, 0xe7, 0x5c, 0xb4, 0x8e, 0x14, 0xdb, 0x63,
+    0xbf, 0xf4, 0x4a, 0xe8, 0xf5, 0xdb, 0xa8, 0x0d,
+    0x6f, 0x4a, 0xd4, 0xbc, 0xb3, 0xdf, 0x18, 0x8b,
+    0x34, 0xb1, 0xa6, 0x50, 0x50, 0xfe, 0x82, 0xf5,
+    0xe4, 0x11, 0x24, 0x54, 0x5f, 0x46, 0x2e, 0xe7,
+    0x30, 0x0a, 0x4b, 0xbc, 0x89, 0xd6, 0x72, 0x6f,
+    0xb2, 0x57, 0xc0, 0xde, 0x95, 0xe0, 0x27, 0x89,
+    0xe9, 0x6c, 0x98, 0xfd, 0x0d, 0x35, 0xf1, 0xfa,
+    0x93, 0x39, 0x1c, 0xe2, 0x09, 0x79, 0x92, 0xaf,
+    0x72, 0xaa, 0xc7, 0xe0, 0xd0, 0x9b, 0x46, 0x44,
+    0x7f, 0x1d, 0xdb, 0x25, 0xff, 0x1e, 0x3c, 0x6f,
+    0x5b, 0xb1, 0xee, 0xad, 0xa9, 0xd8, 0x06, 0xa5,
+    0xaa, 0x54, 0xa2, 0x91, 0xc0, 0x81, 0x27, 0xa0,
+    0x44, 0x7d, 0x73, 0x9b, 0xee, 0xdb, 0x5e, 0x67,
+    0xfb, 0x98, 0x2f, 0xd5, 0x88, 0xc6, 0x76, 0x6e,
+    0xfc, 0x35, 0xff, 0x7d, 0xc2, 0x97, 0xea, 0xc3,
+    0x57, 0xc8, 0x4f, 0xc9, 0xd7, 0x89, 0xbd, 0x85,
+    0x2d, 0x48, 0x25, 0xab, 0x83, 0x41, 0x31, 0xee,
+    0xe1, 0x2e, 0x9d, 0x95, 0x3a, 0x4a, 0xaf, 0xf7,
+    0x3d, 0x34, 0x9b, 0x95, 0xa7, 0xfa, 0xe5, 0x00,
+    0x0c, 0x7e, 0x33, 0xc9, 0x72, 0xe2, 0x5b, 0x32,
+    0xef, 0x95, 0x19, 0x32, 0x8a, 0x9c, 0x72, 0xff,
+    0xdd, 0xc6, 0x06, 0x8b, 0xb9, 0x1d, 0xfc, 0x60,
+    0xef, 0x7f, 0xbd, 0x2b, 0x1a, 0x0a, 0x11, 0xb7,
+    0x13, 0x94, 0x9c, 0x93, 0x2a, 0x1d, 0x36, 0x7f,
+    0x61, 0x1e, 0x9f, 0xc3, 0x7d, 0xbb, 0x2c, 0x9b,
+    0xc1, 0xee, 0x98, 0x07, 0x02, 0x2c, 0x21, 0x9c,
+    0x23, 0x18, 0x3b, 0x08, 0x95, 0xca, 0x17, 0x40,
+    0x19, 0x60, 0x35, 0xa7, 0x73, 0x76, 0xd8, 0xa8,
+    0x55, 0x06, 0x63, 0x79, 0x7b, 0x51, 0xf5, 0xd8,
+    0x7d, 0xea, 0x64, 0x82, 0xe1, 0x12, 0x38, 0xbf,
+    0x29, 0x36, 0xdf, 0x5e, 0xc6, 0xc9, 0xbc, 0x36,
+    0xca, 0xe2, 0xb1, 0x92, 0x0b, 0x57, 0xf4, 0xbc,
+    0x15, 0x71, 0x64, 0x84, 0x8a, 0xec, 0xb8, 0x51,
+    0x0a, 0xfa, 0x40, 0x01, 0x8d, 0x9d, 0x50, 0xe5,
+    0x9f, 0xb3, 0xd5, 0x76, 0xdb, 0xde, 0xfb, 0xe1,
+    0x44, 0xff, 0xe2, 0x16, 0x34, 0x8a, 0x96, 0x4c,
+    0xeb, 0x5d, 0x77, 0x45, 0xb2, 0x11, 0x41, 0xea,
+    0xa2, 0xe8, 0xf4, 0x83, 0xf4, 0x3e, 0x43, 0x91,
+    0x7c, 0xcd, 0x84, 0xe7, 0x0d, 0x71, 0x5f, 0x26,
+    0xe4, 0x8e, 0xca, 0xff, 0xfc, 0x5c, 0xde, 0x01,
+    0xea, 0xfd, 0x72, 0xeb, 0xdb, 0xec, 0xc1, 0x7b,
+    0x09, 0x90, 0xe6, 0xa1, 0x58, 0x00, 0x6c, 0xee,
+    0x85, 0xf2, 0x2c, 0xfe, 0x28, 0x44, 0xb6, 0x45,
+    0xca, 0xc9, 0x17, 0xe2, 0x73, 0x1a, 0x34, 0x79,
+    0xa6, 0xd3, 0x96, 0x77, 0xa7, 0x84, 0x92, 0x76,
+    0x27, 0x36, 0xff, 0x83, 0x44, 0x31, 0x5f, 0xc5,
+    0x96, 0x43, 0x95, 0x91, 0xa3, 0xc6, 0xb9, 0x4a,
+    0x6c, 0xf2, 0x0f, 0xfb, 0x31, 0x37, 0x28, 0xbe,
+    0x67, 0x4f, 0x84, 0x74, 0x9b, 0x0b, 0x88, 0x16,
+    0x66, 0xb8, 0xba, 0xbd, 0x2d, 0x27, 0xec, 0xdf,
+    0x82, 0x4a, 0x92, 0x0c, 0x22, 0x84, 0x05, 0x9b,
+    0xf2, 0xba, 0xb8, 0x33, 0xc3, 0x57, 0xf5, 0xf4,
+    0x4e, 0x76, 0x9e, 0x76, 0x72, 0xc9, 0xdd, 0xad,
+    0x31, 0x85, 0x5f, 0x7d, 0xb8, 0xc7, 0xfe, 0xdb,
+    0x74, 0xe0, 0x2f, 0x08, 0x02, 0x03, 0xa5, 0x6b,
+    0x2d, 0xf4, 0x8c, 0x04, 0x67, 0x7c, 0x8a, 0x3e,
+    0x42, 0xb9, 0x90, 0x82, 0xde, 0x83, 0x06, 0x63,
+    0x1e, 0xc0, 0x05, 0x72, 0x06, 0x94, 0x72, 0x81,
+    0xfb, 0x9a, 0xe1, 0x6f, 0x3b, 0x91, 0x22, 0xa5,
+    0xa4, 0xc3, 0x61, 0x65, 0xb8, 0x24, 0xbb, 0xb0,
+    0x78, 0x87, 0x8e, 0xf6, 0x1c, 0x6c, 0xe0, 0x4d,
+    0x7f, 0xdc, 0x1c, 0xa0, 0x08, 0xa1, 0xc4, 0x78,
+    0xd1, 0xf8, 0x9e, 0x79, 0x9c, 0x0c, 0xe1, 0x31,
+    0x6e, 0xf9, 0x51, 0x50, 0xdd, 0xa8, 0x68, 0xb9,
+    0xb6, 0xcb, 0x3f, 0x5d, 0x7b, 0x72, 0xc3, 0x21,
+    0xde, 0x53, 0x14, 0x2c, 0x12, 0x30, 0x9d, 0xef,
+    0x6a, 0xce, 0x57, 0x0e, 0xbd, 0xe0, 0x8d, 0x4f,
+    0x9c, 0x62, 0xb9, 0x12, 0x1f, 0xe0, 0xd9, 0x76,
+    0x0c, 0x88, 0xbc, 0x4d, 0x71, 0x6b, 0x12, 0x87,
+    0x59, 0x5c, 0x52, 0x20, 0x81, 0x2f, 0xfc, 0xae,
+    0x5b, 0x82, 0xdd, 0x5b, 0xd5, 0x4f, 0xb4, 0x96,
+    0x7f, 0x99, 0x1e, 0xd2, 0xc3, 0x1a, 0x35, 0x73,
+    0xdd, 0x5d, 0xde, 0xa3, 0xf3, 0x90, 0x1d, 0xc6,
+    0x18, 0xd1, 0xb5, 0xb3, 0x9c, 0x04, 0xe6, 0xaa,
+    0x7c, 0x81, 0x81, 0xf4, 0xdf, 0x25, 0x64, 0xf3,
+    0x3a, 0x57, 0xbf, 0x63, 0x5f, 0x48, 0xac, 0xa8,
+    0x68, 0xf3, 0x44, 0xaf, 0x6b, 0x31, 0x74, 0x66,
+    0xef, 0xe0, 0xa4, 0x23, 0x08, 0x3e, 0x49, 0xf3,
+    0x43, 0xa0, 0xa2, 0x8c, 0x42, 0xba, 0x79, 0x2f,
+    0xe9, 0x6a, 0x79, 0xfb, 0x3e, 0x72, 0xad, 0x0c,
+    0x31, 0xb9, 0xc4, 0x05, 0xf8, 0x54, 0x0a, 0x20,
+    0x60, 0x4e, 0xd9, 0x3c, 0x24, 0xd6, 0x7f, 0xf3,
+    0x66, 0x8b, 0xfc, 0x22, 0x71, 0xf5, 0xc6, 0x26,
+    0xcd, 0xfe, 0x17, 0xdb, 0x3f, 0xb2, 0x4d, 0x4a,
+    0x40, 0x52, 0xbf, 0x4b, 0x6f, 0x46, 0x1d, 0xb9,
+    0x66, 0x3c, 0x62, 0xc3, 0xed, 0xba, 0xd7, 0xa0,
+    0x0d, 0x1a, 0x10, 0x14, 0x4e, 0xc3, 0x9c, 0x28,
+    0xd3, 0x6b, 0x47, 0x89, 0xa2, 0x58, 0x2e, 0x7f,
+    0xfe, 0xcf, 0x4d, 0x51, 0x90, 0xb0, 0xfc, 0x61,
+    0x86, 0x2b, 0xe6, 0xbd, 0x71, 0xd7, 0x0c, 0xc8,
+    0xe7, 0x24, 0xf3, 0x39, 0x99, 0xbf, 0xcc, 0x5b,
+    0x23, 0x5a, 0x27, 0xc3, 0x18, 0x8d, 0x25, 0xeb,
+    0x1e, 0xdd, 0xba, 0xe2, 0xc8, 0x02, 0xe4, 0x1a,
+    0x12, 0x32, 0x02, 0xa8, 0xf6, 0x2b, 0xff, 0x7a,
+    0xaf, 0xdf, 0x5c, 0xc0, 0x85, 0x26, 0xa7, 0xa4,
+    0x74, 0x34, 0x6c, 0x10, 0xa1, 0xd4, 0xcf, 0xac,
+    0x43, 0x10, 0x4d, 0x86, 0x56, 0x0e, 0xbc, 0xfc,
+    0x0c, 0x45, 0xf4, 0x52, 0x73, 0xdb, 0x33, 0xa0,
+    0x36, 0xe0, 0x6b, 0x7e, 0x4c, 0x70, 0x19, 0x17,
+    0x8f, 0xa0, 0xaf, 0x2d, 0xd6, 0x03, 0xf8, 0x44,
+    0xb4, 0x8e, 0x26, 0xb4, 0x84, 0xf7, 0xa2, 0x1c,
+    0x0a, 0x4a, 0x46, 0xfb, 0x6a, 0xaf, 0x36, 0x3a,
+    0x66, 0xb0, 0xde, 0x32, 0x25, 0xc4, 0x74, 0x4b,
+    0x96, 0x15, 0xb5, 0x11, 0x0d, 0x1d, 0x78, 0xe5,
+    0xfa, 0xc0, 0x15, 0x40, 0x4d, 0x4d, 0x3d, 0xab,
+    0x64, 0x13, 0x1b, 0xcd, 0xfe, 0xd6, 0xf6, 0x68,
+    0xc0, 0x04, 0xe4, 0x04, 0x8b, 0x7b, 0x0f, 0x98,
+    0x06, 0xeb, 0xb0, 0xf6, 0x21, 0xa0, 0x1b, 0x2d,
+};
+
+/* Index of the comb entry for column col of the scalar k. */
+static unsigned int
+comb_index(const uECC_word_t *k, int col)
+{
+    unsigned int index = 0;
+    int t;
+
+    for (t = 0; t < BOOTUTIL_ECDSA_COMB_TEETH; t++) {
+        if (uECC_vli_testBit(k, col + t * COMB_SPACING)) {
+            index |= 1u << t;
+        }
+    }
+
+    return index;
+}
+
+/*
+ * Add an affine comb entry to the Jacobian point (rx, ry, z), or load it if
+ * the point is still at infinity.  This is the co-Z addition used by
+ * uECC_verify().
+ */
+static void
+comb_add(uECC_word_t *rx, uECC_word_t *ry, uECC_word_t *z, bool *have,
+         const uint8_t *comb, unsigned int index, uECC_Curve curve)
+{
+    uECC_word_t tx[NUM_ECC_WORDS];
+    uECC_word_t ty[NUM_ECC_WORDS];
+    uECC_word_t tz[NUM_ECC_WORDS];
+    const uint8_t *entry = comb + (index - 1) * COMB_ENTRY_SIZE;
+
+    uECC_vli_bytesToNative(tx, entry, NUM_ECC_BYTES);
+    uECC_vli_bytesToNative(ty, entry + NUM_ECC_BYTES, NUM_ECC_BYTES);
+
+    if (!*have) {
+        uECC_vli_set(rx, tx, NUM_ECC_WORDS);
+        uECC_vli_set(ry, ty, NUM_ECC_WORDS);
+        uECC_vli_clear(z, NUM_ECC_WORDS);
+        z[0] = 1;
+        *have = true;
+        return;
+    }
+
+    apply_z(tx, ty, z, curve);
+    uECC_vli_modSub(tz, rx, tx, curve->p, NUM_ECC_WORDS); /* Z = x2 - x1 */
+    XYcZ_add(tx, ty, rx, ry, curve);
+    uECC_vli_modMult_fast(z, z, tz, curve);
+}
+
+int
+bootutil_ecdsa_comb_verify(const uint8_t *pubkey, const uint8_t *comb,
+                           const uint8_t *hash, const uint8_t *signature)
+{
+    uECC_Curve curve = uECC_secp256r1();
+    uECC_word_t u1[NUM_ECC_WORDS], u2[NUM_ECC_WORDS];
+    uECC_word_t r[NUM_ECC_WORDS], s[NUM_ECC_WORDS];
+    uECC_word_t rx[NUM_ECC_WORDS], ry[NUM_ECC_WORDS];
+    uECC_word_t z[NUM_ECC_WORDS];
+    unsigned int index;
+    bool have = false;
+    int col;
+
+    /* The first entry of a comb table is the point itself. */
+    if (memcmp(comb, pubkey, COMB_ENTRY_SIZE) != 0) {
+        return BOOTUTIL_ECDSA_COMB_MISMATCH;
+    }
+
+    uECC_vli_bytesToNative(r, signature, NUM_ECC_BYTES);
+    uECC_vli_bytesToNative(s, signature + NUM_ECC_BYTES, NUM_ECC_BYTES);
+
+    /* r, s must be in [1, n - 1]. */
+    if (uECC_vli_isZero(r, NUM_ECC_WORDS) || uECC_vli_isZero(s, NUM_ECC_WORDS) ||
+        uECC_vli_cmp_unsafe(curve->n, r, NUM_ECC_WORDS) != 1 ||
+        uECC_vli_cmp_unsafe(curve->n, s, NUM_ECC_WORDS) != 1) {
+        return -1;
+    }
+
+    /* u1 = e / s, u2 = r / s */
+    uECC_vli_modInv(z, s, curve->n, NUM_ECC_WORDS);
+    uECC_vli_bytesToNative(u1, hash, NUM_ECC_BYTES);
+    uECC_vli_modMult(u1, u1, z, curve->n, NUM_ECC_WORDS);
+    uECC_vli_modMult(u2, r, z, curve->n, NUM_ECC_WORDS);
+
+    /* u1 * G + u2 * Q, one column of both combs at a time. */
+    for (col = COMB_SPACING - 1; col >= 0; col--) {
+        if (have) {
+            curve->double_jacobian(rx, ry, z, curve);
+        }
+
+        index = comb_index(u1, col);
+        if (index != 0) {
+            comb_add(rx, ry, z, &have, ecdsa_p256_g_comb, index, curve);
+        }
+
+        index = comb_index(u2, col);
+        if (index != 0) {
+            comb_add(rx, ry, z, &have, comb, index, curve);
+        }
+    }
+
+    if (!have) {
+        return -1;
+    }
+
+    uECC_vli_modInv(z, z, curve->p, NUM_ECC_WORDS);
+    apply_z(rx, ry, z, curve);
+
+    /* v = x1 (mod n) */
+    if (uECC_vli_cmp_unsafe(curve->n, rx, NUM_ECC_WORDS) != 1) {
+        uECC_vli_sub(rx, rx, curve->n, NUM_ECC_WORDS);
+    }
+
+    /* Accept only if v == r. */
+    return uECC_vli_equal(rx, r, NUM_ECC_WORDS) == 0 ? 0 : -1;
+}
+
+#endif /* MCUBOOT_ECDSA_COMB_TABLES */
@@ -43,6 +43,7 @@
 #endif
 #endif
 
+#include "bootutil/crypto/sha.h"
 #include "bootutil/image.h"
 #include "bootutil/enc_key.h"
 #include "bootutil/sign_key.h"
@@ -637,7 +638,80 @@ boot_enc_load(struct boot_loader_state *state, int slot,
         return -1;
     }
 
-    return boot_decrypt_key(buf, bs->enckey[slot]);
+    return boot_enc_unwrap_key(state, slot, buf, bs->enckey[slot]);
+}
+
+#if defined(__BOOTSIM__)
+static __thread uint32_t boot_enc_unwraps;
+
+uint32_t
+boot_enc_unwrap_count(void)
+{
+    return boot_enc_unwraps;
+}
+#endif
+
+/*
+ * Recover the key wrapped in an encryption TLV of the current image.
+ *
+ * The key exchange is by far the most expensive part of loading a key, and
+ * the same TLV is needed by the validation of the secondary slot, by the
+ * start of the swap and, after a reset, by the resumed swap.  Keys are
+ * therefore kept in the per-boot cache of the loader state, identified by a
+ * digest of the TLV they came from.  The first of these phases to need a
+ * key unwraps it; all later ones, from either slot since a swap moves the
+ * image, copy it from the cache.  The cache is cleared at the end of the boot
+ * by boot_enc_cache_zeroize().
+ */
+int
+boot_enc_unwrap_key(struct boot_loader_state *state, int slot,
+                    const uint8_t *tlv, uint8_t *enckey)
+{
+    struct boot_enc_key_cache *cache = BOOT_CURR_ENC_CACHE(state);
+    bootutil_sha_context sha_ctx;
+    uint8_t digest[IMAGE_HASH_SIZE];
+    int i;
+    int rc;
+
+    bootutil_sha_init(&sha_ctx);
+    bootutil_sha_update(&sha_ctx, tlv, BOOT_ENC_TLV_SIZE);
+    bootutil_sha_finish(&sha_ctx, digest);
+    bootutil_sha_drop(&sha_ctx);
+
+    for (i = 0; i < BOOT_NUM_SLOTS; i++) {
+        if (cache[i].valid &&
+            memcmp(cache[i].tlv_digest, digest, BOOT_ENC_KEY_CACHE_DIGEST_SIZE) == 0) {
+            BOOT_LOG_DBG("boot_enc_unwrap_key: slot %d, cached", slot);
+            memcpy(enckey, cache[i].key, BOOT_ENC_KEY_SIZE);
+            return 0;
+        }
+    }
+
+#if defined(__BOOTSIM__)
+    boot_enc_unwraps++;
+#endif
+    rc = boot_decrypt_key(tlv, enckey);
+    if (rc == 0) {
+        memcpy(cache[slot].tlv_digest, digest, BOOT_ENC_KEY_CACHE_DIGEST_SIZE);
+        memcpy(cache[slot].key, enckey, BOOT_ENC_KEY_SIZE);
+        cache[slot].valid = 1;
+    }
+
+    return rc;
+}
+
+/**
+ * Clears the keys cached by boot_enc_unwrap_key() for all images.
+ */
+void
+boot_enc_cache_zeroize(struct boot_loader_state *state)
+{
+    volatile uint8_t *p = (volatile uint8_t *)state->enc_cache;
+    size_t i;
+
+    for (i = 0; i < sizeof(state->enc_cache); i++) {
+        p[i] = 0;
+    }
 }
 
 int
@@ -6,6 +6,10 @@
 
 #include "bootutil/fault_injection_hardening.h"
 
+#if defined(__BOOTSIM__)
+#include <stdlib.h>
+#endif
+
 #ifdef FIH_ENABLE_DOUBLE_VARS
 /* Variable that could be (but isn't) changed at runtime to force the compiler
  * not to optimize the double check. Value doesn't matter.
@@ -21,9 +25,9 @@ fih_ret FIH_BOOT_HOOK_REGULAR = FIH_CONST2;
 #ifdef FIH_ENABLE_CFI
 
 #ifdef FIH_ENABLE_DOUBLE_VARS
-fih_int _fih_cfi_ctr = {0, 0 ^ _FIH_MASK_VALUE};
+FIH_CFI_CTR_STORAGE fih_int _fih_cfi_ctr = {0, 0 ^ _FIH_MASK_VALUE};
 #else
-fih_int _fih_cfi_ctr = {0};
+FIH_CFI_CTR_STORAGE fih_int _fih_cfi_ctr = {0};
 #endif /* FIH_ENABLE_DOUBLE_VARS */
 
 /* Increment the CFI counter by one, and return the value before the increment.
@@ -66,6 +70,10 @@ __attribute__((noinline))
 __attribute__((noreturn))
 void fih_panic_loop(void)
 {
+#if defined(__BOOTSIM__)
+    /* The simulator runs on the host, where the loop can't be branched to. */
+    abort();
+#else
     __asm volatile ("b fih_panic_loop");
     __asm volatile ("b fih_panic_loop");
     __asm volatile ("b fih_panic_loop");
@@ -75,6 +83,7 @@ void fih_panic_loop(void)
     __asm volatile ("b fih_panic_loop");
     __asm volatile ("b fih_panic_loop");
     __asm volatile ("b fih_panic_loop");
+#endif
 
     /* An infinite loop to suppress compiler warnings
      * about the return of a noreturn function
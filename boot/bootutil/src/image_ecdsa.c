@@ -73,7 +73,15 @@ bootutil_verify_sig(uint8_t *hash, uint32_t hlen, uint8_t *sig, size_t slen,
         goto out;
     }
 
+#if defined(MCUBOOT_ECDSA_COMB_TABLES)
+    rc = bootutil_ecdsa_verify_comb(&ctx, pubkey, end-pubkey,
+                                    bootutil_ecdsa_combs[key_id].key,
+                                    bootutil_ecdsa_combs[key_id].key != NULL ?
+                                    *bootutil_ecdsa_combs[key_id].len : 0,
+                                    hash, hlen, sig, slen);
+#else
     rc = bootutil_ecdsa_verify(&ctx, pubkey, end-pubkey, hash, hlen, sig, slen);
+#endif
     fih_rc = fih_ret_encode_zero_equality(rc);
     if (FIH_NOT_EQ(fih_rc, FIH_SUCCESS)) {
         FIH_SET(fih_rc, FIH_FAILURE);
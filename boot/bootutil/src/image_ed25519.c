@@ -37,6 +37,22 @@ extern int ED25519_verify(const uint8_t *message, size_t message_len,
                           const uint8_t signature[EDDSA_SIGNATURE_LENGTH],
                           const uint8_t public_key[NUM_ED25519_BYTES]);
 
+#if defined(MCUBOOT_ED25519_KEY_TABLES)
+#if defined(MCUBOOT_USE_PSA_CRYPTO) || defined(CONFIG_BOOT_SIGNATURE_USING_KMU) || \
+    defined(CONFIG_NCS_BOOT_SIGNATURE_USING_ITS)
+#error "MCUBOOT_ED25519_KEY_TABLES requires the fiat Ed25519 implementation and embedded keys"
+#endif
+
+/*
+ * Same as ED25519_verify(), using the precomputed table of the public key.
+ * Returns -1 if the table does not belong to the key.
+ */
+extern int ED25519_verify_precomp(const uint8_t *message, size_t message_len,
+                                  const uint8_t signature[EDDSA_SIGNATURE_LENGTH],
+                                  const uint8_t public_key[NUM_ED25519_BYTES],
+                                  const uint8_t *table, size_t table_len);
+#endif
+
 #if !defined(CONFIG_BOOT_SIGNATURE_USING_KMU)
 #if !defined(MCUBOOT_KEY_IMPORT_BYPASS_ASN)
 #if !defined(CONFIG_NCS_BOOT_SIGNATURE_USING_ITS)
@@ -150,7 +166,18 @@ bootutil_verify(uint8_t *buf, uint32_t blen,
 
 #endif
 
+#if defined(MCUBOOT_ED25519_KEY_TABLES)
+    rc = ED25519_verify_precomp(buf, blen, sig, pubkey, bootutil_ed25519_tables[key_id].key,
+                                bootutil_ed25519_tables[key_id].key != NULL ?
+                                *bootutil_ed25519_tables[key_id].len : 0);
+    if (rc < 0) {
+        /* No table for this key, or a stale one. */
+        BOOT_LOG_DBG("bootutil_verify: no key table for key_id %d", (int)key_id);
+        rc = ED25519_verify(buf, blen, sig, pubkey);
+    }
+#else
     rc = ED25519_verify(buf, blen, sig, pubkey);
+#endif
 
     if (rc == 0) {
         /* if verify returns 0, there was an error. */
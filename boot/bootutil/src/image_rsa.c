@@ -25,6 +25,7 @@
  * under the License.
  */
 
+#include <stdbool.h>
 #include <string.h>
 
 #include "mcuboot_config/mcuboot_config.h"
@@ -42,6 +43,7 @@ BOOT_LOG_MODULE_DECLARE(mcuboot);
 
 #define BOOTUTIL_CRYPTO_RSA_SIGN_ENABLED
 #include "bootutil/crypto/rsa.h"
+#include "bootutil/crypto/rsa_mont.h"
 
 /* PSA Crypto APIs provide an integrated API to perform the verification
  * while for other crypto backends we need to implement each step at this
@@ -118,36 +120,23 @@ pss_mgf1(uint8_t *mask, const uint8_t *hash)
 }
 
 /*
- * Validate an RSA signature, using RSA-PSS, as described in PKCS #1
- * v2.2, section 9.1.2, with many parameters required to have fixed
- * values. RSASSA-PSS-VERIFY RFC8017 section 8.1.2
+ * Check the encoded message em = sig^E mod N of an RSA-PSS signature, as
+ * described in PKCS #1 v2.2, section 9.1.2, with many parameters required
+ * to have fixed values.
  */
 static fih_ret
-bootutil_cmp_rsasig(bootutil_rsa_context *ctx, uint8_t *hash, uint32_t hlen,
-  uint8_t *sig, size_t slen)
+bootutil_cmp_pss(uint8_t *hash, uint32_t hlen, uint8_t *em)
 {
     bootutil_sha_context shactx;
-    uint8_t em[MBEDTLS_MPI_MAX_SIZE];
     uint8_t db_mask[PSS_MASK_LEN];
     uint8_t h2[PSS_HLEN];
     int i;
     FIH_DECLARE(fih_rc, FIH_FAILURE);
 
-    /* The caller has already verified that slen == bootutil_rsa_get_len(ctx) */
-    if (slen != PSS_EMLEN ||
-        PSS_EMLEN > MBEDTLS_MPI_MAX_SIZE) {
-        goto out;
-    }
-
     if (hlen != PSS_HLEN) {
         goto out;
     }
 
-    /* Apply RSAVP1 to produce em = sig^E mod N using the public key */
-    if (bootutil_rsa_public(ctx, sig, em)) {
-        goto out;
-    }
-
     /*
      * PKCS #1 v2.2, 9.1.2 EMSA-PSS-Verify
      *
@@ -241,6 +230,67 @@ out:
     FIH_RET(fih_rc);
 }
 
+/*
+ * Validate an RSA signature, using RSA-PSS, as described in PKCS #1
+ * v2.2, section 9.1.2, with many parameters required to have fixed
+ * values. RSASSA-PSS-VERIFY RFC8017 section 8.1.2
+ */
+static fih_ret
+bootutil_cmp_rsasig(bootutil_rsa_context *ctx, uint8_t *hash, uint32_t hlen,
+  uint8_t *sig, size_t slen)
+{
+    uint8_t em[MBEDTLS_MPI_MAX_SIZE];
+    FIH_DECLARE(fih_rc, FIH_FAILURE);
+
+    /* The caller has already verified that slen == bootutil_rsa_get_len(ctx) */
+    if (slen != PSS_EMLEN ||
+        PSS_EMLEN > MBEDTLS_MPI_MAX_SIZE) {
+        goto out;
+    }
+
+    /* Apply RSAVP1 to produce em = sig^E mod N using the public key */
+    if (bootutil_rsa_public(ctx, sig, em)) {
+        goto out;
+    }
+
+    FIH_CALL(bootutil_cmp_pss, fih_rc, hash, hlen, em);
+
+out:
+    FIH_RET(fih_rc);
+}
+
+#if defined(MCUBOOT_RSA_KEY_TABLES)
+/*
+ * Validate an RSA-PSS signature using the precomputed Montgomery parameters
+ * of the key, without setting up an RSA context.  Sets *no_table if the key
+ * has no usable table, in which case the caller falls back to the generic
+ * path.
+ */
+static fih_ret
+bootutil_cmp_rsasig_table(uint8_t key_id, uint8_t *hash, uint32_t hlen,
+  uint8_t *sig, size_t slen, bool *no_table)
+{
+    uint8_t em[PSS_EMLEN];
+    int rc;
+    FIH_DECLARE(fih_rc, FIH_FAILURE);
+
+    rc = bootutil_rsa_mont_public(bootutil_keys[key_id].key, *bootutil_keys[key_id].len,
+                                  bootutil_rsa_tables[key_id].key,
+                                  bootutil_rsa_tables[key_id].key != NULL ?
+                                  *bootutil_rsa_tables[key_id].len : 0,
+                                  sig, slen, em);
+    *no_table = (rc == BOOTUTIL_RSA_MONT_MISMATCH);
+    if (rc != 0) {
+        goto out;
+    }
+
+    FIH_CALL(bootutil_cmp_pss, fih_rc, hash, hlen, em);
+
+out:
+    FIH_RET(fih_rc);
+}
+#endif /* MCUBOOT_RSA_KEY_TABLES */
+
 #else /* MCUBOOT_USE_PSA_CRYPTO */
 
 static fih_ret
@@ -285,6 +335,20 @@ bootutil_verify_sig(uint8_t *hash, uint32_t hlen, uint8_t *sig, size_t slen,
 
     BOOT_LOG_DBG("bootutil_verify_sig: RSA key_id %d", key_id);
 
+#if defined(MCUBOOT_RSA_KEY_TABLES)
+    {
+        bool no_table;
+
+        FIH_CALL(bootutil_cmp_rsasig_table, fih_rc, key_id, hash, hlen, sig, slen,
+                 &no_table);
+        if (!no_table) {
+            FIH_RET(fih_rc);
+        }
+        /* No table for this key, or a stale one. */
+        BOOT_LOG_DBG("bootutil_verify_sig: no key table for key_id %d", key_id);
+    }
+#endif
+
     bootutil_rsa_init(&ctx);
 
     cp = (uint8_t *)bootutil_keys[key_id].key;
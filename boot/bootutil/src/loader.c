@@ -50,6 +50,8 @@
 #include "bootutil/boot_hooks.h"
 #include "bootutil/mcuboot_status.h"
 #include "bootutil_loader.h"
+#include "bootutil_depends.h"
+#include "bootutil_scratch.h"
 #ifdef CONFIG_NCS_MCUBOOT_LCS_AWARE
 #include <nrf_lcs/nrf_lcs.h>
 #endif
@@ -130,23 +132,6 @@ static struct image_max_size image_max_sizes[BOOT_IMAGE_NUMBER] = {0};
 #warning MCUBOOT_CHECK_HEADER_LOAD_ADDRESS takes precedence over MCUBOOT_VERIFY_IMG_ADDRESS
 #endif
 
-#if (!defined(MCUBOOT_DIRECT_XIP) && !defined(MCUBOOT_RAM_LOAD)) || \
-defined(MCUBOOT_SERIAL_IMG_GRP_SLOT_INFO)
-#if !defined(__BOOTSIM__)
-/* Used for holding static buffers in multiple functions to work around issues
- * in older versions of gcc (e.g. 4.8.4)
- */
-struct sector_buffer_t {
-    boot_sector_t primary[BOOT_IMAGE_NUMBER][BOOT_MAX_IMG_SECTORS];
-    boot_sector_t secondary[BOOT_IMAGE_NUMBER][BOOT_MAX_IMG_SECTORS];
-#if MCUBOOT_SWAP_USING_SCRATCH
-    boot_sector_t scratch[BOOT_MAX_IMG_SECTORS];
-#endif
-};
-
-#endif
-#endif
-
 #if defined(MCUBOOT_IS_SECOND_STAGE) && defined(MCUBOOT_OVERWRITE_ONLY) && \
     defined(MCUBOOT_DOWNGRADE_PREVENTION)
 /* s0/s1 package version of the current MCUboot image */
@@ -161,11 +146,6 @@ static const struct image_version mcuboot_s0_s1_image_version = {
 /* Valid only for ARM Cortext M */
 #define RESET_OFFSET sizeof(uint32_t)
 
-#if BOOT_MAX_ALIGN > 1024
-#define BUF_SZ BOOT_MAX_ALIGN
-#else
-#define BUF_SZ 1024
-#endif
 
 #if defined(MCUBOOT_SWAP_USING_OFFSET) && defined(MCUBOOT_ENC_IMAGES)
 #define BOOT_COPY_REGION(state, fap_pri, fap_sec, pri_off, sec_off, sz, sector_off) \
@@ -225,114 +205,39 @@ fill_rsp(struct boot_loader_state *state, struct boot_rsp *rsp)
 
 #if (BOOT_IMAGE_NUMBER > 1)
 
-static int
-boot_verify_slot_dependencies(struct boot_loader_state *state, uint32_t slot);
-
+#if !defined(MCUBOOT_DIRECT_XIP) && !defined(MCUBOOT_RAM_LOAD)
 /**
- * Check the image dependency whether it is satisfied and modify
- * the swap type if necessary.
+ * Read the dependencies of all the images, update the swap types until they
+ * are satisfied, and determine the order in which to perform the updates.
  *
- * @param dep               Image dependency which has to be verified.
+ * @param order             Filled with the image indexes, dependencies first.
  *
- * @return                  0 on success; nonzero on failure.
+ * @return                  0 on success; nonzero if the dependencies couldn't
+ *                          be read, in which case all upgrades are disabled.
  */
 static int
-boot_verify_slot_dependency(struct boot_loader_state *state,
-                            struct image_dependency *dep)
+boot_verify_dependencies(struct boot_loader_state *state, uint8_t *order)
 {
-    struct image_version *dep_version;
-    size_t dep_slot;
+    TARGET_STATIC struct boot_deps deps;
     int rc;
 
-    /* Determine the source of the image which is the subject of
-     * the dependency and get it's version. */
-#if !defined(MCUBOOT_DIRECT_XIP) && !defined(MCUBOOT_RAM_LOAD)
-    uint8_t swap_type = state->swap_type[dep->image_id];
-    dep_slot = BOOT_IS_UPGRADE(swap_type) ? BOOT_SLOT_SECONDARY
-                                          : BOOT_SLOT_PRIMARY;
-#else
-    dep_slot = state->slot_usage[dep->image_id].active_slot;
-#endif
-
-    dep_version = &state->imgs[dep->image_id][dep_slot].hdr.ih_ver;
+    boot_deps_setup(state, &deps);
 
-    rc = boot_compare_version(dep_version, &dep->image_min_version);
-#if !defined(MCUBOOT_DIRECT_XIP) && !defined(MCUBOOT_RAM_LOAD)
-    if (rc < 0) {
-        /* Dependency not satisfied.
-         * Modify the swap type to decrease the version number of the image
-         * (which will be located in the primary slot after the boot process),
-         * consequently the number of unsatisfied dependencies will be
-         * decreased or remain the same.
+    rc = boot_deps_read(state, &deps);
+    if (rc != 0) {
+        /* Cannot tell whether the dependencies are met, so disable all
+         * image upgrades.
          */
-        switch (BOOT_SWAP_TYPE(state)) {
-        case BOOT_SWAP_TYPE_TEST:
-        case BOOT_SWAP_TYPE_PERM:
+        BOOT_LOG_DBG("boot_verify_dependencies: error %d reading dependencies", rc);
+        IMAGES_ITER(BOOT_CURR_IMG(state)) {
             BOOT_SWAP_TYPE(state) = BOOT_SWAP_TYPE_NONE;
-            break;
-        case BOOT_SWAP_TYPE_NONE:
-            BOOT_SWAP_TYPE(state) = BOOT_SWAP_TYPE_REVERT;
-            break;
-        default:
-            break;
         }
-    } else {
-        /* Dependency satisfied. */
-        rc = 0;
-    }
-#else
-  if (rc >= 0) {
-        /* Dependency satisfied. */
-        rc = 0;
+        return rc;
     }
-#endif
-
-    return rc;
-}
-
-#if !defined(MCUBOOT_DIRECT_XIP) && !defined(MCUBOOT_RAM_LOAD)
-/**
- * Iterate over all the images and verify whether the image dependencies in the
- * TLV area are all satisfied and update the related swap type if necessary.
- */
-static int
-boot_verify_dependencies(struct boot_loader_state *state)
-{
-    int rc = -1;
-    uint8_t slot;
 
-    BOOT_CURR_IMG(state) = 0;
-    while (BOOT_CURR_IMG(state) < BOOT_IMAGE_NUMBER) {
-        if (state->img_mask[BOOT_CURR_IMG(state)]) {
-            BOOT_CURR_IMG(state)++;
-            continue;
-        }
-        if (BOOT_SWAP_TYPE(state) != BOOT_SWAP_TYPE_NONE &&
-            BOOT_SWAP_TYPE(state) != BOOT_SWAP_TYPE_FAIL) {
-            slot = BOOT_SLOT_SECONDARY;
-        } else {
-            slot = BOOT_SLOT_PRIMARY;
-        }
+    boot_deps_solve(&deps, state->swap_type, order);
 
-        rc = boot_verify_slot_dependencies(state, slot);
-        if (rc == 0) {
-            /* All dependencies've been satisfied, continue with next image. */
-            BOOT_CURR_IMG(state)++;
-        } else if (rc == BOOT_EBADIMAGE) {
-            /* Cannot upgrade due to non-met dependencies, so disable all
-             * image upgrades.
-             */
-            for (int idx = 0; idx < BOOT_IMAGE_NUMBER; idx++) {
-                BOOT_CURR_IMG(state) = idx;
-                BOOT_SWAP_TYPE(state) = BOOT_SWAP_TYPE_NONE;
-            }
-            break;
-        } else {
-		/* Other error happened, images are inconsistent */
-		return rc;
-	}
-    }
-    return rc;
+    return 0;
 }
 #else
 
@@ -342,21 +247,33 @@ boot_verify_dependencies(struct boot_loader_state *state)
  * case of MCUBOOT_RAM_LOAD strategy) and its slot is set to unavailable.
  *
  * @param  state        Boot loader status information.
+ * @param  deps         Dependencies read so far, kept across the calls made
+ *                      for the same boot.
  *
  * @return              0 if dependencies are met; nonzero otherwise.
  */
 static int
-boot_verify_dependencies(struct boot_loader_state *state)
+boot_verify_dependencies(struct boot_loader_state *state, struct boot_deps *deps)
 {
-    int rc = -1;
+    uint8_t active_slots[BOOT_IMAGE_NUMBER];
     uint32_t active_slot;
+    int rc = -1;
+
+    IMAGES_ITER(BOOT_CURR_IMG(state)) {
+        active_slots[BOOT_CURR_IMG(state)] =
+            (uint8_t)state->slot_usage[BOOT_CURR_IMG(state)].active_slot;
+    }
 
     IMAGES_ITER(BOOT_CURR_IMG(state)) {
         if (state->img_mask[BOOT_CURR_IMG(state)]) {
             continue;
         }
         active_slot = state->slot_usage[BOOT_CURR_IMG(state)].active_slot;
-        rc = boot_verify_slot_dependencies(state, active_slot);
+        rc = boot_deps_read_slot(state, deps, BOOT_CURR_IMG(state), active_slot);
+        if (rc == 0 && !boot_deps_satisfied(deps, BOOT_CURR_IMG(state), active_slot,
+                                            active_slots)) {
+            rc = -1;
+        }
         if (rc != 0) {
             /* Dependencies not met or invalid dependencies. */
 
@@ -375,79 +292,6 @@ boot_verify_dependencies(struct boot_loader_state *state)
 }
 #endif
 
-/**
- * Read all dependency TLVs of an image from the flash and verify
- * one after another to see if they are all satisfied.
- *
- * @param slot              Image slot number.
- *
- * @return                  0 on success; nonzero on failure.
- */
-static int
-boot_verify_slot_dependencies(struct boot_loader_state *state, uint32_t slot)
-{
-    const struct flash_area *fap;
-    struct image_tlv_iter it;
-    struct image_dependency dep;
-    uint32_t off;
-    uint16_t len;
-    int rc;
-
-    fap = BOOT_IMG_AREA(state, slot);
-    assert(fap != NULL);
-
-    BOOT_LOG_DBG("boot_verify_slot_dependencies");
-#if defined(MCUBOOT_SWAP_USING_OFFSET)
-    it.start_off = boot_get_state_secondary_offset(state, fap);
-#endif
-
-    rc = bootutil_tlv_iter_begin(&it, boot_img_hdr(state, slot), fap,
-            IMAGE_TLV_DEPENDENCY, true);
-    if (rc != 0) {
-        goto done;
-    }
-
-    while (true) {
-        rc = bootutil_tlv_iter_next(&it, &off, &len, NULL);
-        if (rc < 0) {
-            return -1;
-        } else if (rc > 0) {
-            rc = 0;
-            break;
-        }
-
-        if (len != sizeof(dep)) {
-            rc = BOOT_EBADIMAGE;
-            goto done;
-        }
-
-        rc = LOAD_IMAGE_DATA(boot_img_hdr(state, slot),
-                             fap, off, &dep, len);
-        if (rc != 0) {
-            BOOT_LOG_DBG("boot_verify_slot_dependencies: error %d reading dependency %p %d %d",
-                         rc, fap, off, len);
-            rc = BOOT_EFLASH;
-            goto done;
-        }
-
-        if (dep.image_id >= BOOT_IMAGE_NUMBER) {
-            rc = BOOT_EBADARGS;
-            goto done;
-        }
-
-        /* Verify dependency and modify the swap type if not satisfied. */
-        rc = boot_verify_slot_dependency(state, &dep);
-        if (rc != 0) {
-            BOOT_LOG_DBG("boot_verify_slot_dependencies: not satisfied");
-            /* Dependency not satisfied */
-            goto done;
-        }
-    }
-
-done:
-    return rc;
-}
-
 #endif /* (BOOT_IMAGE_NUMBER > 1) */
 
 #if !defined(MCUBOOT_DIRECT_XIP)
@@ -507,6 +351,10 @@ boot_write_status(const struct boot_loader_state *state, struct boot_status *bs)
     uint8_t buf[BOOT_MAX_ALIGN];
     uint32_t align;
     uint8_t erased_val;
+#ifdef MCUBOOT_SWAP_STATUS_PACKED
+    uint32_t entry;
+    uint32_t byte;
+#endif
 
     /* NOTE: The first sector copied (that is the last sector on slot) contains
      *       the trailer. Since in the last step the primary slot is erased, the
@@ -526,12 +374,26 @@ boot_write_status(const struct boot_loader_state *state, struct boot_status *bs)
     }
 #endif
 
-    off = boot_status_off(fap) +
-          boot_status_internal_off(bs, BOOT_WRITE_SZ(state));
     align = flash_area_align(fap);
     erased_val = flash_area_erased_val(fap);
     memset(buf, erased_val, BOOT_MAX_ALIGN);
+
+#ifdef MCUBOOT_SWAP_STATUS_PACKED
+    /* The states are recorded in order, and only the last one is looked at
+     * when resuming, so the write unit of the new state is programmed with
+     * the bits of all the states before it in the unit as well: they are
+     * already set, or don't matter, and the unit needn't be read back.
+     */
+    entry = boot_status_internal_off(bs, 1);
+    byte = (entry / 8) % align;
+    off = boot_status_off(fap) + ALIGN_DOWN(entry / 8, align);
+    memset(buf, (uint8_t)~erased_val, byte);
+    buf[byte] = erased_val ^ (uint8_t)((2 << (entry % 8)) - 1);
+#else
+    off = boot_status_off(fap) +
+          boot_status_internal_off(bs, BOOT_WRITE_SZ(state));
     buf[0] = bs->state;
+#endif
 
     BOOT_LOG_DBG("writing swap status; fa_id=%d off=0x%lx (0x%lx)",
                  flash_area_get_id(fap), (unsigned long)off,
@@ -554,28 +416,28 @@ split_image_check(struct image_header *app_hdr,
                   struct image_header *loader_hdr,
                   const struct flash_area *loader_fap)
 {
-    static void *tmpbuf;
+    uint8_t *tmpbuf;
+    size_t tmpbuf_sz;
     uint8_t loader_hash[32];
     FIH_DECLARE(fih_rc, FIH_FAILURE);
 
-    if (!tmpbuf) {
-        tmpbuf = malloc(BOOT_TMPBUF_SZ);
-        if (!tmpbuf) {
-            goto out;
-        }
+    tmpbuf = boot_scratch_begin(BOOT_SCRATCH_VALIDATE, &tmpbuf_sz);
+    if (tmpbuf == NULL) {
+        FIH_RET(fih_rc);
     }
 
     FIH_CALL(bootutil_img_validate, fih_rc, NULL, loader_hdr, loader_fap,
-             tmpbuf, BOOT_TMPBUF_SZ, NULL, 0, loader_hash);
+             tmpbuf, tmpbuf_sz, NULL, 0, loader_hash);
 
     if (FIH_NOT_EQ(fih_rc, FIH_SUCCESS)) {
-        FIH_RET(fih_rc);
+        goto out;
     }
 
     FIH_CALL(bootutil_img_validate, fih_rc, NULL, app_hdr, app_fap,
-             tmpbuf, BOOT_TMPBUF_SZ, loader_hash, 32, NULL);
+             tmpbuf, tmpbuf_sz, loader_hash, 32, NULL);
 
 out:
+    boot_scratch_end(BOOT_SCRATCH_VALIDATE);
     FIH_RET(fih_rc);
 }
 #endif /* !MCUBOOT_DIRECT_XIP && !MCUBOOT_RAM_LOAD */
@@ -1488,7 +1350,8 @@ boot_copy_region(struct boot_loader_state *state,
     struct image_header *hdr;
 #endif
 
-    TARGET_STATIC uint8_t buf[BUF_SZ] __attribute__((aligned(4)));
+    uint8_t *buf;
+    size_t buf_sz;
 
 #ifdef MCUBOOT_ENC_IMAGES
     encrypted_src = (flash_area_get_id(fap_src) != FLASH_AREA_IMAGE_PRIMARY(image_index));
@@ -1512,27 +1375,38 @@ boot_copy_region(struct boot_loader_state *state,
     }
 #endif
 
+    buf = boot_scratch_begin(BOOT_SCRATCH_COPY, &buf_sz);
+    if (buf == NULL) {
+        return BOOT_ENOMEM;
+    }
+
 #ifdef MCUBOOT_DECOMPRESS_IMAGES
     hdr = boot_img_hdr(state, BOOT_SLOT_SECONDARY);
 
     if (MUST_DECOMPRESS(fap_src, BOOT_CURR_IMG(state), hdr)) {
         /* Use alternative function for compressed images */
-        return boot_copy_region_decompress(state, fap_src, fap_dst, off_src, off_dst, sz, buf,
-                                           BUF_SZ);
+        rc = boot_copy_region_decompress(state, fap_src, fap_dst, off_src, off_dst, sz, buf,
+                                         buf_sz);
+        goto out;
     }
 #endif
 
+    rc = 0;
     bytes_copied = 0;
     while (bytes_copied < sz) {
-        if (sz - bytes_copied > sizeof buf) {
-            chunk_sz = sizeof buf;
-        } else {
+        /* Keep the program operations aligned to the buffer size within the
+         * destination, so that with a page-multiple buffer each write covers
+         * whole pages. Only the first chunk can be shorter because of this.
+         */
+        chunk_sz = buf_sz - ((off_dst + bytes_copied) % buf_sz);
+        if (sz - bytes_copied < (uint32_t)chunk_sz) {
             chunk_sz = sz - bytes_copied;
         }
 
         rc = flash_area_read(fap_src, off_src + bytes_copied, buf, chunk_sz);
         if (rc != 0) {
-            return BOOT_EFLASH;
+            rc = BOOT_EFLASH;
+            goto out;
         }
 
 #ifdef MCUBOOT_ENC_IMAGES
@@ -1587,7 +1461,8 @@ boot_copy_region(struct boot_loader_state *state,
 
         rc = flash_area_write(fap_dst, off_dst + bytes_copied, buf, chunk_sz);
         if (rc != 0) {
-            return BOOT_EFLASH;
+            rc = BOOT_EFLASH;
+            goto out;
         }
 
         bytes_copied += chunk_sz;
@@ -1595,7 +1470,9 @@ boot_copy_region(struct boot_loader_state *state,
         MCUBOOT_WATCHDOG_FEED();
     }
 
-    return 0;
+out:
+    boot_scratch_end(BOOT_SCRATCH_COPY);
+    return rc;
 }
 
 /**
@@ -1671,12 +1548,11 @@ boot_copy_image(struct boot_loader_state *state, struct boot_status *bs)
 #if defined(MCUBOOT_OVERWRITE_ONLY_FAST)
     trailer_sz = boot_trailer_sz(BOOT_WRITE_SZ(state));
     sector = boot_img_num_sectors(state, BOOT_SLOT_PRIMARY) - 1;
-    sz = 0;
-    do {
-        sz += boot_img_sector_size(state, BOOT_SLOT_PRIMARY, sector);
-        off = boot_img_sector_off(state, BOOT_SLOT_PRIMARY, sector);
-        sector--;
-    } while (sz < trailer_sz);
+    sz = boot_img_sector_off(state, BOOT_SLOT_PRIMARY, sector) +
+         boot_img_sector_size(state, BOOT_SLOT_PRIMARY, sector);
+    sector = boot_img_sector_index(state, BOOT_SLOT_PRIMARY, sz - trailer_sz);
+    off = boot_img_sector_off(state, BOOT_SLOT_PRIMARY, sector);
+    sz -= off;
 
     rc = boot_erase_region(fap_primary_slot, off, sz, false);
     assert(rc == 0);
@@ -1764,6 +1640,44 @@ boot_copy_image(struct boot_loader_state *state, struct boot_status *bs)
 #endif
 
 #if !defined(MCUBOOT_OVERWRITE_ONLY)
+#if defined(MCUBOOT_SKIP_PRE_ERASED)
+/*
+ * Takes over the range which the application erased ahead of the swap, as
+ * recorded by boot_pre_erase_multi().  The record is voided before the range
+ * is used, so that a swap resumed after a reset erases it again.
+ */
+static void
+boot_take_pre_erased(struct boot_loader_state *state)
+{
+    const struct flash_area *fap_sec = BOOT_IMG_AREA(state, BOOT_SLOT_SECONDARY);
+#if defined(MCUBOOT_SWAP_USING_SCRATCH)
+    const struct flash_area *fap_erased = state->scratch.area;
+#else
+    const struct flash_area *fap_erased = fap_sec;
+#endif
+    struct boot_pre_erased rec;
+
+    if (boot_read_pre_erased(fap_sec, &rec) != 0) {
+        return;
+    }
+
+    if (rec.fa_id != flash_area_get_id(fap_erased) || rec.off != 0 ||
+        rec.size > flash_area_get_size(fap_erased)) {
+        BOOT_LOG_WRN("Ignoring pre-erased range 0x%x of 0x%x in fa_id=%d",
+                     (unsigned int)rec.off, (unsigned int)rec.size, rec.fa_id);
+        return;
+    }
+
+    if (boot_clear_pre_erased(fap_sec) != 0) {
+        return;
+    }
+
+    BOOT_LOG_DBG("Pre-erased range 0x%x of 0x%x in fa_id=%d",
+                 (unsigned int)rec.off, (unsigned int)rec.size, rec.fa_id);
+    boot_set_pre_erased(rec.fa_id, rec.off, rec.size);
+}
+#endif
+
 /**
  * Swaps the two images in flash.  If a prior copy operation was interrupted
  * by a system reset, this function completes that operation.
@@ -1860,6 +1774,10 @@ boot_swap_image(struct boot_loader_state *state, struct boot_status *bs)
         }
 
         bs->swap_size = copy_size;
+
+#if defined(MCUBOOT_SKIP_PRE_ERASED)
+        boot_take_pre_erased(state);
+#endif
     } else {
         /*
          * If a swap was under way, the swap_size should already be present
@@ -1878,7 +1796,7 @@ boot_swap_image(struct boot_loader_state *state, struct boot_status *bs)
 
             boot_enc_init(BOOT_CURR_ENC_SLOT(state, slot));
 
-            rc = boot_read_enc_key(fap, slot, bs);
+            rc = boot_read_enc_key(state, fap, slot, bs);
             assert(rc == 0);
 
             for (i = 0; i < BOOT_ENC_KEY_SIZE; i++) {
@@ -1913,6 +1831,10 @@ boot_swap_image(struct boot_loader_state *state, struct boot_status *bs)
     }
 #endif
 
+#if defined(MCUBOOT_SKIP_PRE_ERASED)
+    boot_set_pre_erased(0, 0, 0);
+#endif
+
 #ifdef MCUBOOT_VALIDATE_PRIMARY_SLOT
     extern int boot_status_fails;
     if (boot_status_fails > 0) {
@@ -2437,6 +2359,10 @@ context_boot_go(struct boot_loader_state *state, struct boot_rsp *rsp)
     FIH_DECLARE(fih_rc, FIH_FAILURE);
     bool has_upgrade;
     volatile int fih_cnt;
+#if (BOOT_IMAGE_NUMBER > 1)
+    uint8_t update_order[BOOT_IMAGE_NUMBER];
+    uint8_t update_idx;
+#endif
 
     BOOT_LOG_DBG("context_boot_go");
 
@@ -2445,10 +2371,20 @@ context_boot_go(struct boot_loader_state *state, struct boot_rsp *rsp)
     sectors = &sector_buf;
 #endif
 
+    /* The previous boot may have been interrupted while copying. */
+    boot_scratch_reset();
+#if defined(MCUBOOT_SKIP_PRE_ERASED)
+    boot_set_pre_erased(0, 0, 0);
+#endif
+
     has_upgrade = false;
 
 #if (BOOT_IMAGE_NUMBER == 1)
     (void)has_upgrade;
+#else
+    IMAGES_ITER(update_idx) {
+        update_order[update_idx] = update_idx;
+    }
 #endif
 
     /* Open primary and secondary image areas for the duration
@@ -2473,7 +2409,7 @@ context_boot_go(struct boot_loader_state *state, struct boot_rsp *rsp)
 #if defined(MCUBOOT_ENC_IMAGES) && (BOOT_IMAGE_NUMBER > 1)
         /* The keys used for encryption may no longer be valid (could belong to
          * another images). Therefore, mark them as invalid to force their reload
-         * by boot_enc_load().
+         * by boot_enc_load(). The reload is served from the key cache.
          */
         boot_enc_zeroize(BOOT_CURR_ENC(state));
 #endif
@@ -2504,10 +2440,10 @@ context_boot_go(struct boot_loader_state *state, struct boot_rsp *rsp)
 
 #if (BOOT_IMAGE_NUMBER > 1)
     if (has_upgrade) {
-        /* Iterate over all the images and verify whether the image dependencies
-         * are all satisfied and update swap type if necessary.
+        /* Verify whether the image dependencies are all satisfied, update the
+         * swap types if necessary and get the order of the updates.
          */
-        rc = boot_verify_dependencies(state);
+        rc = boot_verify_dependencies(state, update_order);
         if (rc != 0) {
             /*
              * It was impossible to upgrade because the expected dependency version
@@ -2527,10 +2463,14 @@ context_boot_go(struct boot_loader_state *state, struct boot_rsp *rsp)
 
     /* Iterate over all the images. At this point there are no aborted swaps
      * and the swap types are determined for each image. By the end of the loop
-     * all required update operations will have been finished.
+     * all required update operations will have been finished. The images are
+     * updated in dependency order, so that an image is only updated once the
+     * images it depends on are.
      */
-    IMAGES_ITER(BOOT_CURR_IMG(state)) {
+    IMAGES_ITER(update_idx) {
 #if (BOOT_IMAGE_NUMBER > 1)
+        BOOT_CURR_IMG(state) = update_order[update_idx];
+
         if (state->img_mask[BOOT_CURR_IMG(state)]) {
             continue;
         }
@@ -2538,7 +2478,7 @@ context_boot_go(struct boot_loader_state *state, struct boot_rsp *rsp)
 #ifdef MCUBOOT_ENC_IMAGES
         /* The keys used for encryption may no longer be valid (could belong to
          * another images). Therefore, mark them as invalid to force their reload
-         * by boot_enc_load().
+         * by boot_enc_load(). The reload is served from the key cache.
          */
         boot_enc_zeroize(BOOT_CURR_ENC(state));
 #endif /* MCUBOOT_ENC_IMAGES */
@@ -2730,6 +2670,9 @@ out:
 #else
     memset(&bs, 0, sizeof(struct boot_status));
 #endif
+#ifdef MCUBOOT_ENC_IMAGES
+    boot_enc_cache_zeroize(state);
+#endif
 
     boot_close_all_flash_areas(state);
     FIH_RET(fih_rc);
@@ -3016,6 +2959,10 @@ boot_select_or_erase(struct boot_loader_state *state)
 /**
  * Tries to load a slot for all the images with validation.
  *
+ * Slots are ordered using only their headers (and trailers, in revert mode),
+ * and only the selected slot is hashed and verified. The next candidate is
+ * only validated if the selected one turns out to be unusable.
+ *
  * @param  state        Boot loader status information.
  *
  * @return              0 on success; nonzero on failure.
@@ -3173,6 +3120,11 @@ context_boot_go(struct boot_loader_state *state, struct boot_rsp *rsp)
 {
     int rc;
     FIH_DECLARE(fih_rc, FIH_FAILURE);
+#if (BOOT_IMAGE_NUMBER > 1)
+    TARGET_STATIC struct boot_deps deps;
+#endif
+
+    boot_scratch_reset();
 
     rc = boot_open_all_flash_areas(state);
     if (rc != 0) {
@@ -3185,6 +3137,11 @@ context_boot_go(struct boot_loader_state *state, struct boot_rsp *rsp)
     }
 
 #if (BOOT_IMAGE_NUMBER > 1)
+    /* The dependencies of a slot are read at most once, however many times
+     * another slot has to be tried.
+     */
+    boot_deps_setup(state, &deps);
+
     while (true) {
 #endif
         FIH_CALL(boot_load_and_validate_images, fih_rc, state);
@@ -3194,7 +3151,7 @@ context_boot_go(struct boot_loader_state *state, struct boot_rsp *rsp)
         }
 
 #if (BOOT_IMAGE_NUMBER > 1)
-        rc = boot_verify_dependencies(state);
+        rc = boot_verify_dependencies(state, &deps);
         if (rc != 0) {
             /* Dependency check failed for an image, it has been removed from
              * SRAM in case of MCUBOOT_RAM_LOAD strategy, and set to
@@ -3250,6 +3207,9 @@ close:
     boot_close_all_flash_areas(state);
 
 out:
+#ifdef MCUBOOT_ENC_IMAGES
+    boot_enc_cache_zeroize(state);
+#endif
     if (rc != 0) {
         FIH_SET(fih_rc, FIH_FAILURE);
     }
@@ -79,11 +79,6 @@ static struct boot_loader_state boot_data;
 static struct image_max_size image_max_sizes[BOOT_IMAGE_NUMBER] = {0};
 #endif
 
-#if BOOT_MAX_ALIGN > 1024
-#define BUF_SZ BOOT_MAX_ALIGN
-#else
-#define BUF_SZ 1024
-#endif
 
 struct boot_loader_state *boot_get_loader_state(void)
 {
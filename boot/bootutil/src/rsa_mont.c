@@ -0,0 +1,336 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright (c) 2026 Linaro LTD
+ */
+
+#include "mcuboot_config/mcuboot_config.h"
+
+#if defined(MCUBOOT_RSA_KEY_TABLES)
+
+#include <string.h>
+
+#include "mbedtls/asn1.h"
+
+#include "bootutil/crypto/rsa_mont.h"
+
+/*
+ * Use 64-bit limbs where the compiler has a 128-bit type to multiply them,
+ * 32-bit ones otherwise.  R is the same either way, as the modulus is a
+ * multiple of 64 bits.
+ */
+#if defined(__SIZEOF_INT128__) && (UINTPTR_MAX > 0xffffffffu)
+typedef uint64_t rsa_limb_t;
+typedef unsigned __int128 rsa_dlimb_t;
+#else
+typedef uint32_t rsa_limb_t;
+typedef uint64_t rsa_dlimb_t;
+#endif
+
+#define LIMB_BYTES  sizeof(rsa_limb_t)
+#define LIMB_BITS   (8 * LIMB_BYTES)
+#define MONT_LIMBS  ((int)(BOOTUTIL_RSA_MONT_LEN / LIMB_BYTES))
+
+#if (MCUBOOT_SIGN_RSA_LEN % 64) != 0
+#error "MCUBOOT_RSA_KEY_TABLES requires a modulus size multiple of 64 bits"
+#endif
+
+/* Public exponent supported by the tables: 65537. */
+static const uint8_t rsa_mont_e[] = { 0x01, 0x00, 0x01 };
+
+/* Load a little-endian integer of BOOTUTIL_RSA_MONT_LEN bytes. */
+static void
+rsa_mont_load_le(rsa_limb_t *r, const uint8_t *p)
+{
+    size_t i;
+
+    memset(r, 0, MONT_LIMBS * LIMB_BYTES);
+    for (i = 0; i < BOOTUTIL_RSA_MONT_LEN; i++) {
+        r[i / LIMB_BYTES] |= (rsa_limb_t)p[i] << (8 * (i % LIMB_BYTES));
+    }
+}
+
+/* Load a big-endian integer of BOOTUTIL_RSA_MONT_LEN bytes. */
+static void
+rsa_mont_load_be(rsa_limb_t *r, const uint8_t *p)
+{
+    size_t i;
+
+    memset(r, 0, MONT_LIMBS * LIMB_BYTES);
+    for (i = 0; i < BOOTUTIL_RSA_MONT_LEN; i++) {
+        r[i / LIMB_BYTES] |= (rsa_limb_t)p[BOOTUTIL_RSA_MONT_LEN - 1 - i] <<
+                             (8 * (i % LIMB_BYTES));
+    }
+}
+
+static void
+rsa_mont_store_be(uint8_t *p, const rsa_limb_t *a)
+{
+    size_t i;
+
+    for (i = 0; i < BOOTUTIL_RSA_MONT_LEN; i++) {
+        p[BOOTUTIL_RSA_MONT_LEN - 1 - i] = (uint8_t)(a[i / LIMB_BYTES] >>
+                                                     (8 * (i % LIMB_BYTES)));
+    }
+}
+
+/* Returns 1 if a >= n, where a has an extra top limb. */
+static int
+rsa_mont_geq(const rsa_limb_t *a, rsa_limb_t top, const rsa_limb_t *n)
+{
+    int i;
+
+    if (top != 0) {
+        return 1;
+    }
+
+    for (i = MONT_LIMBS - 1; i >= 0; i--) {
+        if (a[i] != n[i]) {
+            return a[i] > n[i];
+        }
+    }
+
+    return 1;
+}
+
+static void
+rsa_mont_sub(rsa_limb_t *a, const rsa_limb_t *n)
+{
+    rsa_dlimb_t borrow = 0;
+    rsa_dlimb_t d;
+    int i;
+
+    for (i = 0; i < MONT_LIMBS; i++) {
+        d = (rsa_dlimb_t)a[i] - n[i] - borrow;
+        a[i] = (rsa_limb_t)d;
+        borrow = (d >> LIMB_BITS) & 1;
+    }
+}
+
+/*
+ * r = a * b * R^-1 mod n, with a, b < n.  The result is only written once
+ * the inputs are no longer needed, so r may alias either of them.  This
+ * only deals with public values, so it doesn't need to run in constant time.
+ */
+static void
+rsa_mont_mul(rsa_limb_t *r, const rsa_limb_t *a, const rsa_limb_t *b, const rsa_limb_t *n,
+             rsa_limb_t n0inv)
+{
+    rsa_limb_t t[MONT_LIMBS + 1];
+    rsa_dlimb_t c1;
+    rsa_dlimb_t c2;
+    rsa_limb_t m;
+    int i;
+    int j;
+
+    memset(t, 0, sizeof(t));
+
+    for (i = 0; i < MONT_LIMBS; i++) {
+        /*
+         * t = (t + a * b[i] + m * n) / 2^LIMB_BITS, where m clears the low
+         * limb, both products being accumulated in the same pass.
+         */
+        c1 = (rsa_dlimb_t)a[0] * b[i] + t[0];
+        m = (rsa_limb_t)c1 * n0inv;
+        c2 = ((rsa_dlimb_t)m * n[0] + (rsa_limb_t)c1) >> LIMB_BITS;
+        c1 >>= LIMB_BITS;
+        for (j = 1; j < MONT_LIMBS; j++) {
+            c1 += (rsa_dlimb_t)a[j] * b[i] + t[j];
+            c2 += (rsa_dlimb_t)m * n[j] + (rsa_limb_t)c1;
+            t[j - 1] = (rsa_limb_t)c2;
+            c1 >>= LIMB_BITS;
+            c2 >>= LIMB_BITS;
+        }
+        c1 += c2 + t[MONT_LIMBS];
+        t[MONT_LIMBS - 1] = (rsa_limb_t)c1;
+        t[MONT_LIMBS] = (rsa_limb_t)(c1 >> LIMB_BITS);
+    }
+
+    /* t < 2n at this point. */
+    if (rsa_mont_geq(t, t[MONT_LIMBS], n)) {
+        rsa_mont_sub(t, n);
+    }
+
+    memcpy(r, t, MONT_LIMBS * sizeof(rsa_limb_t));
+}
+
+/*
+ * r = a^2 * R^-1 mod n, with a < n.  Each cross product is only computed
+ * once, which makes this about a quarter faster than rsa_mont_mul(), and
+ * all but one of the multiplications for e = 65537 are squarings.
+ */
+static void
+rsa_mont_sqr(rsa_limb_t *r, const rsa_limb_t *a, const rsa_limb_t *n, rsa_limb_t n0inv)
+{
+    rsa_limb_t t[2 * MONT_LIMBS];
+    rsa_limb_t top;
+    rsa_dlimb_t c;
+    rsa_limb_t m;
+    int i;
+    int j;
+
+    memset(t, 0, sizeof(t));
+
+    /* Sum of a[i] * a[j] for i < j. */
+    for (i = 0; i < MONT_LIMBS - 1; i++) {
+        c = 0;
+        for (j = i + 1; j < MONT_LIMBS; j++) {
+            c += (rsa_dlimb_t)a[i] * a[j] + t[i + j];
+            t[i + j] = (rsa_limb_t)c;
+            c >>= LIMB_BITS;
+        }
+        t[i + MONT_LIMBS] = (rsa_limb_t)c;
+    }
+
+    /* Double it and add the squares. */
+    top = 0;
+    for (i = 0; i < 2 * MONT_LIMBS; i++) {
+        m = t[i] >> (LIMB_BITS - 1);
+        t[i] = (t[i] << 1) | top;
+        top = m;
+    }
+    c = 0;
+    for (i = 0; i < MONT_LIMBS; i++) {
+        c += (rsa_dlimb_t)a[i] * a[i] + t[2 * i];
+        t[2 * i] = (rsa_limb_t)c;
+        c >>= LIMB_BITS;
+        c += t[2 * i + 1];
+        t[2 * i + 1] = (rsa_limb_t)c;
+        c >>= LIMB_BITS;
+    }
+
+    /* Montgomery reduction, one limb at a time. */
+    top = 0;
+    for (i = 0; i < MONT_LIMBS; i++) {
+        m = t[i] * n0inv;
+        c = 0;
+        for (j = 0; j < MONT_LIMBS; j++) {
+            c += (rsa_dlimb_t)m * n[j] + t[i + j];
+            t[i + j] = (rsa_limb_t)c;
+            c >>= LIMB_BITS;
+        }
+        c += (rsa_dlimb_t)t[i + MONT_LIMBS] + top;
+        t[i + MONT_LIMBS] = (rsa_limb_t)c;
+        top = (rsa_limb_t)(c >> LIMB_BITS);
+    }
+
+    /* The result, in the top half of t, is below 2n. */
+    if (rsa_mont_geq(&t[MONT_LIMBS], top, n)) {
+        rsa_mont_sub(&t[MONT_LIMBS], n);
+    }
+
+    memcpy(r, &t[MONT_LIMBS], MONT_LIMBS * sizeof(rsa_limb_t));
+}
+
+/*
+ * Check that the table holds the modulus of the DER encoded key, and that
+ * the public exponent of the key is 65537.
+ */
+static int
+rsa_mont_check_key(const uint8_t *key, size_t key_len, const uint8_t *table)
+{
+    uint8_t *p = (uint8_t *)key;
+    uint8_t *end = p + key_len;
+    size_t len;
+    size_t i;
+
+    if (mbedtls_asn1_get_tag(&p, end, &len,
+                             MBEDTLS_ASN1_CONSTRUCTED | MBEDTLS_ASN1_SEQUENCE) != 0 ||
+        p + len != end) {
+        return -1;
+    }
+
+    /* Modulus */
+    if (mbedtls_asn1_get_tag(&p, end, &len, MBEDTLS_ASN1_INTEGER) != 0) {
+        return -1;
+    }
+    while (len > 0 && *p == 0) {
+        p++;
+        len--;
+    }
+    if (len != BOOTUTIL_RSA_MONT_LEN) {
+        return -1;
+    }
+    for (i = 0; i < len; i++) {
+        if (p[i] != table[BOOTUTIL_RSA_MONT_LEN - 1 - i]) {
+            return -1;
+        }
+    }
+    p += len;
+
+    /* Public exponent */
+    if (mbedtls_asn1_get_tag(&p, end, &len, MBEDTLS_ASN1_INTEGER) != 0 ||
+        len != sizeof(rsa_mont_e) || memcmp(p, rsa_mont_e, len) != 0 ||
+        p + len != end) {
+        return -1;
+    }
+
+    return 0;
+}
+
+int
+bootutil_rsa_mont_public(const uint8_t *key, size_t key_len,
+                         const uint8_t *table, size_t table_len,
+                         const uint8_t *sig, size_t slen, uint8_t *em)
+{
+    rsa_limb_t n[MONT_LIMBS];
+    rsa_limb_t s[MONT_LIMBS];
+    rsa_limb_t x[MONT_LIMBS];
+    rsa_limb_t n0inv;
+    rsa_limb_t inv;
+    const uint8_t *p;
+    int i;
+
+    if (table == NULL || table_len != BOOTUTIL_RSA_MONT_TABLE_SIZE ||
+        rsa_mont_check_key(key, key_len, table) != 0) {
+        return BOOTUTIL_RSA_MONT_MISMATCH;
+    }
+
+    rsa_mont_load_le(n, table);
+
+    /*
+     * The table holds -n^-1 mod 2^32.  Lift n^-1 to the size of a limb with
+     * a Newton iteration, which doubles the number of correct bits.
+     */
+    p = &table[2 * BOOTUTIL_RSA_MONT_LEN];
+    inv = (rsa_limb_t)(0u - ((uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+                             ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24)));
+    if (LIMB_BYTES > 4) {
+        inv &= 0xffffffffu;
+        inv *= 2 - n[0] * inv;
+    }
+    n0inv = 0 - inv;
+    if (n[0] * n0inv != (rsa_limb_t)-1) {
+        return BOOTUTIL_RSA_MONT_MISMATCH;
+    }
+
+    if (slen != BOOTUTIL_RSA_MONT_LEN) {
+        return -1;
+    }
+    rsa_mont_load_be(s, sig);
+    if (rsa_mont_geq(s, 0, n)) {
+        return -1;
+    }
+
+    /* s = sig * R mod n, using R^2 mod n from the table. */
+    rsa_mont_load_le(x, &table[BOOTUTIL_RSA_MONT_LEN]);
+    rsa_mont_mul(s, s, x, n, n0inv);
+
+    /* x = sig^(2^16) * R, then sig^65537 * R. */
+    memcpy(x, s, sizeof(x));
+    for (i = 0; i < 16; i++) {
+        rsa_mont_sqr(x, x, n, n0inv);
+    }
+    rsa_mont_mul(x, x, s, n, n0inv);
+
+    /* Leave the Montgomery form. */
+    memset(s, 0, sizeof(s));
+    s[0] = 1;
+    rsa_mont_mul(x, x, s, n, n0inv);
+
+    rsa_mont_store_be(em, x);
+
+    return 0;
+}
+
+#endif /* MCUBOOT_RSA_KEY_TABLES */
@@ -0,0 +1,513 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright (c) 2026 Linaro LTD
+ */
+
+/*
+ * Faster SHA-256 and SHA-512 for the TinyCrypt backend.
+ *
+ * The hash state is TinyCrypt's own, so contexts are still set up with
+ * tc_sha256_init() and tc_sha512_init().  Updates feed whole blocks straight
+ * from the input to the compression kernel instead of copying it into the
+ * state one byte at a time, and the kernel is selected at build time, see
+ * bootutil/crypto/sha.h.
+ */
+
+#include "mcuboot_config/mcuboot_config.h"
+
+#if defined(MCUBOOT_SHA_KERNEL_UNROLLED) || defined(MCUBOOT_SHA_KERNEL_SHA_NI) || \
+    defined(MCUBOOT_SHA_KERNEL_ARMV8_CE)
+
+#include <stdint.h>
+#include <string.h>
+
+#include <tinycrypt/constants.h>
+
+#include "bootutil/crypto/sha.h"
+
+#if defined(MCUBOOT_SHA_KERNEL_SHA_NI)
+#if !defined(__x86_64__) && !defined(__i386__)
+#error "MCUBOOT_SHA_KERNEL_SHA_NI requires an x86 target"
+#endif
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+#if defined(MCUBOOT_SHA_KERNEL_ARMV8_CE)
+#if !defined(__ARM_FEATURE_SHA2) && !defined(__ARM_FEATURE_CRYPTO)
+#error "MCUBOOT_SHA_KERNEL_ARMV8_CE requires the Armv8 crypto extension, e.g. -march=armv8-a+crypto"
+#endif
+#include <arm_neon.h>
+#endif
+
+static uint32_t
+sha_get_be32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static void
+sha_put_be64(uint8_t *p, uint64_t v)
+{
+    int i;
+
+    for (i = 7; i >= 0; i--) {
+        p[i] = (uint8_t)v;
+        v >>= 8;
+    }
+}
+
+/* SHA-256 */
+
+static const uint32_t sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+#define ROR32(x, n)     (((x) >> (n)) | ((x) << (32 - (n))))
+#define S256_0(x)       (ROR32(x, 2) ^ ROR32(x, 13) ^ ROR32(x, 22))
+#define S256_1(x)       (ROR32(x, 6) ^ ROR32(x, 11) ^ ROR32(x, 25))
+#define s256_0(x)       (ROR32(x, 7) ^ ROR32(x, 18) ^ ((x) >> 3))
+#define s256_1(x)       (ROR32(x, 17) ^ ROR32(x, 19) ^ ((x) >> 10))
+#define CH(x, y, z)     ((z) ^ ((x) & ((y) ^ (z))))
+#define MAJ(x, y, z)    (((x) & (y)) | ((z) & ((x) | (y))))
+
+/*
+ * Message schedule, kept in a 16-word ring: W[i] for i >= 16, computed in
+ * place of W[i - 16].
+ */
+#define W256(i) \
+    (w[(i) & 15] += s256_1(w[((i) - 2) & 15]) + w[((i) - 7) & 15] + s256_0(w[((i) - 15) & 15]))
+
+/*
+ * One round, with the working variables renamed instead of shifted: the
+ * caller rotates the arguments for the next round.
+ */
+#define R256(a, b, c, d, e, f, g, h, i, wi) \
+    do { \
+        uint32_t t1 = (h) + S256_1(e) + CH(e, f, g) + sha256_k[i] + (wi); \
+        (d) += t1; \
+        (h) = t1 + S256_0(a) + MAJ(a, b, c); \
+    } while (0)
+
+#define R256_8(i, W) \
+    do { \
+        R256(a, b, c, d, e, f, g, h, (i) + 0, W((i) + 0)); \
+        R256(h, a, b, c, d, e, f, g, (i) + 1, W((i) + 1)); \
+        R256(g, h, a, b, c, d, e, f, (i) + 2, W((i) + 2)); \
+        R256(f, g, h, a, b, c, d, e, (i) + 3, W((i) + 3)); \
+        R256(e, f, g, h, a, b, c, d, (i) + 4, W((i) + 4)); \
+        R256(d, e, f, g, h, a, b, c, (i) + 5, W((i) + 5)); \
+        R256(c, d, e, f, g, h, a, b, (i) + 6, W((i) + 6)); \
+        R256(b, c, d, e, f, g, h, a, (i) + 7, W((i) + 7)); \
+    } while (0)
+
+#define W256_LOAD(i)    (w[i] = sha_get_be32(&data[4 * (i)]))
+
+static void
+sha256_blocks_unrolled(uint32_t *state, const uint8_t *data, size_t blocks)
+{
+    uint32_t a, b, c, d, e, f, g, h;
+    uint32_t w[16];
+
+    while (blocks-- > 0) {
+        a = state[0]; b = state[1]; c = state[2]; d = state[3];
+        e = state[4]; f = state[5]; g = state[6]; h = state[7];
+
+        R256_8(0, W256_LOAD);
+        R256_8(8, W256_LOAD);
+        R256_8(16, W256);
+        R256_8(24, W256);
+        R256_8(32, W256);
+        R256_8(40, W256);
+        R256_8(48, W256);
+        R256_8(56, W256);
+
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+
+        data += TC_SHA256_BLOCK_SIZE;
+    }
+}
+
+#if defined(MCUBOOT_SHA_KERNEL_SHA_NI)
+#define SHA_NI_TARGET __attribute__((target("sha,sse4.1,ssse3")))
+
+/*
+ * The SHA-NI instructions work on the state split as ABEF and CDGH, with
+ * each rnds2 doing two rounds.  For every group of four rounds, the next
+ * four schedule words are derived with msg1/msg2.
+ */
+SHA_NI_TARGET static void
+sha256_blocks_sha_ni(uint32_t *state, const uint8_t *data, size_t blocks)
+{
+    const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i state0, state1, abef, cdgh, tmp;
+    __m128i msg[4];
+    int i;
+
+    tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[0]), 0xb1); /* CDAB */
+    state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[4]), 0x1b); /* EFGH */
+    state0 = _mm_alignr_epi8(tmp, state1, 8);       /* ABEF */
+    state1 = _mm_blend_epi16(state1, tmp, 0xf0);    /* CDGH */
+
+    while (blocks-- > 0) {
+        abef = state0;
+        cdgh = state1;
+
+        for (i = 0; i < 4; i++) {
+            msg[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)&data[16 * i]), bswap);
+        }
+
+        for (i = 0; i < 16; i++) {
+            tmp = _mm_add_epi32(msg[i & 3], _mm_loadu_si128((const __m128i *)&sha256_k[4 * i]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, tmp);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(tmp, 0x0e));
+
+            if (i < 12) {
+                tmp = _mm_sha256msg1_epu32(msg[i & 3], msg[(i + 1) & 3]);
+                tmp = _mm_add_epi32(tmp, _mm_alignr_epi8(msg[(i + 3) & 3], msg[(i + 2) & 3], 4));
+                msg[i & 3] = _mm_sha256msg2_epu32(tmp, msg[(i + 3) & 3]);
+            }
+        }
+
+        state0 = _mm_add_epi32(state0, abef);
+        state1 = _mm_add_epi32(state1, cdgh);
+
+        data += TC_SHA256_BLOCK_SIZE;
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1b);          /* FEBA */
+    state1 = _mm_shuffle_epi32(state1, 0xb1);       /* DCHG */
+    _mm_storeu_si128((__m128i *)&state[0], _mm_blend_epi16(tmp, state1, 0xf0));  /* DCBA */
+    _mm_storeu_si128((__m128i *)&state[4], _mm_alignr_epi8(state1, tmp, 8));     /* HGFE */
+}
+
+/* Returns 1 if the CPU has the SHA extensions, which the sim can't assume. */
+static int
+sha_ni_supported(void)
+{
+    static int supported = -1;
+    unsigned int eax, ebx, ecx, edx;
+
+    if (supported < 0) {
+        supported = __get_cpuid(1, &eax, &ebx, &ecx, &edx) &&
+                    (ecx & bit_SSSE3) && (ecx & bit_SSE4_1) &&
+                    __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) &&
+                    (ebx & bit_SHA);
+    }
+
+    return supported;
+}
+#endif /* MCUBOOT_SHA_KERNEL_SHA_NI */
+
+#if defined(MCUBOOT_SHA_KERNEL_ARMV8_CE)
+/*
+ * The Armv8 instructions work on the state as ABCD and EFGH, with each
+ * sha256h/sha256h2 pair doing four rounds.
+ */
+static void
+sha256_blocks_armv8_ce(uint32_t *state, const uint8_t *data, size_t blocks)
+{
+    uint32x4_t state0, state1, abcd, efgh, tmp, prev;
+    uint32x4_t msg[4];
+    int i;
+
+    state0 = vld1q_u32(&state[0]);
+    state1 = vld1q_u32(&state[4]);
+
+    while (blocks-- > 0) {
+        abcd = state0;
+        efgh = state1;
+
+        for (i = 0; i < 4; i++) {
+            msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&data[16 * i])));
+        }
+
+        for (i = 0; i < 16; i++) {
+            tmp = vaddq_u32(msg[i & 3], vld1q_u32(&sha256_k[4 * i]));
+            prev = state0;
+            state0 = vsha256hq_u32(state0, state1, tmp);
+            state1 = vsha256h2q_u32(state1, prev, tmp);
+
+            if (i < 12) {
+                msg[i & 3] = vsha256su1q_u32(vsha256su0q_u32(msg[i & 3], msg[(i + 1) & 3]),
+                                             msg[(i + 2) & 3], msg[(i + 3) & 3]);
+            }
+        }
+
+        state0 = vaddq_u32(state0, abcd);
+        state1 = vaddq_u32(state1, efgh);
+
+        data += TC_SHA256_BLOCK_SIZE;
+    }
+
+    vst1q_u32(&state[0], state0);
+    vst1q_u32(&state[4], state1);
+}
+#endif /* MCUBOOT_SHA_KERNEL_ARMV8_CE */
+
+static void
+sha256_blocks(unsigned int *iv, const uint8_t *data, size_t blocks)
+{
+    /* TinyCrypt keeps the state as unsigned int, which is 32 bits wide here. */
+    uint32_t *state = (uint32_t *)iv;
+
+#if defined(MCUBOOT_SHA_KERNEL_SHA_NI)
+    if (sha_ni_supported()) {
+        sha256_blocks_sha_ni(state, data, blocks);
+        return;
+    }
+#elif defined(MCUBOOT_SHA_KERNEL_ARMV8_CE)
+    sha256_blocks_armv8_ce(state, data, blocks);
+    return;
+#endif
+
+    sha256_blocks_unrolled(state, data, blocks);
+}
+
+int
+bootutil_tc_sha256_update(TCSha256State_t s, const uint8_t *data, size_t datalen)
+{
+    size_t blocks;
+    size_t n;
+
+    if (s == NULL || data == NULL) {
+        return TC_CRYPTO_FAIL;
+    }
+
+    /* Complete a block left over from the previous update first. */
+    if (s->leftover_offset > 0) {
+        n = TC_SHA256_BLOCK_SIZE - s->leftover_offset;
+        if (n > datalen) {
+            n = datalen;
+        }
+        memcpy(&s->leftover[s->leftover_offset], data, n);
+        s->leftover_offset += n;
+        data += n;
+        datalen -= n;
+        if (s->leftover_offset < TC_SHA256_BLOCK_SIZE) {
+            return TC_CRYPTO_SUCCESS;
+        }
+        sha256_blocks(s->iv, s->leftover, 1);
+        s->bits_hashed += TC_SHA256_BLOCK_SIZE << 3;
+        s->leftover_offset = 0;
+    }
+
+    blocks = datalen / TC_SHA256_BLOCK_SIZE;
+    if (blocks > 0) {
+        sha256_blocks(s->iv, data, blocks);
+        s->bits_hashed += (uint64_t)blocks * (TC_SHA256_BLOCK_SIZE << 3);
+        data += blocks * TC_SHA256_BLOCK_SIZE;
+        datalen -= blocks * TC_SHA256_BLOCK_SIZE;
+    }
+
+    memcpy(s->leftover, data, datalen);
+    s->leftover_offset = datalen;
+
+    return TC_CRYPTO_SUCCESS;
+}
+
+int
+bootutil_tc_sha256_final(uint8_t *digest, TCSha256State_t s)
+{
+    int i;
+
+    if (digest == NULL || s == NULL) {
+        return TC_CRYPTO_FAIL;
+    }
+
+    s->bits_hashed += s->leftover_offset << 3;
+
+    s->leftover[s->leftover_offset++] = 0x80;
+    if (s->leftover_offset > TC_SHA256_BLOCK_SIZE - 8) {
+        memset(&s->leftover[s->leftover_offset], 0, TC_SHA256_BLOCK_SIZE - s->leftover_offset);
+        sha256_blocks(s->iv, s->leftover, 1);
+        s->leftover_offset = 0;
+    }
+    memset(&s->leftover[s->leftover_offset], 0, TC_SHA256_BLOCK_SIZE - 8 - s->leftover_offset);
+    sha_put_be64(&s->leftover[TC_SHA256_BLOCK_SIZE - 8], s->bits_hashed);
+    sha256_blocks(s->iv, s->leftover, 1);
+
+    for (i = 0; i < TC_SHA256_STATE_BLOCKS; i++) {
+        digest[4 * i + 0] = (uint8_t)(s->iv[i] >> 24);
+        digest[4 * i + 1] = (uint8_t)(s->iv[i] >> 16);
+        digest[4 * i + 2] = (uint8_t)(s->iv[i] >> 8);
+        digest[4 * i + 3] = (uint8_t)s->iv[i];
+    }
+
+    /* destroy the current state */
+    memset(s, 0, sizeof(*s));
+
+    return TC_CRYPTO_SUCCESS;
+}
+
+#if defined(MCUBOOT_SHA512)
+
+/* SHA-512, only with the portable kernel. */
+
+static const uint64_t sha512_k[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL,
+};
+
+#define ROR64(x, n)     (((x) >> (n)) | ((x) << (64 - (n))))
+#define S512_0(x)       (ROR64(x, 28) ^ ROR64(x, 34) ^ ROR64(x, 39))
+#define S512_1(x)       (ROR64(x, 14) ^ ROR64(x, 18) ^ ROR64(x, 41))
+#define s512_0(x)       (ROR64(x, 1) ^ ROR64(x, 8) ^ ((x) >> 7))
+#define s512_1(x)       (ROR64(x, 19) ^ ROR64(x, 61) ^ ((x) >> 6))
+
+#define W512(i) \
+    (w[(i) & 15] += s512_1(w[((i) - 2) & 15]) + w[((i) - 7) & 15] + s512_0(w[((i) - 15) & 15]))
+
+#define W512_LOAD(i) \
+    (w[i] = ((uint64_t)sha_get_be32(&data[8 * (i)]) << 32) | sha_get_be32(&data[8 * (i) + 4]))
+
+#define R512(a, b, c, d, e, f, g, h, i, wi) \
+    do { \
+        uint64_t t1 = (h) + S512_1(e) + CH(e, f, g) + sha512_k[i] + (wi); \
+        (d) += t1; \
+        (h) = t1 + S512_0(a) + MAJ(a, b, c); \
+    } while (0)
+
+#define R512_8(i, W) \
+    do { \
+        R512(a, b, c, d, e, f, g, h, (i) + 0, W((i) + 0)); \
+        R512(h, a, b, c, d, e, f, g, (i) + 1, W((i) + 1)); \
+        R512(g, h, a, b, c, d, e, f, (i) + 2, W((i) + 2)); \
+        R512(f, g, h, a, b, c, d, e, (i) + 3, W((i) + 3)); \
+        R512(e, f, g, h, a, b, c, d, (i) + 4, W((i) + 4)); \
+        R512(d, e, f, g, h, a, b, c, (i) + 5, W((i) + 5)); \
+        R512(c, d, e, f, g, h, a, b, (i) + 6, W((i) + 6)); \
+        R512(b, c, d, e, f, g, h, a, (i) + 7, W((i) + 7)); \
+    } while (0)
+
+static void
+sha512_blocks(uint64_t *state, const uint8_t *data, size_t blocks)
+{
+    uint64_t a, b, c, d, e, f, g, h;
+    uint64_t w[16];
+
+    while (blocks-- > 0) {
+        a = state[0]; b = state[1]; c = state[2]; d = state[3];
+        e = state[4]; f = state[5]; g = state[6]; h = state[7];
+
+        R512_8(0, W512_LOAD);
+        R512_8(8, W512_LOAD);
+        R512_8(16, W512);
+        R512_8(24, W512);
+        R512_8(32, W512);
+        R512_8(40, W512);
+        R512_8(48, W512);
+        R512_8(56, W512);
+        R512_8(64, W512);
+        R512_8(72, W512);
+
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+
+        data += TC_SHA512_BLOCK_SIZE;
+    }
+}
+
+int
+bootutil_tc_sha512_update(TCSha512State_t s, const uint8_t *data, size_t datalen)
+{
+    size_t blocks;
+    size_t n;
+
+    if (s == NULL || data == NULL) {
+        return TC_CRYPTO_FAIL;
+    }
+
+    if (s->leftover_offset > 0) {
+        n = TC_SHA512_BLOCK_SIZE - s->leftover_offset;
+        if (n > datalen) {
+            n = datalen;
+        }
+        memcpy(&s->leftover[s->leftover_offset], data, n);
+        s->leftover_offset += n;
+        data += n;
+        datalen -= n;
+        if (s->leftover_offset < TC_SHA512_BLOCK_SIZE) {
+            return TC_CRYPTO_SUCCESS;
+        }
+        sha512_blocks(s->iv, s->leftover, 1);
+        s->bits_hashed += TC_SHA512_BLOCK_SIZE << 3;
+        s->leftover_offset = 0;
+    }
+
+    blocks = datalen / TC_SHA512_BLOCK_SIZE;
+    if (blocks > 0) {
+        sha512_blocks(s->iv, data, blocks);
+        s->bits_hashed += (uint64_t)blocks * (TC_SHA512_BLOCK_SIZE << 3);
+        data += blocks * TC_SHA512_BLOCK_SIZE;
+        datalen -= blocks * TC_SHA512_BLOCK_SIZE;
+    }
+
+    memcpy(s->leftover, data, datalen);
+    s->leftover_offset = datalen;
+
+    return TC_CRYPTO_SUCCESS;
+}
+
+int
+bootutil_tc_sha512_final(uint8_t *digest, TCSha512State_t s)
+{
+    int i;
+
+    if (digest == NULL || s == NULL) {
+        return TC_CRYPTO_FAIL;
+    }
+
+    s->bits_hashed += s->leftover_offset << 3;
+
+    /* The length takes 128 bits, of which only the lower 64 can be set. */
+    s->leftover[s->leftover_offset++] = 0x80;
+    if (s->leftover_offset > TC_SHA512_BLOCK_SIZE - 16) {
+        memset(&s->leftover[s->leftover_offset], 0, TC_SHA512_BLOCK_SIZE - s->leftover_offset);
+        sha512_blocks(s->iv, s->leftover, 1);
+        s->leftover_offset = 0;
+    }
+    memset(&s->leftover[s->leftover_offset], 0, TC_SHA512_BLOCK_SIZE - 8 - s->leftover_offset);
+    sha_put_be64(&s->leftover[TC_SHA512_BLOCK_SIZE - 8], s->bits_hashed);
+    sha512_blocks(s->iv, s->leftover, 1);
+
+    for (i = 0; i < TC_SHA512_STATE_BLOCKS; i++) {
+        sha_put_be64(&digest[8 * i], s->iv[i]);
+    }
+
+    /* destroy the current state */
+    memset(s, 0, sizeof(*s));
+
+    return TC_CRYPTO_SUCCESS;
+}
+
+#endif /* MCUBOOT_SHA512 */
+
+#endif /* MCUBOOT_SHA_KERNEL_* */
@@ -139,10 +139,9 @@ swap_read_status_bytes(const struct flash_area *fap,
         struct boot_loader_state *state, struct boot_status *bs)
 {
     uint32_t off;
-    uint8_t status;
+    bool erased;
     int max_entries;
     int found_idx;
-    uint8_t write_sz;
     int move_entries;
     int rc;
     int last_rc;
@@ -158,15 +157,14 @@ swap_read_status_bytes(const struct flash_area *fap,
     found_idx = -1;
     /* skip erased sectors at the end */
     last_rc = 1;
-    write_sz = BOOT_WRITE_SZ(state);
     off = boot_status_off(fap);
     for (i = max_entries; i > 0; i--) {
-        rc = flash_area_read(fap, off + (i - 1) * write_sz, &status, 1);
+        rc = boot_read_status_entry(fap, off, i - 1, BOOT_WRITE_SZ(state), &erased);
         if (rc < 0) {
             return BOOT_EFLASH;
         }
 
-        if (bootutil_buffer_is_erased(fap, &status, 1)) {
+        if (erased) {
             if (rc != last_rc) {
                 erased_sections++;
             }
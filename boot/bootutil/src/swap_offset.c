@@ -224,10 +224,9 @@ int swap_read_status_bytes(const struct flash_area *fap, struct boot_loader_stat
                            struct boot_status *bs)
 {
     uint32_t off;
-    uint8_t status;
+    bool erased;
     int max_entries;
     int found_idx;
-    uint8_t write_sz;
     int rc;
     int last_rc;
     int erased_sections;
@@ -243,15 +242,14 @@ int swap_read_status_bytes(const struct flash_area *fap, struct boot_loader_stat
     found_idx = -1;
     /* Skip erased sectors at the end */
     last_rc = 1;
-    write_sz = BOOT_WRITE_SZ(state);
     off = boot_status_off(fap);
     for (i = max_entries; i > 0; i--) {
-        rc = flash_area_read(fap, off + (i - 1) * write_sz, &status, 1);
+        rc = boot_read_status_entry(fap, off, i - 1, BOOT_WRITE_SZ(state), &erased);
         if (rc < 0) {
             return BOOT_EFLASH;
         }
 
-        if (bootutil_buffer_is_erased(fap, &status, 1)) {
+        if (erased) {
             if (rc != last_rc) {
                 erased_sections++;
             }
@@ -715,6 +713,21 @@ void swap_run(struct boot_loader_state *state, struct boot_status *bs,
         rc = swap_scramble_trailer_sectors(state, fap_sec);
         assert(rc == 0);
     } else {
+#if defined(MCUBOOT_SWAP_OFFSET_PERM_NO_BACKUP)
+        /*
+         * A permanent upgrade is never reverted, so the image in the primary
+         * slot does not need to be kept in the secondary slot, but for its
+         * first sector: the header it holds is read when resuming the swap.
+         * A test upgrade may be reverted and keeps it whole, until the image
+         * is confirmed and boot_set_confirmed_multi() reclaims it.
+         */
+        if (bs->swap_type == BOOT_SWAP_TYPE_PERM) {
+            used_sectors_pri = 0;
+        } else if (bs->idx == BOOT_STATUS_IDX_0) {
+            BOOT_LOG_INF("Test upgrade: keeping the previous image until confirmed");
+        }
+#endif
+
         while (idx <= last_idx) {
             if (idx >= (bs->idx - BOOT_STATUS_IDX_0)) {
                 boot_swap_sectors(idx, sector_sz, state, bs, fap_pri, fap_sec,
@@ -188,7 +188,7 @@ swap_read_status_bytes(const struct flash_area *fap,
         struct boot_loader_state *state, struct boot_status *bs)
 {
     uint32_t off;
-    uint8_t status;
+    bool erased;
     int max_entries;
     int found;
     int found_idx;
@@ -206,13 +206,12 @@ swap_read_status_bytes(const struct flash_area *fap,
     found_idx = 0;
     invalid = 0;
     for (i = 0; i < max_entries; i++) {
-        rc = flash_area_read(fap, off + i * BOOT_WRITE_SZ(state),
-                &status, 1);
+        rc = boot_read_status_entry(fap, off, i, BOOT_WRITE_SZ(state), &erased);
         if (rc < 0) {
             return BOOT_EFLASH;
         }
 
-        if (bootutil_buffer_is_erased(fap, &status, 1)) {
+        if (erased) {
             if (found && !found_idx) {
                 found_idx = i;
             }
@@ -881,9 +880,16 @@ boot_swap_sectors(int idx, uint32_t sz, struct boot_loader_state *state,
             scratch_trailer_off = boot_status_off(fap_scratch);
 
             /* copy current status that is being maintained in scratch */
+#ifdef MCUBOOT_SWAP_STATUS_PACKED
+            /* The states of the swap all fit in the first write unit. */
+            rc = boot_copy_region(state, fap_scratch, fap_primary_slot,
+                        scratch_trailer_off, img_off + copy_sz,
+                        BOOT_WRITE_SZ(state));
+#else
             rc = boot_copy_region(state, fap_scratch, fap_primary_slot,
                         scratch_trailer_off, img_off + copy_sz,
                         (BOOT_STATUS_STATE_COUNT - 1) * BOOT_WRITE_SZ(state));
+#endif
             BOOT_STATUS_ASSERT(rc == 0);
 
             rc = boot_read_swap_state(fap_scratch, &swap_state);
@@ -0,0 +1,192 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright (c) 2026 Linaro LTD
+ */
+#include "boot_test.h"
+
+TEST_CASE_DECL(image_writer_unaligned)
+TEST_CASE_DECL(image_writer_erase_ahead)
+TEST_CASE_DECL(image_writer_bad_header)
+TEST_CASE_DECL(image_writer_bad_tlvs)
+TEST_CASE_DECL(image_writer_max_size)
+TEST_CASE_DECL(image_writer_pre_erased)
+
+/* Byte of the pattern making up the body of the test images. */
+static uint8_t
+bw_test_pattern(uint32_t off)
+{
+    return (uint8_t)(off * 7 + off / 251);
+}
+
+/* Erase the secondary slot of image 0 and fill it with a value. */
+void
+bw_test_slot_fill(uint8_t val)
+{
+    const struct flash_area *fap;
+    uint8_t buf[256];
+    uint32_t off;
+    int rc;
+
+    rc = flash_area_open(FLASH_AREA_IMAGE_SECONDARY(0), &fap);
+    assert(rc == 0);
+
+    rc = flash_area_erase(fap, 0, flash_area_get_size(fap));
+    assert(rc == 0);
+
+    memset(buf, val, sizeof(buf));
+    for (off = 0; off < flash_area_get_size(fap); off += sizeof(buf)) {
+        rc = flash_area_write(fap, off, buf, sizeof(buf));
+        assert(rc == 0);
+    }
+
+    flash_area_close(fap);
+}
+
+/*
+ * Make an image of size bytes in all, made of a header, the pattern and the
+ * TLV holding the hash of both, which flags can spoil.
+ */
+void
+bw_test_image_init(struct bw_test_image *img, uint32_t size, int flags)
+{
+    struct image_tlv_info info;
+    struct image_tlv tlv;
+    bootutil_sha_context sha;
+    uint8_t buf[64];
+    uint32_t off;
+    uint32_t len;
+
+    assert(size >= sizeof(img->hdr) + sizeof(img->tlvs));
+
+    memset(img, 0, sizeof(*img));
+    img->size = size;
+    img->hdr.ih_magic = IMAGE_MAGIC;
+    img->hdr.ih_hdr_size = sizeof(img->hdr);
+    img->hdr.ih_img_size = size - sizeof(img->hdr) - sizeof(img->tlvs);
+
+    bootutil_sha_init(&sha);
+    bootutil_sha_update(&sha, &img->hdr, sizeof(img->hdr));
+    for (off = sizeof(img->hdr); off < BOOT_TLV_OFF(&img->hdr); off += len) {
+        len = BOOT_TLV_OFF(&img->hdr) - off;
+        if (len > sizeof(buf)) {
+            len = sizeof(buf);
+        }
+        bw_test_image_read(img, off, buf, len);
+        bootutil_sha_update(&sha, buf, len);
+    }
+
+    info.it_magic = (flags & BW_TEST_BAD_TLV_MAGIC) ? 0xffff : IMAGE_TLV_INFO_MAGIC;
+    info.it_tlv_tot = sizeof(img->tlvs);
+    tlv.it_type = EXPECTED_HASH_TLV;
+    tlv.it_len = IMAGE_HASH_SIZE;
+    memcpy(img->tlvs, &info, sizeof(info));
+    memcpy(&img->tlvs[sizeof(info)], &tlv, sizeof(tlv));
+    bootutil_sha_finish(&sha, &img->tlvs[sizeof(info) + sizeof(tlv)]);
+    bootutil_sha_drop(&sha);
+
+    if (flags & BW_TEST_BAD_HASH) {
+        img->tlvs[sizeof(img->tlvs) - 1] ^= 0x01;
+    }
+}
+
+/* Read the bytes of the image from off. */
+void
+bw_test_image_read(const struct bw_test_image *img, uint32_t off, uint8_t *buf, uint32_t len)
+{
+    uint32_t tlv_off = BOOT_TLV_OFF(&img->hdr);
+
+    for (; len > 0; off++, buf++, len--) {
+        if (off < sizeof(img->hdr)) {
+            *buf = ((const uint8_t *)&img->hdr)[off];
+        } else if (off < tlv_off) {
+            *buf = bw_test_pattern(off);
+        } else {
+            *buf = img->tlvs[off - tlv_off];
+        }
+    }
+}
+
+/*
+ * Write the bytes of the image from off to end, in chunks whose sizes cycle
+ * through chunks.  Returns the first error of the writer.
+ */
+int
+bw_test_image_write(struct boot_image_writer *writer, const struct bw_test_image *img,
+                    uint32_t off, uint32_t end, const uint32_t *chunks, int num_chunks)
+{
+    uint8_t buf[512];
+    uint32_t len;
+    int rc;
+    int i;
+
+    for (i = 0; off < end; off += len, i = (i + 1) % num_chunks) {
+        len = chunks[i];
+        assert(len <= sizeof(buf));
+        if (len > end - off) {
+            len = end - off;
+        }
+
+        bw_test_image_read(img, off, buf, len);
+        rc = boot_image_writer_write(writer, buf, len);
+        if (rc != 0) {
+            return rc;
+        }
+    }
+
+    return 0;
+}
+
+/* Check that the secondary slot holds the first len bytes of the image at start. */
+void
+bw_test_image_check(const struct bw_test_image *img, uint32_t start, uint32_t len)
+{
+    const struct flash_area *fap;
+    uint8_t expected[64];
+    uint8_t buf[64];
+    uint32_t off;
+    uint32_t n;
+    int rc;
+
+    rc = flash_area_open(FLASH_AREA_IMAGE_SECONDARY(0), &fap);
+    assert(rc == 0);
+
+    for (off = 0; off < len; off += n) {
+        n = len - off < sizeof(buf) ? len - off : sizeof(buf);
+        rc = flash_area_read(fap, start + off, buf, n);
+        assert(rc == 0);
+        bw_test_image_read(img, off, expected, n);
+        assert(memcmp(buf, expected, n) == 0);
+    }
+
+    flash_area_close(fap);
+}
+
+TEST_SUITE(boot_image_writer_suite)
+{
+    image_writer_unaligned();
+    image_writer_erase_ahead();
+    image_writer_bad_header();
+    image_writer_bad_tlvs();
+    image_writer_max_size();
+    image_writer_pre_erased();
+}
+
+int
+bootutil_test(void)
+{
+    boot_image_writer_suite();
+    return tu_any_failed;
+}
+
+#if MYNEWT_VAL(SELFTEST)
+int
+main(void)
+{
+    sysinit();
+
+    bootutil_test();
+
+    return tu_any_failed;
+}
+#endif
@@ -0,0 +1,48 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright (c) 2026 Linaro LTD
+ */
+#ifndef _BOOT_TEST_H
+#define _BOOT_TEST_H
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "syscfg/syscfg.h"
+#include "sysflash/sysflash.h"
+#include "testutil/testutil.h"
+#include "flash_map_backend/flash_map_backend.h"
+#include "bootutil/bootutil.h"
+#include "bootutil/boot_image_writer.h"
+
+#include "bootutil_priv.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BW_TEST_BAD_HASH        0x01    /* The hash TLV does not match */
+#define BW_TEST_BAD_TLV_MAGIC   0x02    /* The TLV info has a bad magic */
+
+/** Image generated for the tests: a header, a pattern and a hash TLV. */
+struct bw_test_image {
+    struct image_header hdr;
+    uint8_t tlvs[sizeof(struct image_tlv_info) + sizeof(struct image_tlv) + IMAGE_HASH_SIZE];
+    uint32_t size;
+};
+
+void bw_test_slot_fill(uint8_t val);
+void bw_test_image_init(struct bw_test_image *img, uint32_t size, int flags);
+void bw_test_image_read(const struct bw_test_image *img, uint32_t off, uint8_t *buf,
+                        uint32_t len);
+int bw_test_image_write(struct boot_image_writer *writer, const struct bw_test_image *img,
+                        uint32_t off, uint32_t end, const uint32_t *chunks, int num_chunks);
+void bw_test_image_check(const struct bw_test_image *img, uint32_t start, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _BOOT_TEST_H */
@@ -0,0 +1,45 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright (c) 2026 Linaro LTD
+ */
+#include "boot_test.h"
+
+/* Images whose header is not valid are refused as soon as it is received. */
+TEST_CASE(image_writer_bad_header)
+{
+    static const uint32_t chunks[] = { 5 };
+    struct boot_image_writer writer;
+    struct bw_test_image img;
+    int rc;
+
+    bw_test_slot_fill(0xa5);
+
+    /* Bad magic */
+    bw_test_image_init(&img, 1000, 0);
+    img.hdr.ih_magic = ~IMAGE_MAGIC;
+    rc = boot_image_writer_open(&writer, 0);
+    assert(rc == 0);
+    rc = bw_test_image_write(&writer, &img, 0, img.size, chunks, 1);
+    assert(rc == BOOT_EBADIMAGE);
+    assert(writer.received < sizeof(img.hdr));
+    boot_image_writer_abort(&writer);
+
+    /* Header smaller than the header structure */
+    bw_test_image_init(&img, 1000, 0);
+    img.hdr.ih_hdr_size = sizeof(img.hdr) - 1;
+    rc = boot_image_writer_open(&writer, 0);
+    assert(rc == 0);
+    rc = bw_test_image_write(&writer, &img, 0, img.size, chunks, 1);
+    assert(rc == BOOT_EBADIMAGE);
+    boot_image_writer_abort(&writer);
+
+    /* Sizes overflowing */
+    bw_test_image_init(&img, 1000, 0);
+    img.hdr.ih_img_size = UINT32_MAX - 8;
+    rc = boot_image_writer_open(&writer, 0);
+    assert(rc == 0);
+    rc = bw_test_image_write(&writer, &img, 0, img.size, chunks, 1);
+    assert(rc == BOOT_EBADIMAGE);
+    boot_image_writer_abort(&writer);
+}
@@ -0,0 +1,40 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright (c) 2026 Linaro LTD
+ */
+#include "boot_test.h"
+
+/*
+ * Images whose TLVs are malformed or whose hash does not match are refused
+ * once written, and not marked as pending.
+ */
+static void
+image_writer_refused(int flags)
+{
+    static const uint32_t chunks[] = { 100, 17 };
+    struct boot_image_writer writer;
+    struct bw_test_image img;
+    struct boot_swap_state state;
+    int rc;
+
+    bw_test_slot_fill(0xa5);
+    bw_test_image_init(&img, 3000, flags);
+
+    rc = boot_image_writer_open(&writer, 0);
+    assert(rc == 0);
+    rc = bw_test_image_write(&writer, &img, 0, img.size, chunks, 2);
+    assert(rc == 0);
+    rc = boot_image_writer_finish(&writer, 1);
+    assert(rc == BOOT_EBADIMAGE);
+
+    rc = boot_read_swap_state_by_id(FLASH_AREA_IMAGE_SECONDARY(0), &state);
+    assert(rc == 0);
+    assert(state.magic != BOOT_MAGIC_GOOD);
+}
+
+TEST_CASE(image_writer_bad_tlvs)
+{
+    image_writer_refused(BW_TEST_BAD_HASH);
+    image_writer_refused(BW_TEST_BAD_TLV_MAGIC);
+}
@@ -0,0 +1,66 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright (c) 2026 Linaro LTD
+ */
+#include "boot_test.h"
+
+/*
+ * A sector is erased when the first write block reaching it is written, and
+ * not before: the next sector keeps its contents until then.
+ */
+TEST_CASE(image_writer_erase_ahead)
+{
+    static const uint32_t chunks[] = { 1 };
+    struct boot_image_writer writer;
+    struct bw_test_image img;
+    struct flash_sector sector;
+    uint32_t end;
+    uint8_t val;
+    int rc;
+
+    bw_test_slot_fill(0xa5);
+
+    rc = boot_image_writer_open(&writer, 0);
+    assert(rc == 0);
+
+    rc = flash_area_get_sector(writer.fap, writer.start, &sector);
+    assert(rc == 0);
+    end = flash_sector_get_off(&sector) + flash_sector_get_size(&sector);
+    assert(end - writer.start + BOOT_IMAGE_WRITER_BUF_SZ <= writer.max_size);
+
+    bw_test_image_init(&img, writer.max_size, 0);
+
+    /* Byte by byte, the data is gathered into whole buffers up to the boundary. */
+    rc = bw_test_image_write(&writer, &img, 0, end - writer.start, chunks, 1);
+    assert(rc == 0);
+    assert(writer.written == end - writer.start);
+    assert(writer.erased_to == end);
+
+    rc = flash_area_read(writer.fap, end, &val, sizeof(val));
+    assert(rc == 0);
+    assert(val == 0xa5);
+
+    /* The next byte stays in the buffer, which leaves the next sector alone. */
+    rc = bw_test_image_write(&writer, &img, end - writer.start, end - writer.start + 1,
+                             chunks, 1);
+    assert(rc == 0);
+    assert(writer.erased_to == end);
+
+    rc = flash_area_read(writer.fap, end, &val, sizeof(val));
+    assert(rc == 0);
+    assert(val == 0xa5);
+
+    /* Filling the buffer writes it, once the next sector is erased. */
+    rc = bw_test_image_write(&writer, &img, end - writer.start + 1,
+                             end - writer.start + BOOT_IMAGE_WRITER_BUF_SZ, chunks, 1);
+    assert(rc == 0);
+    assert(writer.erased_to > end);
+
+    rc = flash_area_read(writer.fap, end + BOOT_IMAGE_WRITER_BUF_SZ, &val, sizeof(val));
+    assert(rc == 0);
+    assert(val == flash_area_erased_val(writer.fap));
+
+    boot_image_writer_abort(&writer);
+    bw_test_image_check(&img, writer.start, end - writer.start + BOOT_IMAGE_WRITER_BUF_SZ);
+}
@@ -0,0 +1,54 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright (c) 2026 Linaro LTD
+ */
+#include "boot_test.h"
+
+/*
+ * The image can take up the size the bootloader allows for it, which stops
+ * short of the swap status and the encryption keys in the trailer.
+ */
+TEST_CASE(image_writer_max_size)
+{
+    static const uint32_t chunks[] = { 512, 300 };
+    struct boot_image_writer writer;
+    struct bw_test_image img;
+    uint8_t buf[1] = { 0 };
+    int rc;
+
+    bw_test_slot_fill(0xa5);
+
+    rc = boot_image_writer_open(&writer, 0);
+    assert(rc == 0);
+    assert(writer.start + writer.max_size <= writer.trailer_off);
+#if defined(MCUBOOT_SWAP_USING_SCRATCH) || defined(MCUBOOT_SWAP_USING_MOVE) || \
+    defined(MCUBOOT_SWAP_USING_OFFSET)
+    assert(writer.start + writer.max_size <= boot_status_off(writer.fap));
+#endif
+
+    /* An image whose body overlaps the trailer is refused from its header. */
+    bw_test_image_init(&img, writer.max_size + sizeof(img.tlvs) + 1, 0);
+    rc = bw_test_image_write(&writer, &img, 0, sizeof(img.hdr), chunks, 2);
+    assert(rc == BOOT_EBADIMAGE);
+    boot_image_writer_abort(&writer);
+
+    /* Data past the largest image, as TLVs would be, is refused when written. */
+    rc = boot_image_writer_open(&writer, 0);
+    assert(rc == 0);
+    bw_test_image_init(&img, writer.max_size, 0);
+    rc = bw_test_image_write(&writer, &img, 0, img.size, chunks, 2);
+    assert(rc == 0);
+    rc = boot_image_writer_write(&writer, buf, sizeof(buf));
+    assert(rc == BOOT_EBADIMAGE);
+    boot_image_writer_abort(&writer);
+
+    /* The largest image fits. */
+    rc = boot_image_writer_open(&writer, 0);
+    assert(rc == 0);
+    rc = bw_test_image_write(&writer, &img, 0, img.size, chunks, 2);
+    assert(rc == 0);
+    rc = boot_image_writer_finish(&writer, 1);
+    assert(rc == 0);
+    bw_test_image_check(&img, writer.start, img.size);
+}
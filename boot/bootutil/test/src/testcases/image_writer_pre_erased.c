@@ -0,0 +1,57 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright (c) 2026 Linaro LTD
+ */
+#include "boot_test.h"
+
+/*
+ * The record of the flash erased ahead of the upgrade is written back when
+ * the image writer erases the sector holding it, and is voided only once.
+ */
+TEST_CASE(image_writer_pre_erased)
+{
+#if defined(MCUBOOT_SWAP_USING_OFFSET) || \
+    (defined(MCUBOOT_SWAP_USING_SCRATCH) && BOOT_IMAGE_NUMBER == 1)
+    static const uint32_t chunks[] = { 256, 100 };
+    const struct flash_area *fap;
+    struct boot_image_writer writer;
+    struct boot_pre_erased rec;
+    struct bw_test_image img;
+    int rc;
+
+    bw_test_slot_fill(0xa5);
+
+    rc = flash_area_open(FLASH_AREA_IMAGE_SECONDARY(0), &fap);
+    assert(rc == 0);
+    if (!device_requires_erase(fap)) {
+        flash_area_close(fap);
+        return;
+    }
+
+    rc = boot_pre_erase_multi(0);
+    assert(rc == 0);
+    rc = boot_read_pre_erased(fap, &rec);
+    assert(rc == 0);
+
+    rc = boot_image_writer_open(&writer, 0);
+    assert(rc == 0);
+    bw_test_image_init(&img, writer.max_size, 0);
+    rc = bw_test_image_write(&writer, &img, 0, img.size, chunks, 2);
+    assert(rc == 0);
+    rc = boot_image_writer_finish(&writer, 0);
+    assert(rc == 0);
+    bw_test_image_check(&img, writer.start, img.size);
+
+    rc = boot_read_pre_erased(fap, &rec);
+    assert(rc == 0);
+    assert(rec.magic == BOOT_PRE_ERASED_MAGIC);
+
+    rc = boot_clear_pre_erased(fap);
+    assert(rc == 0);
+    rc = boot_read_pre_erased(fap, &rec);
+    assert(rc == 1);
+
+    flash_area_close(fap);
+#endif
+}
@@ -0,0 +1,36 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright (c) 2026 Linaro LTD
+ */
+#include "boot_test.h"
+
+/* Chunks of any size make up the image, which is marked as pending. */
+TEST_CASE(image_writer_unaligned)
+{
+    static const uint32_t chunks[] = { 1, 3, 31, 129, 7, 500, 64, 255 };
+    struct boot_image_writer writer;
+    struct bw_test_image img;
+    struct boot_swap_state state;
+    int rc;
+
+    bw_test_slot_fill(0xa5);
+    bw_test_image_init(&img, 5001, 0);
+
+    rc = boot_image_writer_open(&writer, 0);
+    assert(rc == 0);
+
+    rc = bw_test_image_write(&writer, &img, 0, img.size, chunks,
+                             sizeof(chunks) / sizeof(chunks[0]));
+    assert(rc == 0);
+
+    rc = boot_image_writer_finish(&writer, 0);
+    assert(rc == 0);
+
+    bw_test_image_check(&img, writer.start, img.size);
+
+    rc = boot_read_swap_state_by_id(FLASH_AREA_IMAGE_SECONDARY(0), &state);
+    assert(rc == 0);
+    assert(state.magic == BOOT_MAGIC_GOOD);
+    assert(state.image_ok != BOOT_FLAG_SET);
+}
@@ -0,0 +1,125 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright (c) 2026 Linaro LTD
+ */
+
+#include "boot_request_mem.h"
+#include <errno.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/storage/flash_map.h>
+
+#include "bootutil/boot_request_log.h"
+#include "bootutil/bootutil_public.h"
+#include "bootutil/bootutil_log.h"
+
+#define MAIN_FLASH_DEV PARTITION_NODE_DEVICE(DT_CHOSEN(nrf_bootloader_request))
+#define MAIN_OFFSET    PARTITION_NODE_OFFSET(DT_CHOSEN(nrf_bootloader_request))
+#define MAIN_SIZE      PARTITION_NODE_SIZE(DT_CHOSEN(nrf_bootloader_request))
+#define MAIN_ERASE_SIZE \
+	DT_PROP_OR(DT_MTD_FROM_FIXED_PARTITION(DT_CHOSEN(nrf_bootloader_request)), \
+		   erase_block_size, 1)
+
+/** Number of entries kept in the log. */
+#define BOOT_REQUEST_LOG_ENTRIES 16
+
+BOOT_LOG_MODULE_DECLARE(bootloader_request);
+
+/* Erasing one page of the log must leave the other one untouched. */
+BUILD_ASSERT((MAIN_SIZE % 2) == 0 && ((MAIN_SIZE / 2) % MAIN_ERASE_SIZE) == 0,
+	     "Each half of the boot request partition must be a multiple of the erase page size");
+
+/*
+ * The log is split into two pages that are erased independently, which also
+ * protects the requests against an interrupted update, so there is no use for
+ * a separate backup area.  Preserved entries are handled by the log itself.
+ */
+static const struct flash_area boot_request_fa = {
+	.fa_off = MAIN_OFFSET,
+	.fa_size = MAIN_SIZE,
+	.fa_dev = MAIN_FLASH_DEV,
+};
+
+static struct boot_request_log boot_request_log;
+static uint8_t boot_request_values[BOOT_REQUEST_LOG_ENTRIES];
+static bool boot_request_log_ready;
+
+static int boot_request_log_errno(int rc)
+{
+	switch (rc) {
+	case 0:
+		return 0;
+	case BOOT_EBADARGS:
+		return -EINVAL;
+	default:
+		return -EROFS;
+	}
+}
+
+int boot_request_mem_init(void)
+{
+	int rc;
+
+	if (!device_is_ready(MAIN_FLASH_DEV)) {
+		return -EIO;
+	}
+
+	rc = boot_request_log_init(&boot_request_log, &boot_request_fa, boot_request_values,
+				   BOOT_REQUEST_LOG_ENTRIES);
+	if (rc != 0) {
+		BOOT_LOG_ERR("Unable to open boot request log: %d", rc);
+		return boot_request_log_errno(rc);
+	}
+
+	boot_request_log_ready = true;
+	return 0;
+}
+
+bool boot_request_mem_wrtie_prepare(void)
+{
+	if (!boot_request_log_ready) {
+		return boot_request_mem_init() == 0;
+	}
+
+	return true;
+}
+
+int boot_request_mem_read(size_t entry, uint8_t *value)
+{
+	if (value == NULL) {
+		return -EINVAL;
+	}
+
+	if (!boot_request_log_ready && boot_request_mem_init() != 0) {
+		return -ENOENT;
+	}
+
+	return boot_request_log_errno(boot_request_log_read(&boot_request_log, entry, value));
+}
+
+int boot_request_mem_write(size_t entry, uint8_t *value)
+{
+	if (value == NULL) {
+		return -EINVAL;
+	}
+
+	if (!boot_request_log_ready) {
+		return -EIO;
+	}
+
+	return boot_request_log_errno(boot_request_log_write(&boot_request_log, entry, *value));
+}
+
+int boot_request_mem_selective_erase(size_t *nv_indexes, size_t nv_count)
+{
+	if ((nv_indexes == NULL) && (nv_count != 0)) {
+		return -EINVAL;
+	}
+
+	if (!boot_request_log_ready) {
+		return -EIO;
+	}
+
+	return boot_request_log_errno(boot_request_log_clear(&boot_request_log, nv_indexes,
+							     nv_count));
+}
@@ -51,6 +51,9 @@
 #define MCUBOOT_SIGN_RSA 1
 #define MCUBOOT_SIGN_RSA_LEN MYNEWT_VAL(BOOTUTIL_SIGN_RSA_LEN)
 #endif
+#if MYNEWT_VAL(BOOTUTIL_RSA_KEY_TABLES)
+#define MCUBOOT_RSA_KEY_TABLES 1
+#endif
 #if MYNEWT_VAL(BOOTUTIL_SIGN_ED25519)
 #define MCUBOOT_SIGN_ED25519 1
 #endif
@@ -132,7 +132,15 @@
 
 #define MCUBOOT_USE_FLASH_AREA_GET_SECTORS
 
-#define MCUBOOT_DEV_WITH_ERASE
+/* Storage that can be written without being erased first (e.g. RRAM or
+ * FRAM) lets MCUboot skip the erase emulation entirely.
+ */
+
+#ifdef CONFIG_MCUBOOT_STORAGE_WITHOUT_ERASE
+#  define MCUBOOT_SUPPORT_DEV_WITHOUT_ERASE
+#else
+#  define MCUBOOT_SUPPORT_DEV_WITH_ERASE
+#endif
 
 /* Enable non-protected TLV check against allow list */
 #define MCUBOOT_USE_TLV_ALLOW_LIST 1
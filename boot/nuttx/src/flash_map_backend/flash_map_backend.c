@@ -29,6 +29,7 @@
 #include <stdint.h>
 #include <string.h>
 #include <sys/ioctl.h>
+#include <sys/param.h>
 #include <unistd.h>
 
 #include <nuttx/fs/fs.h>
@@ -46,6 +47,18 @@
 
 #define ARRAYSIZE(x)                (sizeof((x)) / sizeof((x)[0]))
 
+/* Whole erase blocks are erased through the MTD erase ioctl, when the NuttX
+ * version provides it.  The BCH layer caches one sector, so it must also be
+ * possible to flush that cache before the erase and to drop it afterwards.
+ * Otherwise, erase is emulated by writing the erased value.
+ */
+
+#if defined(MTDIOC_ERASESECTORS) && defined(BIOC_FLUSH) && defined(BIOC_DISCARD)
+#  define FLASH_NATIVE_ERASE        1
+#else
+#  define FLASH_NATIVE_ERASE        0
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -66,6 +79,8 @@ struct flash_device_s
 
   int      fd;          /* File descriptor for an open flash area */
   uint32_t refs;        /* Reference counter */
+  uint32_t sector_size; /* Erase block size, cached from the geometry */
+  uint32_t sector_mask; /* sector_size - 1 if it is a power of 2, else 0 */
   uint8_t  erase_state; /* Byte value of the flash erased state */
 };
 
@@ -155,6 +170,15 @@ static struct flash_device_s *g_flash_devices[] =
   &g_scratch_priv,
 };
 
+/* Buffer filled with the erased value, used for the parts of an erase that
+ * are not whole erase blocks, or for all of it when there is no native
+ * erase.  It is allocated on first use and kept for later erases.
+ */
+
+static uint8_t *g_erase_buf;
+static size_t   g_erase_buf_size;
+static uint8_t  g_erase_buf_val;
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -221,6 +245,196 @@ static struct flash_device_s *lookup_flash_device_by_offset(uint32_t offset)
   return NULL;
 }
 
+/****************************************************************************
+ * Name: sector_start
+ *
+ * Description:
+ *   Round an offset down to the start of its erase block.
+ *
+ * Input Parameters:
+ *   dev - Flash device.
+ *   off - Offset relative from beginning of flash area.
+ *
+ * Returned Value:
+ *   Offset of the erase block containing off.
+ *
+ ****************************************************************************/
+
+static inline uint32_t sector_start(const struct flash_device_s *dev,
+                                    uint32_t off)
+{
+  if (dev->sector_mask != 0)
+    {
+      return off & ~dev->sector_mask;
+    }
+
+  return off - (off % dev->sector_size);
+}
+
+/****************************************************************************
+ * Name: erase_buffer
+ *
+ * Description:
+ *   Get the buffer holding the erased value, growing it if needed.
+ *
+ * Input Parameters:
+ *   size      - Minimum size of the buffer.
+ *   erase_val - Byte value of the flash erased state.
+ *
+ * Returned Value:
+ *   Reference to the buffer, or NULL if it could not be allocated.
+ *
+ ****************************************************************************/
+
+static uint8_t *erase_buffer(size_t size, uint8_t erase_val)
+{
+  if (g_erase_buf_size < size)
+    {
+      free(g_erase_buf);
+
+      g_erase_buf = malloc(size);
+      if (g_erase_buf == NULL)
+        {
+          g_erase_buf_size = 0;
+
+          return NULL;
+        }
+
+      g_erase_buf_size = size;
+      memset(g_erase_buf, erase_val, size);
+      g_erase_buf_val = erase_val;
+    }
+  else if (g_erase_buf_val != erase_val)
+    {
+      memset(g_erase_buf, erase_val, g_erase_buf_size);
+      g_erase_buf_val = erase_val;
+    }
+
+  return g_erase_buf;
+}
+
+/****************************************************************************
+ * Name: erase_by_write
+ *
+ * Description:
+ *   Emulate erase by programming the erased value over a range.
+ *
+ * Input Parameters:
+ *   fa  - Flash area to be erased.
+ *   dev - Flash device of the flash area.
+ *   off - Offset relative from beginning of flash area to be erased.
+ *   len - Number of bytes to be erased.
+ *
+ * Returned Value:
+ *   Zero on success, or negative value in case of error.
+ *
+ ****************************************************************************/
+
+static int erase_by_write(const struct flash_area *fa,
+                          const struct flash_device_s *dev,
+                          uint32_t off, uint32_t len)
+{
+  uint8_t *buffer;
+  uint32_t chunk;
+  int ret;
+
+  buffer = erase_buffer(MIN(len, dev->sector_size), dev->erase_state);
+  if (buffer == NULL)
+    {
+      BOOT_LOG_ERR("Failed to allocate erase buffer");
+
+      return ERROR;
+    }
+
+  while (len > 0)
+    {
+      chunk = MIN(len, dev->sector_size);
+
+      BOOT_LOG_DBG("Erasing %" PRIu32 " bytes at offset %" PRIu32,
+                   chunk, off);
+
+      ret = flash_area_write(fa, off, buffer, chunk);
+      if (ret != OK)
+        {
+          return ret;
+        }
+
+      off += chunk;
+      len -= chunk;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: erase_blocks
+ *
+ * Description:
+ *   Erase whole erase blocks of a flash area.
+ *
+ * Input Parameters:
+ *   fa  - Flash area to be erased.
+ *   dev - Flash device of the flash area.
+ *   off - Offset relative from beginning of flash area, aligned to an
+ *         erase block.
+ *   len - Number of bytes to be erased, a multiple of the erase block size.
+ *
+ * Returned Value:
+ *   Zero on success, or negative value in case of error.
+ *
+ ****************************************************************************/
+
+static int erase_blocks(const struct flash_area *fa,
+                        const struct flash_device_s *dev,
+                        uint32_t off, uint32_t len)
+{
+#if FLASH_NATIVE_ERASE
+  struct mtd_erase_s erase;
+  int ret;
+
+  BOOT_LOG_DBG("Erasing %" PRIu32 " blocks at offset %" PRIu32,
+               len / dev->sector_size, off);
+
+  /* Write back anything pending in the BCH sector cache, so it can't land
+   * on the erased blocks later.
+   */
+
+  ret = ioctl(dev->fd, BIOC_FLUSH, 0);
+  if (ret < 0)
+    {
+      BOOT_LOG_ERR("Flush of %s failed: %d", fa->fa_mtd_path, errno);
+
+      return ERROR;
+    }
+
+  erase.startblock = off / dev->sector_size;
+  erase.nblocks = len / dev->sector_size;
+
+  ret = ioctl(dev->fd, MTDIOC_ERASESECTORS,
+              (unsigned long)((uintptr_t)&erase));
+  if (ret < 0)
+    {
+      BOOT_LOG_ERR("Erase of %s failed: %d", fa->fa_mtd_path, errno);
+
+      return ERROR;
+    }
+
+  /* The cached sector may hold data that was just erased */
+
+  ret = ioctl(dev->fd, BIOC_DISCARD, 0);
+  if (ret < 0)
+    {
+      BOOT_LOG_ERR("Discard of %s failed: %d", fa->fa_mtd_path, errno);
+
+      return ERROR;
+    }
+
+  return OK;
+#else
+  return erase_by_write(fa, dev, off, len);
+#endif
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -313,6 +527,19 @@ int flash_area_open(uint8_t id, const struct flash_area **fa)
   dev->fa_cfg->fa_off = dev->partinfo.startsector * dev->partinfo.sectorsize;
   dev->fa_cfg->fa_size = dev->partinfo.numsectors * dev->partinfo.sectorsize;
 
+  /* Cache the erase block geometry for flash_area_get_sector() */
+
+  dev->sector_size = dev->mtdgeo.erasesize;
+  if (dev->sector_size == 0)
+    {
+      BOOT_LOG_ERR("Invalid MTD erase block size");
+
+      goto errout_with_fd;
+    }
+
+  dev->sector_mask = (dev->sector_size & (dev->sector_size - 1)) == 0 ?
+                     dev->sector_size - 1 : 0;
+
   BOOT_LOG_INF("Flash area offset: 0x%" PRIx32, dev->fa_cfg->fa_off);
   BOOT_LOG_INF("Flash area size: %" PRIu32, dev->fa_cfg->fa_size);
   BOOT_LOG_INF("MTD erase state: 0x%" PRIx8, dev->erase_state);
@@ -518,9 +745,10 @@ int flash_area_write(const struct flash_area *fa, uint32_t off,
  *
  * Description:
  *   Erase a given flash area range.
- *   Area boundaries are asserted before erase request. API has the same
- *   limitation regarding erase-block alignment and size as the underlying
- *   flash driver.
+ *   Area boundaries are asserted before erase request. Whole erase blocks
+ *   are erased through the MTD driver when possible, while the parts of
+ *   the range that don't cover a whole erase block are programmed with the
+ *   erased value.
  *
  * Input Parameters:
  *   fa  - Flash area to be erased.
@@ -534,49 +762,64 @@ int flash_area_write(const struct flash_area *fa, uint32_t off,
 
 int flash_area_erase(const struct flash_area *fa, uint32_t off, uint32_t len)
 {
+  struct flash_device_s *dev;
+  uint32_t head;
+  uint32_t body;
   int ret;
-  void *buffer;
-  size_t i;
-  struct flash_device_s *dev = lookup_flash_device_by_id(fa->fa_id);
-  const size_t sector_size = dev->mtdgeo.erasesize;
-  const uint8_t erase_val = dev->erase_state;
 
   BOOT_LOG_INF("ID:%" PRIu8 " offset:%" PRIu32 " length:%" PRIu32,
                fa->fa_id, off, len);
 
-  buffer = malloc(sector_size);
-  if (buffer == NULL)
+  dev = lookup_flash_device_by_id(fa->fa_id);
+
+  DEBUGASSERT(dev != NULL);
+
+  if (off + len > fa->fa_size)
     {
-      BOOT_LOG_ERR("Failed to allocate erase buffer");
+      BOOT_LOG_ERR("Attempt to erase out of flash area bounds");
 
       return ERROR;
     }
 
-  memset(buffer, erase_val, sector_size);
+  /* Partial erase block at the start of the range */
 
-  i = 0;
-
-  do
+  head = sector_start(dev, off) == off ? 0 :
+         MIN(len, sector_start(dev, off) + dev->sector_size - off);
+  if (head > 0)
     {
-      BOOT_LOG_DBG("Erasing %zu bytes at offset %" PRIu32,
-                   sector_size, off + i);
+      ret = erase_by_write(fa, dev, off, head);
+      if (ret != OK)
+        {
+          return ret;
+        }
 
-      ret = flash_area_write(fa, off + i, buffer, sector_size);
-      i += sector_size;
+      off += head;
+      len -= head;
     }
-  while (ret == OK && i < (len - sector_size));
 
-  if (ret == OK)
+  /* Whole erase blocks */
+
+  body = sector_start(dev, len);
+  if (body > 0)
     {
-      BOOT_LOG_DBG("Erasing %" PRIu32 " bytes at offset %" PRIu32,
-                   len - i, off + i);
+      ret = erase_blocks(fa, dev, off, body);
+      if (ret != OK)
+        {
+          return ret;
+        }
 
-      ret = flash_area_write(fa, off + i, buffer, len - i);
+      off += body;
+      len -= body;
     }
 
-  free(buffer);
+  /* Partial erase block at the end of the range */
+
+  if (len > 0)
+    {
+      return erase_by_write(fa, dev, off, len);
+    }
 
-  return ret;
+  return OK;
 }
 
 /****************************************************************************
@@ -662,18 +905,28 @@ uint8_t flash_area_erased_val(const struct flash_area *fa)
 int flash_area_get_sectors(int fa_id, uint32_t *count,
                            struct flash_sector *sectors)
 {
-  size_t off;
+  uint32_t off;
   uint32_t total_count = 0;
   struct flash_device_s *dev = lookup_flash_device_by_id(fa_id);
-  const size_t sector_size = dev->mtdgeo.erasesize;
-  const struct flash_area *fa = fa = dev->fa_cfg;
+  const struct flash_area *fa;
+
+  DEBUGASSERT(dev != NULL);
 
-  for (off = 0; off < fa->fa_size; off += sector_size)
+  fa = dev->fa_cfg;
+
+  for (off = 0; off < fa->fa_size; off += dev->sector_size)
     {
+      if (total_count >= *count)
+        {
+          BOOT_LOG_ERR("Too many sectors in flash area %d", fa_id);
+
+          return ERROR;
+        }
+
       /* Note: Offset here is relative to flash area, not device */
 
       sectors[total_count].fs_off = off;
-      sectors[total_count].fs_size = sector_size;
+      sectors[total_count].fs_size = dev->sector_size;
       total_count++;
     }
 
@@ -815,30 +1068,39 @@ int flash_area_id_from_image_offset(uint32_t offset)
  * Name: flash_area_get_sector
  *
  * Description:
- *   Retrieve the flash sector a given offset belongs to.
+ *   Retrieve the flash sector a given offset belongs to, using the erase
+ *   block geometry cached when the flash area was opened.
  *
  * Input Parameters:
  *   fap - flash area structure
- *   off - address offset.
+ *   off - offset relative from beginning of flash area.
  *   sector - flash sector
  *
  * Returned Value:
- *   Returns 0 on success, or an error code on failure.
+ *   Returns 0 on success, -ERANGE if off is beyond the flash area, or
+ *   another negative errno value on failure.
  *
  ****************************************************************************/
 
 int flash_area_get_sector(const struct flash_area *fap, off_t off,
                           struct flash_sector *fs)
 {
-  off_t offset = fap->fa_off + off;
-  struct flash_device_s *dev = lookup_flash_device_by_offset(offset);
-  if (dev == NULL)
+  struct flash_device_s *dev = lookup_flash_device_by_id(fap->fa_id);
+
+  if (dev == NULL || dev->sector_size == 0)
     {
-      return -errno;
+      return -ENODEV;
     }
 
-  fs->fs_off = (offset / dev->mtdgeo.erasesize) * dev->mtdgeo.erasesize;
-  fs->fs_size = dev->mtdgeo.erasesize;
+  if (off < 0 || off >= fap->fa_size)
+    {
+      return -ERANGE;
+    }
+
+  /* Note: Offset here is relative to flash area, not device */
+
+  fs->fs_off = sector_start(dev, (uint32_t)off);
+  fs->fs_size = dev->sector_size;
 
   return 0;
 }
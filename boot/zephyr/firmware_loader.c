@@ -11,6 +11,7 @@
 #include <zephyr/drivers/gpio.h>
 #include "bootutil/image.h"
 #include "bootutil_priv.h"
+#include "bootutil_scratch.h"
 #include "bootutil/bootutil_log.h"
 #include "bootutil/bootutil_public.h"
 #include "bootutil/fault_injection_hardening.h"
@@ -40,7 +41,8 @@ fih_ret
 boot_image_validate(const struct flash_area *fa_p,
                     struct image_header *hdr)
 {
-    static uint8_t tmpbuf[BOOT_TMPBUF_SZ];
+    uint8_t *tmpbuf;
+    size_t tmpbuf_sz;
     FIH_DECLARE(fih_rc, FIH_FAILURE);
 
     BOOT_LOG_DBG("boot_image_validate: encrypted == %d", (int)IS_ENCRYPTED(hdr));
@@ -60,8 +62,15 @@ boot_image_validate(const struct flash_area *fa_p,
          */
         hdr->ih_flags &= ~(ENCRYPTIONFLAGS);
     }
+
+    tmpbuf = boot_scratch_begin(BOOT_SCRATCH_VALIDATE, &tmpbuf_sz);
+    if (tmpbuf == NULL) {
+        FIH_RET(fih_rc);
+    }
+
     FIH_CALL(bootutil_img_validate, fih_rc, NULL, hdr, fa_p, tmpbuf,
-             BOOT_TMPBUF_SZ, NULL, 0, NULL);
+             tmpbuf_sz, NULL, 0, NULL);
+    boot_scratch_end(BOOT_SCRATCH_VALIDATE);
 
     FIH_RET(fih_rc);
 }
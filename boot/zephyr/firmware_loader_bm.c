@@ -11,6 +11,7 @@
 #include <zephyr/storage/flash_map.h>
 #include "bootutil/image.h"
 #include "bootutil_priv.h"
+#include "bootutil_scratch.h"
 #include "bootutil/bootutil_log.h"
 #include "bootutil/bootutil_public.h"
 #include "bootutil/fault_injection_hardening.h"
@@ -59,10 +60,17 @@ static struct image_header hdr_firmware_loader = { 0 };
  */
 static fih_ret validate_image(const struct flash_area *fap, struct image_header *hdr)
 {
-    static uint8_t tmpbuf[BOOT_TMPBUF_SZ];
+    uint8_t *tmpbuf;
+    size_t tmpbuf_sz;
     FIH_DECLARE(fih_rc, FIH_FAILURE);
 
-    FIH_CALL(bootutil_img_validate, fih_rc, NULL, hdr, fap, tmpbuf, BOOT_TMPBUF_SZ, NULL, 0, NULL);
+    tmpbuf = boot_scratch_begin(BOOT_SCRATCH_VALIDATE, &tmpbuf_sz);
+    if (tmpbuf == NULL) {
+        FIH_RET(fih_rc);
+    }
+
+    FIH_CALL(bootutil_img_validate, fih_rc, NULL, hdr, fap, tmpbuf, tmpbuf_sz, NULL, 0, NULL);
+    boot_scratch_end(BOOT_SCRATCH_VALIDATE);
     FIH_RET(fih_rc);
 }
 
@@ -55,6 +55,20 @@
 #define MCUBOOT_USE_NRF_OBERON
 #endif
 
+#ifdef CONFIG_BOOT_SHA_KERNEL_UNROLLED
+#define MCUBOOT_SHA_KERNEL_UNROLLED
+#elif defined(CONFIG_BOOT_SHA_KERNEL_ARMV8_CE)
+#define MCUBOOT_SHA_KERNEL_ARMV8_CE
+#endif
+
+#ifdef CONFIG_BOOT_ECDSA_COMB_TABLES
+#define MCUBOOT_ECDSA_COMB_TABLES
+#endif
+
+#ifdef CONFIG_BOOT_ED25519_KEY_TABLES
+#define MCUBOOT_ED25519_KEY_TABLES
+#endif
+
 #ifdef CONFIG_BOOT_IMG_HASH_ALG_SHA512
 #define MCUBOOT_SHA512
 #endif
@@ -100,6 +114,14 @@
 #define MCUBOOT_SWAP_USING_OFFSET 1
 #endif
 
+#ifdef CONFIG_BOOT_SWAP_USING_OFFSET_PERM_NO_BACKUP
+#define MCUBOOT_SWAP_OFFSET_PERM_NO_BACKUP 1
+#endif
+
+#ifdef CONFIG_BOOT_SKIP_PRE_ERASED
+#define MCUBOOT_SKIP_PRE_ERASED 1
+#endif
+
 #ifdef CONFIG_BOOT_DIRECT_XIP
 #define MCUBOOT_DIRECT_XIP
 #endif
@@ -136,8 +158,20 @@
 #define MCUBOOT_SWAP_SAVE_ENCTLV 1
 #endif
 
+#ifdef CONFIG_BOOT_SWAP_STATUS_PACKED
+#define MCUBOOT_SWAP_STATUS_PACKED 1
+#endif
+
+#ifdef CONFIG_BOOT_COPY_BUFFER_SIZE
+#define MCUBOOT_COPY_BUFFER_SIZE CONFIG_BOOT_COPY_BUFFER_SIZE
+#endif
+
 #endif /* CONFIG_SINGLE_APPLICATION_SLOT */
 
+#ifdef CONFIG_BOOT_SCRATCH_STATS
+#define MCUBOOT_SCRATCH_STATS 1
+#endif
+
 /* Is MCUboot second stage bootloader in NSIB configuration ? */
 #if CONFIG_MCUBOOT_MCUBOOT_IMAGE_NUMBER != -1
 #define MCUBOOT_IS_SECOND_STAGE 1
@@ -159,6 +193,15 @@
 #define MCUBOOT_HAVE_LOGGING 1
 #endif
 
+#ifdef CONFIG_BOOT_LOG_BINARY
+#define MCUBOOT_LOG_BINARY
+#define MCUBOOT_LOG_BINARY_SIZE CONFIG_BOOT_LOG_BINARY_SIZE
+#define MCUBOOT_LOG_BINARY_LEVEL CONFIG_BOOT_LOG_BINARY_LEVEL
+#if CONFIG_BOOT_LOG_BINARY_ADDRESS != 0
+#define MCUBOOT_LOG_BINARY_ADDRESS CONFIG_BOOT_LOG_BINARY_ADDRESS
+#endif
+#endif
+
 /* Enable/disable non-protected TLV check against allow list */
 #ifdef CONFIG_MCUBOOT_USE_TLV_ALLOW_LIST
 #define MCUBOOT_USE_TLV_ALLOW_LIST 1
@@ -364,6 +407,10 @@
 #define MCUBOOT_SERIAL_IMG_GRP_SLOT_INFO
 #endif
 
+#ifdef CONFIG_BOOT_SERIAL_IMG_LIST_CACHE
+#define MCUBOOT_SERIAL_IMG_LIST_CACHE
+#endif
+
 #ifdef CONFIG_MCUBOOT_SERIAL
 #define MCUBOOT_SERIAL_RECOVERY
 #endif
@@ -436,6 +483,10 @@
 #define MCUBOOT_MAX_IMG_SECTORS       128
 #endif
 
+#ifdef CONFIG_BOOT_MAX_SECTOR_RUNS
+#define MCUBOOT_MAX_SECTOR_RUNS       CONFIG_BOOT_MAX_SECTOR_RUNS
+#endif
+
 #ifdef CONFIG_BOOT_SERIAL_MAX_RECEIVE_SIZE
 #define MCUBOOT_SERIAL_MAX_RECEIVE_SIZE CONFIG_BOOT_SERIAL_MAX_RECEIVE_SIZE
 #endif
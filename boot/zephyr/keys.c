@@ -77,6 +77,39 @@ const struct bootutil_key bootutil_keys[] = {
     LISTIFY(UTIL_DEC(MCUBOOT_SIGN_KEY_COUNT), BOOT_KEY_ENTRY_AT, ())
 };
 const int bootutil_key_cnt = sizeof(bootutil_keys) / sizeof(bootutil_keys[0]);
+
+#if defined(MCUBOOT_ECDSA_COMB_TABLES)
+#  define BOOT_TABLE_SUFFIX _comb
+#  define BOOT_TABLES bootutil_ecdsa_combs
+#elif defined(MCUBOOT_ED25519_KEY_TABLES)
+#  define BOOT_TABLE_SUFFIX _table
+#  define BOOT_TABLES bootutil_ed25519_tables
+#endif
+
+#if defined(BOOT_TABLES)
+#define BOOT_TABLE_NAME(name) BOOT_KEY_CAT(name, BOOT_TABLE_SUFFIX)
+
+#define BOOT_TABLE_DECL_AT(i, _) \
+    extern const unsigned char BOOT_TABLE_NAME(BOOT_KEY_NAME(UTIL_INC(i)))[]; \
+    extern unsigned int BOOT_KEY_CAT(BOOT_TABLE_NAME(BOOT_KEY_NAME(UTIL_INC(i))), _len);
+
+#define BOOT_TABLE_ENTRY_AT(i, _) \
+    { .key = BOOT_TABLE_NAME(BOOT_KEY_NAME(UTIL_INC(i))), \
+      .len = &BOOT_KEY_CAT(BOOT_TABLE_NAME(BOOT_KEY_NAME(UTIL_INC(i))), _len) },
+
+/* Verification tables, autogenerated from the same key files as the keys above. */
+extern const unsigned char BOOT_TABLE_NAME(BOOT_KEY_PRIMARY)[];
+extern unsigned int BOOT_KEY_CAT(BOOT_TABLE_NAME(BOOT_KEY_PRIMARY), _len);
+LISTIFY(UTIL_DEC(MCUBOOT_SIGN_KEY_COUNT), BOOT_TABLE_DECL_AT, ())
+
+const struct bootutil_key BOOT_TABLES[] = {
+    {
+        .key = BOOT_TABLE_NAME(BOOT_KEY_PRIMARY),
+        .len = &BOOT_KEY_CAT(BOOT_TABLE_NAME(BOOT_KEY_PRIMARY), _len),
+    },
+    LISTIFY(UTIL_DEC(MCUBOOT_SIGN_KEY_COUNT), BOOT_TABLE_ENTRY_AT, ())
+};
+#endif /* BOOT_TABLES */
 #endif /* HAVE_KEYS */
 #else
 unsigned int pub_key_len;
@@ -29,5 +29,7 @@ mkdir targets
 cp -r repos/apache-mynewt-core/targets/unittest targets
 newt test boot/boot_serial
 [[ $? -ne 0 ]] && exit 1
+newt test boot/bootutil
+[[ $? -ne 0 ]] && exit 1
 
 exit 0
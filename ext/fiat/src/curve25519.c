@@ -696,6 +696,110 @@ static void ge_double_scalarmult_vartime(ge_p2 *r, const uint8_t *a,
   }
 }
 
+// A key table is a comb table for a public key A: entry i-1, for i from 1 to
+// 15, is the sum of 2^(64*t)*A over the bits t set in i, stored as its affine
+// x and y coordinates in little-endian form. It is computed offline, by
+// "imgtool getpub -e lang-c-table". Together with Bcomb, the same table for
+// the base point, b*B - a*A then takes 64 doublings instead of 256, and the
+// key does not have to be decompressed.
+#define ED25519_COMB_TEETH 4
+#define ED25519_TABLE_POINTS ((1 << ED25519_COMB_TEETH) - 1)
+#define ED25519_TABLE_SIZE (ED25519_TABLE_POINTS * 64)
+
+// ge_precomp_from_table loads a key table, returning 0 unless its first point
+// is a valid curve point that encodes to |public_key|.
+static int ge_precomp_from_table(ge_precomp Ai[ED25519_TABLE_POINTS],
+                                 const uint8_t *table,
+                                 const uint8_t public_key[32]) {
+  fe x, y, t;
+  int i;
+
+  for (i = 0; i < ED25519_TABLE_POINTS; i++) {
+    fe_frombytes(&x, table + 64 * i);
+    fe_frombytes(&y, table + 64 * i + 32);
+
+    if (i == 0) {
+      uint8_t s[32];
+      fe x2, y2, rhs;
+      fe_loose l;
+
+      fe_tobytes(s, &y);
+      s[31] |= fe_isnegative(&x) << 7;
+      if (CRYPTO_memcmp(s, public_key, sizeof(s)) != 0) {
+        return 0;
+      }
+
+      // -x^2 + y^2 = 1 + d x^2 y^2
+      fe_sq_tt(&x2, &x);
+      fe_sq_tt(&y2, &y);
+      fe_mul_ttt(&t, &x2, &y2);
+      fe_mul_ttt(&t, &t, &d);
+      fe_1(&rhs);
+      fe_add(&l, &t, &rhs);
+      fe_carry(&rhs, &l);
+      fe_sub(&l, &y2, &x2);
+      fe_carry(&t, &l);
+      fe_sub(&l, &t, &rhs);
+      if (fe_isnonzero(&l)) {
+        return 0;
+      }
+    }
+
+    fe_add(&Ai[i].yplusx, &y, &x);
+    fe_sub(&Ai[i].yminusx, &y, &x);
+    fe_mul_ttt(&t, &x, &y);
+    fe_mul_ltt(&Ai[i].xy2d, &t, &d2);
+  }
+
+  return 1;
+}
+
+// comb_index gathers the bits |i|, |i|+64, |i|+128 and |i|+192 of |a|.
+static int comb_index(const uint8_t *a, int i) {
+  int index = 0;
+  int t;
+
+  for (t = ED25519_COMB_TEETH - 1; t >= 0; --t) {
+    int bit = i + 64 * t;
+    index = (index << 1) | ((a[bit >> 3] >> (bit & 7)) & 1);
+  }
+
+  return index;
+}
+
+// r = b * B - a * A
+// where Ai is the comb table of A, and B is the Ed25519 base point.
+static void ge_double_scalarmult_comb_vartime(
+    ge_p2 *r, const uint8_t *a, const ge_precomp Ai[ED25519_TABLE_POINTS],
+    const uint8_t *b) {
+  ge_p1p1 t;
+  ge_p3 u;
+  int ia;
+  int ib;
+  int i;
+
+  ge_p2_0(r);
+
+  for (i = 63; i >= 0; --i) {
+    ia = comb_index(a, i);
+    ib = comb_index(b, i);
+
+    ge_p2_dbl(&t, r);
+
+    if (ia) {
+      x25519_ge_p1p1_to_p3(&u, &t);
+      ge_msub(&t, &u, &Ai[ia - 1]);
+    }
+
+    if (ib) {
+      x25519_ge_p1p1_to_p3(&u, &t);
+      ge_madd(&t, &u, &Bcomb[ib - 1]);
+    }
+
+    x25519_ge_p1p1_to_p2(r, &t);
+  }
+}
+
 // int64_lshift21 returns |a << 21| but is defined when shifting bits into the
 // sign bit. This works around a language flaw in C.
 static inline int64_t int64_lshift21(int64_t a) {
@@ -1045,24 +1149,9 @@ void x25519_sc_reduce(uint8_t s[64]) {
   s[31] = s11 >> 17;
 }
 
-int ED25519_verify(const uint8_t *message, size_t message_len,
-                   const uint8_t signature[64], const uint8_t public_key[32]) {
-  ge_p3 A;
-  if ((signature[63] & 224) != 0 ||
-      !x25519_ge_frombytes_vartime(&A, public_key)) {
-    return 0;
-  }
-
-  fe_loose t;
-  fe_neg(&t, &A.X);
-  fe_carry(&A.X, &t);
-  fe_neg(&t, &A.T);
-  fe_carry(&A.T, &t);
-
-  uint8_t pkcopy[32];
-  memcpy(pkcopy, public_key, 32);
-  uint8_t rcopy[32];
-  memcpy(rcopy, signature, 32);
+// ed25519_s_is_canonical returns 1 if the s half of |signature| is in the
+// range [0, order).
+static int ed25519_s_is_canonical(const uint8_t signature[64]) {
   union {
     uint64_t u64[4];
     uint8_t u8[32];
@@ -1083,12 +1172,19 @@ int ED25519_verify(const uint8_t *message, size_t message_len,
     if (scopy.u64[i] > kOrder[i]) {
       return 0;
     } else if (scopy.u64[i] < kOrder[i]) {
-      break;
+      return 1;
     } else if (i == 0) {
       return 0;
     }
   }
+}
 
+// ed25519_challenge computes h = SHA-512(R || A || message), reduced modulo
+// the order.
+static void ed25519_challenge(uint8_t h[SHA512_DIGEST_LENGTH],
+                              const uint8_t *message, size_t message_len,
+                              const uint8_t signature[64],
+                              const uint8_t public_key[32]) {
 #if defined(MCUBOOT_USE_MBED_TLS)
 
   mbedtls_sha512_context ctx;
@@ -1106,7 +1202,6 @@ int ED25519_verify(const uint8_t *message, size_t message_len,
   ret = mbedtls_sha512_update_ret(&ctx, message, message_len);
   assert(ret == 0);
 
-  uint8_t h[SHA512_DIGEST_LENGTH];
   ret = mbedtls_sha512_finish_ret(&ctx, h);
   assert(ret == 0);
   mbedtls_sha512_free(&ctx);
@@ -1126,21 +1221,71 @@ int ED25519_verify(const uint8_t *message, size_t message_len,
   rc = tc_sha512_update(&s, message, message_len);
   assert(rc == TC_CRYPTO_SUCCESS);
 
-  uint8_t h[TC_SHA512_DIGEST_SIZE];
   rc = tc_sha512_final(h, &s);
   assert(rc == TC_CRYPTO_SUCCESS);
 
 #endif
 
   x25519_sc_reduce(h);
+}
+
+int ED25519_verify(const uint8_t *message, size_t message_len,
+                   const uint8_t signature[64], const uint8_t public_key[32]) {
+  ge_p3 A;
+  if ((signature[63] & 224) != 0 ||
+      !x25519_ge_frombytes_vartime(&A, public_key)) {
+    return 0;
+  }
+
+  fe_loose t;
+  fe_neg(&t, &A.X);
+  fe_carry(&A.X, &t);
+  fe_neg(&t, &A.T);
+  fe_carry(&A.T, &t);
+
+  if (!ed25519_s_is_canonical(signature)) {
+    return 0;
+  }
+
+  uint8_t h[SHA512_DIGEST_LENGTH];
+  ed25519_challenge(h, message, message_len, signature, public_key);
+
+  ge_p2 R;
+  ge_double_scalarmult_vartime(&R, h, &A, signature + 32);
+
+  uint8_t rcheck[32];
+  x25519_ge_tobytes(rcheck, &R);
+
+  return CRYPTO_memcmp(rcheck, signature, sizeof(rcheck)) == 0;
+}
+
+// ED25519_verify_precomp is ED25519_verify with a key table for |public_key|,
+// see ge_precomp_from_table. It returns -1, without checking the signature, if
+// the table does not belong to the key.
+int ED25519_verify_precomp(const uint8_t *message, size_t message_len,
+                           const uint8_t signature[64],
+                           const uint8_t public_key[32],
+                           const uint8_t *table, size_t table_len) {
+  ge_precomp Ai[ED25519_TABLE_POINTS];
+  if (table == NULL || table_len != ED25519_TABLE_SIZE ||
+      !ge_precomp_from_table(Ai, table, public_key)) {
+    return -1;
+  }
+
+  if ((signature[63] & 224) != 0 || !ed25519_s_is_canonical(signature)) {
+    return 0;
+  }
+
+  uint8_t h[SHA512_DIGEST_LENGTH];
+  ed25519_challenge(h, message, message_len, signature, public_key);
 
   ge_p2 R;
-  ge_double_scalarmult_vartime(&R, h, &A, scopy.u8);
+  ge_double_scalarmult_comb_vartime(&R, h, Ai, signature + 32);
 
   uint8_t rcheck[32];
   x25519_ge_tobytes(rcheck, &R);
 
-  return CRYPTO_memcmp(rcheck, rcopy, sizeof(rcheck)) == 0;
+  return CRYPTO_memcmp(rcheck, signature, sizeof(rcheck)) == 0;
 }
 
 static void fe_cswap(fe *f, fe *g, fe_limb_t b) {
@@ -105,3 +105,128 @@ static const ge_precomp Bi[8] = {
           17317989, 34647629, 21263748}},
     },
 };
+
+// Bcomb[i-1] = the sum of 2^(64*t)*B over the bits t set in i, for the
+// fixed-base comb in ED25519_verify_precomp.
+static const ge_precomp Bcomb[15] = {
+    {
+        {{25967493, 19198397, 29566455, 3660896, 54414519, 4014786, 27544626,
+          21800161, 61029707, 2047604}},
+        {{54563134, 934261, 64385954, 3049989, 66381436, 9406985, 12720692,
+          5043384, 19500929, 18085054}},
+        {{58370664, 4489569, 9688441, 18769238, 10184608, 21191052, 29287918,
+          11864899, 42594502, 29115885}},
+    },
+    {
+        {{64091413, 10058205, 1980837, 3964243, 22160966, 12322533, 60677741,
+          20936246, 12228556, 26550755}},
+        {{32944382, 14922211, 44263970, 5188527, 21913450, 24834489, 4001464,
+          13238564, 60994061, 8653814}},
+        {{22865569, 28901697, 27603667, 21009037, 14348957, 8234005, 24808405,
+          5719875, 28483275, 2841751}},
+    },
+    {
+        {{1989096, 24207704, 30146570, 22753856, 35540176, 4580428, 39151743,
+          31811522, 40141116, 10201955}},
+        {{8676004, 23997863, 60488046, 2834072, 12018111, 1262326, 12154436,
+          31848867, 24181778, 2479830}},
+        {{39561027, 29933814, 55430265, 694157, 1244790, 7563226, 63465557,
+          12404326, 7987052, 21830081}},
+    },
+    {
+        {{11374242, 12660715, 17861383, 21013599, 10935567, 1099227, 53222788,
+          24462691, 39381819, 11358503}},
+        {{54378055, 10311866, 1510375, 10778093, 64989409, 24408729, 32676002,
+          11149336, 40985213, 4985767}},
+        {{48012542, 341146, 60911379, 33315398, 15756972, 24757770, 66125820,
+          13794113, 47694557, 17933176}},
+    },
+    {
+        {{62678856, 648056, 31384611, 17204624, 60588021, 8106392, 14624995,
+          27901610, 38602051, 10126553}},
+        {{61028846, 9129668, 44377386, 8611524, 34949269, 16052465, 18704982,
+          8772605, 61314087, 19357102}},
+        {{22472221, 9473251, 20136607, 3545737, 6583525, 28160389, 44807891,
+          28853391, 37392334, 20479679}},
+    },
+    {
+        {{57279564, 29445960, 16540348, 25812076, 15955698, 18982952, 11561321,
+          24414771, 15793243, 20534888}},
+        {{1208348, 3808679, 57409472, 5250273, 39285616, 191259, 10659206,
+          6395949, 20314229, 29999239}},
+        {{64955422, 4260297, 27710638, 22385792, 58529726, 10918622, 57519664,
+          245709, 50363324, 26473180}},
+    },
+    {
+        {{64196810, 30815003, 52397853, 27834580, 62775701, 4380255, 6014946,
+          14545162, 47643912, 29152025}},
+        {{10017796, 15920398, 48558718, 26351677, 1984510, 3446813, 46156647,
+          32357111, 15251529, 2975278}},
+        {{12777097, 32531075, 29704761, 4041038, 33834264, 743744, 31466336,
+          14221651, 51059398, 17073314}},
+    },
+    {
+        {{793280, 24323954, 8836301, 27318725, 39747955, 31184838, 33152842,
+          28669181, 57202663, 32932579}},
+        {{5666214, 525582, 20782575, 25516013, 42570364, 14657739, 16099374,
+          1468826, 60937436, 18367850}},
+        {{62249590, 29775088, 64191105, 26806412, 7778749, 11688288, 36704511,
+          23683193, 65549940, 23690785}},
+    },
+    {
+        {{10666484, 22545923, 65536337, 14574406, 33913539, 3100313, 54338524,
+          12065532, 17172465, 18251938}},
+        {{21098884, 14267519, 2351070, 8916607, 36545832, 22062925, 15773440,
+          3623271, 64400693, 16797632}},
+        {{48260556, 10532635, 13162400, 32051799, 14345811, 12380276, 55405695,
+          30009961, 1941254, 18909527}},
+    },
+    {
+        {{30341120, 16430044, 64448384, 2511959, 37804501, 2737271, 66393141,
+          9193223, 51103317, 20584014}},
+        {{65364876, 25449128, 37855835, 21581351, 48802090, 25891747, 6901437,
+          19434198, 9943479, 28238953}},
+        {{31969798, 7967153, 8955209, 7115550, 46463975, 28005022, 28734582,
+          7563797, 60493502, 8601077}},
+    },
+    {
+        {{48716872, 10736546, 23861626, 9052160, 15955978, 12329328, 31253580,
+          17876711, 20575600, 32523809}},
+        {{16678346, 19195772, 37343158, 8281418, 64240356, 25042205, 32706074,
+          13869361, 58231188, 578952}},
+        {{22694915, 29097656, 29402142, 10609596, 12393514, 10083943, 42271230,
+          9465662, 9244769, 14895110}},
+    },
+    {
+        {{40048095, 289603, 38929533, 3085685, 2987060, 22894700, 17280211,
+          29218551, 21357044, 1113015}},
+        {{50803223, 5373105, 37854936, 13606270, 51988196, 4323330, 65928888,
+          15189169, 43316304, 6091070}},
+        {{42858948, 8034340, 46507950, 3251098, 23984608, 9786034, 2664017,
+          9329462, 38376396, 7907776}},
+    },
+    {
+        {{6062367, 8646453, 16804867, 32282464, 9625329, 30556287, 24319371,
+          23385113, 48259621, 25111823}},
+        {{17431460, 21130829, 57583136, 28322584, 3552973, 4201607, 57040169,
+          15627003, 54598446, 1120551}},
+        {{26747231, 21572453, 5341569, 20341171, 7208512, 1498346, 51882680,
+          11658865, 61197326, 3287151}},
+    },
+    {
+        {{1904716, 29420890, 23638460, 13144862, 16039401, 15035491, 8784782,
+          14243278, 66047038, 28186097}},
+        {{52953536, 9809186, 33066810, 23192064, 33193722, 20167233, 13995683,
+          22631658, 56480792, 2586799}},
+        {{66087039, 4455675, 57952126, 27758363, 24832936, 23462733, 53515022,
+          5856403, 44841764, 23927224}},
+    },
+    {
+        {{66828354, 29022673, 55665263, 27984904, 31948145, 33081498, 30652344,
+          33049413, 23313551, 2512041}},
+        {{8321084, 3330807, 4510805, 30604446, 39507739, 6611877, 32869763,
+          31849117, 30301292, 16936235}},
+        {{54743236, 21982816, 11962522, 2961320, 35956300, 21626671, 24989996,
+          28090212, 40912471, 27714978}},
+    },
+};
@@ -0,0 +1,156 @@
+#! /usr/bin/env python3
+#
+# Copyright (c) 2026 Linaro LTD
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Decode the binary boot log of MCUboot (MCUBOOT_LOG_BINARY).
+
+The log is read from a dump of its buffer, starting with its header, and the
+format strings of the messages, as well as the strings they print, are looked
+up in the ELF file of the bootloader the log comes from.  Requires pyelftools.
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+from elftools.elf.constants import SH_FLAGS
+from elftools.elf.elffile import ELFFile
+
+MAGIC = 0x424c4f47
+VERSION = 1
+HEADER = "IBBHIIII"
+
+LEVELS = {1: "ERR", 2: "WRN", 3: "INF", 4: "DBG"}
+
+CONV_RE = re.compile(r"%([-+ #0]*)(\d*)(?:\.(\d+))?(hh|h|ll|l|z|j|t)?([diouxXcsp%])")
+
+# Size in bits of the integer arguments, for each length modifier.  Those
+# without a fixed size are as large as a word.
+LENGTH_BITS = {None: 32, "hh": 8, "h": 16, "ll": 64, "j": 64}
+
+
+class Image:
+    """The read-only allocated sections of the bootloader ELF file.
+
+    Strings in writable sections are left out: the log only holds their
+    address, and what the ELF file has is their initial value, not the one
+    they had when they were logged.
+    """
+
+    def __init__(self, path):
+        self.sections = []
+        with open(path, "rb") as f:
+            elf = ELFFile(f)
+            for sec in elf.iter_sections():
+                flags = sec["sh_flags"]
+                if ((flags & SH_FLAGS.SHF_ALLOC) and not (flags & SH_FLAGS.SHF_WRITE) and
+                        sec["sh_type"] != "SHT_NOBITS"):
+                    self.sections.append((sec["sh_addr"], sec.data()))
+
+    def string(self, addr):
+        for base, data in self.sections:
+            if base <= addr < base + len(data):
+                end = data.find(b"\0", addr - base)
+                if end < 0:
+                    end = len(data)
+                return data[addr - base:end].decode("utf-8", errors="replace")
+        return None
+
+
+def format_message(image, fmt, args, word_bits):
+    """Format a message like printf() would, from its arguments as words."""
+    args = list(args)
+
+    def conv(m):
+        flags, width, prec, length, kind = m.groups()
+        if kind == "%":
+            return "%"
+        if not args:
+            return "<missing>"
+        value = args.pop(0)
+        spec = "%" + flags + width + ("." + prec if prec is not None else "")
+        if kind == "s":
+            s = image.string(value)
+            return (spec + "s") % s if s is not None else "<0x%x>" % value
+        if kind == "p":
+            return "0x%x" % value
+        if kind == "c":
+            return (spec + "c") % chr(value & 0xff)
+        bits = LENGTH_BITS.get(length, word_bits)
+        value &= (1 << bits) - 1
+        if kind in "di" and value >> (bits - 1):
+            value -= 1 << bits
+        return (spec + kind) % value
+
+    return CONV_RE.sub(conv, fmt)
+
+
+def decode(image, dump, big_endian):
+    order = ">" if big_endian else "<"
+    hdr_size = struct.calcsize(order + HEADER)
+    magic, version, word_size, _, size, head, used, dropped = \
+        struct.unpack_from(order + HEADER, dump)
+    if magic != MAGIC:
+        raise ValueError("No binary boot log in the dump (magic 0x%08x)" % magic)
+    if version != VERSION:
+        raise ValueError("Unsupported binary boot log version %d" % version)
+    if word_size not in (4, 8) or head >= size or used > size:
+        raise ValueError("Corrupted binary boot log header")
+
+    word = order + ("I" if word_size == 4 else "Q")
+    ring = [struct.unpack_from(word, dump, hdr_size + i * word_size)[0] for i in range(size)]
+
+    lines = []
+    if dropped:
+        lines.append("-- %d messages dropped --" % dropped)
+
+    pos = (head + size - used) % size
+    left = used
+    while left > 0:
+        rec = ring[pos]
+        level = rec & 0xff
+        nargs = (rec >> 8) & 0xff
+        if nargs + 2 > left:
+            raise ValueError("Truncated record at word %d" % pos)
+        fmt_addr = ring[(pos + 1) % size]
+        args = [ring[(pos + 2 + i) % size] for i in range(nargs)]
+        fmt = image.string(fmt_addr)
+        if fmt is None:
+            msg = "<unknown message 0x%x> %s" % (fmt_addr, " ".join("0x%x" % a for a in args))
+        else:
+            msg = format_message(image, fmt, args, word_size * 8)
+        lines.append("[%s] %s" % (LEVELS.get(level, "???"), msg))
+        pos = (pos + nargs + 2) % size
+        left -= nargs + 2
+
+    return lines
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("-e", "--elf", required=True,
+                        help="ELF file of the bootloader which wrote the log")
+    parser.add_argument("--big-endian", action="store_true",
+                        help="The log was written by a big-endian target")
+    parser.add_argument("dump", help="Binary dump of the log buffer")
+    args = parser.parse_args()
+
+    with open(args.dump, "rb") as f:
+        dump = f.read()
+
+    try:
+        lines = decode(Image(args.elf), dump, args.big_endian)
+    except (ValueError, struct.error) as e:
+        print("error: %s" % e, file=sys.stderr)
+        sys.exit(1)
+
+    for line in lines:
+        print(line)
+
+
+if __name__ == "__main__":
+    main()
@@ -17,8 +17,10 @@
 """
 Parse and print header, TLV area and trailer information of a signed image.
 """
+import json
 import os.path
 import struct
+import sys
 
 import click
 import yaml
@@ -116,8 +118,9 @@ def print_tlv_records(tlv_list):
         print()
 
 
-def dump_imginfo(imgfile, outfile=None, silent=False):
-    """Parse a signed image binary and print/save the available information."""
+def dump_imginfo(imgfile, outfile=None, silent=False, json_output=False):
+    """Parse a signed image binary and print/save the available information.
+    With json_output, the information is printed in JSON instead of text."""
     trailer_magic = None
     #   set to INVALID by default
     swap_size = 0x99
@@ -127,125 +130,132 @@ def dump_imginfo(imgfile, outfile=None, silent=False):
     trailer = {}
     key_field_len = None
 
-    try:
-        with open(imgfile, "rb") as f:
-            b = f.read()
-    except FileNotFoundError:
-        raise click.UsageError(f"Image file not found ({imgfile})")
-
-    # Parsing the image header
-    _header = struct.unpack('IIHHIIBBHI', b[:28])
-    # Image version consists of the last 4 item ('BBHI')
-    _version = _header[-4:]
-    header = {}
-    for i, key in enumerate(HEADER_ITEMS):
-        if key == "version":
-            header[key] = "{}.{}.{}+{}".format(*_version)
-        else:
-            header[key] = _header[i]
-
-    # Parsing the TLV area
-    tlv_area = {"tlv_hdr_prot": {},
-                "tlvs_prot": [],
-                "tlv_hdr": {},
-                "tlvs": []}
-    tlv_off = header["hdr_size"] + header["img_size"]
-    protected_tlv_size = header["protected_tlv_size"]
+    # Only the header, the TLV area and the trailer are read, and not the
+    # payload or the padding up to the trailer.
+    with image.ImageReader(imgfile) as r:
+        # Parsing the image header
+        _header = struct.unpack('IIHHIIBBHI', r.read(0, 28))
+        # Image version consists of the last 4 item ('BBHI')
+        _version = _header[-4:]
+        header = {}
+        for i, key in enumerate(HEADER_ITEMS):
+            if key == "version":
+                header[key] = "{}.{}.{}+{}".format(*_version)
+            else:
+                header[key] = _header[i]
+
+        # Parsing the TLV area
+        tlv_area = {"tlv_hdr_prot": {},
+                    "tlvs_prot": [],
+                    "tlv_hdr": {},
+                    "tlvs": []}
+        tlv_off = header["hdr_size"] + header["img_size"]
+        protected_tlv_size = header["protected_tlv_size"]
+
+        if protected_tlv_size != 0:
+            _tlv_prot_head = struct.unpack(
+                'HH',
+                r.read(tlv_off, image.TLV_INFO_SIZE))
+            tlv_area["tlv_hdr_prot"]["magic"] = _tlv_prot_head[0]
+            tlv_area["tlv_hdr_prot"]["tlv_tot"] = _tlv_prot_head[1]
+            tlv_end = tlv_off + tlv_area["tlv_hdr_prot"]["tlv_tot"]
+            tlv_off += image.TLV_INFO_SIZE
 
-    if protected_tlv_size != 0:
-        _tlv_prot_head = struct.unpack(
-            'HH',
-            b[tlv_off:(tlv_off + image.TLV_INFO_SIZE)])
-        tlv_area["tlv_hdr_prot"]["magic"] = _tlv_prot_head[0]
-        tlv_area["tlv_hdr_prot"]["tlv_tot"] = _tlv_prot_head[1]
-        tlv_end = tlv_off + tlv_area["tlv_hdr_prot"]["tlv_tot"]
+            # Iterating through the protected TLV area
+            while tlv_off < tlv_end:
+                tlv_type, tlv_len = struct.unpack(
+                    'HH',
+                    r.read(tlv_off, image.TLV_INFO_SIZE))
+                tlv_off += image.TLV_INFO_SIZE
+                tlv_data = r.read(tlv_off, tlv_len)
+                tlv_area["tlvs_prot"].append(
+                    {"type": tlv_type, "len": tlv_len, "data": tlv_data})
+                tlv_off += tlv_len
+
+        _tlv_head = struct.unpack('HH', r.read(tlv_off, image.TLV_INFO_SIZE))
+        tlv_area["tlv_hdr"]["magic"] = _tlv_head[0]
+        tlv_area["tlv_hdr"]["tlv_tot"] = _tlv_head[1]
+
+        tlv_end = tlv_off + tlv_area["tlv_hdr"]["tlv_tot"]
         tlv_off += image.TLV_INFO_SIZE
 
-        # Iterating through the protected TLV area
+        # Iterating through the TLV area
         while tlv_off < tlv_end:
             tlv_type, tlv_len = struct.unpack(
                 'HH',
-                b[tlv_off:(tlv_off + image.TLV_INFO_SIZE)])
+                r.read(tlv_off, image.TLV_INFO_SIZE))
             tlv_off += image.TLV_INFO_SIZE
-            tlv_data = b[tlv_off:(tlv_off + tlv_len)]
-            tlv_area["tlvs_prot"].append(
+            tlv_data = r.read(tlv_off, tlv_len)
+            tlv_area["tlvs"].append(
                 {"type": tlv_type, "len": tlv_len, "data": tlv_data})
             tlv_off += tlv_len
 
-    _tlv_head = struct.unpack('HH', b[tlv_off:(tlv_off + image.TLV_INFO_SIZE)])
-    tlv_area["tlv_hdr"]["magic"] = _tlv_head[0]
-    tlv_area["tlv_hdr"]["tlv_tot"] = _tlv_head[1]
-
-    tlv_end = tlv_off + tlv_area["tlv_hdr"]["tlv_tot"]
-    tlv_off += image.TLV_INFO_SIZE
-
-    # Iterating through the TLV area
-    while tlv_off < tlv_end:
-        tlv_type, tlv_len = struct.unpack(
-            'HH',
-            b[tlv_off:(tlv_off + image.TLV_INFO_SIZE)])
-        tlv_off += image.TLV_INFO_SIZE
-        tlv_data = b[tlv_off:(tlv_off + tlv_len)]
-        tlv_area["tlvs"].append(
-            {"type": tlv_type, "len": tlv_len, "data": tlv_data})
-        tlv_off += tlv_len
-
-    _img_pad_size = len(b) - tlv_end
-
-    if _img_pad_size:
-        # Parsing the image trailer
-        trailer_off = -BOOT_MAGIC_SIZE
-        trailer_magic = b[trailer_off:]
-        trailer["magic"] = trailer_magic
-        max_align = None
-        if trailer_magic == BOOT_MAGIC:
-            # The maximum supported write alignment is the default 8 Bytes
-            max_align = 8
-        elif trailer_magic[-len(BOOT_MAGIC_2):] == BOOT_MAGIC_2:
-            # The alignment value is encoded in the magic field
-            max_align = int.from_bytes(trailer_magic[:2], "little")
-        else:
-            # Invalid magic: the rest of the image trailer cannot be processed.
-            print("Warning: the trailer magic value is invalid!")
-
-        if max_align is not None:
-            if max_align > BOOT_MAGIC_SIZE:
-                trailer_off -= max_align - BOOT_MAGIC_SIZE
-            # Parsing rest of the trailer fields
-            trailer_off -= max_align
-            image_ok = b[trailer_off]
-            trailer["image_ok"] = image_ok
-
-            trailer_off -= max_align
-            copy_done = b[trailer_off]
-            trailer["copy_done"] = copy_done
-
-            trailer_off -= max_align
-            swap_info = b[trailer_off]
-            trailer["swap_info"] = swap_info
-
-            trailer_off -= max_align
-            swap_size = int.from_bytes(b[trailer_off:(trailer_off + 4)],
-                                       "little")
-            trailer["swap_size"] = swap_size
-
-            # Encryption key 0/1
-            if ((header["flags"] & image.IMAGE_F["ENCRYPTED_AES128"]) or
-                    (header["flags"] & image.IMAGE_F["ENCRYPTED_AES256"])):
-                # The image is encrypted
-                #    Estimated value of key_field_len is correct if
-                #    BOOT_SWAP_SAVE_ENCTLV is unset
-                key_field_len = image.align_up(16, max_align) * 2
+        _img_pad_size = r.size - tlv_end
+
+        if _img_pad_size:
+            # Parsing the image trailer
+            trailer_off = -BOOT_MAGIC_SIZE
+            trailer_magic = r.read(trailer_off, BOOT_MAGIC_SIZE)
+            trailer["magic"] = trailer_magic
+            max_align = None
+            if trailer_magic == BOOT_MAGIC:
+                # The maximum supported write alignment is the default 8 Bytes
+                max_align = 8
+            elif trailer_magic[-len(BOOT_MAGIC_2):] == BOOT_MAGIC_2:
+                # The alignment value is encoded in the magic field
+                max_align = int.from_bytes(trailer_magic[:2], "little")
+            else:
+                # Invalid magic: the rest of the image trailer cannot be processed.
+                print("Warning: the trailer magic value is invalid!",
+                      file=sys.stderr if json_output else sys.stdout)
+
+            if max_align is not None:
+                if max_align > BOOT_MAGIC_SIZE:
+                    trailer_off -= max_align - BOOT_MAGIC_SIZE
+                # Parsing rest of the trailer fields
+                trailer_off -= max_align
+                image_ok = r.read(trailer_off, 1)[0]
+                trailer["image_ok"] = image_ok
+
+                trailer_off -= max_align
+                copy_done = r.read(trailer_off, 1)[0]
+                trailer["copy_done"] = copy_done
+
+                trailer_off -= max_align
+                swap_info = r.read(trailer_off, 1)[0]
+                trailer["swap_info"] = swap_info
+
+                trailer_off -= max_align
+                swap_size = int.from_bytes(r.read(trailer_off, 4),
+                                           "little")
+                trailer["swap_size"] = swap_size
+
+                # Encryption key 0/1
+                if ((header["flags"] & image.IMAGE_F["ENCRYPTED_AES128"]) or
+                        (header["flags"] & image.IMAGE_F["ENCRYPTED_AES256"])):
+                    # The image is encrypted
+                    #    Estimated value of key_field_len is correct if
+                    #    BOOT_SWAP_SAVE_ENCTLV is unset
+                    key_field_len = image.align_up(16, max_align) * 2
+
+            _erased_val = r.read(tlv_end, 1)[0]
+
+    imgdata = {"header": header,
+               "tlv_area": tlv_area,
+               "trailer": trailer}
 
     # Generating output yaml file
     if outfile is not None:
-        imgdata = {"header": header,
-                   "tlv_area": tlv_area,
-                   "trailer": trailer}
         with open(outfile, "w") as outf:
             # sort_keys - from pyyaml 5.1
             yaml.dump(imgdata, outf, sort_keys=False)
 
+    if json_output:
+        # The TLV data and the trailer magic are printed in hex.
+        print(json.dumps(imgdata, indent=2,
+                         default=lambda v: v.hex() if isinstance(v, bytes) else str(v)))
+        return
+
     ###############################################################################
 
     if silent:
@@ -301,7 +311,6 @@ def dump_imginfo(imgfile, outfile=None, silent=False):
 
     if _img_pad_size:
         _sectionoff += tlv_area["tlv_hdr"]["tlv_tot"]
-        _erased_val = b[_sectionoff]
         frame_header_text = f"Image padding (offset: {hex(_sectionoff)})"
         frame_content = f"padding ({hex(_erased_val)})"
         print_in_frame(frame_header_text, frame_content)
@@ -55,6 +55,8 @@ DEFAULT_MAX_ALIGN = 8
 DEP_IMAGES_KEY = "images"
 DEP_VERSIONS_KEY = "versions"
 MAX_SW_TYPE_LENGTH = 12  # Bytes
+# Size of the chunks in which images are hashed, encrypted, read and padded.
+CHUNK_SIZE = 64 * 1024
 
 # Image header flags.
 IMAGE_F = {
@@ -232,10 +234,11 @@ def key_and_user_sha_to_alg_and_tlv(key, user_sha, is_pure = False):
                            )
 
 
-def get_digest(tlv_type, hash_region):
+def get_digest(tlv_type, chunks):
     sha = TLV_SHA_TO_SHA_AND_ALG[tlv_type].alg()
 
-    sha.update(hash_region)
+    for chunk in chunks:
+        sha.update(chunk)
     return sha.digest()
 
 
@@ -252,6 +255,53 @@ def tlv_matches_key_type(tlv_type, key):
 
     return False
 
+class ImageReader:
+    """Read parts of a signed image, without reading it whole when it is a
+    binary file. Intel HEX files are converted as a whole."""
+
+    def __init__(self, path):
+        ext = os.path.splitext(path)[1][1:].lower()
+        self._file = None
+        try:
+            if ext == INTEL_HEX_EXT:
+                self._data = IntelHex(path).tobinstr()
+                self.size = len(self._data)
+            else:
+                self._file = open(path, 'rb')
+                self.size = os.fstat(self._file.fileno()).st_size
+        except FileNotFoundError:
+            raise click.UsageError(f"Image file {path} not found")
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def close(self):
+        if self._file is not None:
+            self._file.close()
+            self._file = None
+
+    def read(self, off, size):
+        """Read size bytes at off, counted from the end of the image if
+        negative."""
+        if off < 0:
+            off = max(self.size + off, 0)
+        if self._file is None:
+            return self._data[off:off + size]
+        self._file.seek(off)
+        return self._file.read(size)
+
+    def chunks(self, off, size):
+        """Read size bytes at off, CHUNK_SIZE bytes at a time."""
+        end = min(off + size, self.size)
+        while off < end:
+            chunk = self.read(off, min(CHUNK_SIZE, end - off))
+            yield chunk
+            off += len(chunk)
+
+
 class Manifest:
     def __init__(self, endian, path):
         self.path = path
@@ -503,10 +553,18 @@ class Image:
                        bytes(self.boot_magic))
             h.tofile(path, 'hex')
         else:
-            if self.pad:
-                self.pad_to(self.slot_size)
             with open(path, 'wb') as f:
                 f.write(self.payload)
+                if self.pad:
+                    # The slot may be much larger than the image, so its
+                    # padding is written a chunk at a time.
+                    padding, trailer = self._padding(self.slot_size)
+                    chunk = bytes([self.erased_val]) * min(max(padding, 0), CHUNK_SIZE)
+                    while padding > 0:
+                        n = min(padding, len(chunk))
+                        f.write(memoryview(chunk)[:n])
+                        padding -= n
+                    f.write(trailer)
 
     def _apply_header_padding(self, payload_reserves_header):
         """Apply header padding using the configured pad value""" 
@@ -816,7 +874,7 @@ class Image:
         # At this point the image was hashed + signed, we can remove the
         # protected TLVs from the payload (will be re-added later)
         if protected_tlv_off is not None:
-            self.payload = self.payload[:protected_tlv_off]
+            del self.payload[protected_tlv_off:]
 
         if enckey is not None and dont_encrypt is False:
             if encrypt_keylen == 256:
@@ -862,9 +920,12 @@ class Image:
                 cipher = Cipher(algorithms.AES(plainkey), modes.CTR(nonce),
                                 backend=default_backend())
                 encryptor = cipher.encryptor()
-                img = bytes(self.payload[self.header_size:])
-                self.payload[self.header_size:] = \
-                    encryptor.update(img) + encryptor.finalize()
+                # Encrypt the image in place, a chunk at a time; the AES-CTR
+                # output is as long as its input.
+                for off in range(self.header_size, len(self.payload), CHUNK_SIZE):
+                    end = min(off + CHUNK_SIZE, len(self.payload))
+                    self.payload[off:end] = encryptor.update(bytes(self.payload[off:end]))
+                encryptor.finalize()
 
         self.payload += prot_tlv.get()
         self.payload += tlv.get()
@@ -924,7 +985,8 @@ class Image:
                              self.version.revision or 0,
                              self.version.build or 0,
                              0)  # Pad1
-        self.payload = bytearray(self.payload)
+        if not isinstance(self.payload, bytearray):
+            self.payload = bytearray(self.payload)
         self.payload[:len(header)] = header
 
     def _trailer_size(self, write_size, max_sectors, overwrite_only, enckey,
@@ -950,46 +1012,47 @@ class Image:
             trailer += magic_align_size
             return trailer
 
-    def pad_to(self, size):
-        """Pad the image to the given size, with the given flash alignment."""
+    def _padding(self, size):
+        """Return the size of the padding between the image and its trailer,
+        and the trailer, when the image is padded to the given size."""
         tsize = self._trailer_size(self.align, self.max_sectors,
                                    self.overwrite_only, self.enckey,
                                    self.save_enctlv, self.enctlv_len)
         padding = size - (len(self.payload) + tsize)
-        pbytes = bytearray([self.erased_val] * padding)
-        pbytes += bytearray([self.erased_val] * (tsize - len(self.boot_magic)))
-        pbytes += self.boot_magic
+        tbytes = bytearray([self.erased_val] * (tsize - len(self.boot_magic)))
+        tbytes += self.boot_magic
         if self.confirm and not self.overwrite_only:
             magic_size = 16
             magic_align_size = align_up(magic_size, self.max_align)
             image_ok_idx = -(magic_align_size + self.max_align)
-            pbytes[image_ok_idx] = 0x01  # image_ok = 0x01
-        self.payload += pbytes
+            tbytes[image_ok_idx] = 0x01  # image_ok = 0x01
+        return padding, tbytes
+
+    def pad_to(self, size):
+        """Pad the image to the given size, with the given flash alignment."""
+        padding, trailer = self._padding(size)
+        self.payload += bytearray([self.erased_val] * padding)
+        self.payload += trailer
 
     @staticmethod
     def verify(imgfile, key):
-        ext = os.path.splitext(imgfile)[1][1:].lower()
-        try:
-            if ext == INTEL_HEX_EXT:
-                b = IntelHex(imgfile).tobinstr()
-            else:
-                with open(imgfile, 'rb') as f:
-                    b = f.read()
-        except FileNotFoundError:
-            raise click.UsageError(f"Image file {imgfile} not found")
+        with ImageReader(imgfile) as r:
+            return Image._verify(r, key)
 
-        magic, _, header_size, _, img_size = struct.unpack('IIHHI', b[:16])
-        version = struct.unpack('BBHI', b[20:28])
+    @staticmethod
+    def _verify(r, key):
+        magic, _, header_size, _, img_size = struct.unpack('IIHHI', r.read(0, 16))
+        version = struct.unpack('BBHI', r.read(20, 8))
 
         if magic != IMAGE_MAGIC:
             return VerifyResult.INVALID_MAGIC, None, None, None
 
         tlv_off = header_size + img_size
-        tlv_info = b[tlv_off:tlv_off + TLV_INFO_SIZE]
+        tlv_info = r.read(tlv_off, TLV_INFO_SIZE)
         magic, tlv_tot = struct.unpack('HH', tlv_info)
         if magic == TLV_PROT_INFO_MAGIC:
             tlv_off += tlv_tot
-            tlv_info = b[tlv_off:tlv_off + TLV_INFO_SIZE]
+            tlv_info = r.read(tlv_off, TLV_INFO_SIZE)
             magic, tlv_tot = struct.unpack('HH', tlv_info)
 
         if magic != TLV_INFO_MAGIC:
@@ -999,13 +1062,13 @@ class Image:
         is_pure = False
 
         prot_tlv_size = tlv_off
-        hash_region = b[:prot_tlv_size]
-        tlv_end = tlv_off + tlv_tot
-        tlv_off += TLV_INFO_SIZE  # skip tlv info
+        tlvs = r.read(tlv_off, tlv_tot)
+        tlv_end = tlv_tot
+        tlv_off = TLV_INFO_SIZE  # skip tlv info
 
         # First scan all TLVs in search of SIG_PURE
         while tlv_off < tlv_end:
-            tlv = b[tlv_off:tlv_off + TLV_SIZE]
+            tlv = tlvs[tlv_off:tlv_off + TLV_SIZE]
             tlv_type, _, tlv_len = struct.unpack('BBH', tlv)
             if tlv_type == TLV_VALUES['SIG_PURE']:
                 is_pure = True
@@ -1013,29 +1076,27 @@ class Image:
             tlv_off += TLV_SIZE + tlv_len
 
         digest = None
-        tlv_off = prot_tlv_size
-        tlv_end = tlv_off + tlv_tot
-        tlv_off += TLV_INFO_SIZE  # skip tlv info
+        tlv_off = TLV_INFO_SIZE  # skip tlv info
         while tlv_off < tlv_end:
-            tlv = b[tlv_off:tlv_off + TLV_SIZE]
+            tlv = tlvs[tlv_off:tlv_off + TLV_SIZE]
             tlv_type, _, tlv_len = struct.unpack('BBH', tlv)
             if is_sha_tlv(tlv_type):
                 if not tlv_matches_key_type(tlv_type, key):
                     return VerifyResult.KEY_MISMATCH, None, None, None
                 off = tlv_off + TLV_SIZE
-                digest = get_digest(tlv_type, hash_region)
-                if digest == b[off:off + tlv_len]:
+                digest = get_digest(tlv_type, r.chunks(0, prot_tlv_size))
+                if digest == tlvs[off:off + tlv_len]:
                     if key is None:
                         return VerifyResult.OK, version, digest, None
                 else:
                     return VerifyResult.INVALID_HASH, None, None, None
             elif not is_pure and key is not None and tlv_type == TLV_VALUES[key.sig_tlv()]:
                 off = tlv_off + TLV_SIZE
-                tlv_sig = b[off:off + tlv_len]
-                payload = b[:prot_tlv_size]
+                tlv_sig = tlvs[off:off + tlv_len]
                 try:
                     if hasattr(key, 'verify'):
-                        key.verify(tlv_sig, payload)
+                        # The key hashes the payload itself.
+                        key.verify(tlv_sig, r.read(0, prot_tlv_size))
                     else:
                         key.verify_digest(tlv_sig, digest)
                     return VerifyResult.OK, version, digest, None
@@ -1044,9 +1105,9 @@ class Image:
                     pass
             elif is_pure and key is not None and tlv_type in ALLOWED_PURE_SIG_TLVS:
                 off = tlv_off + TLV_SIZE
-                tlv_sig = b[off:off + tlv_len]
+                tlv_sig = tlvs[off:off + tlv_len]
                 try:
-                    key.verify_digest(tlv_sig, hash_region)
+                    key.verify_digest(tlv_sig, r.read(0, prot_tlv_size))
                     return VerifyResult.OK, version, None, tlv_sig
                 except InvalidSignature:
                     # continue to next TLV
@@ -4,6 +4,7 @@ ECDSA key management
 
 # SPDX-License-Identifier: Apache-2.0
 import os.path
+import sys
 
 from cryptography.hazmat.backends import default_backend
 from cryptography.hazmat.primitives import serialization
@@ -14,6 +15,60 @@ from .general import KeyClass
 from .privatebytes import PrivateBytesMixin
 
 
+# NIST P-256 field prime and generator, for building comb tables.
+P256_P = 0xffffffff00000001000000000000000000000000ffffffffffffffffffffffff
+P256_GX = 0x6b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296
+P256_GY = 0x4fe342e2fe1a7f9b8ee7eb4a7c0f9e162bce33576b315ececbb6406837bf51f5
+
+# Number of teeth of the comb, must match BOOTUTIL_ECDSA_COMB_TEETH.
+COMB_TEETH = 4
+
+
+def _p256_add(p1, p2):
+    """Add two affine P-256 points, with None as the point at infinity."""
+    if p1 is None:
+        return p2
+    if p2 is None:
+        return p1
+    (x1, y1), (x2, y2) = p1, p2
+    if x1 == x2:
+        if (y1 + y2) % P256_P == 0:
+            return None
+        lam = (3 * x1 * x1 - 3) * pow(2 * y1, -1, P256_P)
+    else:
+        lam = (y2 - y1) * pow(x2 - x1, -1, P256_P)
+    lam %= P256_P
+    x3 = (lam * lam - x1 - x2) % P256_P
+    return (x3, (lam * (x1 - x3) - y1) % P256_P)
+
+
+def p256_comb_table(x, y, teeth=COMB_TEETH):
+    """
+    Return the comb table for the point (x, y), as used by the bootloader
+    for fixed-base ECDSA verification.
+
+    With d = 256 / teeth, entry i - 1 (for i from 1 to 2^teeth - 1) is the
+    sum of 2^(d * t) * P over the bits t set in i.  Each entry is stored as
+    the big-endian x and y coordinates.
+    """
+    spacing = 256 // teeth
+    teeth_points = []
+    point = (x, y)
+    for _ in range(teeth):
+        teeth_points.append(point)
+        for _ in range(spacing):
+            point = _p256_add(point, point)
+
+    table = bytearray()
+    for i in range(1, 1 << teeth):
+        entry = None
+        for t in range(teeth):
+            if i & (1 << t):
+                entry = _p256_add(entry, teeth_points[t])
+        table += entry[0].to_bytes(32, 'big') + entry[1].to_bytes(32, 'big')
+    return bytes(table)
+
+
 class ECDSAUsageError(Exception):
     pass
 
@@ -171,6 +226,21 @@ class ECDSA256P1Public(ECDSAPublicKey):
         # requested.
         return 72
 
+    def get_comb_bytes(self):
+        """Comb table of the key, for fixed-base signature verification."""
+        numbers = self._get_public().public_numbers()
+        return p256_comb_table(numbers.x, numbers.y)
+
+    def emit_c_comb(self, file=sys.stdout, name_suffix: str = ""):
+        self._emit(
+                header=f"const unsigned char {self.shortname()}_pub_key{name_suffix}_comb[] = {{",
+                trailer="};",
+                encoded_bytes=self.get_comb_bytes(),
+                indent="    ",
+                len_format=("const unsigned int "
+                            f"{self.shortname()}_pub_key{name_suffix}_comb_len = {{}};"),
+                file=file)
+
     def verify(self, signature, payload):
         # strip possible paddings added during sign
         signature = signature[:signature[1] + 2]
@@ -3,6 +3,7 @@ ED25519 key management
 """
 
 # SPDX-License-Identifier: Apache-2.0
+import sys
 
 from cryptography.hazmat.primitives import serialization
 from cryptography.hazmat.primitives.asymmetric import ed25519
@@ -10,6 +11,64 @@ from cryptography.hazmat.primitives.asymmetric import ed25519
 from .general import KeyClass
 
 
+# Edwards25519 field prime and curve constant, for building key tables.
+ED25519_P = 2**255 - 19
+ED25519_D = -121665 * pow(121666, -1, ED25519_P) % ED25519_P
+
+# Number of teeth of the comb, must match ED25519_COMB_TEETH.
+COMB_TEETH = 4
+
+
+def _ed25519_decompress(encoded):
+    """Decode a 32-byte public key into its affine coordinates."""
+    y = int.from_bytes(encoded, 'little') & ((1 << 255) - 1)
+    u = (y * y - 1) * pow(ED25519_D * y * y + 1, -1, ED25519_P) % ED25519_P
+    x = pow(u, (ED25519_P + 3) // 8, ED25519_P)
+    if (x * x - u) % ED25519_P != 0:
+        x = x * pow(2, (ED25519_P - 1) // 4, ED25519_P) % ED25519_P
+    if (x * x - u) % ED25519_P != 0:
+        raise Ed25519UsageError("Public key is not a curve point")
+    if (x & 1) != (encoded[31] >> 7):
+        x = ED25519_P - x
+    return (x, y)
+
+
+def _ed25519_add(p1, p2):
+    """Add two affine Edwards25519 points."""
+    (x1, y1), (x2, y2) = p1, p2
+    t = ED25519_D * x1 * x2 * y1 * y2
+    x3 = (x1 * y2 + x2 * y1) * pow(1 + t, -1, ED25519_P)
+    y3 = (y1 * y2 + x1 * x2) * pow(1 - t, -1, ED25519_P)
+    return (x3 % ED25519_P, y3 % ED25519_P)
+
+
+def ed25519_key_table(encoded, teeth=COMB_TEETH):
+    """
+    Return the key table for the 32-byte public key A, as used by the
+    bootloader to verify signatures without decompressing the key.
+
+    This is a comb table: with d = 256 / teeth, entry i - 1 (for i from 1 to
+    2^teeth - 1) is the sum of 2^(d * t) * A over the bits t set in i.  Each
+    entry is stored as the little-endian x and y coordinates.
+    """
+    spacing = 256 // teeth
+    teeth_points = []
+    point = _ed25519_decompress(encoded)
+    for _ in range(teeth):
+        teeth_points.append(point)
+        for _ in range(spacing):
+            point = _ed25519_add(point, point)
+
+    table = bytearray()
+    for i in range(1, 1 << teeth):
+        entry = (0, 1)
+        for t in range(teeth):
+            if i & (1 << t):
+                entry = _ed25519_add(entry, teeth_points[t])
+        table += entry[0].to_bytes(32, 'little') + entry[1].to_bytes(32, 'little')
+    return bytes(table)
+
+
 class Ed25519UsageError(Exception):
     pass
 
@@ -41,6 +100,22 @@ class Ed25519Public(KeyClass):
     def get_private_bytes(self, minimal, format):
         self._unsupported('get_private_bytes')
 
+    def get_table_bytes(self):
+        """Key table of the key, for faster signature verification."""
+        return ed25519_key_table(self._get_public().public_bytes(
+                encoding=serialization.Encoding.Raw,
+                format=serialization.PublicFormat.Raw))
+
+    def emit_c_table(self, file=sys.stdout, name_suffix: str = ""):
+        self._emit(
+                header=f"const unsigned char {self.shortname()}_pub_key{name_suffix}_table[] = {{",
+                trailer="};",
+                encoded_bytes=self.get_table_bytes(),
+                indent="    ",
+                len_format=("const unsigned int "
+                            f"{self.shortname()}_pub_key{name_suffix}_table_len = {{}};"),
+                file=file)
+
     def export_private(self, path, passwd=None):
         self._unsupported('export_private')
 
@@ -4,6 +4,8 @@ RSA Key management
 
 # SPDX-License-Identifier: Apache-2.0
 
+import sys
+
 from cryptography.hazmat.backends import default_backend
 from cryptography.hazmat.primitives import serialization
 from cryptography.hazmat.primitives.asymmetric import rsa
@@ -21,6 +23,22 @@ class RSAUsageError(Exception):
     pass
 
 
+def rsa_key_table(n):
+    """
+    Return the table of Montgomery parameters for the modulus n, as used by
+    the bootloader to verify signatures without setting up a bignum context.
+
+    With 32-bit limbs and R = 2^(32 * limbs), this is n and R^2 mod n as
+    little-endian integers of the size of n, followed by -n^-1 mod 2^32.
+    """
+    size = (n.bit_length() + 7) // 8
+    r = 1 << (8 * size)
+    n0inv = -pow(n, -1, 1 << 32) % (1 << 32)
+    return (n.to_bytes(size, 'little') +
+            (r * r % n).to_bytes(size, 'little') +
+            n0inv.to_bytes(4, 'little'))
+
+
 class RSAPublic(KeyClass):
     """The public key can only do a few operations"""
     def __init__(self, key):
@@ -49,6 +67,20 @@ class RSAPublic(KeyClass):
                 encoding=serialization.Encoding.PEM,
                 format=serialization.PublicFormat.SubjectPublicKeyInfo)
 
+    def get_table_bytes(self):
+        """Montgomery parameters of the key, for faster signature verification."""
+        return rsa_key_table(self._get_public().public_numbers().n)
+
+    def emit_c_table(self, file=sys.stdout, name_suffix: str = ""):
+        self._emit(
+                header=f"const unsigned char {self.shortname()}_pub_key{name_suffix}_table[] = {{",
+                trailer="};",
+                encoded_bytes=self.get_table_bytes(),
+                indent="    ",
+                len_format=("const unsigned int "
+                            f"{self.shortname()}_pub_key{name_suffix}_table_len = {{}};"),
+                file=file)
+
     def get_private_bytes(self, minimal, format):
         self._unsupported('get_private_bytes')
 
@@ -18,18 +18,27 @@
 # limitations under the License.
 
 import base64
+import contextlib
+import copy
 import getpass
+import io
+import json
 import lzma
+import multiprocessing
+import os
 import re
 import struct
 import sys
+import time
 from pathlib import Path
 
 import click
+from yaml import safe_load as yaml_safe_load
 
 import imgtool.keys as keys
 from imgtool import image, imgtool_version
 from imgtool.dumpinfo import dump_imginfo
+from imgtool.verify_cache import VerifyCache, key_fingerprint
 from imgtool.version import decode_version
 
 from .keys import ECDSAUsageError, Ed25519UsageError, RSAUsageError, X25519UsageError
@@ -66,7 +75,8 @@ def gen_x25519(keyfile, passwd):
 
 valid_langs = ['c', 'rust']
 valid_hash_encodings = ['lang-c', 'raw']
-valid_encodings = ['lang-c', 'lang-rust', 'pem', 'raw']
+valid_encodings = ['lang-c', 'lang-rust', 'pem', 'raw', 'lang-c-comb',
+                   'lang-c-table']
 
 
 def _validate_name_suffix(ctx: click.Context, param: click.Parameter, value: str) -> str:
@@ -103,7 +113,19 @@ def save_signature(sigfile, sig):
         f.write(signature)
 
 
+# When signing several images in the same process (sign-batch), the
+# passphrases of the keys, which were asked for up front, and the keys already
+# loaded, by path.
+_batch_passwords = None
+_batch_keys = {}
+
+
 def load_key(keyfile):
+    if _batch_passwords is not None:
+        if keyfile not in _batch_keys:
+            _batch_keys[keyfile] = keys.load(keyfile, _batch_passwords.get(keyfile))
+        # sign sets attributes of the key, such as pad_sig, for its image only.
+        return copy.copy(_batch_keys[keyfile])
     # TODO: better handling of invalid pass-phrase
     key = keys.load(keyfile)
     if key is not None:
@@ -182,6 +204,16 @@ def getpub(key, encoding, lang, output, name_suffix):
         key.emit_public_pem(file=output)
     elif encoding == 'raw':
         key.emit_raw_public(file=output)
+    elif encoding == 'lang-c-comb':
+        if not hasattr(key, 'emit_c_comb'):
+            raise click.UsageError(
+                'The lang-c-comb encoding is only available for ECDSA P-256 keys')
+        key.emit_c_comb(file=output, name_suffix=name_suffix)
+    elif encoding == 'lang-c-table':
+        if not hasattr(key, 'emit_c_table'):
+            raise click.UsageError(
+                'The lang-c-table encoding is only available for RSA and Ed25519 keys')
+        key.emit_c_table(file=output, name_suffix=name_suffix)
     else:
         raise click.UsageError()
 
@@ -270,33 +302,136 @@ def getpriv(key, minimal, format):
         raise click.UsageError(e)
 
 
-@click.argument('imgfile')
+VERIFY_MESSAGES = {
+    image.VerifyResult.OK: "Image was correctly validated",
+    image.VerifyResult.INVALID_MAGIC: "Invalid image magic; is this an MCUboot image?",
+    image.VerifyResult.INVALID_TLV_INFO_MAGIC: "Invalid TLV info magic; is this an MCUboot image?",
+    image.VerifyResult.INVALID_HASH: "Image has an invalid hash",
+    image.VerifyResult.INVALID_SIGNATURE: "No signature found for the given key",
+    image.VerifyResult.KEY_MISMATCH: "Key type does not match TLV record",
+}
+
+# Key used by the verify worker processes.
+_verify_key = None
+
+
+def _verify_init(keyfile, passwd):
+    global _verify_key
+    _verify_key = keys.load(keyfile, passwd) if keyfile else None
+
+
+def _verify_run(imgfile):
+    """Verify one image, returning its result, or the error which prevented
+    verifying it."""
+    try:
+        return image.Image.verify(imgfile, _verify_key), None
+    except click.ClickException as e:
+        return None, e.format_message()
+    except Exception as e:
+        return None, f'{type(e).__name__}: {e}'
+
+
+def _verify_files(paths):
+    """The images to verify: the files given, and the .bin and .hex files
+    found in the directories given."""
+    files = []
+    for path in paths:
+        if not os.path.isdir(path):
+            files.append(path)
+            continue
+        for root, dirs, names in os.walk(path):
+            dirs.sort()
+            for name in sorted(names):
+                ext = os.path.splitext(name)[1][1:].lower()
+                if ext in (image.BIN_EXT, image.INTEL_HEX_EXT):
+                    files.append(os.path.join(root, name))
+    return files
+
+
+@click.argument('imgfiles', metavar='IMGFILE...', nargs=-1, required=True)
+@click.option('-j', '--jobs', 'workers', type=int, default=1,
+              help='Number of worker processes verifying the images')
+@click.option('--cache', metavar='filename',
+              help='Cache of the verification results, which are reused for '
+                   'the images and key already verified')
 @click.option('-k', '--key', metavar='filename')
-@click.command(help="Check that signed image can be verified by given key")
-def verify(key, imgfile):
-    key = load_key(key) if key else None
-    ret, version, digest, signature = image.Image.verify(imgfile, key)
-    if ret == image.VerifyResult.OK:
-        print("Image was correctly validated")
+@click.command(help='''Check that signed images can be verified by given
+               key\n
+               The .bin and .hex images found in the directories given are
+               verified.''')
+def verify(key, imgfiles, cache, workers):
+    global _verify_key
+    _verify_key = None
+    passwd = None
+    if key:
+        _verify_key = keys.load(key)
+        if _verify_key is None:
+            passwd = getpass.getpass("Enter key passphrase: ").encode('utf-8')
+            _verify_key = keys.load(key, passwd)
+
+    files = _verify_files(imgfiles)
+    results = {}
+    digests = {}
+    verify_cache = VerifyCache(cache) if cache else None
+    key_fp = key_fingerprint(_verify_key)
+    todo = []
+    for imgfile in files:
+        if verify_cache is not None:
+            try:
+                digests[imgfile] = verify_cache.file_digest(imgfile)
+            except OSError:
+                todo.append(imgfile)
+                continue
+            cached = verify_cache.get(digests[imgfile], key_fp)
+            if cached is not None:
+                results[imgfile] = (cached, None)
+                continue
+        todo.append(imgfile)
+
+    workers = min(workers, len(todo))
+    if workers > 1:
+        with multiprocessing.Pool(workers, _verify_init, (key, passwd)) as pool:
+            runs = pool.map(_verify_run, todo)
+    else:
+        runs = [_verify_run(imgfile) for imgfile in todo]
+    for imgfile, (result, error) in zip(todo, runs):
+        results[imgfile] = (result, error)
+        if verify_cache is not None and result is not None and imgfile in digests:
+            verify_cache.put(digests[imgfile], key_fp, result)
+    if verify_cache is not None:
+        verify_cache.save()
+
+    if len(files) == 1 and not os.path.isdir(imgfiles[0]):
+        result, error = results[files[0]]
+        if result is None:
+            raise click.UsageError(error)
+        ret, version, digest, signature = result
+        print(VERIFY_MESSAGES.get(ret, f"Unknown return code: {ret}"))
+        if ret != image.VerifyResult.OK:
+            sys.exit(1)
         print("Image version: {}.{}.{}+{}".format(*version))
         if digest:
             print(f"Image digest: {digest.hex()}")
         if signature and digest is None:
             print(f"Image signature over image: {signature.hex()}")
         return
-    elif ret == image.VerifyResult.INVALID_MAGIC:
-        print("Invalid image magic; is this an MCUboot image?")
-    elif ret == image.VerifyResult.INVALID_TLV_INFO_MAGIC:
-        print("Invalid TLV info magic; is this an MCUboot image?")
-    elif ret == image.VerifyResult.INVALID_HASH:
-        print("Image has an invalid hash")
-    elif ret == image.VerifyResult.INVALID_SIGNATURE:
-        print("No signature found for the given key")
-    elif ret == image.VerifyResult.KEY_MISMATCH:
-        print("Key type does not match TLV record")
-    else:
-        print(f"Unknown return code: {ret}")
-    sys.exit(1)
+
+    failed = 0
+    for imgfile in files:
+        result, error = results[imgfile]
+        if result is None:
+            print(f"{imgfile}: {error}")
+            failed += 1
+            continue
+        ret, version, _, _ = result
+        if ret == image.VerifyResult.OK:
+            print(f"{imgfile}: OK, version {version[0]}.{version[1]}.{version[2]}+{version[3]}")
+        else:
+            print(f"{imgfile}: {VERIFY_MESSAGES.get(ret, ret)}")
+            failed += 1
+    print(f"{len(files) - failed} of {len(files)} images were correctly validated")
+    if failed:
+        sys.exit(1)
 
 
 @click.argument('imgfile')
@@ -304,11 +439,13 @@ def verify(key, imgfile):
               help='Save image information to outfile in YAML format')
 @click.option('-s', '--silent', default=False, is_flag=True,
               help='Do not print image information to output')
+@click.option('--json', 'json_output', default=False, is_flag=True,
+              help='Print image information in JSON, for other tools')
 @click.command(help='Print header, TLV area and trailer information '
                     'of a signed image')
-def dumpinfo(imgfile, outfile, silent):
-    dump_imginfo(imgfile, outfile, silent)
-    if not silent:
+def dumpinfo(imgfile, outfile, silent, json_output):
+    dump_imginfo(imgfile, outfile, silent, json_output)
+    if not silent and not json_output:
         print("dumpinfo has run successfully")
 
 
@@ -690,6 +827,125 @@ def sign(key, public_key_format, align, version, pad_sig, header_size,
         save_signature(sig_out, new_signature)
 
 
+def _sign_batch_init(passwords):
+    global _batch_passwords
+    _batch_passwords = passwords
+    _batch_keys.clear()
+
+
+def _sign_batch_run(job):
+    """Run one sign job, returning its name, its error if it failed, what it
+    printed and how long it took."""
+    name, args = job
+    start = time.perf_counter()
+    out = io.StringIO()
+    error = None
+    try:
+        with contextlib.redirect_stdout(out):
+            with sign.make_context('sign', list(args)) as ctx:
+                sign.invoke(ctx)
+    except click.ClickException as e:
+        error = e.format_message()
+    except Exception as e:
+        error = f'{type(e).__name__}: {e}'
+    return name, error, out.getvalue(), time.perf_counter() - start
+
+
+def _sign_batch_jobs(manifest):
+    with open(manifest) as f:
+        config = yaml_safe_load(f)
+    if isinstance(config, list):
+        config = {'jobs': config}
+    if not isinstance(config, dict) or not isinstance(config.get('jobs'), list):
+        raise click.UsageError(f'{manifest}: expected a list of jobs')
+
+    defaults = [str(arg) for arg in config.get('defaults', [])]
+    jobs = []
+    for index, job in enumerate(config['jobs']):
+        if not isinstance(job, dict) or not isinstance(job.get('args'), list):
+            raise click.UsageError(f'{manifest}: job {index} has no list of args')
+        name = str(job.get('name', index))
+        jobs.append((name, defaults + [str(arg) for arg in job['args']]))
+    return jobs
+
+
+def _sign_batch_passwords(jobs):
+    """Ask for the passphrases of the encrypted keys used by the jobs, once
+    for each key."""
+    paths = set()
+    for _, args in jobs:
+        ctx = sign.make_context('sign', list(args), resilient_parsing=True)
+        for param in ('key', 'encrypt', 'fix_sig_pubkey'):
+            if ctx.params.get(param):
+                paths.add(ctx.params[param])
+
+    passwords = {}
+    for path in sorted(paths):
+        try:
+            if keys.load(path) is None:
+                passwd = getpass.getpass(f'Enter passphrase for {path}: ').encode('utf-8')
+                keys.load(path, passwd)
+                passwords[path] = passwd
+        except Exception as e:
+            raise click.UsageError(f'Cannot load key {path}: {e}')
+    return passwords
+
+
+@click.option('--results', metavar='filename',
+              help='Write the result and duration of each job to this file, '
+                   'in JSON')
+@click.option('-j', '--jobs', 'workers', type=int, default=None,
+              help='Number of worker processes (defaults to the number of '
+                   'CPUs)')
+@click.argument('manifest')
+@click.command('sign-batch', help='''Sign a batch of images\n
+               MANIFEST is a YAML (or JSON) file holding a list of jobs, each
+               with an optional name and the arguments of a sign command, and
+               optionally default arguments placed before those of every job.
+               Each key is loaded, and its passphrase asked for, only once,
+               and the images are signed in parallel.''')
+def sign_batch(manifest, workers, results):
+    jobs = _sign_batch_jobs(manifest)
+    passwords = _sign_batch_passwords(jobs)
+    workers = min(workers or os.cpu_count() or 1, max(len(jobs), 1))
+
+    start = time.perf_counter()
+    report = []
+    failed = 0
+    if workers > 1:
+        pool = multiprocessing.Pool(workers, _sign_batch_init, (passwords,))
+        runs = pool.imap(_sign_batch_run, jobs)
+    else:
+        pool = None
+        _sign_batch_init(passwords)
+        runs = map(_sign_batch_run, jobs)
+    try:
+        for name, error, output, duration in runs:
+            for line in output.splitlines():
+                print(f'{name}: {line}')
+            if error is None:
+                print(f'{name}: signed in {duration:.3f} s')
+            else:
+                print(f'{name}: failed: {error}')
+                failed += 1
+            report.append({'name': name, 'ok': error is None, 'error': error,
+                           'seconds': round(duration, 6)})
+    finally:
+        if pool is not None:
+            pool.close()
+            pool.join()
+        else:
+            _sign_batch_init(None)
+
+    print(f'{len(jobs) - failed} of {len(jobs)} images signed in '
+          f'{time.perf_counter() - start:.3f} s')
+    if results is not None:
+        with open(results, 'w') as f:
+            json.dump(report, f, indent=2)
+    if failed:
+        raise click.ClickException(f'{failed} of {len(jobs)} jobs failed')
+
+
 class AliasesGroup(click.Group):
 
     _aliases = {
@@ -728,6 +984,7 @@ imgtool.add_command(getpriv)
 imgtool.add_command(keyinfo)
 imgtool.add_command(verify)
 imgtool.add_command(sign)
+imgtool.add_command(sign_batch)
 imgtool.add_command(version)
 imgtool.add_command(dumpinfo)
 
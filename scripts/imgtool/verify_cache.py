@@ -0,0 +1,104 @@
+# Copyright (c) 2026 Linaro LTD
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Cache of the results of image verifications.
+
+The results are keyed by the SHA-256 of the image file and the fingerprint of
+the key, so that an image is only verified again when its content or the key
+changes. The SHA-256 of each file is itself kept along with its size and
+modification time, so that unchanged files aren't even read.
+"""
+import hashlib
+import json
+import os
+
+from imgtool import image, imgtool_version
+
+CACHE_VERSION = 1
+
+
+def key_fingerprint(key):
+    """The SHA-256 of the public key, or 'none' when verifying without a key."""
+    if key is None:
+        return 'none'
+    return hashlib.sha256(key.get_public_bytes()).hexdigest()
+
+
+class VerifyCache:
+
+    def __init__(self, path):
+        self.path = path
+        self.files = {}
+        self.results = {}
+        try:
+            with open(path) as f:
+                data = json.load(f)
+        except FileNotFoundError:
+            return
+        except ValueError:
+            # A corrupted cache is dropped and rebuilt.
+            return
+        if (data.get('version') == CACHE_VERSION and
+                data.get('imgtool_version') == imgtool_version):
+            self.files = data.get('files', {})
+            self.results = data.get('results', {})
+
+    def file_digest(self, path):
+        """The SHA-256 of a file, only computed if the file changed."""
+        st = os.stat(path)
+        name = os.path.abspath(path)
+        entry = self.files.get(name)
+        if (entry is not None and entry['size'] == st.st_size and
+                entry['mtime_ns'] == st.st_mtime_ns):
+            return entry['sha256']
+
+        sha = hashlib.sha256()
+        with open(path, 'rb') as f:
+            for chunk in iter(lambda: f.read(image.CHUNK_SIZE), b''):
+                sha.update(chunk)
+        digest = sha.hexdigest()
+        self.files[name] = {'size': st.st_size, 'mtime_ns': st.st_mtime_ns,
+                            'sha256': digest}
+        return digest
+
+    def get(self, file_digest, key_fp):
+        """The result of a previous verification, as returned by
+        Image.verify(), or None."""
+        entry = self.results.get(f'{file_digest}:{key_fp}')
+        if entry is None:
+            return None
+        return (image.VerifyResult[entry['result']],
+                tuple(entry['version']) if entry['version'] else None,
+                bytes.fromhex(entry['digest']) if entry['digest'] else None,
+                bytes.fromhex(entry['signature']) if entry['signature'] else None)
+
+    def put(self, file_digest, key_fp, result):
+        ret, version, digest, signature = result
+        self.results[f'{file_digest}:{key_fp}'] = {
+            'result': ret.name,
+            'version': list(version) if version else None,
+            'digest': digest.hex() if digest else None,
+            'signature': signature.hex() if signature else None,
+        }
+
+    def save(self):
+        data = {'version': CACHE_VERSION, 'imgtool_version': imgtool_version,
+                'files': self.files, 'results': self.results}
+        tmp = self.path + '.tmp'
+        with open(tmp, 'w') as f:
+            json.dump(data, f)
+        os.replace(tmp, self.path)
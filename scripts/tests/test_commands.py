@@ -30,6 +30,7 @@ COMMANDS = [
     "keygen",
     "keyinfo",
     "sign",
+    "sign-batch",
     "verify",
     "version",
 ]
@@ -17,11 +17,16 @@ import subprocess
 import pytest
 from click.testing import CliRunner
 from imgtool import main as imgtool_main
+from imgtool.keys.ed25519 import _ed25519_add, ed25519_key_table
+from imgtool.keys.rsa import rsa_key_table
 from imgtool.main import imgtool
 
 # all supported key types for 'keygen'
 KEY_TYPES = [*imgtool_main.keygens]
-KEY_ENCODINGS = [*imgtool_main.valid_encodings]
+# lang-c-comb only applies to ECDSA P-256 keys and lang-c-table to RSA and
+# Ed25519 keys, see test_getpub_comb and test_getpub_table
+KEY_ENCODINGS = [e for e in imgtool_main.valid_encodings
+                 if e not in ("lang-c-comb", "lang-c-table")]
 PUB_HASH_ENCODINGS = [*imgtool_main.valid_hash_encodings]
 PVT_KEY_FORMATS = [*imgtool_main.valid_formats]
 
@@ -148,6 +153,100 @@ def test_getpub(key_type, encoding, tmp_path_persistent):
     assert pub_key.stat().st_size > 0
 
 
+@pytest.mark.parametrize("key_type", KEY_TYPES)
+def test_getpub_comb(key_type, tmp_path_persistent):
+    """Get the comb table of an ECDSA P-256 public key"""
+    runner = CliRunner()
+
+    gen_key = tmp_name(tmp_path_persistent, key_type, GEN_KEY_EXT)
+    comb = tmp_name(tmp_path_persistent, key_type, PUB_KEY_EXT + ".comb.c")
+
+    result = runner.invoke(
+        imgtool,
+        [
+            "getpub", "--key", str(gen_key),
+            "--output", str(comb),
+            "--encoding", "lang-c-comb",
+            "--name-suffix", "_2",
+        ],
+    )
+    if key_type != "ecdsa-p256":
+        assert result.exit_code != 0
+        return
+
+    assert result.exit_code == 0
+    content = comb.read_text()
+    assert "ecdsa_pub_key_2_comb[]" in content
+    # 15 points, each with 32-byte x and y coordinates
+    assert "ecdsa_pub_key_2_comb_len = 960;" in content
+
+
+@pytest.mark.parametrize("key_type", KEY_TYPES)
+def test_getpub_table(key_type, tmp_path_persistent):
+    """Get the precomputed table of an RSA or Ed25519 public key"""
+    runner = CliRunner()
+
+    gen_key = tmp_name(tmp_path_persistent, key_type, GEN_KEY_EXT)
+    table = tmp_name(tmp_path_persistent, key_type, PUB_KEY_EXT + ".table.c")
+
+    result = runner.invoke(
+        imgtool,
+        [
+            "getpub", "--key", str(gen_key),
+            "--output", str(table),
+            "--encoding", "lang-c-table",
+        ],
+    )
+    if key_type == "ed25519":
+        # 15 points, each with 32-byte x and y coordinates
+        name, size = "ed25519", 960
+    elif key_type in ("rsa-2048", "rsa-3072"):
+        # The modulus and R^2 mod N, followed by a 32-bit word
+        name, size = "rsa", 2 * int(key_type[4:]) // 8 + 4
+    else:
+        assert result.exit_code != 0
+        return
+
+    assert result.exit_code == 0
+    content = table.read_text()
+    assert f"{name}_pub_key_table[]" in content
+    assert f"{name}_pub_key_table_len = {size};" in content
+
+
+def test_ed25519_key_table():
+    """Check the layout of an Ed25519 key table"""
+    # Public key of RFC 8032 test 1
+    pub = bytes.fromhex(
+        "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a")
+    table = ed25519_key_table(pub)
+
+    assert len(table) == 15 * 64
+    x = int.from_bytes(table[0:32], "little")
+    y = int.from_bytes(table[32:64], "little")
+    assert (y | (x & 1) << 255).to_bytes(32, "little") == pub
+
+    # Entry 1 is 2^64 * A, and entry 2 is the sum of the first two.
+    x1 = int.from_bytes(table[64:96], "little")
+    y1 = int.from_bytes(table[96:128], "little")
+    assert table[128:192] == b"".join(
+        c.to_bytes(32, "little") for c in _ed25519_add((x, y), (x1, y1)))
+
+
+def test_rsa_key_table():
+    """Check the Montgomery parameters of an RSA key table"""
+    # Any odd modulus will do, here the product of two Mersenne primes.
+    n = ((1 << 1279) - 1) * ((1 << 607) - 1)
+    size = (n.bit_length() + 7) // 8
+    table = rsa_key_table(n)
+
+    assert len(table) == 2 * size + 4
+    assert int.from_bytes(table[:size], "little") == n
+    r = 1 << (8 * size)
+    assert int.from_bytes(table[size:2 * size], "little") == r * r % n
+    n0inv = int.from_bytes(table[2 * size:], "little")
+    assert (n * n0inv + 1) % (1 << 32) == 0
+
+
 @pytest.mark.parametrize("key_type", KEY_TYPES)
 @pytest.mark.parametrize("encoding", PUB_HASH_ENCODINGS)
 def test_getpubhash(key_type, encoding, tmp_path_persistent):
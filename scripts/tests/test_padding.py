@@ -0,0 +1,60 @@
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from pathlib import Path
+
+import pytest
+from click.testing import CliRunner
+from imgtool import image
+from imgtool.dumpinfo import BOOT_MAGIC
+from imgtool.main import imgtool
+
+ROOT = Path(__file__).parents[2]
+# Larger than the chunks in which the image and its padding are processed.
+SLOT_SIZE = 4 * image.CHUNK_SIZE + 0x1000
+
+
+@pytest.mark.parametrize('encrypt', [False, True])
+def test_padded_image(tmp_path, encrypt):
+    """
+    Sign a padded image larger than a chunk, and check its padding and
+    trailer, and that verify and dumpinfo read it.
+    """
+    in_file = tmp_path / 'zephyr.bin'
+    in_file.write_bytes(bytes(range(256)) * (image.CHUNK_SIZE // 128 + 3))
+    out_file = tmp_path / 'zephyr_signed.bin'
+
+    args = ['sign', '--key', str(ROOT / 'root-ec-p256.pem'), '--version', '1.0.0',
+            '--header-size', '0x200', '--pad-header', '--slot-size', hex(SLOT_SIZE),
+            '--pad', '--confirm']
+    if encrypt:
+        args += ['-E', str(ROOT / 'enc-ec256-pub.pem')]
+
+    runner = CliRunner()
+    result = runner.invoke(imgtool, args + [str(in_file), str(out_file)])
+    assert result.exit_code == 0
+
+    data = out_file.read_bytes()
+    assert len(data) == SLOT_SIZE
+    assert data[-len(BOOT_MAGIC):] == BOOT_MAGIC
+
+    result = runner.invoke(imgtool, ['dumpinfo', str(out_file)])
+    assert result.exit_code == 0
+    assert 'image_ok:    SET' in result.output
+
+    # The hash of an encrypted image is the one of its plain text.
+    if not encrypt:
+        result = runner.invoke(imgtool, ['verify', '--key', str(ROOT / 'root-ec-p256.pem'),
+                                         str(out_file)])
+        assert result.exit_code == 0
@@ -0,0 +1,73 @@
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import json
+from pathlib import Path
+
+import pytest
+from click.testing import CliRunner
+from imgtool.main import imgtool
+
+SIGN_ARGS = ['--header-size=0x200', '--slot-size=0x20000', '--pad-header']
+
+
+@pytest.fixture
+def key_file() -> Path:
+    # Ed25519 signatures are deterministic, so the images can be compared.
+    return Path(__file__).parents[2] / 'root-ed25519.pem'
+
+
+@pytest.mark.parametrize('workers', ['1', '2'])
+def test_sign_batch(tmpdir, key_file, workers):
+    """
+    Sign images with ``imgtool sign-batch`` and check that they are the same
+    as those of ``imgtool sign``.
+    """
+    runner = CliRunner()
+    jobs = []
+    for i in range(3):
+        in_file = tmpdir / f'image{i}.bin'
+        with in_file.open('wb') as f:
+            f.write(bytes([i]) * (1000 + 100 * i))
+        args = [f'--key={key_file}', f'--version=1.{i}.0', str(in_file)]
+
+        result = runner.invoke(imgtool, ['sign'] + SIGN_ARGS + args +
+                               [str(tmpdir / f'single{i}.bin')])
+        assert result.exit_code == 0
+        jobs.append({'name': f'image{i}', 'args': args + [str(tmpdir / f'batch{i}.bin')]})
+
+    # A job which fails does not stop the others.
+    jobs.append({'name': 'missing', 'args': [f'--key={key_file}', '--version=1.0.0',
+                                             str(tmpdir / 'missing.bin'),
+                                             str(tmpdir / 'missing_signed.bin')]})
+
+    manifest = tmpdir / 'jobs.json'
+    with manifest.open('w') as f:
+        json.dump({'defaults': SIGN_ARGS, 'jobs': jobs}, f)
+    results = tmpdir / 'results.json'
+
+    result = runner.invoke(imgtool, ['sign-batch', '-j', workers, '--results',
+                                     str(results), str(manifest)])
+    assert result.exit_code != 0
+    assert '3 of 4 images signed' in result.output
+
+    for i in range(3):
+        single = (tmpdir / f'single{i}.bin').read_binary()
+        batch = (tmpdir / f'batch{i}.bin').read_binary()
+        assert single == batch
+
+    with results.open() as f:
+        report = json.load(f)
+    assert [job['name'] for job in report] == ['image0', 'image1', 'image2', 'missing']
+    assert [job['ok'] for job in report] == [True, True, True, False]
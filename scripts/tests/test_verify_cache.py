@@ -0,0 +1,88 @@
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import json
+from pathlib import Path
+
+import pytest
+from click.testing import CliRunner
+from imgtool import image
+from imgtool.main import imgtool
+
+KEY = Path(__file__).parents[2] / 'root-ec-p256.pem'
+
+
+@pytest.fixture
+def images(tmp_path):
+    runner = CliRunner()
+    paths = []
+    for i in range(3):
+        in_file = tmp_path / f'app{i}.raw'
+        in_file.write_bytes(bytes([i]) * 4096)
+        out_file = tmp_path / 'store' / f'app{i}.bin'
+        out_file.parent.mkdir(exist_ok=True)
+        result = runner.invoke(imgtool, ['sign', '--key', str(KEY), '--version', f'1.{i}.0',
+                                         '--header-size', '0x200', '--pad-header',
+                                         '--slot-size', '0x10000', str(in_file), str(out_file)])
+        assert result.exit_code == 0
+        paths.append(out_file)
+    return paths
+
+
+@pytest.mark.parametrize('workers', ['1', '2'])
+def test_verify_directory(tmp_path, images, workers):
+    """Verify a directory of images, in parallel."""
+    runner = CliRunner()
+    result = runner.invoke(imgtool, ['verify', '--key', str(KEY), '-j', workers,
+                                     str(tmp_path / 'store')])
+    assert result.exit_code == 0
+    assert '3 of 3 images were correctly validated' in result.output
+    assert f'{images[1]}: OK, version 1.1.0+0' in result.output
+
+
+def test_verify_cache(tmp_path, images, monkeypatch):
+    """Check that the cached results are used for unchanged images only."""
+    runner = CliRunner()
+    cache = tmp_path / 'cache.json'
+    args = ['verify', '--key', str(KEY), '--cache', str(cache), str(tmp_path / 'store')]
+
+    result = runner.invoke(imgtool, args)
+    assert result.exit_code == 0
+    assert len(json.loads(cache.read_text())['results']) == 3
+
+    def fail(imgfile, key):
+        raise RuntimeError('not cached')
+
+    monkeypatch.setattr(image.Image, 'verify', staticmethod(fail))
+    result = runner.invoke(imgtool, args)
+    assert result.exit_code == 0
+    assert '3 of 3 images were correctly validated' in result.output
+
+    # Changing the size makes sure the change is seen, whatever the
+    # resolution of the modification times.
+    images[2].write_bytes(images[2].read_bytes() + b'\xff')
+    result = runner.invoke(imgtool, args)
+    assert result.exit_code != 0
+    assert f'{images[2]}: RuntimeError: not cached' in result.output
+
+
+def test_dumpinfo_json(images):
+    """Check the JSON output of dumpinfo."""
+    runner = CliRunner()
+    result = runner.invoke(imgtool, ['dumpinfo', '--json', str(images[0])])
+    assert result.exit_code == 0
+    info = json.loads(result.output)
+    assert info['header']['magic'] == image.IMAGE_MAGIC
+    assert info['header']['version'] == '1.0.0+0'
+    assert any(tlv['type'] == image.TLV_VALUES['SHA256'] for tlv in info['tlv_area']['tlvs'])
@@ -17,10 +17,18 @@ fn main() {
     let sig_ecdsa_mbedtls = env::var("CARGO_FEATURE_SIG_ECDSA_MBEDTLS").is_ok();
     let sig_ecdsa_psa = env::var("CARGO_FEATURE_SIG_ECDSA_PSA").is_ok();
     let sig_p384 = env::var("CARGO_FEATURE_SIG_P384").is_ok();
+    let ecdsa_comb = env::var("CARGO_FEATURE_ECDSA_COMB").is_ok();
+    let ed25519_tables = env::var("CARGO_FEATURE_ED25519_TABLES").is_ok();
+    let rsa_tables = env::var("CARGO_FEATURE_RSA_TABLES").is_ok();
+    let sha_kernels = env::var("CARGO_FEATURE_SHA_KERNELS").is_ok();
+    let sha_flash_range = env::var("CARGO_FEATURE_SHA_FLASH_RANGE").is_ok();
     let sig_ed25519 = env::var("CARGO_FEATURE_SIG_ED25519").is_ok();
     let overwrite_only = env::var("CARGO_FEATURE_OVERWRITE_ONLY").is_ok();
     let swap_move = env::var("CARGO_FEATURE_SWAP_MOVE").is_ok();
     let swap_offset = env::var("CARGO_FEATURE_SWAP_OFFSET").is_ok();
+    let swap_status_packed = env::var("CARGO_FEATURE_SWAP_STATUS_PACKED").is_ok();
+    let swap_offset_no_backup = env::var("CARGO_FEATURE_SWAP_OFFSET_NO_BACKUP").is_ok();
+    let skip_pre_erased = env::var("CARGO_FEATURE_SKIP_PRE_ERASED").is_ok();
     let validate_primary_slot =
                   env::var("CARGO_FEATURE_VALIDATE_PRIMARY_SLOT").is_ok();
     let enc_rsa = env::var("CARGO_FEATURE_ENC_RSA").is_ok();
@@ -40,12 +48,18 @@ fn main() {
     let max_align_32 = env::var("CARGO_FEATURE_MAX_ALIGN_32").is_ok();
     let hw_rollback_protection = env::var("CARGO_FEATURE_HW_ROLLBACK_PROTECTION").is_ok();
     let check_load_addr = env::var("CARGO_FEATURE_CHECK_LOAD_ADDR").is_ok();
+    let log_binary = env::var("CARGO_FEATURE_LOG_BINARY").is_ok();
+    let fih_profiles: Vec<&str> = ["OFF", "LOW", "MEDIUM", "HIGH"].iter()
+        .filter(|p| env::var(format!("CARGO_FEATURE_FIH_PROFILE_{}", p)).is_ok())
+        .cloned()
+        .collect();
 
     let mut conf = CachedBuild::new();
     conf.conf.define("__BOOTSIM__", None);
     conf.conf.define("MCUBOOT_HAVE_LOGGING", None);
     conf.conf.define("MCUBOOT_USE_FLASH_AREA_GET_SECTORS", None);
     conf.conf.define("MCUBOOT_HAVE_ASSERT_H", None);
+    conf.conf.define("MCUBOOT_SCRATCH_STATS", None);
     conf.conf.define("MCUBOOT_MAX_IMG_SECTORS", Some("128"));
 
     if max_align_32 {
@@ -55,6 +69,11 @@ fn main() {
     }
 
     conf.conf.define("MCUBOOT_IMAGE_NUMBER", Some(if multiimage { "2" } else { "1" }));
+    if multiimage {
+        // Let the dependency resolver be exercised with more images than the
+        // simulated devices have.
+        conf.conf.define("MCUBOOT_DEPS_MAX_IMAGES", Some("8"));
+    }
 
     if downgrade_prevention && !overwrite_only {
         panic!("Downgrade prevention requires overwrite only");
@@ -85,6 +104,23 @@ fn main() {
         conf.conf.define("MCUBOOT_DIRECT_XIP", None);
     }
 
+    if log_binary {
+        conf.conf.define("MCUBOOT_LOG_BINARY", None);
+        conf.conf.define("MCUBOOT_LOG_BINARY_SIZE", Some("4096"));
+    }
+
+    if fih_profiles.len() > 1 {
+        panic!("Only one FIH profile can be selected");
+    }
+    if fih_profiles.is_empty() && env::var("CARGO_FEATURE_FIH_PROFILING").is_ok() {
+        panic!("fih-profiling is set by the fih-profile features");
+    }
+    if let Some(profile) = fih_profiles.first() {
+        conf.conf.define(&format!("MCUBOOT_FIH_PROFILE_{}", profile), None);
+        conf.conf.define("MCUBOOT_FIH_PROFILING", None);
+        conf.file("csupport/fih_profile.c");
+    }
+
     if hw_rollback_protection {
         conf.conf.define("MCUBOOT_HW_ROLLBACK_PROT", None);
         conf.file("csupport/security_cnt.c");
@@ -184,6 +220,10 @@ fn main() {
         conf.file("../../ext/mbedtls/library/asn1parse.c");
         conf.file("../../ext/mbedtls/library/md.c");
 
+        if rsa_tables {
+            conf.conf.define("MCUBOOT_RSA_KEY_TABLES", None);
+            conf.file("../../boot/bootutil/src/rsa_mont.c");
+        }
     } else if sig_ecdsa {
         conf.conf.define("MCUBOOT_SIGN_EC256", None);
         conf.conf.define("MCUBOOT_USE_TINYCRYPT", None);
@@ -202,6 +242,11 @@ fn main() {
         conf.file("../../ext/tinycrypt/lib/source/ecc_platform_specific.c");
         conf.file("../../ext/mbedtls/library/platform_util.c");
         conf.file("../../ext/mbedtls/library/asn1parse.c");
+
+        if ecdsa_comb {
+            conf.conf.define("MCUBOOT_ECDSA_COMB_TABLES", None);
+            conf.file("../../boot/bootutil/src/ecdsa_comb.c");
+        }
     } else if sig_ecdsa_mbedtls {
         conf.conf.define("MCUBOOT_SIGN_EC256", None);
         conf.conf.define("MCUBOOT_USE_MBED_TLS", None);
@@ -255,6 +300,10 @@ fn main() {
         conf.file("../../ext/fiat/src/curve25519.c");
         conf.file("../../ext/mbedtls/library/platform_util.c");
         conf.file("../../ext/mbedtls/library/asn1parse.c");
+
+        if ed25519_tables {
+            conf.conf.define("MCUBOOT_ED25519_KEY_TABLES", None);
+        }
     } else if !enc_ec256 && !enc_x25519 {
         // No signature type, only sha256 validation. The default
         // configuration file bundled with mbedTLS is sufficient.
@@ -265,6 +314,29 @@ fn main() {
         conf.file("../../ext/mbedtls/library/platform_util.c");
     }
 
+    if sha_kernels {
+        if !sig_ecdsa && !sig_ed25519 {
+            panic!("sha-kernels requires sig-ecdsa or sig-ed25519");
+        }
+
+        let arch = env::var("CARGO_CFG_TARGET_ARCH").unwrap();
+        let target_features = env::var("CARGO_CFG_TARGET_FEATURE").unwrap_or_default();
+        if arch == "x86_64" || arch == "x86" {
+            conf.conf.define("MCUBOOT_SHA_KERNEL_SHA_NI", None);
+        } else if arch == "aarch64" && target_features.split(',').any(|f| f == "sha2") {
+            conf.conf.define("MCUBOOT_SHA_KERNEL_ARMV8_CE", None);
+            conf.conf.flag("-march=armv8-a+crypto");
+        } else {
+            conf.conf.define("MCUBOOT_SHA_KERNEL_UNROLLED", None);
+        }
+        conf.file("../../boot/bootutil/src/sha_kernels.c");
+    }
+
+    if sha_flash_range {
+        conf.conf.define("MCUBOOT_SHA_FLASH_RANGE", None);
+        conf.file("csupport/sha_flash_range.c");
+    }
+
     if overwrite_only {
         conf.conf.define("MCUBOOT_OVERWRITE_ONLY", None);
     }
@@ -278,6 +350,27 @@ fn main() {
         conf.conf.define("MCUBOOT_SWAP_USING_SCRATCH", None);
     }
 
+    if swap_status_packed {
+        if overwrite_only || direct_xip || ram_load {
+            panic!("The packed swap status requires a swap upgrade strategy");
+        }
+        conf.conf.define("MCUBOOT_SWAP_STATUS_PACKED", None);
+    }
+
+    if swap_offset_no_backup {
+        if !swap_offset {
+            panic!("swap-offset-no-backup requires swap-offset");
+        }
+        conf.conf.define("MCUBOOT_SWAP_OFFSET_PERM_NO_BACKUP", None);
+    }
+
+    if skip_pre_erased {
+        if overwrite_only || swap_move || ram_load || direct_xip {
+            panic!("skip-pre-erased requires swap using scratch or swap-offset");
+        }
+        conf.conf.define("MCUBOOT_SKIP_PRE_ERASED", None);
+    }
+
     if enc_rsa || enc_aes256_rsa {
         if enc_aes256_rsa {
                 conf.conf.define("MCUBOOT_AES_256", None);
@@ -494,8 +587,13 @@ fn main() {
     conf.file("../../boot/bootutil/src/caps.c");
     conf.file("../../boot/bootutil/src/bootutil_misc.c");
     conf.file("../../boot/bootutil/src/bootutil_area.c");
+    conf.file("../../boot/bootutil/src/bootutil_depends.c");
     conf.file("../../boot/bootutil/src/bootutil_loader.c");
+    conf.file("../../boot/bootutil/src/bootutil_scratch.c");
     conf.file("../../boot/bootutil/src/bootutil_public.c");
+    conf.file("../../boot/bootutil/src/boot_request_log.c");
+    conf.file("../../boot/bootutil/src/boot_image_writer.c");
+    conf.file("../../boot/bootutil/src/boot_log_binary.c");
     conf.file("../../boot/bootutil/src/tlv.c");
     conf.file("../../boot/bootutil/src/fault_injection_hardening.c");
     conf.file("csupport/run.c");
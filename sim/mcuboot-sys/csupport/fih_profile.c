@@ -0,0 +1,136 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright (c) 2026 Linaro LTD
+ */
+
+/*
+ * Counters of the fault injection hardening calls made by the bootloader,
+ * per call site, and the delay RNG of the simulator.
+ *
+ * Since the simulator runs several boots at once, the counters are kept per
+ * thread, and a test reads the ones of the boots it ran itself.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "bootutil/fault_injection_hardening.h"
+
+#ifdef MCUBOOT_FIH_PROFILING
+
+#define FIH_PROFILE_MAX_SITES 256
+
+/* Laid out as FihSite in c.rs. */
+struct fih_profile_site {
+    const char *func;
+    const char *file;
+    uint32_t line;
+    uint32_t calls;
+    uint32_t delays;
+    uint64_t delay_loops;
+};
+
+static __thread struct fih_profile_site sites[FIH_PROFILE_MAX_SITES];
+static __thread uint32_t num_sites;
+static __thread struct fih_profile_site *last_delay;
+
+static struct fih_profile_site *
+fih_profile_site(const char *file, int line)
+{
+    struct fih_profile_site *site;
+    uint32_t i;
+
+    for (i = 0; i < num_sites; i++) {
+        site = &sites[i];
+        if (site->line == (uint32_t)line &&
+            (site->file == file || strcmp(site->file, file) == 0)) {
+            return site;
+        }
+    }
+
+    if (num_sites == FIH_PROFILE_MAX_SITES) {
+        return NULL;
+    }
+
+    site = &sites[num_sites++];
+    site->file = file;
+    site->line = line;
+    return site;
+}
+
+void fih_profile_call(const char *func, const char *file, int line)
+{
+    struct fih_profile_site *site = fih_profile_site(file, line);
+
+    if (site != NULL) {
+        site->func = func;
+        site->calls++;
+    }
+}
+
+void fih_profile_delay(const char *file, int line)
+{
+    last_delay = fih_profile_site(file, line);
+    if (last_delay != NULL) {
+        last_delay->delays++;
+    }
+}
+
+#ifdef FIH_ENABLE_DELAY
+static __thread uint32_t seed;
+static __thread uint32_t boots;
+static __thread uint32_t delay_state;
+
+/*
+ * The delays come from a xorshift generator, seeded at each boot from the
+ * seed of the test and the number of the boot, so that a run can be repeated.
+ */
+int fih_delay_init(void)
+{
+    delay_state = (seed ^ (++boots * 0x9e3779b9)) | 1;
+
+    return 1;
+}
+
+unsigned char fih_delay_random_uchar(void)
+{
+    unsigned char delay;
+
+    delay_state ^= delay_state << 13;
+    delay_state ^= delay_state >> 17;
+    delay_state ^= delay_state << 5;
+    delay = delay_state >> 24;
+
+    if (last_delay != NULL) {
+        last_delay->delay_loops += delay;
+    }
+
+    return delay;
+}
+#endif /* FIH_ENABLE_DELAY */
+
+void sim_fih_profile_reset(uint32_t new_seed)
+{
+    memset(sites, 0, sizeof(sites));
+    num_sites = 0;
+    last_delay = NULL;
+#ifdef FIH_ENABLE_DELAY
+    seed = new_seed;
+    boots = 0;
+#else
+    (void)new_seed;
+#endif
+}
+
+int sim_fih_profile_site(uint32_t idx, struct fih_profile_site *site)
+{
+    if (idx >= num_sites) {
+        return -1;
+    }
+
+    *site = sites[idx];
+    return 0;
+}
+
+#endif /* MCUBOOT_FIH_PROFILING */
@@ -167,6 +167,456 @@ const struct bootutil_key bootutil_keys[] = {
 const int bootutil_key_cnt = 1;
 #endif
 
+#if defined(MCUBOOT_ECDSA_COMB_TABLES)
+/* Comb table of root_pub_der, from "imgtool getpub -e lang-c-comb". */
+static const unsigned char root_pub_comb[] = {
+    0x2a, 0xcb, 0x40, 0x3c, 0xe8, 0xfe, 0xed, 0x5b,
+    0xa4, 0x49, 0x95, 0xa1, 0xa9, 0x1d, 0xae, 0xe8,
+    0xdb, 0xbe, 0x19, 0x37, 0xcd, 0x14, 0xfb, 0x2f,
+    0x24, 0x57, 0x37, 0xe5, 0x95, 0x39, 0x88, 0xd9,
+    0x94, 0xb9, 0xd6, 0x5a, 0xeb, 0xd7, 0xcd, 0xd5,
+    0x30, 0x8a, 0xd6, 0xfe, 0x48, 0xb2, 0x4a, 0x6a,
+    0x81, 0x0e, 0xe5, 0xf0, 0x7d, 0x8b, 0x68, 0x34,
+    0xcc, 0x3a, 0x6a, 0xfc, 0x53, 0x8e, 0xfa, 0xc1,
+    0x40, 0x14, 0x12, 0xb1, 0xf1, 0xc4, 0x9e, 0x0c,
+    0xdd, 0x08, 0xfd, 0xc4, 0xa4, 0xbf, 0xdf, 0xf6,
+    0xb9, 0x38, 0x81, 0x9c, 0x90, 0x76, 0xf8, 0x7e,
+    0x37, 0xfe, 0xa7, 0x7a, 0xe0, 0xde, 0x8d, 0x08,
+    0x18, 0xff, 0xad, 0xa2, 0x41, 0x0f, 0xd6, 0x9b,
+    0x7b, 0x5a, 0xcd, 0x96, 0xfc, 0xb3, 0x4a, 0x59,
+    0x24, 0x87, 0x3c, 0x84, 0x25, 0x4c, 0x59, 0xc4,
+    0x75, 0xe1, 0x5e, 0x4d, 0x44, 0x8d, 0x02, 0xf8,
+    0xff, 0x9d, 0xbd, 0x73, 0xe9, 0x4b, 0x8a, 0x0f,
+    0x6f, 0x8f, 0x80, 0xb3, 0x8b, 0x1a, 0x64, 0xa2,
+    0xb6, 0x85, 0xc3, 0xa2, 0x9f, 0x52, 0x54, 0xfe,
+    0xba, 0x51, 0x09, 0x1c, 0x09, 0x5d, 0x64, 0x04,
+    0x99, 0xdd, 0xb9, 0xbd, 0x29, 0xb3, 0x3c, 0x7c,
+    0xae, 0x04, 0xa2, 0xe4, 0x6c, 0xf4, 0x8f, 0x1f,
+    0x5e, 0x09, 0x89, 0x3c, 0x56, 0xe6, 0x38, 0x64,
+    0x3d, 0x94, 0xab, 0x64, 0x87, 0x57, 0x0f, 0xf8,
+    0x47, 0xe4, 0x7a, 0x7f, 0x3c, 0x83, 0xbb, 0xb4,
+    0x05, 0x17, 0x5d, 0x0d, 0x80, 0x9e, 0x67, 0x50,
+    0x66, 0x49, 0x6f, 0x5d, 0x19, 0xc0, 0xac, 0x3d,
+    0xae, 0x87, 0x63, 0x4a, 0x73, 0x84, 0x20, 0xb4,
+    0x82, 0x98, 0x0e, 0x0b, 0xfd, 0x6d, 0x88, 0x09,
+    0x27, 0xe5, 0x36, 0x8e, 0xbe, 0x69, 0x87, 0x3b,
+    0xe0, 0x63, 0x1d, 0x97, 0xb1, 0xfa, 0xa3, 0x6b,
+    0xcc, 0x45, 0x00, 0xc5, 0x3e, 0x35, 0xf5, 0x6a,
+    0x0e, 0x7b, 0x50, 0xaf, 0x8d, 0x6c, 0xe2, 0x0e,
+    0xd9, 0x8d, 0x20, 0x55, 0x7d, 0x33, 0xc2, 0x59,
+    0x17, 0x70, 0x29, 0x7b, 0xda, 0x37, 0x36, 0xca,
+    0xa4, 0xdd, 0xec, 0x1d, 0x92, 0x4f, 0x90, 0x52,
+    0xbb, 0xae, 0x20, 0xef, 0xfa, 0x8e, 0xa1, 0x76,
+    0x95, 0x85, 0xc0, 0xdd, 0x24, 0x60, 0x24, 0x91,
+    0xea, 0x27, 0xdf, 0xbb, 0xb8, 0x93, 0x08, 0x65,
+    0xe4, 0x05, 0x7c, 0x36, 0x86, 0xbc, 0xb5, 0xab,
+    0x3e, 0x46, 0x09, 0x7f, 0x8c, 0x25, 0x66, 0xdf,
+    0x85, 0xf0, 0x9c, 0x08, 0x75, 0x75, 0x2b, 0x58,
+    0x12, 0x77, 0x6b, 0x49, 0xe7, 0xf6, 0xcc, 0x50,
+    0x64, 0x13, 0x30, 0xfe, 0xc1, 0xf3, 0x48, 0xab,
+    0x05, 0x9c, 0xed, 0xb5, 0x14, 0x1f, 0xea, 0x38,
+    0x83, 0xdc, 0x4f, 0xe4, 0xc6, 0x71, 0x3f, 0xaa,
+    0xb7, 0x21, 0x14, 0xa7, 0x34, 0x71, 0x62, 0x14,
+    0x9c, 0xbf, 0x86, 0xbf, 0xe7, 0x4c, 0xc6, 0x8a,
+    0x09, 0x4f, 0xf5, 0x67, 0x3b, 0x4f, 0x06, 0x26,
+    0x51, 0x18, 0xa6, 0xb3, 0xef, 0x2c, 0x11, 0xd0,
+    0x32, 0xd5, 0xdd, 0xc4, 0xdc, 0x94, 0x76, 0x07,
+    0x7a, 0xc5, 0x93, 0x35, 0xbb, 0x3b, 0xf6, 0x2d,
+    0xd0, 0x20, 0xf7, 0xd5, 0x0a, 0x1a, 0xac, 0xf0,
+    0xdb, 0xfa, 0x74, 0x18, 0x59, 0xd8, 0xbb, 0x88,
+    0xfc, 0x27, 0xa1, 0x7c, 0x17, 0x55, 0x63, 0xa8,
+    0x6f, 0xc4, 0xa6, 0x73, 0x76, 0x30, 0xe5, 0xcd,
+    0x8a, 0x8a, 0x1e, 0x17, 0xa2, 0x78, 0x90, 0x66,
+    0xe1, 0x99, 0xf0, 0x83, 0x10, 0x57, 0x16, 0x17,
+    0x83, 0xf5, 0x35, 0x55, 0xce, 0xf1, 0xa9, 0x4a,
+    0xb5, 0x7c, 0x5e, 0x3c, 0x0b, 0x3d, 0xe0, 0x29,
+    0x73, 0xfa, 0xe4, 0x10, 0x2f, 0xde, 0x32, 0x00,
+    0x31, 0x07, 0xec, 0x54, 0xf4, 0x8e, 0x4f, 0x8c,
+    0x82, 0xd5, 0x0a, 0xe8, 0xa3, 0x90, 0x9b, 0xdd,
+    0xa4, 0xb9, 0xb5, 0xec, 0x9c, 0xe8, 0xd2, 0xd9,
+    0xa2, 0xe4, 0x0f, 0x39, 0x2f, 0x22, 0xc3, 0x27,
+    0x62, 0x17, 0xa2, 0x4a, 0xd2, 0xdb, 0xcd, 0x89,
+    0xad, 0xe1, 0x5d, 0x2c, 0x99, 0x5f, 0xc6, 0x72,
+    0xa6, 0x2b, 0x1d, 0x7f, 0x7d, 0x66, 0x4d, 0x50,
+    0x62, 0xf5, 0x6c, 0x26, 0x03, 0x03, 0xc5, 0x65,
+    0x88, 0xf2, 0xb5, 0xe1, 0x88, 0x43, 0xc7, 0x7d,
+    0x26, 0xbc, 0x6f, 0xc0, 0x64, 0xaf, 0xbe, 0xa5,
+    0xd1, 0x9a, 0xfc, 0xc0, 0xec, 0xae, 0xd1, 0xfc,
+    0x82, 0x91, 0x83, 0x29, 0x67, 0x56, 0x16, 0x2c,
+    0x00, 0xb8, 0xb8, 0x7b, 0xdc, 0x06, 0x01, 0xba,
+    0xe1, 0x5c, 0x86, 0xf9, 0x2a, 0xfc, 0xb7, 0x0b,
+    0x79, 0x5a, 0xf5, 0x9e, 0x63, 0xc4, 0xa0, 0x52,
+    0x71, 0x8e, 0x39, 0xa0, 0x20, 0x24, 0xd0, 0x52,
+    0xab, 0x1a, 0x49, 0xbd, 0x6b, 0x8f, 0xae, 0x89,
+    0xcb, 0x86, 0xd4, 0x4c, 0x43, 0x09, 0x4a, 0xea,
+    0x76, 0xe7, 0x21, 0x25, 0x63, 0x28, 0xeb, 0x26,
+    0x4e, 0x47, 0x12, 0x00, 0x7d, 0x7d, 0xf9, 0x77,
+    0x85, 0x19, 0xe9, 0xaa, 0x5d, 0x08, 0xa3, 0x19,
+    0x3c, 0x4f, 0x9b, 0x79, 0x90, 0xec, 0x37, 0xcd,
+    0x9d, 0x24, 0xb0, 0xb3, 0x82, 0x4f, 0x1c, 0x58,
+    0x6d, 0xbb, 0x61, 0x72, 0xf7, 0xa3, 0xfb, 0x4d,
+    0x59, 0xb9, 0xae, 0xd5, 0xfa, 0xd8, 0xe7, 0x19,
+    0x39, 0xe6, 0x7b, 0x7b, 0x44, 0x84, 0xed, 0xc8,
+    0x9b, 0x28, 0xd1, 0xaf, 0x2c, 0x35, 0x1c, 0x95,
+    0x24, 0x1a, 0x04, 0x81, 0x27, 0xdc, 0x12, 0x91,
+    0x80, 0x1d, 0x39, 0xcf, 0x3f, 0xab, 0xa4, 0x53,
+    0xc3, 0x8d, 0x9f, 0x8e, 0x00, 0xea, 0x1d, 0x92,
+    0xe0, 0x72, 0xce, 0xd5, 0xae, 0xca, 0x25, 0x2a,
+    0x68, 0xea, 0x1b, 0x7a, 0x8b, 0x01, 0xd2, 0x25,
+    0xbe, 0xad, 0x00, 0xd9, 0xe3, 0xb2, 0xfc, 0xf3,
+    0xd3, 0xc2, 0x71, 0x46, 0x46, 0xb8, 0x20, 0x97,
+    0x19, 0xc5, 0x2e, 0xc0, 0x7e, 0x3d, 0x40, 0xe4,
+    0xe9, 0xc7, 0x0a, 0x59, 0x9b, 0x0a, 0x3c, 0xc0,
+    0xd0, 0x39, 0x99, 0x77, 0xf4, 0x86, 0xfc, 0x0e,
+    0x00, 0x49, 0x89, 0x1c, 0x62, 0xd5, 0xba, 0x6c,
+    0x92, 0x8f, 0x76, 0x0d, 0x0c, 0xcf, 0x4b, 0x2e,
+    0xb1, 0x83, 0x4d, 0x05, 0x88, 0x03, 0x11, 0xc7,
+    0xd4, 0x2b, 0xd1, 0x6f, 0xe3, 0xa8, 0x6e, 0xb1,
+    0xcc, 0x20, 0x47, 0xe3, 0xab, 0xea, 0xf1, 0xc4,
+    0xda, 0x5d, 0xae, 0x89, 0x03, 0x29, 0x0a, 0x89,
+    0xa5, 0x68, 0x2b, 0x32, 0x8d, 0xe7, 0xf3, 0x3a,
+    0xc7, 0xc8, 0x66, 0x17, 0xf8, 0x47, 0xe9, 0xfc,
+    0xbb, 0xa1, 0x29, 0x14, 0x9d, 0x35, 0xc7, 0x50,
+    0x0d, 0x35, 0xeb, 0xf4, 0x3b, 0xee, 0x9b, 0xa7,
+    0x25, 0x15, 0x2a, 0x50, 0x9b, 0xf4, 0x14, 0x45,
+    0xe7, 0x49, 0x53, 0x72, 0xa0, 0xa0, 0xd7, 0x7f,
+    0x77, 0x10, 0x1d, 0xb6, 0x55, 0xa1, 0x66, 0x9c,
+    0x63, 0xce, 0x98, 0xfb, 0xb6, 0xc9, 0x68, 0xc4,
+    0x0a, 0x92, 0xea, 0x41, 0xf0, 0x32, 0x64, 0x62,
+    0x7b, 0x9b, 0x4d, 0xf3, 0xb7, 0x81, 0x69, 0x5f,
+    0xa7, 0x9f, 0x13, 0x6c, 0x0c, 0x8b, 0xe5, 0x2c,
+    0xa3, 0x6a, 0x74, 0x92, 0xf0, 0x1e, 0xad, 0x1e,
+    0xf1, 0x7e, 0x2c, 0xae, 0xf9, 0x44, 0x3c, 0xdd,
+    0x48, 0x68, 0x6a, 0x75, 0xa5, 0x46, 0x4d, 0xbd,
+    0x13, 0xca, 0xe4, 0xe0, 0xa0, 0xbb, 0x34, 0x2f,
+    0x43, 0x82, 0x24, 0x50, 0x65, 0x0c, 0x8e, 0x03,
+};
+static const unsigned int root_pub_comb_len = 960;
+
+const struct bootutil_key bootutil_ecdsa_combs[] = {
+    {
+        .key = root_pub_comb,
+        .len = &root_pub_comb_len,
+    },
+};
+#endif
+
+#if defined(MCUBOOT_ED25519_KEY_TABLES)
+/* Key table of root_pub_der, from "imgtool getpub -e lang-c-table". */
+static const unsigned char root_pub_table[] = {
+    0x77, 0xb3, 0x6c, 0xa3, 0x2d, 0x95, 0x18, 0x7a,
+    0x9e, 0x9e, 0x57, 0xc5, 0xd2, 0x71, 0xfe, 0x25,
+    0x11, 0xc9, 0x92, 0x67, 0xd6, 0x4b, 0x34, 0x66,
+    0xe4, 0x71, 0xaf, 0xcf, 0x9f, 0xb6, 0x0e, 0x7d,
+    0xd4, 0xb3, 0x1b, 0xa4, 0x9a, 0x3a, 0xdd, 0x3f,
+    0x82, 0x5d, 0x10, 0xca, 0x7f, 0x31, 0xb5, 0x0b,
+    0x0d, 0xe8, 0x7f, 0x37, 0xcc, 0xc4, 0x9f, 0x1a,
+    0x40, 0x3a, 0x5c, 0x13, 0x20, 0xff, 0xb4, 0x60,
+    0x13, 0x3e, 0x23, 0xaf, 0x00, 0x89, 0x0d, 0xd7,
+    0x5f, 0x6e, 0x04, 0x35, 0xea, 0x16, 0x45, 0x04,
+    0xfd, 0x88, 0xa9, 0x35, 0x63, 0x7f, 0xc4, 0x63,
+    0x81, 0xff, 0x04, 0xa5, 0x0e, 0xc7, 0x9e, 0x7f,
+    0xca, 0xd5, 0x02, 0x65, 0xca, 0x0e, 0xc4, 0x81,
+    0xce, 0x23, 0x5b, 0x61, 0x8f, 0x85, 0x67, 0x10,
+    0xc1, 0x7d, 0x55, 0x5d, 0xc6, 0xe3, 0xb1, 0x20,
+    0x29, 0x3a, 0x9a, 0xb9, 0xc3, 0x5b, 0x19, 0x06,
+    0x2e, 0x6c, 0x11, 0x5c, 0x38, 0x28, 0x4a, 0x83,
+    0x30, 0x8c, 0xc4, 0x55, 0x8f, 0x70, 0x2d, 0xb0,
+    0xf0, 0xd7, 0x65, 0xbb, 0xc2, 0x90, 0xa6, 0x29,
+    0x94, 0xb8, 0x93, 0x57, 0x66, 0xd2, 0x7c, 0x29,
+    0x13, 0x2e, 0x3f, 0x76, 0x2e, 0x13, 0xc8, 0xac,
+    0x23, 0x7d, 0x63, 0x62, 0x80, 0xaf, 0x8c, 0x82,
+    0x80, 0xe7, 0xfb, 0x94, 0x8b, 0x0b, 0xb9, 0x0d,
+    0xdb, 0x22, 0xff, 0x5e, 0x58, 0xf7, 0xee, 0x25,
+    0xe7, 0xa0, 0x1e, 0xba, 0xd5, 0xd7, 0x75, 0x6a,
+    0x95, 0xdb, 0xdc, 0xcc, 0xed, 0xda, 0x70, 0x46,
+    0x53, 0xe8, 0xcb, 0x20, 0x90, 0x7a, 0xf6, 0xf6,
+    0x5f, 0xbe, 0x7d, 0xc2, 0x0b, 0xe3, 0x41, 0x39,
+    0xd7, 0xdd, 0xbc, 0x21, 0xc3, 0x31, 0x96, 0xda,
+    0x63, 0x1b, 0x89, 0xb8, 0x8e, 0x8a, 0x10, 0x5a,
+    0x12, 0xc8, 0xd5, 0x3d, 0x9c, 0xe7, 0xe5, 0xdf,
+    0x49, 0x98, 0x35, 0xce, 0x50, 0x0e, 0xcf, 0x07,
+    0x0a, 0x9e, 0xe2, 0x7e, 0x2a, 0xd1, 0x3d, 0x8a,
+    0x99, 0x27, 0x71, 0x01, 0x64, 0x9a, 0xc1, 0x0a,
+    0xfe, 0xca, 0xf8, 0x04, 0xf3, 0xd9, 0xd3, 0x38,
+    0x37, 0xa0, 0x26, 0x86, 0x11, 0x10, 0xe6, 0x29,
+    0xe5, 0x3d, 0x2f, 0x84, 0x39, 0x0f, 0xa6, 0x8d,
+    0xa0, 0xf5, 0x98, 0xca, 0x9a, 0x72, 0x44, 0xac,
+    0xdc, 0x44, 0xcf, 0x51, 0x05, 0x03, 0xc5, 0xcb,
+    0xda, 0x00, 0x4e, 0x52, 0x65, 0x1d, 0x55, 0x44,
+    0x32, 0x10, 0x8c, 0x87, 0xb6, 0xf4, 0x62, 0x24,
+    0x9c, 0x13, 0xb7, 0xfe, 0x4d, 0x36, 0xfc, 0x56,
+    0xcb, 0x7e, 0x18, 0x75, 0x0c, 0xcd, 0x0f, 0xec,
+    0x3f, 0x51, 0x09, 0xbf, 0x27, 0x69, 0x9b, 0x27,
+    0xce, 0x86, 0x4b, 0x3c, 0xa6, 0x4d, 0xfc, 0xf3,
+    0xe9, 0xee, 0x5a, 0xbf, 0xe8, 0x60, 0x5b, 0x05,
+    0xfb, 0x84, 0x08, 0xa7, 0x82, 0x8c, 0xb4, 0x3b,
+    0x43, 0xe1, 0x47, 0x53, 0x68, 0x00, 0xc2, 0x36,
+    0x35, 0x64, 0x32, 0xb3, 0xa1, 0xac, 0xb7, 0x1b,
+    0xaa, 0x5a, 0x7d, 0x02, 0xb8, 0x03, 0xd4, 0x9e,
+    0x60, 0x93, 0xd0, 0xc3, 0x02, 0x86, 0x16, 0x31,
+    0xbf, 0x66, 0x4e, 0x68, 0x99, 0x99, 0x8f, 0x0c,
+    0xa2, 0x9a, 0xb9, 0x81, 0xf8, 0x81, 0xe9, 0xda,
+    0xfe, 0x93, 0x86, 0xb7, 0x34, 0xd1, 0x1d, 0xee,
+    0x3d, 0xfd, 0xcf, 0x5a, 0xa9, 0x24, 0x8c, 0x3f,
+    0x10, 0x5c, 0x11, 0x86, 0xed, 0xbe, 0x13, 0x27,
+    0xce, 0xe4, 0xc1, 0x3f, 0x73, 0x82, 0x5b, 0x74,
+    0x8a, 0xe4, 0x0b, 0x48, 0x2b, 0xc9, 0xd5, 0x70,
+    0x46, 0xfc, 0x81, 0x50, 0xe3, 0x08, 0x49, 0x87,
+    0x06, 0xe9, 0xe0, 0xef, 0xbb, 0xd6, 0xc8, 0x62,
+    0xc3, 0xe4, 0x9c, 0xfd, 0x73, 0x7d, 0x32, 0x69,
+    0xcb, 0xb8, 0x07, 0x79, 0x9e, 0x82, 0x75, 0x3d,
+    0xa2, 0x77, 0xe6, 0xf6, 0xbb, 0x15, 0xbb, 0x05,
+    0x8b, 0x2c, 0xa1, 0xc4, 0x68, 0xa9, 0x62, 0x1e,
+    0x3e, 0x7e, 0x8a, 0xbb, 0xa5, 0x34, 0x37, 0x41,
+    0x10, 0x73, 0xb2, 0x2e, 0x64, 0xcb, 0xb7, 0xb1,
+    0xfc, 0xb0, 0x23, 0xe4, 0x83, 0x62, 0x62, 0x07,
+    0x66, 0xb8, 0xf6, 0xa7, 0x5e, 0x0a, 0xaa, 0x53,
+    0xdc, 0x0b, 0xf4, 0xa2, 0x09, 0x05, 0x9a, 0x6f,
+    0x6d, 0x65, 0xfb, 0xc8, 0x72, 0x70, 0xdd, 0x86,
+    0x27, 0x63, 0x94, 0x2f, 0xc7, 0x4c, 0x39, 0x63,
+    0xd8, 0x02, 0xa1, 0x57, 0xa7, 0x2b, 0xc9, 0x58,
+    0xa9, 0x7e, 0xf3, 0x10, 0x3b, 0xea, 0x56, 0x79,
+    0x3b, 0xba, 0x0b, 0xf9, 0xba, 0x20, 0x0d, 0xa8,
+    0x8f, 0xa0, 0xdc, 0xe9, 0x7d, 0x12, 0x5f, 0x2f,
+    0x5d, 0xfd, 0xea, 0x3c, 0xdd, 0x80, 0x64, 0x79,
+    0xd2, 0xce, 0xfb, 0xc5, 0x03, 0x37, 0x0d, 0x85,
+    0xf1, 0x6c, 0xa7, 0x99, 0x56, 0xcb, 0x52, 0x0e,
+    0x70, 0xab, 0x09, 0x5b, 0x75, 0x76, 0xf7, 0x73,
+    0x44, 0x02, 0x93, 0x79, 0xf6, 0x96, 0x3d, 0x6e,
+    0x6f, 0xc4, 0x4b, 0x8b, 0xf6, 0x3b, 0x25, 0xdd,
+    0x6b, 0xbf, 0x4f, 0xd7, 0xa9, 0x63, 0xf4, 0x17,
+    0xf2, 0x42, 0x5f, 0x22, 0xbc, 0x14, 0xe3, 0xae,
+    0xed, 0x4b, 0xba, 0x0d, 0x48, 0xd5, 0x95, 0x50,
+    0x37, 0x5d, 0xe5, 0x0f, 0xe0, 0x63, 0x13, 0xab,
+    0x10, 0x03, 0x39, 0x0a, 0x24, 0x68, 0x33, 0xbc,
+    0xc0, 0x33, 0xbb, 0x09, 0xda, 0x45, 0xdf, 0x80,
+    0xf0, 0x18, 0xe8, 0x07, 0xa5, 0x65, 0x02, 0x4b,
+    0x77, 0xf9, 0xdb, 0xfd, 0x2a, 0x94, 0x44, 0x86,
+    0x60, 0x8c, 0x61, 0x31, 0x87, 0xb4, 0x77, 0xe9,
+    0xa5, 0x5b, 0xff, 0x4c, 0x70, 0x7d, 0x01, 0x5c,
+    0x4e, 0x10, 0x71, 0x55, 0x19, 0x60, 0x55, 0x18,
+    0xcb, 0xa9, 0x59, 0x03, 0x12, 0x7b, 0x34, 0xcb,
+    0x38, 0xb4, 0xb5, 0x91, 0x0a, 0x5f, 0x7c, 0xcb,
+    0x19, 0xc8, 0x8a, 0xcc, 0x9b, 0xf5, 0x3b, 0x33,
+    0x56, 0x54, 0x2f, 0xc4, 0x5d, 0x8a, 0xc2, 0x38,
+    0xb6, 0x81, 0x59, 0xcf, 0xf3, 0x3a, 0xe2, 0x08,
+    0x23, 0x7f, 0xbe, 0x84, 0x5d, 0xfd, 0xd8, 0xfe,
+    0xbc, 0x47, 0x21, 0xf3, 0xe1, 0x95, 0x3a, 0x58,
+    0x8a, 0x4a, 0xa2, 0x89, 0xc8, 0xee, 0x48, 0x74,
+    0xda, 0x2d, 0x89, 0x72, 0x3a, 0x8c, 0x8f, 0xb7,
+    0xd9, 0x0c, 0x5a, 0xc1, 0xca, 0xcf, 0x73, 0x2e,
+    0xf1, 0xd1, 0x00, 0x49, 0xcf, 0x15, 0x88, 0x8c,
+    0xac, 0x70, 0xac, 0xd2, 0x39, 0x0a, 0x37, 0x3f,
+    0xa9, 0x24, 0xf8, 0xf7, 0xbf, 0x7e, 0x2b, 0xce,
+    0x9e, 0xe1, 0x4e, 0xef, 0xbd, 0x63, 0xb5, 0xcb,
+    0x52, 0x81, 0xd9, 0x47, 0x78, 0xe7, 0x89, 0x55,
+    0x4a, 0xaa, 0x1d, 0x95, 0x19, 0x67, 0xeb, 0x1a,
+    0x40, 0x02, 0x62, 0x35, 0x89, 0x85, 0xa0, 0xf6,
+    0x46, 0x43, 0x06, 0x70, 0x7b, 0xd1, 0x16, 0xbf,
+    0xac, 0xb9, 0xf2, 0x9b, 0x0c, 0xc5, 0x4a, 0x6e,
+    0x42, 0xe2, 0x10, 0xb4, 0x14, 0x04, 0xff, 0x04,
+    0xdd, 0x20, 0x8a, 0x02, 0xce, 0xa1, 0x57, 0x97,
+    0x35, 0x46, 0xcc, 0xda, 0x13, 0xbe, 0x9b, 0xf8,
+    0xad, 0xcb, 0xd8, 0xec, 0x96, 0xb6, 0x2f, 0x58,
+    0xa5, 0x25, 0x41, 0x37, 0x03, 0x22, 0xde, 0x00,
+    0xcf, 0xf8, 0xe0, 0x3f, 0xc8, 0x52, 0xe2, 0x84,
+    0xb7, 0x06, 0xc2, 0x22, 0x18, 0xa7, 0xd9, 0xe6,
+    0xbc, 0x82, 0x32, 0x88, 0xb3, 0xb7, 0x32, 0x00,
+    0x6b, 0xea, 0xe0, 0x46, 0x0f, 0x24, 0x23, 0x33,
+};
+static const unsigned int root_pub_table_len = 960;
+
+const struct bootutil_key bootutil_ed25519_tables[] = {
+    {
+        .key = root_pub_table,
+        .len = &root_pub_table_len,
+    },
+};
+#endif
+
+#if defined(MCUBOOT_RSA_KEY_TABLES)
+/* Key table of root_pub_der, from "imgtool getpub -e lang-c-table". */
+#if MCUBOOT_SIGN_RSA_LEN == 2048
+static const unsigned char root_pub_table[] = {
+    0xc9, 0xd1, 0xe1, 0x62, 0x2c, 0x4b, 0xb1, 0xef,
+    0x47, 0xc6, 0x67, 0xd1, 0xa7, 0x3a, 0x5c, 0xaf,
+    0x9d, 0x11, 0x0d, 0xfa, 0xec, 0x35, 0x64, 0x66,
+    0x1b, 0x68, 0xce, 0xdc, 0xab, 0x1c, 0xf8, 0x59,
+    0x66, 0x24, 0x1a, 0xf8, 0xe8, 0xfe, 0x1d, 0x1a,
+    0x93, 0x3e, 0x87, 0xab, 0xf3, 0x23, 0x27, 0x69,
+    0x8a, 0xf2, 0x17, 0x82, 0xb0, 0x5f, 0xad, 0x31,
+    0x81, 0x88, 0xc8, 0x4c, 0x5e, 0xf6, 0x18, 0x58,
+    0x08, 0xd3, 0xd0, 0x2b, 0xe1, 0x3e, 0xf4, 0x54,
+    0x37, 0x82, 0xfa, 0xe0, 0xb8, 0xaf, 0xbe, 0x2a,
+    0xfa, 0xce, 0xb8, 0xfe, 0xf9, 0x9d, 0x6a, 0xa7,
+    0x0f, 0xd2, 0xae, 0xa3, 0x3f, 0x83, 0x39, 0x13,
+    0xf3, 0xfd, 0xb7, 0xff, 0x2f, 0x0d, 0x53, 0xe4,
+    0x4a, 0x5c, 0xd5, 0x85, 0xd7, 0x0e, 0xc8, 0x3e,
+    0x64, 0x6e, 0x65, 0xf8, 0xfb, 0x24, 0x69, 0x89,
+    0x21, 0x72, 0x7b, 0xbe, 0xd4, 0x73, 0x77, 0xdb,
+    0x15, 0xe1, 0xb7, 0x7e, 0x61, 0x62, 0xca, 0x35,
+    0x38, 0x8d, 0xaa, 0x4b, 0x54, 0x67, 0x77, 0xc3,
+    0x94, 0x3c, 0x47, 0x7e, 0x88, 0xc8, 0xa9, 0xb4,
+    0xba, 0x5b, 0xe7, 0x6f, 0x1e, 0x3d, 0xcf, 0xf8,
+    0xf2, 0xdf, 0x14, 0x5c, 0x9e, 0x4d, 0x41, 0xac,
+    0x5f, 0x2f, 0x8c, 0x69, 0xe6, 0x10, 0x3c, 0xb4,
+    0x01, 0xa7, 0x49, 0x28, 0x15, 0xed, 0x60, 0x41,
+    0x77, 0xaa, 0x0b, 0x84, 0x4d, 0xe0, 0xdf, 0x99,
+    0xb3, 0xec, 0xee, 0x5c, 0xbb, 0x0d, 0x0f, 0x08,
+    0x67, 0xd1, 0x44, 0x2c, 0x57, 0x0d, 0x5e, 0x43,
+    0x7e, 0x53, 0x10, 0x7f, 0x8c, 0xe7, 0x42, 0xdb,
+    0x74, 0xbc, 0xf3, 0xcb, 0x1b, 0x34, 0x9c, 0xf0,
+    0xf9, 0x19, 0x80, 0x18, 0x6d, 0xe9, 0x5a, 0xd3,
+    0x18, 0x4b, 0xd2, 0xaa, 0xf9, 0x5e, 0xee, 0xbb,
+    0x1f, 0x4f, 0xa3, 0x0d, 0xf7, 0xfd, 0xfb, 0xe8,
+    0x18, 0x2c, 0x44, 0x18, 0x1a, 0x08, 0x06, 0xd1,
+    0x40, 0x7e, 0x6d, 0xa4, 0xb3, 0x87, 0xd8, 0x61,
+    0x1d, 0xc6, 0xf6, 0x1a, 0x48, 0x6f, 0xbf, 0xa0,
+    0xe8, 0xc2, 0xce, 0xb8, 0xe7, 0x95, 0x68, 0x6f,
+    0xa3, 0xae, 0x3e, 0x72, 0x9b, 0xf4, 0x4c, 0x9f,
+    0x24, 0x8e, 0x64, 0xc1, 0x56, 0xb1, 0x33, 0x49,
+    0x9e, 0xcc, 0x20, 0xb6, 0x6a, 0x59, 0x3d, 0x6a,
+    0x1c, 0x7b, 0x60, 0xd7, 0x22, 0xf1, 0xc7, 0xb9,
+    0x4e, 0x31, 0xa7, 0x05, 0xfa, 0xab, 0xbd, 0xfa,
+    0x65, 0x04, 0xee, 0xb7, 0xc6, 0x22, 0x94, 0x9d,
+    0x79, 0xb7, 0x60, 0x77, 0x96, 0x22, 0xf3, 0x7e,
+    0x81, 0x85, 0x5d, 0xc2, 0xcb, 0x32, 0x1a, 0xa7,
+    0x6c, 0x58, 0x31, 0xfa, 0x41, 0xb3, 0x49, 0xed,
+    0x8c, 0xdd, 0x49, 0x52, 0xdc, 0x58, 0xe1, 0xda,
+    0xd7, 0x5c, 0x6a, 0x93, 0x91, 0x8c, 0xb5, 0x2f,
+    0x38, 0x72, 0x61, 0x1f, 0xbe, 0x0b, 0xc4, 0xf4,
+    0x74, 0xf7, 0x9e, 0xfc, 0x84, 0xbd, 0x62, 0xbb,
+    0x7e, 0x10, 0x88, 0xba, 0x45, 0x0c, 0x1a, 0xef,
+    0x03, 0x46, 0x12, 0x52, 0x7a, 0xf8, 0x57, 0x65,
+    0x9b, 0x77, 0x26, 0x9c, 0x28, 0x30, 0x86, 0x05,
+    0x18, 0x55, 0x87, 0x35, 0x06, 0xd1, 0xb8, 0xf9,
+    0x09, 0x6c, 0xc6, 0x51, 0x44, 0xf5, 0x41, 0x79,
+    0x70, 0xf0, 0xf6, 0xbc, 0x06, 0x37, 0xb5, 0x39,
+    0x31, 0xa9, 0x66, 0x31, 0xf7, 0x93, 0x7f, 0xc9,
+    0x3a, 0xbd, 0xf7, 0x23, 0x06, 0x85, 0xdb, 0x5e,
+    0xda, 0x0e, 0xe5, 0xab, 0x7d, 0x16, 0x98, 0xfc,
+    0x44, 0x52, 0xca, 0xa4, 0x95, 0x6a, 0x3f, 0xf9,
+    0xa9, 0xd5, 0x7c, 0x44, 0x10, 0x71, 0xef, 0x15,
+    0x5e, 0x2d, 0x7c, 0xa5, 0xf4, 0x61, 0x5d, 0x2e,
+    0x17, 0x32, 0x3d, 0x61, 0xce, 0x2c, 0xf5, 0x4f,
+    0xe1, 0xf5, 0xe3, 0xaf, 0x30, 0x8e, 0x6f, 0x69,
+    0xf7, 0x51, 0xf0, 0x1e, 0x8c, 0x29, 0x6e, 0x00,
+    0x14, 0x1d, 0x7f, 0xb9, 0xe8, 0xa3, 0x20, 0xa9,
+    0x87, 0xe7, 0xae, 0x80
+};
+static const unsigned int root_pub_table_len = 516;
+#elif MCUBOOT_SIGN_RSA_LEN == 3072
+static const unsigned char root_pub_table[] = {
+    0x3b, 0xde, 0x73, 0xe6, 0x5a, 0xac, 0x74, 0x63,
+    0x66, 0x93, 0xaf, 0x2d, 0xb0, 0xd3, 0x7b, 0xb5,
+    0x91, 0x65, 0x88, 0x6e, 0x23, 0xcf, 0x18, 0x8a,
+    0x17, 0x07, 0x9f, 0xd9, 0x01, 0xdd, 0x65, 0xb5,
+    0x81, 0xf8, 0x0e, 0x2b, 0xe7, 0xaf, 0x5f, 0xf5,
+    0xf7, 0xff, 0x62, 0x01, 0xf3, 0x81, 0x0a, 0x06,
+    0x74, 0x43, 0x8c, 0x6d, 0xb7, 0xca, 0x01, 0xad,
+    0x1f, 0x75, 0x05, 0x4a, 0x0c, 0xf4, 0x9d, 0xe6,
+    0x36, 0x57, 0x30, 0x23, 0x37, 0x96, 0xe8, 0x52,
+    0xdd, 0x65, 0xfa, 0xf7, 0xc8, 0x94, 0xa0, 0xa0,
+    0x1e, 0xd0, 0x0d, 0x1f, 0x80, 0x08, 0x15, 0xcf,
+    0xf4, 0x22, 0x2a, 0xac, 0x85, 0xee, 0x85, 0x59,
+    0xb0, 0xa4, 0x72, 0x58, 0x68, 0xac, 0xbf, 0x99,
+    0x0c, 0xe7, 0x9c, 0x01, 0x83, 0xf6, 0xf3, 0xb0,
+    0x12, 0x7c, 0x51, 0xb1, 0x1a, 0xff, 0x1b, 0x1d,
+    0x40, 0x1a, 0xea, 0xd1, 0xbe, 0xdc, 0xee, 0x06,
+    0x87, 0xda, 0x7e, 0xa7, 0xeb, 0x51, 0x77, 0x6a,
+    0xa5, 0x4f, 0x09, 0xa4, 0x94, 0x6b, 0x8c, 0x76,
+    0x7f, 0xfb, 0x22, 0x11, 0x2f, 0xfd, 0x19, 0xe8,
+    0x7a, 0xe7, 0x82, 0x5b, 0xbb, 0xcb, 0x6f, 0x9a,
+    0xf8, 0xc4, 0xca, 0xe7, 0xfb, 0xc3, 0x7c, 0xb3,
+    0xb7, 0xab, 0x7b, 0x6f, 0x6c, 0x5a, 0xaa, 0xb2,
+    0x4d, 0x9c, 0x08, 0x30, 0x73, 0xcc, 0x85, 0x44,
+    0x8d, 0x33, 0x73, 0xd4, 0xbf, 0xd7, 0x6c, 0x93,
+    0xca, 0xa8, 0xa4, 0xce, 0xbe, 0x8d, 0xf8, 0x25,
+    0x60, 0xee, 0x87, 0x8e, 0x99, 0x5e, 0x66, 0x51,
+    0x3a, 0xf6, 0xa7, 0xad, 0xe8, 0x1c, 0xe4, 0x9b,
+    0xb3, 0xcf, 0xed, 0x96, 0x2e, 0x17, 0x1b, 0x13,
+    0x80, 0x7a, 0xba, 0xa8, 0xe5, 0xcd, 0x9a, 0xb6,
+    0x61, 0x5e, 0x6c, 0x22, 0x6e, 0xc8, 0x1f, 0x67,
+    0x47, 0xbe, 0xe5, 0x78, 0x2f, 0xcc, 0xb4, 0xd3,
+    0x00, 0xaa, 0x02, 0x25, 0xe0, 0xb2, 0x68, 0x4e,
+    0xba, 0x9b, 0x9c, 0x7e, 0x0c, 0x57, 0x4e, 0xd2,
+    0xa5, 0xe1, 0xc2, 0xad, 0x4f, 0x15, 0xd1, 0x6f,
+    0x25, 0x13, 0x2b, 0xa7, 0x34, 0x8c, 0xda, 0x04,
+    0x54, 0x5f, 0xdd, 0x76, 0x38, 0x49, 0x80, 0x36,
+    0x78, 0xdb, 0x49, 0xf9, 0xed, 0x85, 0xcc, 0x6e,
+    0xd8, 0x00, 0x10, 0xf9, 0x8b, 0x3f, 0x46, 0x72,
+    0x05, 0x73, 0xfd, 0x5c, 0x83, 0x00, 0x87, 0xad,
+    0x44, 0x1d, 0xa7, 0xb8, 0x7a, 0xd3, 0x72, 0x7e,
+    0x0f, 0xde, 0x4b, 0x57, 0x71, 0x9e, 0x22, 0x8c,
+    0x8f, 0x2a, 0xef, 0xf4, 0x1a, 0x8c, 0x68, 0x15,
+    0x6e, 0xbf, 0x73, 0x81, 0x4e, 0x2d, 0x8b, 0x22,
+    0x63, 0x8a, 0xa6, 0xaa, 0x15, 0xb1, 0x7b, 0xea,
+    0x96, 0xd2, 0xe5, 0x25, 0x26, 0x71, 0xc8, 0x45,
+    0x5d, 0x20, 0x34, 0x1a, 0x96, 0xf8, 0x33, 0x34,
+    0x28, 0x2a, 0x08, 0xdd, 0x01, 0x7c, 0x99, 0x58,
+    0xa7, 0xa4, 0x10, 0x58, 0x98, 0x0e, 0x2c, 0xb4,
+    0xd4, 0x38, 0x46, 0xa0, 0x48, 0x90, 0x87, 0x3a,
+    0x2d, 0x1b, 0xa6, 0x7c, 0x59, 0x62, 0xdd, 0xe0,
+    0xc5, 0x3f, 0x12, 0x55, 0xec, 0xde, 0xf5, 0x2e,
+    0x8c, 0x68, 0xc7, 0x9a, 0x39, 0xb3, 0x5b, 0x8a,
+    0xcf, 0x3d, 0x08, 0x04, 0xe4, 0x82, 0xa0, 0xfb,
+    0x21, 0x5f, 0xbd, 0xf5, 0x80, 0xbb, 0xc0, 0x3b,
+    0x68, 0xb1, 0x08, 0x05, 0x31, 0xe8, 0x26, 0xd3,
+    0x6d, 0x39, 0x3e, 0x1a, 0xe1, 0x7f, 0xbf, 0x00,
+    0x01, 0xbc, 0x36, 0xc5, 0xaa, 0x32, 0xb3, 0x42,
+    0x9d, 0xab, 0x4c, 0xfe, 0x66, 0x6a, 0x5a, 0x7d,
+    0x90, 0xca, 0x2b, 0x03, 0xa7, 0xc4, 0xa3, 0xa5,
+    0xa8, 0xa6, 0x29, 0xb7, 0x49, 0x25, 0x60, 0x2d,
+    0x23, 0x22, 0xbc, 0xd5, 0x04, 0xa3, 0x87, 0x31,
+    0x91, 0xe5, 0xf6, 0x4a, 0xc1, 0xaf, 0xdb, 0x9b,
+    0x69, 0x6f, 0x3c, 0xf1, 0xc0, 0x4c, 0x73, 0xb9,
+    0x82, 0xe8, 0x55, 0x66, 0xb0, 0xb3, 0x2f, 0x9d,
+    0xf5, 0x2d, 0x10, 0xd3, 0x27, 0x40, 0xcd, 0x33,
+    0xb3, 0x2b, 0xe7, 0x94, 0x0a, 0x23, 0x55, 0x7c,
+    0xb2, 0x67, 0xb1, 0x9a, 0xc3, 0xed, 0x4f, 0x1d,
+    0x6f, 0x3c, 0xa8, 0xd8, 0x29, 0x83, 0xec, 0x54,
+    0xd1, 0xb4, 0xee, 0xd5, 0xec, 0x7b, 0x2a, 0xed,
+    0xc5, 0x40, 0xdb, 0x91, 0x4a, 0x27, 0xd3, 0x16,
+    0x93, 0x58, 0x80, 0xdc, 0x2b, 0x33, 0xb2, 0xbb,
+    0x5b, 0xdf, 0x68, 0x18, 0x0a, 0x6e, 0x0b, 0xcd,
+    0xc8, 0x03, 0x80, 0x79, 0x32, 0xf9, 0xf4, 0x84,
+    0xd7, 0xe8, 0x98, 0xb0, 0x66, 0xc1, 0x8f, 0x49,
+    0x1f, 0xc4, 0xef, 0xae, 0x77, 0xfe, 0x00, 0xf0,
+    0xee, 0x4e, 0xc4, 0x93, 0x91, 0xfe, 0xbc, 0x95,
+    0x7d, 0x86, 0xf5, 0x60, 0x92, 0x97, 0xa0, 0x07,
+    0xa7, 0x01, 0x87, 0x23, 0x45, 0x95, 0x49, 0x0e,
+    0xe1, 0x92, 0x9d, 0x3e, 0x58, 0x51, 0x07, 0xbb,
+    0x22, 0x5f, 0x71, 0x54, 0x75, 0x66, 0x72, 0xf7,
+    0x02, 0x96, 0x48, 0x47, 0xea, 0x2b, 0x2c, 0x4e,
+    0x50, 0xbd, 0x4c, 0xd1, 0xfb, 0xe1, 0x60, 0xbd,
+    0xec, 0x2b, 0xda, 0x82, 0xd1, 0x52, 0x70, 0x99,
+    0xdf, 0x62, 0x27, 0x7e, 0x1c, 0x9f, 0xaa, 0x85,
+    0x0c, 0x71, 0x38, 0xaf, 0xc5, 0xc5, 0xa5, 0x14,
+    0x16, 0x94, 0x1e, 0xd6, 0xbc, 0xdb, 0x91, 0xf9,
+    0x6c, 0x50, 0xd2, 0xc3, 0x1b, 0xdb, 0xc4, 0x9d,
+    0xfe, 0xb7, 0x7b, 0xc7, 0x9a, 0x32, 0x34, 0x4a,
+    0x7b, 0x6e, 0x96, 0x2b, 0xc5, 0x11, 0x0b, 0xd3,
+    0xd3, 0x28, 0x13, 0xeb, 0x53, 0xdb, 0x39, 0xb2,
+    0xd9, 0x95, 0x82, 0x8a, 0x98, 0x87, 0x59, 0x29,
+    0x2d, 0x87, 0x4c, 0x50, 0x83, 0x9b, 0xfa, 0x65,
+    0xfc, 0x19, 0x4b, 0x18, 0xcf, 0x1f, 0xdb, 0xb1,
+    0x95, 0x15, 0x75, 0x43, 0xf5, 0x38, 0x43, 0x3d,
+    0x73, 0x26, 0x86, 0x62, 0x99, 0xef, 0x17, 0x07,
+    0x92, 0xf0, 0xd2, 0xa6, 0x21, 0x00, 0x94, 0x0b,
+    0x0d, 0xb5, 0x1a, 0x8a
+};
+static const unsigned int root_pub_table_len = 772;
+#endif
+
+const struct bootutil_key bootutil_rsa_tables[] = {
+    {
+        .key = root_pub_table,
+        .len = &root_pub_table_len,
+    },
+};
+#endif
+
 #if defined(MCUBOOT_ENCRYPT_RSA)
 unsigned char enc_key[] = {
   0x30, 0x82, 0x04, 0xa4, 0x02, 0x01, 0x00, 0x02, 0x82, 0x01, 0x01, 0x00,
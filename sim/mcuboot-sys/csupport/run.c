@@ -7,11 +7,16 @@
 #include <string.h>
 #include <bootutil/bootutil.h>
 #include <bootutil/image.h>
+#include <bootutil/boot_request_log.h>
+#include <bootutil/boot_image_writer.h>
 #include <errno.h>
 
 #include <flash_map_backend/flash_map_backend.h>
 
 #include "../../../boot/bootutil/src/bootutil_priv.h"
+#include "../../../boot/bootutil/src/bootutil_depends.h"
+#include "../../../boot/bootutil/src/bootutil_scratch.h"
+#include "bootutil/crypto/sha.h"
 #include "bootsim.h"
 
 #ifdef MCUBOOT_ENCRYPT_RSA
@@ -23,6 +28,23 @@
 #include "mbedtls/nist_kw.h"
 #endif
 
+#if defined(MCUBOOT_ECDSA_COMB_TABLES) || defined(MCUBOOT_ED25519_KEY_TABLES) || \
+    defined(MCUBOOT_RSA_KEY_TABLES) || defined(MCUBOOT_SHA_KERNEL)
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "bootutil/sign_key.h"
+#endif
+#ifdef MCUBOOT_ECDSA_COMB_TABLES
+#include "bootutil/crypto/ecdsa.h"
+#endif
+#ifdef MCUBOOT_RSA_KEY_TABLES
+#define BOOTUTIL_CRYPTO_RSA_SIGN_ENABLED
+#include "bootutil/crypto/rsa.h"
+#include "bootutil/crypto/rsa_mont.h"
+#endif
+
 #define BOOT_LOG_LEVEL BOOT_LOG_LEVEL_ERROR
 #include <bootutil/bootutil_log.h>
 #include "bootutil/crypto/common.h"
@@ -223,6 +245,225 @@ done:
 #endif
 }
 
+#if defined(MCUBOOT_ECDSA_COMB_TABLES) || defined(MCUBOOT_ED25519_KEY_TABLES) || \
+    defined(MCUBOOT_RSA_KEY_TABLES) || defined(MCUBOOT_SHA_KERNEL)
+/* CPU cycles where the time stamp counter is available, nanoseconds otherwise. */
+static uint64_t bench_ticks(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+#endif
+}
+#endif
+
+#ifdef MCUBOOT_ECDSA_COMB_TABLES
+/*
+ * Verify a signature with the first built-in key, either with the generic
+ * verification or with its comb table, and measure the total time taken by
+ * `iterations` verifications.
+ */
+int ecdsa_verify_bench_(int use_comb, uint8_t *hash, uint8_t *sig, unsigned sig_len,
+                        unsigned iterations, uint64_t *ticks)
+{
+    bootutil_ecdsa_context ctx;
+    uint8_t *pubkey;
+    uint8_t *end;
+    uint64_t start;
+    unsigned i;
+    int rc = -1;
+
+    pubkey = (uint8_t *)bootutil_keys[0].key;
+    end = pubkey + *bootutil_keys[0].len;
+    bootutil_ecdsa_init(&ctx);
+
+    if (bootutil_ecdsa_parse_public_key(&ctx, &pubkey, end) != 0) {
+        goto out;
+    }
+
+    start = bench_ticks();
+    for (i = 0; i < iterations; i++) {
+        if (use_comb) {
+            rc = bootutil_ecdsa_verify_comb(&ctx, pubkey, end - pubkey,
+                                            bootutil_ecdsa_combs[0].key,
+                                            *bootutil_ecdsa_combs[0].len,
+                                            hash, 32, sig, sig_len);
+        } else {
+            rc = bootutil_ecdsa_verify(&ctx, pubkey, end - pubkey, hash, 32, sig, sig_len);
+        }
+    }
+    *ticks = bench_ticks() - start;
+
+out:
+    bootutil_ecdsa_drop(&ctx);
+    return rc;
+}
+#endif /* MCUBOOT_ECDSA_COMB_TABLES */
+
+#ifdef MCUBOOT_ED25519_KEY_TABLES
+extern int ED25519_verify(const uint8_t *message, size_t message_len,
+                          const uint8_t signature[64], const uint8_t public_key[32]);
+extern int ED25519_verify_precomp(const uint8_t *message, size_t message_len,
+                                  const uint8_t signature[64], const uint8_t public_key[32],
+                                  const uint8_t *table, size_t table_len);
+
+/*
+ * Verify an Ed25519 signature with the first built-in key, either with the
+ * generic verification or with its key table, and measure the total time
+ * taken by `iterations` verifications.  Returns 0 if the signature is valid.
+ */
+int ed25519_verify_bench_(int use_table, const uint8_t *msg, unsigned msg_len,
+                          const uint8_t *sig, unsigned iterations, uint64_t *ticks)
+{
+    /* The raw key is at the end of the SubjectPublicKeyInfo. */
+    const uint8_t *pubkey = bootutil_keys[0].key + *bootutil_keys[0].len - 32;
+    uint64_t start;
+    unsigned i;
+    int rc = 0;
+
+    start = bench_ticks();
+    for (i = 0; i < iterations; i++) {
+        if (use_table) {
+            rc = ED25519_verify_precomp(msg, msg_len, sig, pubkey,
+                                        bootutil_ed25519_tables[0].key,
+                                        *bootutil_ed25519_tables[0].len);
+        } else {
+            rc = ED25519_verify(msg, msg_len, sig, pubkey);
+        }
+    }
+    *ticks = bench_ticks() - start;
+
+    return rc == 1 ? 0 : -1;
+}
+#endif /* MCUBOOT_ED25519_KEY_TABLES */
+
+#ifdef MCUBOOT_RSA_KEY_TABLES
+/*
+ * Apply the public key operation of the first built-in key to a signature,
+ * either by setting up an RSA context from the DER key as the generic
+ * verification does, or with the Montgomery parameters of the key, and
+ * measure the total time taken by `iterations` operations.  The result,
+ * sig^65537 mod N, is stored in `em`.
+ */
+int rsa_public_bench_(int use_table, const uint8_t *sig, unsigned sig_len, uint8_t *em,
+                      unsigned iterations, uint64_t *ticks)
+{
+    bootutil_rsa_context ctx;
+    uint8_t *cp;
+    uint64_t start;
+    unsigned i;
+    int rc = -1;
+
+    start = bench_ticks();
+    for (i = 0; i < iterations; i++) {
+        if (use_table) {
+            rc = bootutil_rsa_mont_public(bootutil_keys[0].key, *bootutil_keys[0].len,
+                                          bootutil_rsa_tables[0].key,
+                                          *bootutil_rsa_tables[0].len, sig, sig_len, em);
+        } else {
+            bootutil_rsa_init(&ctx);
+            cp = (uint8_t *)bootutil_keys[0].key;
+            rc = bootutil_rsa_parse_public_key(&ctx, &cp, cp + *bootutil_keys[0].len);
+            if (rc == 0) {
+                rc = sig_len == bootutil_rsa_get_len(&ctx) ?
+                     bootutil_rsa_public(&ctx, sig, em) : -1;
+            }
+            bootutil_rsa_drop(&ctx);
+        }
+    }
+    *ticks = bench_ticks() - start;
+
+    return rc != 0 ? -1 : 0;
+}
+#endif /* MCUBOOT_RSA_KEY_TABLES */
+
+#ifdef MCUBOOT_SHA_KERNEL
+/*
+ * Compute the SHA-256 of `data`, either with TinyCrypt's own implementation
+ * or with the compression kernel selected for the build, and measure the
+ * total time taken by `iterations` computations.
+ */
+int sha256_bench_(int use_kernel, const uint8_t *data, unsigned len, uint8_t *digest,
+                  unsigned iterations, uint64_t *ticks)
+{
+    struct tc_sha256_state_struct ctx;
+    uint64_t start;
+    unsigned i;
+    int rc = TC_CRYPTO_SUCCESS;
+
+    start = bench_ticks();
+    for (i = 0; i < iterations && rc == TC_CRYPTO_SUCCESS; i++) {
+        tc_sha256_init(&ctx);
+        if (use_kernel) {
+            rc = bootutil_tc_sha256_update(&ctx, data, len);
+            if (rc == TC_CRYPTO_SUCCESS) {
+                rc = bootutil_tc_sha256_final(digest, &ctx);
+            }
+        } else {
+            rc = tc_sha256_update(&ctx, data, len);
+            if (rc == TC_CRYPTO_SUCCESS) {
+                rc = tc_sha256_final(digest, &ctx);
+            }
+        }
+    }
+    *ticks = bench_ticks() - start;
+
+    return rc == TC_CRYPTO_SUCCESS ? 0 : -1;
+}
+#endif /* MCUBOOT_SHA_KERNEL */
+
+#if MCUBOOT_IMAGE_NUMBER > 1
+/*
+ * Run the dependency resolver on a graph of `num_images` images, which can be
+ * more than the images of the simulated device.  `versions` holds the version
+ * of each slot of each image, and `known` the slots whose dependencies are
+ * read.  Dependency `i` belongs to slot `dep_slots[i]` of image
+ * `dep_images[i]`.  The swap types are updated in place and the update order
+ * is returned in `order`.
+ */
+int deps_solve_(unsigned num_images, const struct image_version *versions,
+                const uint8_t *known, unsigned num_deps, const uint8_t *dep_images,
+                const uint8_t *dep_slots, const struct image_dependency *deps,
+                uint8_t *swap_type, uint8_t *order)
+{
+    struct boot_deps graph;
+    unsigned image;
+    unsigned slot;
+    unsigned i;
+    int rc;
+
+    if (num_images > BOOT_DEPS_MAX_IMAGES) {
+        return BOOT_EBADARGS;
+    }
+
+    boot_deps_init(&graph, num_images);
+    for (image = 0; image < num_images; image++) {
+        for (slot = 0; slot < BOOT_NUM_SLOTS; slot++) {
+            graph.version[image][slot] = versions[image * BOOT_NUM_SLOTS + slot];
+        }
+        graph.slots[image] = known[image];
+    }
+
+    for (i = 0; i < num_deps; i++) {
+        if (dep_images[i] >= num_images || dep_slots[i] >= BOOT_NUM_SLOTS) {
+            return BOOT_EBADARGS;
+        }
+        rc = boot_deps_add(&graph, dep_images[i], dep_slots[i], &deps[i]);
+        if (rc != 0) {
+            return rc;
+        }
+    }
+
+    boot_deps_solve(&graph, swap_type, order);
+
+    return 0;
+}
+#endif /* MCUBOOT_IMAGE_NUMBER > 1 */
+
 uint32_t flash_area_align(const struct flash_area *area)
 {
     return sim_flash_align(area->fa_device_id);
@@ -275,6 +516,7 @@ int invoke_boot_go(struct sim_context *ctx, struct area_desc *adesc,
         (void) image_id;
 #endif /* BOOT_IMAGE_NUMBER > 1 */
 
+        (void)fih_delay_init();
         res = context_boot_go(state, rsp);
         sim_reset_flash_areas();
         sim_reset_context();
@@ -346,6 +588,125 @@ int invoke_boot_load_image_from_flash_to_sram(struct sim_context *ctx, struct ar
 #endif /* MCUBOOT_RAM_LOAD */
 }
 
+/*
+ * Open the boot request log in the given area and apply a list of operations,
+ * given as (entry, value) pairs.  An entry of 0xff clears every entry except
+ * entry 0.  The entry values are left in `values`.
+ */
+int invoke_boot_request_log(struct sim_context *ctx, struct area_desc *adesc,
+                            uint8_t area_id, const uint8_t *ops, uint32_t num_ops,
+                            uint8_t *values, uint32_t num_values)
+{
+    static const size_t keep[] = { 0 };
+    struct boot_request_log log;
+    const struct flash_area *fap;
+    uint32_t i;
+    int rc;
+
+    sim_set_flash_areas(adesc);
+    sim_set_context(ctx);
+
+    if (setjmp(ctx->boot_jmpbuf) == 0) {
+        rc = flash_area_open(area_id, &fap);
+        if (rc == 0) {
+            rc = boot_request_log_init(&log, fap, values, num_values);
+        }
+        for (i = 0; rc == 0 && i < num_ops; i++) {
+            if (ops[2 * i] == 0xff) {
+                rc = boot_request_log_clear(&log, keep, 1);
+            } else {
+                rc = boot_request_log_write(&log, ops[2 * i], ops[2 * i + 1]);
+            }
+        }
+    } else {
+        rc = -0x13579;
+    }
+
+    sim_reset_flash_areas();
+    sim_reset_context();
+    return rc;
+}
+
+/*
+ * Stream an image into the secondary slot of an image with the image writer,
+ * in chunks of pseudo-random sizes derived from `seed`, as an application
+ * receiving it would.
+ */
+int invoke_image_writer(struct sim_context *ctx, struct area_desc *adesc,
+                        int image_index, const uint8_t *data, uint32_t len,
+                        uint32_t seed, int permanent)
+{
+    struct boot_image_writer writer;
+    uint32_t off = 0;
+    uint32_t n;
+    int rc;
+
+    sim_set_flash_areas(adesc);
+    sim_set_context(ctx);
+
+    if (setjmp(ctx->boot_jmpbuf) == 0) {
+        rc = boot_image_writer_open(&writer, image_index);
+        while (rc == 0 && off < len) {
+            seed = seed * 1103515245 + 12345;
+            n = 1 + (seed >> 16) % (2 * BOOT_IMAGE_WRITER_BUF_SZ + 7);
+            if (n > len - off) {
+                n = len - off;
+            }
+            rc = boot_image_writer_write(&writer, &data[off], n);
+            off += n;
+        }
+        if (rc == 0) {
+            rc = boot_image_writer_finish(&writer, permanent);
+        } else {
+            boot_image_writer_abort(&writer);
+        }
+    } else {
+        rc = -0x13579;
+    }
+
+    sim_reset_flash_areas();
+    sim_reset_context();
+    return rc;
+}
+
+int invoke_pre_erase(struct sim_context *ctx, struct area_desc *adesc,
+                     int image_index)
+{
+    int rc;
+
+    sim_set_flash_areas(adesc);
+    sim_set_context(ctx);
+
+    if (setjmp(ctx->boot_jmpbuf) == 0) {
+        rc = boot_pre_erase_multi(image_index);
+    } else {
+        rc = -0x13579;
+    }
+
+    sim_reset_flash_areas();
+    sim_reset_context();
+    return rc;
+}
+
+int invoke_set_confirmed(struct sim_context *ctx, struct area_desc *adesc,
+                         int image_index)
+{
+    int rc;
+
+    sim_set_flash_areas(adesc);
+    sim_set_context(ctx);
+
+    if (setjmp(ctx->boot_jmpbuf) == 0) {
+        rc = boot_set_confirmed_multi(image_index);
+    } else {
+        rc = -0x13579;
+    }
+
+    sim_reset_flash_areas();
+    sim_reset_context();
+    return rc;
+}
+
 void *os_malloc(size_t size)
 {
     // printf("os_malloc 0x%x bytes\n", size);
@@ -544,7 +905,7 @@ int flash_area_sector_from_off(uint32_t off, struct flash_sector *sector)
 int flash_area_get_sector(const struct flash_area *fa, uint32_t off,
                           struct flash_sector *sector)
 {
-    uint32_t i, sec_off, sec_size;
+    uint32_t i, lo, hi, mid, sec_off, sec_size;
     struct area *slot;
     struct area_desc *flash_areas;
 
@@ -560,19 +921,33 @@ int flash_area_get_sector(const struct flash_area *fa, uint32_t off,
     }
 
     slot = &flash_areas->slots[i];
+    if (slot->num_areas == 0) {
+        return -1;
+    }
 
-    for (i = 0; i < slot->num_areas; i++) {
-        sec_off = slot->areas[i].fa_off - slot->whole.fa_off;
-        sec_size = slot->areas[i].fa_size;
-
-        if (off >= sec_off && off < (sec_off + sec_size)) {
-            sector->fs_off = sec_off;
-            sector->fs_size = sec_size;
-            break;
+    /* The sectors are sorted by offset, find the last one starting at or
+     * before off. */
+    lo = 0;
+    hi = slot->num_areas;
+    while (hi - lo > 1) {
+        mid = lo + (hi - lo) / 2;
+        if (slot->areas[mid].fa_off - slot->whole.fa_off <= off) {
+            lo = mid;
+        } else {
+            hi = mid;
         }
     }
 
-    return (i < slot->num_areas) ? 0 : -1;
+    sec_off = slot->areas[lo].fa_off - slot->whole.fa_off;
+    sec_size = slot->areas[lo].fa_size;
+
+    if (off < sec_off || off >= (sec_off + sec_size)) {
+        return -1;
+    }
+
+    sector->fs_off = sec_off;
+    sector->fs_size = sec_size;
+    return 0;
 }
 
 void sim_assert(int x, const char *assertion, const char *file, unsigned int line, const char *function)
@@ -601,3 +976,22 @@ uint32_t boot_magic_sz(void)
 {
     return BOOT_MAGIC_ALIGN_SIZE;
 }
+
+uint32_t boot_max_img_sectors(void)
+{
+    return BOOT_MAX_IMG_SECTORS;
+}
+
+uint32_t boot_scratch_sz(void)
+{
+    return BOOT_SCRATCH_SZ;
+}
+
+uint32_t sim_enc_unwrap_count(void)
+{
+#if defined(MCUBOOT_ENC_IMAGES)
+    return boot_enc_unwrap_count();
+#else
+    return 0;
+#endif
+}
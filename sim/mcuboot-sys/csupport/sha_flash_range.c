@@ -0,0 +1,120 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright (c) 2026 Linaro LTD
+ */
+
+/*
+ * Mock of a crypto engine hashing flash ranges, for MCUBOOT_SHA_FLASH_RANGE.
+ *
+ * The engine runs on a thread of its own, hashing a chunk of the range while
+ * the next one is read, the way a DMA would fetch it.  The flash is only read
+ * by the thread of the boot, which is the one the simulated flash belongs to.
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <flash_map_backend/flash_map_backend.h>
+
+#include "bootutil/crypto/sha.h"
+
+#define SHA_ENGINE_CHUNK_SZ 512
+
+struct sha_engine {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    bootutil_sha_context *ctx;
+    uint8_t buf[2][SHA_ENGINE_CHUNK_SZ];
+    uint32_t len[2];            /* Bytes waiting to be hashed in each buffer */
+    bool done;                  /* No more chunks are coming */
+};
+
+static void *
+sha_engine_run(void *arg)
+{
+    struct sha_engine *engine = arg;
+    uint32_t len;
+    int i = 0;
+
+    pthread_mutex_lock(&engine->lock);
+    for (;;) {
+        while (engine->len[i] == 0 && !engine->done) {
+            pthread_cond_wait(&engine->cond, &engine->lock);
+        }
+        len = engine->len[i];
+        if (len == 0) {
+            break;
+        }
+
+        pthread_mutex_unlock(&engine->lock);
+        bootutil_sha_update(engine->ctx, engine->buf[i], len);
+        pthread_mutex_lock(&engine->lock);
+
+        engine->len[i] = 0;
+        pthread_cond_broadcast(&engine->cond);
+        i ^= 1;
+    }
+    pthread_mutex_unlock(&engine->lock);
+
+    return NULL;
+}
+
+int
+bootutil_sha_update_flash(bootutil_sha_context *ctx, const struct flash_area *fap,
+                          uint32_t off, uint32_t len)
+{
+    struct sha_engine engine;
+    pthread_t thread;
+    uint32_t n;
+    int rc = 0;
+    int i = 0;
+
+    pthread_mutex_init(&engine.lock, NULL);
+    pthread_cond_init(&engine.cond, NULL);
+    engine.ctx = ctx;
+    engine.len[0] = 0;
+    engine.len[1] = 0;
+    engine.done = false;
+
+    if (pthread_create(&thread, NULL, sha_engine_run, &engine) != 0) {
+        rc = -1;
+        goto out;
+    }
+
+    while (len > 0) {
+        n = len < SHA_ENGINE_CHUNK_SZ ? len : SHA_ENGINE_CHUNK_SZ;
+
+        pthread_mutex_lock(&engine.lock);
+        while (engine.len[i] != 0) {
+            pthread_cond_wait(&engine.cond, &engine.lock);
+        }
+        pthread_mutex_unlock(&engine.lock);
+
+        rc = flash_area_read(fap, off, engine.buf[i], n);
+        if (rc != 0) {
+            break;
+        }
+
+        pthread_mutex_lock(&engine.lock);
+        engine.len[i] = n;
+        pthread_cond_broadcast(&engine.cond);
+        pthread_mutex_unlock(&engine.lock);
+
+        off += n;
+        len -= n;
+        i ^= 1;
+    }
+
+    pthread_mutex_lock(&engine.lock);
+    engine.done = true;
+    pthread_cond_broadcast(&engine.cond);
+    pthread_mutex_unlock(&engine.lock);
+    pthread_join(thread, NULL);
+
+out:
+    pthread_cond_destroy(&engine.cond);
+    pthread_mutex_destroy(&engine.lock);
+    return rc;
+}
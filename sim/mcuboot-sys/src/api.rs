@@ -8,7 +8,7 @@
 
 use crate::area::CAreaDesc;
 use log::{Level, log_enabled, warn};
-use simflash::{Result, Flash, FlashPtr};
+use simflash::{Result, Flash, FlashOp, FlashPtr};
 use std::{
     cell::RefCell,
     collections::HashMap,
@@ -165,8 +165,13 @@ impl NvCounterStorage {
     }
 }
 
+/// A journal of the flash operations performed, in order, tagged with the device id they were
+/// performed on.
+pub type FlashJournal = Vec<(u8, FlashOp)>;
+
 thread_local! {
     pub static THREAD_CTX: RefCell<FlashContext> = RefCell::new(FlashContext::new());
+    pub static JOURNAL_CTX: RefCell<Option<FlashJournal>> = RefCell::new(None);
     pub static SIM_CTX: RefCell<CSimContextPtr> = RefCell::new(CSimContextPtr::new());
     pub static RAM_CTX: RefCell<BootsimRamInfo> = RefCell::new(BootsimRamInfo::default());
     pub static NV_COUNTER_CTX: RefCell<NvCounterStorage> = RefCell::new(NvCounterStorage::new());
@@ -268,6 +273,28 @@ pub fn clear_ram_info() {
     });
 }
 
+/// Start recording every erase and write performed on this thread.
+pub fn start_journal() {
+    JOURNAL_CTX.with(|ctx| {
+        ctx.replace(Some(Vec::new()));
+    });
+}
+
+/// Stop recording, and return the operations recorded since `start_journal`.
+pub fn take_journal() -> FlashJournal {
+    JOURNAL_CTX.with(|ctx| {
+        ctx.replace(None).unwrap_or_default()
+    })
+}
+
+fn record(dev_id: u8, rc: libc::c_int, op: impl FnOnce() -> FlashOp) {
+    JOURNAL_CTX.with(|ctx| {
+        if let Some(journal) = ctx.borrow_mut().as_mut() {
+            journal.push((dev_id, if rc == 0 { op() } else { FlashOp::Failed }));
+        }
+    });
+}
+
 #[no_mangle]
 pub extern "C" fn sim_flash_erase(dev_id: u8, offset: u32, size: u32) -> libc::c_int {
     let mut rc: libc::c_int = -19;
@@ -277,6 +304,7 @@ pub extern "C" fn sim_flash_erase(dev_id: u8, offset: u32, size: u32) -> libc::c
             rc = map_err(dev.erase(offset as usize, size as usize));
         }
     });
+    record(dev_id, rc, || FlashOp::Erase { offset: offset as usize, len: size as usize });
     rc
 }
 
@@ -303,6 +331,10 @@ pub extern "C" fn sim_flash_write(dev_id: u8, offset: u32, src: *const u8, size:
             rc = map_err(dev.write(offset as usize, &buf));
         }
     });
+    record(dev_id, rc, || {
+        let buf: &[u8] = unsafe { slice::from_raw_parts(src, size as usize) };
+        FlashOp::Write { offset: offset as usize, data: buf.to_vec() }
+    });
     rc
 }
 
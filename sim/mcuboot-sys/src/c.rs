@@ -14,6 +14,8 @@ use crate::api;
 use std::sync::Once;
 
 use std::borrow::Borrow;
+#[cfg(any(feature = "fih-profiling", feature = "log-binary"))]
+use std::ffi::CStr;
 
 /// The result of an invocation of `boot_go`.  This is intentionally opaque so that we can provide
 /// accessors for everything we need from this.
@@ -115,6 +117,16 @@ pub fn boot_go(multiflash: &mut SimMultiFlash, areadesc: &AreaDesc,
     }
 }
 
+/// Invoke the bootloader to completion, recording every erase and write it performs.  The returned
+/// journal can be replayed on a copy of the original flash to reconstruct the state of the flash
+/// after any number of operations, as if the bootloader had been interrupted there.
+pub fn boot_go_journaled(multiflash: &mut SimMultiFlash, areadesc: &AreaDesc,
+                         image_index: Option<i32>) -> (BootGoResult, api::FlashJournal) {
+    api::start_journal();
+    let result = boot_go(multiflash, areadesc, None, image_index, false);
+    (result, api::take_journal())
+}
+
 pub fn boot_load_image_from_flash_to_sram(multiflash: &mut SimMultiFlash, areadesc: &AreaDesc) -> bool {
     init_crypto();
 
@@ -137,6 +149,130 @@ pub fn boot_load_image_from_flash_to_sram(multiflash: &mut SimMultiFlash, areade
     result == 0
 }
 
+/// Apply a sequence of updates to the boot request log stored in `area`.  Each operation is an
+/// `(entry, value)` pair; an entry of 0xff clears every entry but the first.  The log is opened
+/// first, so an empty list of operations just reads the current values back.  Returns `None` if
+/// the run was stopped by the flash counter, otherwise the result code and the entry values.
+pub fn boot_request_log(multiflash: &mut SimMultiFlash, areadesc: &AreaDesc, area: u8,
+                        ops: &[(u8, u8)], counter: Option<&mut i32>,
+                        num_values: usize) -> Option<(i32, Vec<u8>)> {
+    for (&dev_id, flash) in multiflash.iter_mut() {
+        api::set_flash(dev_id, flash);
+    }
+    let mut sim_ctx = api::CSimContext {
+        flash_counter: match counter {
+            None => 0,
+            Some(ref c) => **c as libc::c_int
+        },
+        .. Default::default()
+    };
+    let raw_ops: Vec<u8> = ops.iter().flat_map(|&(entry, value)| [entry, value]).collect();
+    let mut values = vec![0u8; num_values];
+    let result: i32 = unsafe {
+        let adesc = areadesc.get_c();
+        raw::invoke_boot_request_log(&mut sim_ctx as *mut _, adesc.borrow() as *const _, area,
+                                     raw_ops.as_ptr(), ops.len() as u32,
+                                     values.as_mut_ptr(), num_values as u32) as i32
+    };
+    if let Some(c) = counter {
+        *c = sim_ctx.flash_counter;
+    }
+    for &dev_id in multiflash.keys() {
+        api::clear_flash(dev_id);
+    }
+    if result == -0x13579 {
+        None
+    } else {
+        Some((result, values))
+    }
+}
+
+/// Stream `data` into the secondary slot of `image_index` with the image writer, in chunks of
+/// sizes derived from `seed`, and mark it as pending.  Returns the result code of the writer.
+pub fn image_writer(multiflash: &mut SimMultiFlash, areadesc: &AreaDesc, image_index: usize,
+                    data: &[u8], seed: u32, permanent: bool) -> i32 {
+    for (&dev_id, flash) in multiflash.iter_mut() {
+        api::set_flash(dev_id, flash);
+    }
+    let mut sim_ctx = api::CSimContext::default();
+    let result: i32 = unsafe {
+        let adesc = areadesc.get_c();
+        raw::invoke_image_writer(&mut sim_ctx as *mut _, adesc.borrow() as *const _,
+                                 image_index as libc::c_int, data.as_ptr(), data.len() as u32,
+                                 seed, permanent as libc::c_int) as i32
+    };
+    for &dev_id in multiflash.keys() {
+        api::clear_flash(dev_id);
+    }
+    result
+}
+
+/// Erase what the previous upgrade of `image_index` left behind, as the application would once
+/// the image is confirmed.  Returns `None` if the run was stopped by the flash counter, otherwise
+/// the result code of boot_pre_erase_multi().
+pub fn pre_erase(multiflash: &mut SimMultiFlash, areadesc: &AreaDesc, image_index: usize,
+                 counter: Option<&mut i32>) -> Option<i32> {
+    for (&dev_id, flash) in multiflash.iter_mut() {
+        api::set_flash(dev_id, flash);
+    }
+    let mut sim_ctx = api::CSimContext {
+        flash_counter: match counter {
+            None => 0,
+            Some(ref c) => **c as libc::c_int
+        },
+        .. Default::default()
+    };
+    let result: i32 = unsafe {
+        let adesc = areadesc.get_c();
+        raw::invoke_pre_erase(&mut sim_ctx as *mut _, adesc.borrow() as *const _,
+                              image_index as libc::c_int) as i32
+    };
+    if let Some(c) = counter {
+        *c = sim_ctx.flash_counter;
+    }
+    for &dev_id in multiflash.keys() {
+        api::clear_flash(dev_id);
+    }
+    if result == -0x13579 {
+        None
+    } else {
+        Some(result)
+    }
+}
+
+/// Confirm the image `image_index` in the primary slot, as the application would.  Returns `None`
+/// if the run was stopped by the flash counter, otherwise the result code of
+/// boot_set_confirmed_multi().
+pub fn set_confirmed(multiflash: &mut SimMultiFlash, areadesc: &AreaDesc, image_index: usize,
+                     counter: Option<&mut i32>) -> Option<i32> {
+    for (&dev_id, flash) in multiflash.iter_mut() {
+        api::set_flash(dev_id, flash);
+    }
+    let mut sim_ctx = api::CSimContext {
+        flash_counter: match counter {
+            None => 0,
+            Some(ref c) => **c as libc::c_int
+        },
+        .. Default::default()
+    };
+    let result: i32 = unsafe {
+        let adesc = areadesc.get_c();
+        raw::invoke_set_confirmed(&mut sim_ctx as *mut _, adesc.borrow() as *const _,
+                                  image_index as libc::c_int) as i32
+    };
+    if let Some(c) = counter {
+        *c = sim_ctx.flash_counter;
+    }
+    for &dev_id in multiflash.keys() {
+        api::clear_flash(dev_id);
+    }
+    if result == -0x13579 {
+        None
+    } else {
+        Some(result)
+    }
+}
+
 pub fn boot_trailer_sz(align: u32) -> u32 {
     unsafe { raw::boot_trailer_sz(align) }
 }
@@ -153,6 +289,39 @@ pub fn boot_max_align() -> usize {
     unsafe { raw::boot_max_align() as usize }
 }
 
+pub fn boot_max_img_sectors() -> usize {
+    unsafe { raw::boot_max_img_sectors() as usize }
+}
+
+/// The phases of the boot sharing the scratch arena, as `enum boot_scratch_phase`.
+#[repr(C)]
+#[derive(Clone, Copy, Debug)]
+pub enum ScratchPhase {
+    Validate,
+    Copy,
+    Serial,
+}
+
+/// Size of the scratch arena.
+pub fn boot_scratch_sz() -> usize {
+    unsafe { raw::boot_scratch_sz() as usize }
+}
+
+/// Largest part of the scratch arena used by a phase, in the boots run on the current thread.
+pub fn boot_scratch_high_water(phase: ScratchPhase) -> usize {
+    unsafe { raw::boot_scratch_high_water(phase) }
+}
+
+/// Number of encryption keys unwrapped by the boots run on the current thread.
+pub fn enc_unwrap_count() -> u32 {
+    unsafe { raw::sim_enc_unwrap_count() }
+}
+
+/// Whether a phase of the boot last run on the current thread still holds the scratch arena.
+pub fn boot_scratch_held() -> bool {
+    unsafe { raw::boot_scratch_held() }
+}
+
 pub fn rsa_oaep_encrypt(pubkey: &[u8], seckey: &[u8]) -> Result<[u8; 256], &'static str> {
     unsafe {
         let mut encbuf: [u8; 256] = [0; 256];
@@ -178,6 +347,233 @@ pub fn kw_encrypt(kek: &[u8], seckey: &[u8], keylen: u32) -> Result<Vec<u8>, &'s
     }
 }
 
+/// Verify a DER encoded signature of `hash` with the first built-in ECDSA key, `iterations` times,
+/// either with the generic verification or with the comb table of the key.  Returns the result of
+/// the last verification, and the total time taken, in CPU cycles on x86 hosts or in nanoseconds
+/// otherwise.
+#[cfg(feature = "ecdsa-comb")]
+pub fn ecdsa_verify_bench(use_comb: bool, hash: &[u8; 32], sig: &[u8],
+                          iterations: u32) -> (i32, u64) {
+    let mut hash = *hash;
+    let mut sig = sig.to_vec();
+    let mut ticks = 0u64;
+    let rc = unsafe {
+        raw::ecdsa_verify_bench_(use_comb as libc::c_int, hash.as_mut_ptr(), sig.as_mut_ptr(),
+                                 sig.len() as libc::c_uint, iterations, &mut ticks)
+    };
+    (rc as i32, ticks)
+}
+
+/// Verify an Ed25519 signature of `msg` with the first built-in key, `iterations` times, either
+/// with the generic verification or with the precomputed table of the key.  Returns 0 if the
+/// signature is valid, and the total time taken, as for `ecdsa_verify_bench`.
+#[cfg(feature = "ed25519-tables")]
+pub fn ed25519_verify_bench(use_table: bool, msg: &[u8], sig: &[u8; 64],
+                            iterations: u32) -> (i32, u64) {
+    let mut ticks = 0u64;
+    let rc = unsafe {
+        raw::ed25519_verify_bench_(use_table as libc::c_int, msg.as_ptr(),
+                                   msg.len() as libc::c_uint, sig.as_ptr(), iterations,
+                                   &mut ticks)
+    };
+    (rc as i32, ticks)
+}
+
+/// Apply the public key operation of the first built-in RSA key to `sig`, `iterations` times,
+/// either with a context set up from the DER key or with the Montgomery parameters of the key.
+/// Returns sig^65537 mod N, or None if the signature was rejected, and the total time taken, as
+/// for `ecdsa_verify_bench`.
+#[cfg(feature = "rsa-tables")]
+pub fn rsa_public_bench(use_table: bool, sig: &[u8], iterations: u32) -> (Option<Vec<u8>>, u64) {
+    let mut em = vec![0u8; sig.len()];
+    let mut ticks = 0u64;
+    let rc = unsafe {
+        raw::rsa_public_bench_(use_table as libc::c_int, sig.as_ptr(), sig.len() as libc::c_uint,
+                               em.as_mut_ptr(), iterations, &mut ticks)
+    };
+    (if rc == 0 { Some(em) } else { None }, ticks)
+}
+
+/// Compute the SHA-256 of `data`, `iterations` times, either with TinyCrypt's own implementation or
+/// with the compression kernel selected for the build.  Returns the digest, or None on failure, and
+/// the total time taken, as for `ecdsa_verify_bench`.
+#[cfg(feature = "sha-kernels")]
+pub fn sha256_bench(use_kernel: bool, data: &[u8], iterations: u32) -> (Option<[u8; 32]>, u64) {
+    let mut digest = [0u8; 32];
+    let mut ticks = 0u64;
+    let rc = unsafe {
+        raw::sha256_bench_(use_kernel as libc::c_int, data.as_ptr(), data.len() as libc::c_uint,
+                           digest.as_mut_ptr(), iterations, &mut ticks)
+    };
+    (if rc == 0 { Some(digest) } else { None }, ticks)
+}
+
+/// An image version, laid out as `struct image_version`.
+#[repr(C)]
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
+pub struct DepVersion {
+    pub major: u8,
+    pub minor: u8,
+    pub revision: u16,
+    pub build_num: u32,
+}
+
+/// A dependency of slot `slot` of image `image` on at least `min_version` of image `on`.
+#[derive(Clone, Copy, Debug)]
+pub struct Dep {
+    pub image: u8,
+    pub slot: u8,
+    pub on: u8,
+    pub min_version: DepVersion,
+}
+
+/// Run the dependency resolver of the bootloader on a graph of up to 8 images.  `versions` gives
+/// the version of the primary and secondary slot of each image, and `known` the slots, as a bit
+/// mask, whose dependencies have been read.  The swap types are updated in place, and the order in
+/// which to update the images is returned, or the error code if the graph was rejected.
+#[cfg(feature = "multiimage")]
+pub fn deps_solve(versions: &[[DepVersion; 2]], known: &[u8], deps: &[Dep],
+                  swap_type: &mut [u8]) -> Result<Vec<u8>, i32> {
+    assert_eq!(versions.len(), known.len());
+    assert_eq!(versions.len(), swap_type.len());
+
+    let flat: Vec<DepVersion> = versions.iter().flatten().cloned().collect();
+    let dep_images: Vec<u8> = deps.iter().map(|d| d.image).collect();
+    let dep_slots: Vec<u8> = deps.iter().map(|d| d.slot).collect();
+    let c_deps: Vec<raw::CImageDependency> = deps.iter().map(|d| raw::CImageDependency {
+        image_id: d.on,
+        _pad1: 0,
+        _pad2: 0,
+        image_min_version: d.min_version,
+    }).collect();
+    let mut order = vec![0u8; versions.len()];
+
+    let rc = unsafe {
+        raw::deps_solve_(versions.len() as libc::c_uint, flat.as_ptr(), known.as_ptr(),
+                         deps.len() as libc::c_uint, dep_images.as_ptr(), dep_slots.as_ptr(),
+                         c_deps.as_ptr(), swap_type.as_mut_ptr(), order.as_mut_ptr())
+    };
+    if rc == 0 { Ok(order) } else { Err(rc as i32) }
+}
+
+/// The FIH calls and delays made from one call site, laid out as `struct fih_profile_site`.
+#[cfg(feature = "fih-profiling")]
+#[repr(C)]
+#[derive(Debug)]
+pub struct FihSite {
+    func: *const libc::c_char,
+    file: *const libc::c_char,
+    pub line: u32,
+    pub calls: u32,
+    pub delays: u32,
+    pub delay_loops: u64,
+}
+
+#[cfg(feature = "fih-profiling")]
+impl FihSite {
+    /// The function called with FIH_CALL from this site, if any.
+    pub fn func(&self) -> Option<String> {
+        if self.func.is_null() {
+            None
+        } else {
+            Some(unsafe { CStr::from_ptr(self.func) }.to_string_lossy().into_owned())
+        }
+    }
+
+    pub fn file(&self) -> String {
+        unsafe { CStr::from_ptr(self.file) }.to_string_lossy().into_owned()
+    }
+}
+
+/// Clear the FIH counters of the current thread, and seed the delays of the following boots.
+#[cfg(feature = "fih-profiling")]
+pub fn fih_profile_reset(seed: u32) {
+    unsafe { raw::sim_fih_profile_reset(seed) }
+}
+
+/// The FIH counters of the boots run on the current thread since the last reset.
+#[cfg(feature = "fih-profiling")]
+pub fn fih_profile_sites() -> Vec<FihSite> {
+    let mut sites = Vec::new();
+    loop {
+        let mut site = FihSite {
+            func: std::ptr::null(),
+            file: std::ptr::null(),
+            line: 0,
+            calls: 0,
+            delays: 0,
+            delay_loops: 0,
+        };
+        if unsafe { raw::sim_fih_profile_site(sites.len() as u32, &mut site) } != 0 {
+            return sites;
+        }
+        sites.push(site);
+    }
+}
+
+/// Header of the binary boot log, laid out as `struct boot_log_binary`.
+#[cfg(feature = "log-binary")]
+#[repr(C)]
+pub struct BootLogHeader {
+    magic: u32,
+    version: u8,
+    word_size: u8,
+    _seq: u16,
+    size: u32,
+    head: u32,
+    used: u32,
+    dropped: u32,
+}
+
+/// A message of the binary boot log.
+#[cfg(feature = "log-binary")]
+#[derive(Debug)]
+pub struct BootLogRecord {
+    pub level: u8,
+    pub seq: u16,
+    pub fmt: String,
+    pub args: Vec<usize>,
+}
+
+/// Empty the binary boot log of the current thread.
+#[cfg(feature = "log-binary")]
+pub fn boot_log_binary_init() {
+    unsafe { raw::boot_log_binary_init() }
+}
+
+/// The messages in the binary boot log of the current thread, oldest first, and the number of
+/// messages dropped from it.
+#[cfg(feature = "log-binary")]
+pub fn boot_log_binary() -> (Vec<BootLogRecord>, u32) {
+    let mut records = Vec::new();
+    unsafe {
+        let hdr = &*raw::boot_log_binary_get();
+        assert_eq!(hdr.magic, 0x424c4f47);
+        assert_eq!(hdr.version, 1);
+        assert_eq!(hdr.word_size as usize, std::mem::size_of::<usize>());
+
+        let size = hdr.size as usize;
+        let ring = std::slice::from_raw_parts((hdr as *const BootLogHeader).add(1) as *const usize,
+                                              size);
+        let mut pos = (hdr.head as usize + size - hdr.used as usize) % size;
+        let mut left = hdr.used as usize;
+        while left > 0 {
+            let word = ring[pos];
+            let nargs = (word >> 8) & 0xff;
+            let fmt = ring[(pos + 1) % size] as *const libc::c_char;
+            records.push(BootLogRecord {
+                level: word as u8,
+                seq: (word >> 16) as u16,
+                fmt: CStr::from_ptr(fmt).to_string_lossy().into_owned(),
+                args: (0..nargs).map(|i| ring[(pos + 2 + i) % size]).collect(),
+            });
+            pos = (pos + nargs + 2) % size;
+            left -= nargs + 2;
+        }
+        (records, hdr.dropped)
+    }
+}
+
 pub fn set_security_counter(image_index: u32, security_counter_value: u32) {
     api::sim_set_nv_counter_for_image(image_index, security_counter_value);
 }
@@ -196,6 +592,16 @@ mod raw {
     use crate::area::CAreaDesc;
     use crate::api::{BootRsp, CSimContext};
 
+    /// Laid out as `struct image_dependency`.
+    #[cfg(feature = "multiimage")]
+    #[repr(C)]
+    pub struct CImageDependency {
+        pub image_id: u8,
+        pub _pad1: u8,
+        pub _pad2: u16,
+        pub image_min_version: super::DepVersion,
+    }
+
     extern "C" {
         // This generates a warning about `CAreaDesc` not being foreign safe.  There doesn't appear to
         // be any way to get rid of this warning.  See https://github.com/rust-lang/rust/issues/34798
@@ -206,11 +612,31 @@ mod raw {
         pub fn invoke_boot_load_image_from_flash_to_sram(sim_ctx: *mut CSimContext,
             areadesc: *const CAreaDesc) -> libc::c_int;
 
+        pub fn invoke_boot_request_log(sim_ctx: *mut CSimContext, areadesc: *const CAreaDesc,
+            area_id: u8, ops: *const u8, num_ops: u32, values: *mut u8,
+            num_values: u32) -> libc::c_int;
+
+        pub fn invoke_image_writer(sim_ctx: *mut CSimContext, areadesc: *const CAreaDesc,
+            image_index: libc::c_int, data: *const u8, len: u32, seed: u32,
+            permanent: libc::c_int) -> libc::c_int;
+
+        pub fn invoke_pre_erase(sim_ctx: *mut CSimContext, areadesc: *const CAreaDesc,
+            image_index: libc::c_int) -> libc::c_int;
+
+        pub fn invoke_set_confirmed(sim_ctx: *mut CSimContext, areadesc: *const CAreaDesc,
+            image_index: libc::c_int) -> libc::c_int;
+
         pub fn boot_trailer_sz(min_write_sz: u32) -> u32;
         pub fn boot_status_sz(min_write_sz: u32) -> u32;
 
         pub fn boot_magic_sz() -> u32;
         pub fn boot_max_align() -> u32;
+        pub fn boot_max_img_sectors() -> u32;
+
+        pub fn boot_scratch_sz() -> u32;
+        pub fn boot_scratch_high_water(phase: super::ScratchPhase) -> libc::size_t;
+        pub fn boot_scratch_held() -> bool;
+        pub fn sim_enc_unwrap_count() -> u32;
 
         pub fn rsa_oaep_encrypt_(pubkey: *const u8, pubkey_len: libc::c_uint,
                                  seckey: *const u8, seckey_len: libc::c_uint,
@@ -219,6 +645,44 @@ mod raw {
         pub fn kw_encrypt_(kek: *const u8, seckey: *const u8,
                            encbuf: *mut u8) -> libc::c_int;
 
+        #[cfg(feature = "ecdsa-comb")]
+        pub fn ecdsa_verify_bench_(use_comb: libc::c_int, hash: *mut u8, sig: *mut u8,
+                                   sig_len: libc::c_uint, iterations: u32,
+                                   ticks: *mut u64) -> libc::c_int;
+
+        #[cfg(feature = "ed25519-tables")]
+        pub fn ed25519_verify_bench_(use_table: libc::c_int, msg: *const u8,
+                                     msg_len: libc::c_uint, sig: *const u8, iterations: u32,
+                                     ticks: *mut u64) -> libc::c_int;
+
+        #[cfg(feature = "rsa-tables")]
+        pub fn rsa_public_bench_(use_table: libc::c_int, sig: *const u8, sig_len: libc::c_uint,
+                                 em: *mut u8, iterations: u32,
+                                 ticks: *mut u64) -> libc::c_int;
+
+        #[cfg(feature = "sha-kernels")]
+        pub fn sha256_bench_(use_kernel: libc::c_int, data: *const u8, len: libc::c_uint,
+                             digest: *mut u8, iterations: u32,
+                             ticks: *mut u64) -> libc::c_int;
+
+        #[cfg(feature = "multiimage")]
+        pub fn deps_solve_(num_images: libc::c_uint, versions: *const super::DepVersion,
+                           known: *const u8, num_deps: libc::c_uint, dep_images: *const u8,
+                           dep_slots: *const u8, deps: *const CImageDependency,
+                           swap_type: *mut u8, order: *mut u8) -> libc::c_int;
+
+        #[cfg(feature = "fih-profiling")]
+        pub fn sim_fih_profile_reset(seed: u32);
+
+        #[cfg(feature = "fih-profiling")]
+        pub fn sim_fih_profile_site(idx: u32, site: *mut super::FihSite) -> libc::c_int;
+
+        #[cfg(feature = "log-binary")]
+        pub fn boot_log_binary_init();
+
+        #[cfg(feature = "log-binary")]
+        pub fn boot_log_binary_get() -> *const super::BootLogHeader;
+
         #[allow(unused)]
         pub fn psa_crypto_init() -> u32;
 
@@ -18,12 +18,14 @@ use rand::{
     Rng,
 };
 use std::{
+    cell::Cell,
     collections::HashMap,
     fs::File,
     io::{self, Write},
     iter::Enumerate,
     path::Path,
     slice,
+    sync::Arc,
 };
 use thiserror::Error;
 
@@ -61,6 +63,10 @@ pub trait Flash {
 
     fn set_verify_writes(&mut self, enable: bool);
 
+    /// Allow a written location to be written again, as long as this only programs more bits, as
+    /// NOR flash allows.
+    fn set_rewrite_bits(&mut self, enable: bool);
+
     fn sector_iter(&self) -> SectorIter<'_>;
     fn device_size(&self) -> usize;
 
@@ -82,18 +88,42 @@ fn esimulatedwrite<T: AsRef<str>>(message: T) -> FlashError {
     FlashError::SimulatedFail(message.as_ref().to_owned())
 }
 
-/// An emulated flash device.  It is represented as a block of bytes, and a list of the sector
-/// mappings.
+/// An emulated flash device.  It is represented as a list of sectors, each holding its own block
+/// of bytes.  The sector contents are shared copy-on-write between clones of the device, so
+/// cloning a device (for example to try a different power-fail point) only copies the sectors that
+/// are subsequently modified.
 #[derive(Clone)]
 pub struct SimFlash {
-    data: Vec<u8>,
-    write_safe: Vec<bool>,
+    blocks: Vec<Arc<SectorData>>,
     sectors: Vec<usize>,
+    // The offset of the start of each sector, used to look up sectors by offset.
+    bases: Arc<Vec<usize>>,
+    size: usize,
     bad_region: Vec<(usize, usize, f32)>,
     // Alignment required for writes.
     align: usize,
     verify_writes: bool,
+    rewrite_bits: bool,
     erased_val: u8,
+    // The number of bytes read from the device, for tests that measure how much flash the
+    // bootloader touches.
+    bytes_read: Cell<usize>,
+}
+
+/// The contents of a single sector.
+#[derive(Clone)]
+struct SectorData {
+    data: Vec<u8>,
+    write_safe: Vec<bool>,
+}
+
+impl SectorData {
+    fn new(size: usize, erased_val: u8) -> SectorData {
+        SectorData {
+            data: vec![erased_val; size],
+            write_safe: vec![true; size],
+        }
+    }
 }
 
 impl SimFlash {
@@ -103,54 +133,141 @@ impl SimFlash {
         assert!(align > 0);
         assert!(align & (align - 1) == 0);
 
-        let total = sectors.iter().sum();
+        let mut bases = Vec::with_capacity(sectors.len());
+        let mut total = 0;
+        for &size in &sectors {
+            bases.push(total);
+            total += size;
+        }
+
+        // All sectors of the same size start out sharing the same erased block.
+        let mut erased: HashMap<usize, Arc<SectorData>> = HashMap::new();
+        let blocks = sectors.iter().map(|&size| {
+            erased.entry(size)
+                .or_insert_with(|| Arc::new(SectorData::new(size, erased_val)))
+                .clone()
+        }).collect();
+
         SimFlash {
-            data: vec![erased_val; total],
-            write_safe: vec![true; total],
+            blocks,
             sectors,
+            bases: Arc::new(bases),
+            size: total,
             bad_region: Vec::new(),
             align,
             verify_writes: true,
+            rewrite_bits: false,
             erased_val,
+            bytes_read: Cell::new(0),
         }
     }
 
+    /// The number of bytes read from this device since it was created, or since the last call to
+    /// `reset_bytes_read`.
+    pub fn bytes_read(&self) -> usize {
+        self.bytes_read.get()
+    }
+
+    pub fn reset_bytes_read(&self) {
+        self.bytes_read.set(0);
+    }
+
     #[allow(dead_code)]
     pub fn dump(&self) {
-        self.data.dump();
+        self.contents().dump();
     }
 
     /// Dump this image to the given file.
     #[allow(dead_code)]
     pub fn write_file<P: AsRef<Path>>(&self, path: P) -> Result<()> {
         let mut fd = File::create(path)?;
-        fd.write_all(&self.data)?;
+        fd.write_all(&self.contents())?;
         Ok(())
     }
 
-    // Scan the sector map, and return the base and offset within a sector for this given byte.
-    // Returns None if the value is outside of the device.
+    /// Return a copy of the entire contents of the device.
+    pub fn contents(&self) -> Vec<u8> {
+        let mut result = Vec::with_capacity(self.size);
+        for block in &self.blocks {
+            result.extend_from_slice(&block.data);
+        }
+        result
+    }
+
+    /// Take a snapshot of this device.  The snapshot shares all sector data with the device, and
+    /// sectors are only copied once either of them modifies them.
+    pub fn snapshot(&self) -> SimFlash {
+        self.clone()
+    }
+
+    /// Count the sectors whose storage is still shared with `other`.  This is mostly useful to
+    /// check how much copying a snapshot has caused.
+    pub fn shared_sectors(&self, other: &SimFlash) -> usize {
+        self.blocks.iter().zip(other.blocks.iter())
+            .filter(|(a, b)| Arc::ptr_eq(a, b))
+            .count()
+    }
+
+    // Look up the sector containing the given byte, and return the sector number and the offset
+    // within that sector.  Returns None if the value is outside of the device.
     fn get_sector(&self, offset: usize) -> Option<(usize, usize)> {
-        let mut offset = offset;
-        for (sector, &size) in self.sectors.iter().enumerate() {
-            if offset < size {
-                return Some((sector, offset));
-            }
-            offset -= size;
+        if offset >= self.size {
+            return None;
         }
-        None
+        let sector = match self.bases.binary_search(&offset) {
+            Ok(sector) => sector,
+            Err(next) => next - 1,
+        };
+        Some((sector, offset - self.bases[sector]))
     }
 
+    // Call `f` for each piece of the range `offset .. offset + len`, split at sector boundaries.
+    // The arguments to `f` are the sector number, the offset within that sector, the offset within
+    // the range, and the length of the piece.  The range must be within the device.
+    fn for_each_chunk<F>(&self, offset: usize, len: usize, mut f: F)
+        where F: FnMut(usize, usize, usize, usize)
+    {
+        let mut pos = 0;
+        while pos < len {
+            let (sector, sub) = self.get_sector(offset + pos).unwrap();
+            let count = (self.sectors[sector] - sub).min(len - pos);
+            f(sector, sub, pos, count);
+            pos += count;
+        }
+    }
 }
 
 pub type SimMultiFlash = HashMap<u8, SimFlash>;
 
+/// A single modifying operation performed on a flash device.  A sequence of these, recorded while
+/// running the bootloader, can be replayed on top of a snapshot to reconstruct the state of the
+/// flash at any point during that run.
+#[derive(Clone, Debug)]
+pub enum FlashOp {
+    Erase { offset: usize, len: usize },
+    Write { offset: usize, data: Vec<u8> },
+    /// An operation that was attempted, but failed, and therefore has no effect.  It is kept so
+    /// that positions in a journal match the bootloader's count of flash operations.
+    Failed,
+}
+
+impl FlashOp {
+    /// Perform this operation on the given device.
+    pub fn apply(&self, flash: &mut dyn Flash) -> Result<()> {
+        match *self {
+            FlashOp::Erase { offset, len } => flash.erase(offset, len),
+            FlashOp::Write { offset, ref data } => flash.write(offset, data),
+            FlashOp::Failed => Ok(()),
+        }
+    }
+}
+
 impl Flash for SimFlash {
     /// The flash drivers tend to erase beyond the bounds of the given range.  Instead, we'll be
     /// strict, and make sure that the passed arguments are exactly at a sector boundary, otherwise
     /// return an error.
     fn erase(&mut self, offset: usize, len: usize) -> Result<()> {
-        let (_start, slen) = self.get_sector(offset).ok_or_else(|| ebounds("start"))?;
+        let (_, slen) = self.get_sector(offset).ok_or_else(|| ebounds("start"))?;
         let (end, elen) = self.get_sector(offset + len - 1).ok_or_else(|| ebounds("end"))?;
 
         if slen != 0 {
@@ -160,12 +277,16 @@ impl Flash for SimFlash {
             bail!(ebounds("end not at start of sector"));
         }
 
-        for x in &mut self.data[offset .. offset + len] {
-            *x = self.erased_val;
-        }
-
-        for x in &mut self.write_safe[offset .. offset + len] {
-            *x = true;
+        // Whole sectors are erased, so just point them at freshly erased data.  Erasing an
+        // already erased sector keeps it shared.
+        let (start, _) = self.get_sector(offset).unwrap();
+        let erased_val = self.erased_val;
+        for block in &mut self.blocks[start ..= end] {
+            let is_erased = block.write_safe.iter().all(|&x| x) &&
+                block.data.iter().all(|&x| x == erased_val);
+            if !is_erased {
+                *block = Arc::new(SectorData::new(block.data.len(), erased_val));
+            }
         }
 
         Ok(())
@@ -178,7 +299,8 @@ impl Flash for SimFlash {
     ///
     /// This emulates a flash device which starts out erased, with the
     /// added restriction that repeated writes to the same location
-    /// are disallowed, even if they would be safe to do.
+    /// are disallowed, even if they would be safe to do, unless
+    /// `set_rewrite_bits` allowed writes which only program more bits.
     fn write(&mut self, offset: usize, payload: &[u8]) -> Result<()> {
         for &(off, len, rate) in &self.bad_region {
             if offset >= off && (offset + payload.len()) <= (off + len) {
@@ -191,7 +313,7 @@ impl Flash for SimFlash {
             }
         }
 
-        if offset + payload.len() > self.data.len() {
+        if offset + payload.len() > self.size {
             panic!("Write outside of device");
         }
 
@@ -204,26 +326,40 @@ impl Flash for SimFlash {
             panic!("Write length not multiple of alignment");
         }
 
-        for (i, x) in &mut self.write_safe[offset .. offset + payload.len()].iter_mut().enumerate() {
-            if self.verify_writes && !(*x) {
-                panic!("Write to unerased location at 0x{:x}", offset + i);
+        let mut chunks = Vec::new();
+        self.for_each_chunk(offset, payload.len(), |sector, sub, pos, count| {
+            chunks.push((sector, sub, pos, count));
+        });
+
+        for (sector, sub, pos, count) in chunks {
+            // Copy the sector, if it is still shared with a snapshot.
+            let block = Arc::make_mut(&mut self.blocks[sector]);
+            for (i, x) in block.write_safe[sub .. sub + count].iter_mut().enumerate() {
+                if self.verify_writes && !(*x) {
+                    // Bits that are programmed, and would have to be erased by the write.
+                    let old = block.data[sub + i] ^ self.erased_val;
+                    let new = payload[pos + i] ^ self.erased_val;
+                    if !self.rewrite_bits || old & !new != 0 {
+                        panic!("Write to unerased location at 0x{:x}", offset + pos + i);
+                    }
+                }
+                *x = false;
             }
-            *x = false;
+            block.data[sub .. sub + count].copy_from_slice(&payload[pos .. pos + count]);
         }
-
-        let sub = &mut self.data[offset .. offset + payload.len()];
-        sub.copy_from_slice(payload);
         Ok(())
     }
 
     /// Read is simple.
     fn read(&self, offset: usize, data: &mut [u8]) -> Result<()> {
-        if offset + data.len() > self.data.len() {
+        if offset + data.len() > self.size {
             bail!(ebounds("Read outside of device"));
         }
+        self.bytes_read.set(self.bytes_read.get() + data.len());
 
-        let sub = &self.data[offset .. offset + data.len()];
-        data.copy_from_slice(sub);
+        self.for_each_chunk(offset, data.len(), |sector, sub, pos, count| {
+            data[pos .. pos + count].copy_from_slice(&self.blocks[sector].data[sub .. sub + count]);
+        });
         Ok(())
     }
 
@@ -248,6 +384,10 @@ impl Flash for SimFlash {
         self.verify_writes = enable;
     }
 
+    fn set_rewrite_bits(&mut self, enable: bool) {
+        self.rewrite_bits = enable;
+    }
+
     /// An iterator over each sector in the device.
     fn sector_iter(&self) -> SectorIter<'_> {
         SectorIter {
@@ -257,7 +397,7 @@ impl Flash for SimFlash {
     }
 
     fn device_size(&self) -> usize {
-        self.data.len()
+        self.size
     }
 
     fn align(&self) -> usize {
@@ -306,7 +446,7 @@ impl<'a> Iterator for SectorIter<'a> {
 
 #[cfg(test)]
 mod test {
-    use super::{Flash, FlashError, SimFlash, Result, Sector};
+    use super::{Flash, FlashError, FlashOp, SimFlash, Result, Sector};
 
     #[test]
     fn test_flash() {
@@ -360,6 +500,74 @@ mod test {
         }
     }
 
+    #[test]
+    fn test_snapshot() {
+        for &erased_val in &[0, 0xff] {
+            let mut f1 = SimFlash::new(vec![4096usize; 16], 8, erased_val);
+            f1.write(0, &[0x55; 16]).unwrap();
+
+            // The snapshot shares all of the sectors until one side writes.
+            let mut f2 = f1.snapshot();
+            assert_eq!(f2.shared_sectors(&f1), 16);
+
+            // Write across a sector boundary in the snapshot only.
+            f2.write(4096 - 8, &[0xAA; 16]).unwrap();
+            assert_eq!(f2.shared_sectors(&f1), 14);
+
+            let mut buf = [0u8; 16];
+            f1.read(4096 - 8, &mut buf).unwrap();
+            assert_eq!(buf, [erased_val; 16]);
+            f2.read(4096 - 8, &mut buf).unwrap();
+            assert_eq!(buf, [0xAA; 16]);
+
+            // Writing to the original must not be visible in the snapshot.
+            f1.write(16, &[0x11; 8]).unwrap();
+            f2.read(16, &mut buf[..8]).unwrap();
+            assert_eq!(buf[..8], [erased_val; 8]);
+
+            // Replaying the same operations gives the same contents.
+            let mut f3 = f1.snapshot();
+            let ops = [
+                FlashOp::Write { offset: 4096 - 8, data: vec![0xAA; 16] },
+                FlashOp::Failed,
+                FlashOp::Erase { offset: 0, len: 4096 },
+            ];
+            for op in &ops {
+                op.apply(&mut f3).unwrap();
+            }
+            f2.erase(0, 4096).unwrap();
+            assert_eq!(f2.contents(), f3.contents());
+        }
+    }
+
+    #[test]
+    fn test_rewrite_bits() {
+        for &erased_val in &[0, 0xff] {
+            let mut f = SimFlash::new(vec![4096usize; 4], 4, erased_val);
+            f.set_rewrite_bits(true);
+
+            // Program one bit, then another one in the same unit, keeping the first.
+            let bit = |b: u8| erased_val ^ b;
+            f.write(0, &[bit(0x01), erased_val, erased_val, erased_val]).unwrap();
+            f.write(0, &[bit(0x03), erased_val, erased_val, bit(0x80)]).unwrap();
+
+            let mut buf = [0u8; 4];
+            f.read(0, &mut buf).unwrap();
+            assert_eq!(buf, [bit(0x03), erased_val, erased_val, bit(0x80)]);
+        }
+    }
+
+    #[test]
+    #[should_panic(expected = "Write to unerased location")]
+    fn test_rewrite_bits_erase() {
+        let mut f = SimFlash::new(vec![4096usize; 4], 1, 0xff);
+        f.set_rewrite_bits(true);
+
+        // Going back to the erased value of a bit needs an erase.
+        f.write(0, &[0xf0]).unwrap();
+        f.write(0, &[0xf1]).unwrap();
+    }
+
     // Helper checks for the result type.
     trait EChecker {
         fn is_bounds(&self) -> bool;
@@ -0,0 +1,179 @@
+// Copyright (c) 2026 Linaro LTD
+//
+// SPDX-License-Identifier: Apache-2.0
+
+//! Tests for the log-structured boot request store.
+//!
+//! The log is exercised directly on a small flash device, and the values read back are compared
+//! against a simple model.  The same sequence is then interrupted after every flash operation, to
+//! check that the log always reopens in a state that some prefix of the updates would produce.
+
+use log::{info, error};
+use mcuboot_sys::{api, c, AreaDesc, FlashId};
+use simflash::{FlashOp, SimFlash, SimMultiFlash};
+
+/// Number of entries kept in the log.
+const NUM_VALUES: usize = 8;
+
+/// Entry number that clears every entry but the first, see `c::boot_request_log`.
+const CLEAR: u8 = 0xff;
+
+/// Sector size of the test device.  The log uses two of them.
+const SECTOR_SIZE: usize = 512;
+
+/// A deterministic sequence of updates, long enough to fill each page several times.
+fn make_ops(count: usize) -> Vec<(u8, u8)> {
+    let mut state: u32 = 0x1234_5678;
+    (0 .. count).map(|i| {
+        state = state.wrapping_mul(1_103_515_245).wrapping_add(12_345);
+        if i % 53 == 52 {
+            (CLEAR, 0)
+        } else {
+            (((state >> 16) as usize % NUM_VALUES) as u8, (state >> 24) as u8)
+        }
+    }).collect()
+}
+
+/// The entry values after applying `ops`.
+fn model(ops: &[(u8, u8)], erased_val: u8) -> Vec<u8> {
+    let mut values = vec![erased_val; NUM_VALUES];
+    for &(entry, value) in ops {
+        if entry == CLEAR {
+            for v in &mut values[1..] {
+                *v = erased_val;
+            }
+        } else {
+            values[entry as usize] = value;
+        }
+    }
+    values
+}
+
+fn new_flash(align: usize, erased_val: u8) -> (SimMultiFlash, AreaDesc) {
+    let flash = SimFlash::new(vec![SECTOR_SIZE; 2], align, erased_val);
+    let mut areadesc = AreaDesc::new();
+    areadesc.add_flash_sectors(0, &flash);
+    areadesc.add_image(0, 2 * SECTOR_SIZE, FlashId::BootLoader, 0);
+    let mut multiflash = SimMultiFlash::new();
+    multiflash.insert(0, flash);
+    (multiflash, areadesc)
+}
+
+/// Read the values back from a freshly opened log.
+fn reopen(flash: &mut SimMultiFlash, areadesc: &AreaDesc) -> Option<Vec<u8>> {
+    match c::boot_request_log(flash, areadesc, FlashId::BootLoader as u8, &[], None, NUM_VALUES) {
+        Some((0, values)) => Some(values),
+        other => {
+            error!("Unable to reopen log: {:?}", other);
+            None
+        }
+    }
+}
+
+/// Run the boot request log tests, returning true on failure.
+pub fn run_boot_request_log() -> bool {
+    let mut fails = 0;
+
+    for &erased_val in &[0xffu8, 0x00] {
+        for &align in &[1usize, 8, 16] {
+            if !check_sequence(align, erased_val) || !check_interrupted(align, erased_val) {
+                error!("Boot request log failed: align {}, erased 0x{:02x}", align, erased_val);
+                fails += 1;
+            }
+        }
+    }
+
+    fails > 0
+}
+
+/// Apply a long sequence of updates, and check that the values survive being reopened, and that
+/// the log erases far less often than it is updated.
+fn check_sequence(align: usize, erased_val: u8) -> bool {
+    let (mut flash, areadesc) = new_flash(align, erased_val);
+    let ops = make_ops(1000);
+
+    api::start_journal();
+    let result = c::boot_request_log(&mut flash, &areadesc, FlashId::BootLoader as u8, &ops,
+                                     None, NUM_VALUES);
+    let journal = api::take_journal();
+
+    let expected = model(&ops, erased_val);
+    match result {
+        Some((0, ref values)) if *values == expected => (),
+        other => {
+            error!("Unexpected values after updates: {:?}, expecting {:?}", other, expected);
+            return false;
+        }
+    }
+
+    if reopen(&mut flash, &areadesc).as_ref() != Some(&expected) {
+        error!("Values not preserved across reopen");
+        return false;
+    }
+
+    let erases = journal.iter().filter(|(_, op)| matches!(op, FlashOp::Erase { .. })).count();
+    let writes = journal.iter().filter(|(_, op)| matches!(op, FlashOp::Write { .. })).count();
+    info!("Boot request log, align {}: {} updates, {} writes, {} erases",
+          align, ops.len(), writes, erases);
+
+    // Every update that changes a value needs at least one write, but a page is only erased once
+    // it has filled up.
+    let capacity = SECTOR_SIZE / align.max(8) - 1;
+    if erases == 0 || erases > writes / (capacity - NUM_VALUES) + 2 {
+        error!("Unexpected number of erases: {}", erases);
+        return false;
+    }
+
+    true
+}
+
+/// Interrupt the update sequence after each flash operation.  The log must reopen with the values
+/// of some prefix of the updates, and must still accept further updates.
+fn check_interrupted(align: usize, erased_val: u8) -> bool {
+    let (flash, areadesc) = new_flash(align, erased_val);
+    let ops = make_ops(150);
+
+    let mut total = flash.clone();
+    api::start_journal();
+    let result = c::boot_request_log(&mut total, &areadesc, FlashId::BootLoader as u8, &ops,
+                                     None, NUM_VALUES);
+    let count = api::take_journal().len();
+    if result.map(|(rc, _)| rc) != Some(0) {
+        error!("Uninterrupted run failed");
+        return false;
+    }
+
+    let prefixes: Vec<Vec<u8>> = (0 ..= ops.len()).map(|n| model(&ops[..n], erased_val)).collect();
+
+    for stop in 1 ..= count as i32 {
+        let mut run = flash.clone();
+        let mut counter = stop;
+        if c::boot_request_log(&mut run, &areadesc, FlashId::BootLoader as u8, &ops,
+                               Some(&mut counter), NUM_VALUES).is_some() {
+            error!("Run not interrupted at {}", stop);
+            return false;
+        }
+
+        let values = match reopen(&mut run, &areadesc) {
+            Some(values) => values,
+            None => return false,
+        };
+        if !prefixes.contains(&values) {
+            error!("Interrupted at {}: values {:?} don't match any prefix", stop, values);
+            return false;
+        }
+
+        let mut expected = values;
+        expected[1] = expected[1].wrapping_add(1);
+        let update = [(1, expected[1])];
+        if c::boot_request_log(&mut run, &areadesc, FlashId::BootLoader as u8, &update,
+                               None, NUM_VALUES).map(|(rc, _)| rc) != Some(0) ||
+            reopen(&mut run, &areadesc).as_ref() != Some(&expected)
+        {
+            error!("Interrupted at {}: update after reopen failed", stop);
+            return false;
+        }
+    }
+
+    true
+}
@@ -31,6 +31,9 @@ pub enum Caps {
     HwRollbackProtection = (1 << 18),
     EcdsaP384            = (1 << 19),
     SwapUsingOffset      = (1 << 20),
+    SwapStatusPacked     = (1 << 21),
+    SwapOffsetNoBackup   = (1 << 22),
+    SkipPreErased        = (1 << 23),
 }
 
 impl Caps {
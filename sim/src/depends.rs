@@ -185,3 +185,297 @@ impl ImageVersion {
         }
     }
 }
+
+#[cfg(feature = "multiimage")]
+pub use self::resolver::run_dependency_resolver;
+
+/// Tests of the dependency resolver of the bootloader on graphs of more images than the simulated
+/// devices have.
+#[cfg(feature = "multiimage")]
+mod resolver {
+    use log::error;
+    use mcuboot_sys::c::{self, Dep, DepVersion};
+    use rand::Rng;
+
+    /// Swap types, as in bootutil_public.h.
+    mod swap {
+        pub const NONE: u8 = 1;
+        pub const TEST: u8 = 2;
+        pub const PERM: u8 = 3;
+        pub const REVERT: u8 = 4;
+    }
+
+    /// A graph given to the resolver of the bootloader, with the expected outcome.
+    struct Resolution {
+        name: &'static str,
+        versions: Vec<[DepVersion; 2]>,
+        known: Vec<u8>,
+        deps: Vec<Dep>,
+        swap_type: Vec<u8>,
+        /// The expected swap types, or None if the graph must be rejected.
+        expected: Option<Vec<u8>>,
+        /// The expected update order, if it matters.
+        order: Option<Vec<u8>>,
+    }
+
+    fn ver(major: u8, minor: u8) -> DepVersion {
+        DepVersion { major, minor, revision: 0, build_num: 0 }
+    }
+
+    fn dep(image: u8, slot: u8, on: u8, min_version: DepVersion) -> Dep {
+        Dep { image, slot, on, min_version }
+    }
+
+    /// A chain of `n` images, where the new version of each one needs the new version of the next.
+    fn chain(name: &'static str, n: u8, last_swap: u8, expected: u8) -> Resolution {
+        let mut deps = vec![];
+        for image in 0 .. n - 1 {
+            deps.push(dep(image, 0, image + 1, ver(1, 0)));
+            deps.push(dep(image, 1, image + 1, ver(2, 0)));
+        }
+        let mut swap_type = vec![swap::TEST; n as usize];
+        swap_type[n as usize - 1] = last_swap;
+
+        Resolution {
+            name,
+            versions: vec![[ver(1, 0), ver(2, 0)]; n as usize],
+            known: vec![3; n as usize],
+            deps,
+            swap_type,
+            expected: Some(vec![expected; n as usize]),
+            order: Some((0 .. n).rev().collect()),
+        }
+    }
+
+    fn resolutions() -> Vec<Resolution> {
+        vec![
+            chain("chain upgraded", 8, swap::TEST, swap::TEST),
+            // The last image isn't upgraded, which cancels all the other upgrades one after
+            // another.
+            chain("chain cancelled", 8, swap::NONE, swap::NONE),
+            Resolution {
+                name: "cycle",
+                versions: vec![[ver(1, 0), ver(2, 0)]; 3],
+                known: vec![3; 3],
+                deps: vec![
+                    dep(0, 1, 1, ver(2, 0)),
+                    dep(1, 1, 2, ver(2, 0)),
+                    dep(2, 1, 0, ver(2, 0)),
+                ],
+                swap_type: vec![swap::TEST, swap::PERM, swap::TEST],
+                expected: Some(vec![swap::TEST, swap::PERM, swap::TEST]),
+                order: Some(vec![0, 2, 1]),
+            },
+            Resolution {
+                name: "cycle cancelled",
+                versions: vec![[ver(1, 0), ver(2, 0)]; 3],
+                known: vec![3; 3],
+                deps: vec![
+                    dep(0, 1, 1, ver(2, 0)),
+                    dep(1, 1, 2, ver(2, 0)),
+                    dep(2, 1, 0, ver(2, 0)),
+                    dep(2, 1, 0, ver(2, 1)),
+                ],
+                swap_type: vec![swap::TEST, swap::TEST, swap::TEST],
+                expected: Some(vec![swap::NONE, swap::NONE, swap::NONE]),
+                order: None,
+            },
+            // Image 1 goes back to 1.0, which the running image 0 can't work with, but the image
+            // in its secondary slot can.
+            Resolution {
+                name: "revert",
+                versions: vec![[ver(2, 0), ver(1, 0)], [ver(2, 0), ver(1, 0)]],
+                known: vec![3, 3],
+                deps: vec![
+                    dep(0, 0, 1, ver(2, 0)),
+                    dep(0, 1, 1, ver(1, 0)),
+                ],
+                swap_type: vec![swap::NONE, swap::REVERT],
+                expected: Some(vec![swap::REVERT, swap::REVERT]),
+                order: Some(vec![1, 0]),
+            },
+            // Same, but the secondary slot of image 0 couldn't be read.
+            Resolution {
+                name: "revert unknown",
+                versions: vec![[ver(2, 0), ver(1, 0)], [ver(2, 0), ver(1, 0)]],
+                known: vec![1, 3],
+                deps: vec![dep(0, 0, 1, ver(2, 0))],
+                swap_type: vec![swap::NONE, swap::REVERT],
+                expected: Some(vec![swap::NONE, swap::REVERT]),
+                order: Some(vec![1, 0]),
+            },
+            // The highest of several dependencies on the same image applies, whatever their order.
+            Resolution {
+                name: "highest dependency",
+                versions: vec![[ver(1, 0), ver(2, 0)]; 2],
+                known: vec![3; 2],
+                deps: vec![
+                    dep(0, 1, 1, ver(1, 5)),
+                    dep(0, 1, 1, ver(3, 0)),
+                    dep(0, 1, 1, ver(2, 0)),
+                ],
+                swap_type: vec![swap::TEST, swap::TEST],
+                expected: Some(vec![swap::NONE, swap::TEST]),
+                order: None,
+            },
+            // Only the images depending on a cancelled upgrade are affected.
+            Resolution {
+                name: "diamond",
+                versions: vec![[ver(1, 0), ver(2, 0)]; 5],
+                known: vec![3; 5],
+                deps: vec![
+                    dep(0, 1, 1, ver(2, 0)),
+                    dep(0, 1, 2, ver(2, 0)),
+                    dep(1, 1, 3, ver(2, 0)),
+                    dep(2, 1, 3, ver(1, 0)),
+                ],
+                swap_type: vec![swap::TEST, swap::TEST, swap::TEST, swap::NONE, swap::PERM],
+                expected: Some(vec![swap::NONE, swap::NONE, swap::TEST, swap::NONE, swap::PERM]),
+                order: None,
+            },
+            Resolution {
+                name: "unknown image",
+                versions: vec![[ver(1, 0), ver(2, 0)]; 2],
+                known: vec![3; 2],
+                deps: vec![dep(0, 1, 5, ver(1, 0))],
+                swap_type: vec![swap::TEST, swap::TEST],
+                expected: None,
+                order: None,
+            },
+        ]
+    }
+
+    fn is_upgrade(swap_type: u8) -> bool {
+        swap_type == swap::TEST || swap_type == swap::PERM || swap_type == swap::REVERT
+    }
+
+    fn at_least(version: &DepVersion, min: &DepVersion) -> bool {
+        (version.major, version.minor, version.revision) >= (min.major, min.minor, min.revision)
+    }
+
+    /// Check the outcome of a random graph, whose dependencies only go from an image to a higher
+    /// one.
+    fn check_random(versions: &[[DepVersion; 2]], known: &[u8], deps: &[Dep], before: &[u8],
+                    after: &[u8], order: &[u8]) -> bool {
+        let n = versions.len();
+        let slot = |image: usize| if is_upgrade(after[image]) { 1 } else { 0 };
+        let satisfied = |image: usize, swaps: &[u8]| {
+            let s = if is_upgrade(swaps[image]) { 1 } else { 0 };
+            deps.iter().filter(|d| d.image as usize == image && d.slot == s).all(|d| {
+                let on = d.on as usize;
+                at_least(&versions[on][if is_upgrade(swaps[on]) { 1 } else { 0 }], &d.min_version)
+            })
+        };
+
+        let mut sorted = order.to_vec();
+        sorted.sort();
+        if sorted != (0 .. n as u8).collect::<Vec<_>>() {
+            error!("Update order {:?} is not a permutation", order);
+            return false;
+        }
+
+        if (0 .. n).all(|image| satisfied(image, before)) && before != after {
+            error!("Swap types changed from {:?} to {:?} with all dependencies satisfied",
+                   before, after);
+            return false;
+        }
+
+        for image in 0 .. n {
+            let allowed = match (before[image], after[image]) {
+                (b, a) if b == a => true,
+                (swap::TEST, swap::NONE) | (swap::PERM, swap::NONE) => true,
+                (swap::NONE, swap::REVERT) => known[image] & 2 != 0,
+                _ => false,
+            };
+            if !allowed {
+                error!("Image {}: swap type changed from {} to {}", image, before[image],
+                       after[image]);
+                return false;
+            }
+
+            if (after[image] == swap::TEST || after[image] == swap::PERM) &&
+                !satisfied(image, after) {
+                error!("Image {}: upgraded with unsatisfied dependencies", image);
+                return false;
+            }
+
+            let pos = order.iter().position(|&i| i as usize == image).unwrap();
+            for d in deps.iter().filter(|d| d.image as usize == image && d.slot == slot(image)) {
+                if order.iter().position(|&i| i == d.on).unwrap() > pos {
+                    error!("Image {} updated before image {} it depends on", image, d.on);
+                    return false;
+                }
+            }
+        }
+
+        true
+    }
+
+    /// Run the dependency resolver on fixed and random graphs of up to 8 images, returning true on
+    /// failure.
+    pub fn run_dependency_resolver() -> bool {
+        let mut fails = 0;
+
+        for r in resolutions() {
+            let mut swap_type = r.swap_type.clone();
+            let result = c::deps_solve(&r.versions, &r.known, &r.deps, &mut swap_type);
+            let ok = match (&result, &r.expected) {
+                (Ok(order), Some(expected)) => {
+                    swap_type == *expected && r.order.as_ref().map_or(true, |o| o == order)
+                }
+                (Err(_), None) => true,
+                _ => false,
+            };
+            if !ok {
+                error!("{}: got {:?} {:?}, expected {:?} {:?}", r.name, swap_type, result,
+                       r.expected, r.order);
+                fails += 1;
+            }
+        }
+
+        let mut rng = rand::thread_rng();
+        for _ in 0 .. 1000 {
+            let n = rng.gen_range(2 ..= 8);
+            let versions: Vec<[DepVersion; 2]> = (0 .. n).map(|_| {
+                [ver(rng.gen_range(1 ..= 3), 0), ver(rng.gen_range(1 ..= 3), 0)]
+            }).collect();
+            let known: Vec<u8> = (0 .. n).map(|_| if rng.gen_bool(0.8) { 3 } else { 1 }).collect();
+            let mut deps = vec![];
+            for image in 0 .. n - 1 {
+                for slot in 0 .. 2 {
+                    if slot == 1 && known[image as usize] & 2 == 0 {
+                        continue;
+                    }
+                    for on in image + 1 .. n {
+                        if rng.gen_bool(0.3) {
+                            deps.push(dep(image, slot, on, ver(rng.gen_range(1 ..= 3), 0)));
+                        }
+                    }
+                }
+            }
+            let types = [swap::NONE, swap::TEST, swap::PERM];
+            let before: Vec<u8> = (0 .. n).map(|_| {
+                types[rng.gen_range(0 .. types.len())]
+            }).collect();
+
+            let mut after = before.clone();
+            match c::deps_solve(&versions, &known, &deps, &mut after) {
+                Ok(order) => {
+                    if !check_random(&versions, &known, &deps, &before, &after, &order) {
+                        error!("Graph {:?} {:?} {:?}", versions, known, deps);
+                        fails += 1;
+                    }
+                }
+                Err(rc) => {
+                    error!("Graph rejected: {}", rc);
+                    fails += 1;
+                }
+            }
+        }
+
+        if fails > 0 {
+            error!("{} dependency resolver failures", fails);
+        }
+        fails > 0
+    }
+}
@@ -0,0 +1,79 @@
+// Copyright (c) 2026 Linaro LTD
+//
+// SPDX-License-Identifier: Apache-2.0
+
+//! Tests for ECDSA P-256 verification with comb tables.
+//!
+//! Signatures made with the sim key are verified both with the generic verification and with the
+//! comb table of the key.  Both must agree on valid and tampered signatures.  Their timings are
+//! only logged, as they depend too much on the load of the machine to be checked.
+
+use log::{info, error};
+use mcuboot_sys::c;
+use ring::{
+    digest,
+    rand,
+    signature::{EcdsaKeyPair, ECDSA_P256_SHA256_ASN1_SIGNING},
+};
+
+/// Verifications timed for each path and signature.
+const ITERATIONS: u32 = 20;
+
+/// Number of signatures to check.
+const SIGNATURES: usize = 8;
+
+/// Run the comb verification tests, returning true on failure.
+pub fn run_ecdsa_comb() -> bool {
+    let key_bytes = pem::parse(include_bytes!("../../root-ec-p256-pkcs8.pem").as_ref()).unwrap();
+    let key_pair = EcdsaKeyPair::from_pkcs8(&ECDSA_P256_SHA256_ASN1_SIGNING,
+                                            &key_bytes.contents).unwrap();
+    let rng = rand::SystemRandom::new();
+
+    let mut generic_ticks = 0u64;
+    let mut comb_ticks = 0u64;
+    let mut fails = 0;
+
+    for i in 0 .. SIGNATURES {
+        let payload = format!("comb table payload {}", i);
+        let mut hash = [0u8; 32];
+        hash.copy_from_slice(digest::digest(&digest::SHA256, payload.as_bytes()).as_ref());
+        let sig = key_pair.sign(&rng, payload.as_bytes()).unwrap();
+
+        let (rc, ticks) = c::ecdsa_verify_bench(false, &hash, sig.as_ref(), ITERATIONS);
+        generic_ticks += ticks;
+        if rc != 0 {
+            error!("Generic verification rejected signature {}", i);
+            fails += 1;
+        }
+
+        let (rc, ticks) = c::ecdsa_verify_bench(true, &hash, sig.as_ref(), ITERATIONS);
+        comb_ticks += ticks;
+        if rc != 0 {
+            error!("Comb verification rejected signature {}", i);
+            fails += 1;
+        }
+
+        // Flip a bit of the hash, and one of the last byte of the signature, which is part of s.
+        let mut bad_hash = hash;
+        bad_hash[i] ^= 0x01;
+        let mut bad_sig = sig.as_ref().to_vec();
+        *bad_sig.last_mut().unwrap() ^= 0x01;
+
+        let tampered = [("hash", &bad_hash, sig.as_ref()), ("signature", &hash, &bad_sig[..])];
+        for (what, hash, sig) in tampered {
+            if c::ecdsa_verify_bench(false, hash, sig, 1).0 == 0 ||
+                c::ecdsa_verify_bench(true, hash, sig, 1).0 == 0
+            {
+                error!("Tampered {} {} accepted", what, i);
+                fails += 1;
+            }
+        }
+    }
+
+    let count = (SIGNATURES as u64) * (ITERATIONS as u64);
+    info!("ECDSA P-256 verification: generic {} ticks, comb {} ticks per signature ({:.2}x)",
+          generic_ticks / count, comb_ticks / count,
+          generic_ticks as f64 / comb_ticks.max(1) as f64);
+
+    fails > 0
+}
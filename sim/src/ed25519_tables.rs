@@ -0,0 +1,80 @@
+// Copyright (c) 2026 Linaro LTD
+//
+// SPDX-License-Identifier: Apache-2.0
+
+//! Tests for Ed25519 verification with precomputed key tables.
+//!
+//! Signatures made with the sim key are verified both with the generic verification and with the
+//! key table.  Both must agree on valid and tampered signatures, and the table verification must
+//! be faster.
+
+use log::{info, error};
+use mcuboot_sys::c;
+use ring::signature::Ed25519KeyPair;
+
+/// Verifications timed for each path and signature.
+const ITERATIONS: u32 = 20;
+
+/// Number of signatures to check.
+const SIGNATURES: usize = 8;
+
+/// Run the key table verification tests, returning true on failure.
+pub fn run_ed25519_tables() -> bool {
+    let key_bytes = pem::parse(include_bytes!("../../root-ed25519.pem").as_ref()).unwrap();
+    let key_pair = Ed25519KeyPair::from_seed_unchecked(&key_bytes.contents[16..48]).unwrap();
+
+    let mut generic_ticks = 0u64;
+    let mut table_ticks = 0u64;
+    let mut fails = 0;
+
+    for i in 0 .. SIGNATURES {
+        let msg = format!("key table payload {}", i).into_bytes();
+        let mut sig = [0u8; 64];
+        sig.copy_from_slice(key_pair.sign(&msg).as_ref());
+
+        let (rc, ticks) = c::ed25519_verify_bench(false, &msg, &sig, ITERATIONS);
+        generic_ticks += ticks;
+        if rc != 0 {
+            error!("Generic verification rejected signature {}", i);
+            fails += 1;
+        }
+
+        let (rc, ticks) = c::ed25519_verify_bench(true, &msg, &sig, ITERATIONS);
+        table_ticks += ticks;
+        if rc != 0 {
+            error!("Table verification rejected signature {}", i);
+            fails += 1;
+        }
+
+        // Flip one bit of the message, of R, and of S.
+        let mut bad_msg = msg.clone();
+        bad_msg[i] ^= 0x01;
+        let mut bad_r = sig;
+        bad_r[i] ^= 0x01;
+        let mut bad_s = sig;
+        bad_s[32 + i] ^= 0x01;
+
+        let tampered = [("message", &bad_msg[..], &sig), ("R", &msg[..], &bad_r),
+                        ("S", &msg[..], &bad_s)];
+        for (what, msg, sig) in tampered {
+            if c::ed25519_verify_bench(false, msg, sig, 1).0 == 0 ||
+                c::ed25519_verify_bench(true, msg, sig, 1).0 == 0
+            {
+                error!("Tampered {} {} accepted", what, i);
+                fails += 1;
+            }
+        }
+    }
+
+    let count = (SIGNATURES as u64) * (ITERATIONS as u64);
+    info!("Ed25519 verification: generic {} ticks, table {} ticks per signature ({:.2}x)",
+          generic_ticks / count, table_ticks / count,
+          generic_ticks as f64 / table_ticks.max(1) as f64);
+
+    if table_ticks >= generic_ticks {
+        error!("Table verification is not faster than the generic verification");
+        fails += 1;
+    }
+
+    fails > 0
+}
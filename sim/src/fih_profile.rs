@@ -0,0 +1,154 @@
+// Copyright (c) 2026 Linaro LTD
+//
+// SPDX-License-Identifier: Apache-2.0
+
+//! Cost of the fault injection hardening profile.
+//!
+//! The same upgrade scenarios are run on each device, with the FIH profile of the build, and the
+//! number of FIH_CALL and fih_delay invocations made by each call site is logged, along with the
+//! number of delay loop iterations and the time taken by each scenario.  Comparing the logs of
+//! builds with different `fih-profile-*` features gives the cost of each profile.
+//!
+//! When `MCUBOOT_FIH_REPORT` names a file, the results are also appended to it as CSV, so that
+//! the results of several builds can be gathered.  The columns are the profile, the scenario, the
+//! call site, the function called, the FIH_CALL, fih_delay and delay loop counts, and the time in
+//! microseconds.  The first line of each scenario has its totals, with no call site, and the time
+//! is only given there.
+
+use log::{info, error};
+use mcuboot_sys::c;
+use std::{
+    collections::BTreeMap,
+    env,
+    fs::OpenOptions,
+    io::Write,
+    time::{Duration, Instant},
+};
+
+use crate::{
+    ALL_DEVICES,
+    depends::NO_DEPS,
+    image::{Images, ImagesBuilder, ImageManipulation},
+};
+
+/// Seed of the delays, so that the runs are repeatable.
+const SEED: u32 = 0x46494821;
+
+/// Write alignment of the devices the scenarios run on.
+const ALIGN: usize = 8;
+
+#[cfg(feature = "fih-profile-off")]
+const PROFILE: &str = "off";
+#[cfg(feature = "fih-profile-low")]
+const PROFILE: &str = "low";
+#[cfg(feature = "fih-profile-medium")]
+const PROFILE: &str = "medium";
+#[cfg(feature = "fih-profile-high")]
+const PROFILE: &str = "high";
+
+/// A scenario: the images to start from, and the test to run on them, which returns true on
+/// failure.
+struct Scenario {
+    name: &'static str,
+    make: fn(ImagesBuilder) -> Images,
+    run: fn(&Images) -> bool,
+}
+
+static SCENARIOS: &[Scenario] = &[
+    Scenario {
+        name: "no-upgrade",
+        make: |b| b.make_no_upgrade_image(&NO_DEPS, ImageManipulation::None),
+        run: Images::run_norevert_newimage,
+    },
+    Scenario {
+        name: "upgrade",
+        make: |b| b.make_image(&NO_DEPS, true),
+        run: Images::run_norevert,
+    },
+    Scenario {
+        name: "revert",
+        make: |b| b.make_image(&NO_DEPS, true),
+        run: Images::run_basic_revert,
+    },
+    Scenario {
+        name: "power-fail",
+        make: |b| b.make_image(&NO_DEPS, true),
+        run: Images::run_perm_with_fails,
+    },
+];
+
+/// Counters of a call site, summed over the devices.
+#[derive(Default)]
+struct Site {
+    func: Option<String>,
+    calls: u64,
+    delays: u64,
+    delay_loops: u64,
+}
+
+/// Run the scenarios, returning true on failure.
+pub fn run_fih_profile() -> bool {
+    let mut fails = 0;
+    let mut report = Vec::new();
+
+    for scenario in SCENARIOS {
+        let mut sites: BTreeMap<(String, u32), Site> = BTreeMap::new();
+        let mut elapsed = Duration::ZERO;
+        let mut devices = 0;
+
+        for &dev in ALL_DEVICES {
+            let builder = match ImagesBuilder::new(dev, ALIGN, 0xff) {
+                Ok(builder) => builder,
+                Err(_) => continue,
+            };
+            let images = (scenario.make)(builder);
+
+            c::fih_profile_reset(SEED);
+            let start = Instant::now();
+            if (scenario.run)(&images) {
+                error!("FIH profile {}: scenario {} failed on {}", PROFILE, scenario.name, dev);
+                fails += 1;
+            }
+            elapsed += start.elapsed();
+            devices += 1;
+
+            for s in c::fih_profile_sites() {
+                let site = sites.entry((s.file(), s.line)).or_default();
+                if site.func.is_none() {
+                    site.func = s.func();
+                }
+                site.calls += s.calls as u64;
+                site.delays += s.delays as u64;
+                site.delay_loops += s.delay_loops as u64;
+            }
+        }
+
+        let calls: u64 = sites.values().map(|s| s.calls).sum();
+        let delays: u64 = sites.values().map(|s| s.delays).sum();
+        let delay_loops: u64 = sites.values().map(|s| s.delay_loops).sum();
+        info!("FIH profile {}: {} on {} devices: {:?}, {} FIH_CALL, {} fih_delay, \
+               {} delay loops",
+              PROFILE, scenario.name, devices, elapsed, calls, delays, delay_loops);
+        report.push(format!("{},{},,,{},{},{},{}", PROFILE, scenario.name, calls, delays,
+                            delay_loops, elapsed.as_micros()));
+
+        for ((file, line), site) in &sites {
+            let func = site.func.as_deref().unwrap_or("");
+            info!("    {}:{} {}: {} FIH_CALL, {} fih_delay, {} delay loops",
+                  file, line, func, site.calls, site.delays, site.delay_loops);
+            report.push(format!("{},{},{}:{},{},{},{},{},", PROFILE, scenario.name, file, line,
+                                func, site.calls, site.delays, site.delay_loops));
+        }
+    }
+
+    if let Ok(path) = env::var("MCUBOOT_FIH_REPORT") {
+        let written = OpenOptions::new().create(true).append(true).open(&path)
+            .and_then(|mut f| report.iter().try_for_each(|line| writeln!(f, "{}", line)));
+        if let Err(e) = written {
+            error!("Unable to write FIH report to {}: {}", path, e);
+            fails += 1;
+        }
+    }
+
+    fails > 0
+}
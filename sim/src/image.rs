@@ -34,13 +34,14 @@ use cipher::{
     StreamCipher,
     };
 
-use simflash::{Flash, SimFlash, SimMultiFlash};
-use mcuboot_sys::{c, AreaDesc, FlashId, RamBlock};
+use simflash::{Flash, FlashOp, SimFlash, SimMultiFlash};
+use mcuboot_sys::{api, c, AreaDesc, FlashId, RamBlock, api::FlashJournal};
 use crate::{
     ALL_DEVICES,
     DeviceName,
 };
 use crate::caps::Caps;
+use crate::pool;
 use crate::depends::{
     BoringDep,
     Depender,
@@ -54,6 +55,13 @@ use crate::tlv::{ManifestGen, TlvGen, TlvFlags};
 use crate::utils::align_up;
 use typenum::{U32, U16};
 
+/// How often, in flash operations, `FlashCheckpoints` keeps a snapshot of the flash.
+const CHECKPOINT_INTERVAL: usize = 64;
+
+/// How many bytes, per image, a direct-xip boot may read beyond the contents of the selected image.
+/// This covers the headers, trailers and TLV area, but not the validation of a second slot.
+const DIRECT_XIP_READ_ALLOWANCE: usize = 4096;
+
 /// For testing, use a non-zero offset for the ram-load, to make sure the offset is getting used
 /// properly, but the value is not really that important.
 const RAM_LOAD_ADDR: u32 = 1024;
@@ -120,6 +128,60 @@ struct SlotPlace {
     size: u32,
 }
 
+/// The states the flash goes through during one uninterrupted run of the bootloader.  Rather than
+/// running the bootloader from the beginning to reach the state left by an interruption at flash
+/// operation N, the recorded operations are replayed on top of the nearest snapshot before N.
+/// Snapshots share unmodified sectors, so keeping them is cheap.
+struct FlashCheckpoints {
+    journal: FlashJournal,
+    // Entry `n` is the flash with the first `n * CHECKPOINT_INTERVAL` operations performed.
+    checkpoints: Vec<SimMultiFlash>,
+}
+
+impl FlashCheckpoints {
+    /// Run the bootloader to completion on a copy of `flash`, and record the states it goes
+    /// through.
+    fn record(flash: &SimMultiFlash, areadesc: &AreaDesc) -> FlashCheckpoints {
+        let mut run = flash.clone();
+        let (result, journal) = c::boot_go_journaled(&mut run, areadesc, None);
+        if !result.success() {
+            panic!("Unable to record upgrade: {:?}", result);
+        }
+
+        let mut checkpoints = Vec::new();
+        let mut cursor = flash.clone();
+        for (i, (dev_id, op)) in journal.iter().enumerate() {
+            if i % CHECKPOINT_INTERVAL == 0 {
+                checkpoints.push(cursor.clone());
+            }
+            op.apply(cursor.get_mut(dev_id).unwrap()).unwrap();
+        }
+        if journal.len() % CHECKPOINT_INTERVAL == 0 {
+            checkpoints.push(cursor);
+        }
+
+        FlashCheckpoints { journal, checkpoints }
+    }
+
+    /// The number of flash operations performed by the recorded run.
+    fn len(&self) -> usize {
+        self.journal.len()
+    }
+
+    /// Return the flash as the bootloader would leave it when interrupted at flash operation
+    /// `stop` (counting from 1), that is, with the first `stop - 1` operations performed.
+    fn interrupted_at(&self, stop: i32) -> SimMultiFlash {
+        assert!(stop > 0 && stop as usize <= self.len());
+        let done = stop as usize - 1;
+        let base = done / CHECKPOINT_INTERVAL;
+        let mut flash = self.checkpoints[base].clone();
+        for (dev_id, op) in &self.journal[base * CHECKPOINT_INTERVAL .. done] {
+            op.apply(flash.get_mut(dev_id).unwrap()).unwrap();
+        }
+        flash
+    }
+}
+
 #[derive(Copy, Clone, Debug, Eq, PartialEq)]
 pub enum ImageManipulation {
     None,
@@ -138,7 +200,7 @@ impl ImagesBuilder {
     /// Some(builder) if is possible to test this configuration, or None if
     /// not possible (for example, if there aren't enough image slots).
     pub fn new(device: DeviceName, align: usize, erased_val: u8) -> Result<Self, String> {
-        let (flash, areadesc, unsupported_caps) = Self::make_device(device, align, erased_val);
+        let (mut flash, areadesc, unsupported_caps) = Self::make_device(device, align, erased_val);
 
         for cap in unsupported_caps {
             if cap.present() {
@@ -146,6 +208,13 @@ impl ImagesBuilder {
             }
         }
 
+        if Caps::SwapStatusPacked.present() {
+            // The bits of the swap status are programmed one after another in the same write unit.
+            for dev in flash.values_mut() {
+                dev.set_rewrite_bits(true);
+            }
+        }
+
         let num_images = Caps::get_num_images();
 
         let mut slots = Vec::with_capacity(num_images);
@@ -204,19 +273,26 @@ impl ImagesBuilder {
         })
     }
 
+    /// The combinations of device, alignment and erased value are independent, and are run on
+    /// the worker pool (see `pool`).  Each one is built and run on a single worker thread.
     pub fn each_device<F>(f: F)
-        where F: Fn(Self)
+        where F: Fn(Self) + Sync
     {
+        let mut jobs = Vec::new();
         for &dev in ALL_DEVICES {
             for &align in test_alignments() {
                 for &erased_val in &[0, 0xff] {
-                    match Self::new(dev, align, erased_val) {
-                        Ok(run) => f(run),
-                        Err(msg) => warn!("Skipping {}: {}", dev, msg),
-                    }
+                    jobs.push((dev, align, erased_val));
                 }
             }
         }
+
+        pool::run(&jobs, |&(dev, align, erased_val)| {
+            match Self::new(dev, align, erased_val) {
+                Ok(run) => f(run),
+                Err(msg) => warn!("Skipping {}: {}", dev, msg),
+            }
+        });
     }
 
     /// Construct an `Images` that doesn't expect an upgrade to happen.
@@ -696,6 +772,12 @@ impl Images {
         Caps::SwapUsingScratch.present() || Caps::SwapUsingMove.present() || Caps::SwapUsingOffset.present()
     }
 
+    /// The slot the secondary slot should match after a permanent upgrade: the previous image, or
+    /// the update image when it is not kept.
+    fn perm_secondary_against(&self) -> usize {
+        if Caps::SwapOffsetNoBackup.present() { 1 } else { 0 }
+    }
+
     pub fn run_basic_revert(&self) -> bool {
         if Caps::OverwriteUpgrade.present() || !Caps::modifies_flash() {
             return false;
@@ -730,10 +812,14 @@ impl Images {
             return false;
         }
 
+        let mut flash = self.flash.clone();
+        self.mark_permanent_upgrades(&mut flash, 1);
+        let checkpoints = FlashCheckpoints::record(&flash, &self.areadesc);
+
         // Let's try an image halfway through.
         for i in 1 .. total_flash_ops {
             info!("Try interruption at {}", i);
-            let (flash, count) = self.try_upgrade(Some(i), true);
+            let (flash, count) = self.try_upgrade_from(&checkpoints, i);
             info!("Second boot, count={}", count);
             if !self.verify_images(&flash, 0, 1) {
                 warn!("FAIL at step {} of {}", i, total_flash_ops);
@@ -752,7 +838,8 @@ impl Images {
                 fails += 1;
             }
 
-            if self.is_swap_upgrade() && !self.verify_images(&flash, 1, 0) {
+            if self.is_swap_upgrade() &&
+                !self.verify_images(&flash, 1, self.perm_secondary_against()) {
                 warn!("Secondary slot FAIL at step {} of {}",
                     i, total_flash_ops);
                 fails += 1;
@@ -780,7 +867,7 @@ impl Images {
         let primary_slot_ok = self.verify_images(&flash, 0, 1);
         let secondary_slot_ok = if self.is_swap_upgrade() {
             // TODO: This result is ignored.
-            self.verify_images(&flash, 1, 0)
+            self.verify_images(&flash, 1, self.perm_secondary_against())
         } else {
             true
         };
@@ -821,9 +908,10 @@ impl Images {
         }
 
         if self.is_swap_upgrade() {
+            let checkpoints = FlashCheckpoints::record(&self.flash, &self.areadesc);
             for i in 1 .. self.total_count.unwrap() {
                 info!("Try interruption at {}", i);
-                if self.try_revert_with_fail_at(i) {
+                if self.try_revert_with_fail_at(&checkpoints, i) {
                     error!("Revert failed at interruption {}", i);
                     fails += 1;
                 }
@@ -833,6 +921,42 @@ impl Images {
         fails > 0
     }
 
+    /// Interrupt the upgrade until it is stopped while copying, with the scratch arena held, and
+    /// check that the next boot takes the arena back and completes the upgrade.
+    pub fn run_scratch_interrupted(&self) -> bool {
+        if !Caps::modifies_flash() {
+            return false;
+        }
+
+        for stop in 1 .. self.total_count.unwrap() {
+            let mut flash = self.flash.clone();
+            let mut counter = stop;
+            if !c::boot_go(&mut flash, &self.areadesc, Some(&mut counter), None,
+                           false).interrupted() || !c::boot_scratch_held() {
+                continue;
+            }
+
+            info!("Scratch arena held after interruption at {}", stop);
+            let mut fails = 0;
+            if !c::boot_go(&mut flash, &self.areadesc, None, None, false).success() {
+                warn!("Failed boot after interruption at {}", stop);
+                fails += 1;
+            }
+            if c::boot_scratch_held() {
+                warn!("Scratch arena still held after a complete boot");
+                fails += 1;
+            }
+            if !self.verify_images(&flash, 0, 1) {
+                warn!("Primary slot image verification FAIL");
+                fails += 1;
+            }
+            return fails > 0;
+        }
+
+        warn!("No interruption left the scratch arena held");
+        true
+    }
+
     pub fn run_norevert(&self) -> bool {
         if Caps::OverwriteUpgrade.present() || !Caps::modifies_flash() {
             return false;
@@ -1118,6 +1242,514 @@ impl Images {
         fails > 0
     }
 
+    // Stream the upgrades into secondary slots holding garbage with the image
+    // writer, as an application would, and boot them.
+    pub fn run_image_writer(&self) -> bool {
+        if !Caps::modifies_flash() {
+            return false;
+        }
+
+        let mut flash = self.flash.clone();
+        let mut fails = 0;
+
+        info!("Try an upgrade staged by the image writer");
+
+        for (image_index, image) in self.images.iter().enumerate() {
+            let slot = &image.slots[1];
+            let dev = flash.get_mut(&slot.dev_id).unwrap();
+            let mut garbage = vec![0u8; slot.len];
+            splat(&mut garbage, slot.base_off);
+            dev.erase(slot.base_off, slot.len).unwrap();
+            dev.write(slot.base_off, &garbage).unwrap();
+
+            let data = image.upgrades.find(1);
+            let rc = c::image_writer(&mut flash, &self.areadesc, image_index, data,
+                                     image_index as u32 + 1, true);
+            if rc != 0 {
+                warn!("Image writer failed with {}", rc);
+                fails += 1;
+            }
+        }
+
+        if !c::boot_go(&mut flash, &self.areadesc, None, None, false).success() {
+            warn!("Failed first boot");
+            fails += 1;
+        }
+
+        if !self.verify_images(&flash, 0, 1) {
+            warn!("Failed image verification");
+            fails += 1;
+        }
+
+        if fails > 0 {
+            error!("Expected the staged image to be installed");
+        }
+
+        fails > 0
+    }
+
+    /// The flash left behind by an upgrade can only be pre-erased once the image is confirmed,
+    /// and the next upgrade must still go through afterwards, even if the pre-erase was
+    /// interrupted.  The bootloader only skips the erases the pre-erase recorded, and never
+    /// takes flash programmed with the erased value for erased flash.
+    pub fn run_pre_erase(&self) -> bool {
+        if !self.is_swap_upgrade() || !Caps::modifies_flash() {
+            return false;
+        }
+
+        let mut flash = self.flash.clone();
+        let mut fails = 0;
+
+        info!("Try pre-erasing the flash left behind by an upgrade");
+
+        for image_index in 0 .. self.images.len() {
+            if c::pre_erase(&mut flash, &self.areadesc, image_index, None) != Some(BOOT_EBADSTATUS) {
+                warn!("Pre-erase should fail with a pending upgrade");
+                fails += 1;
+            }
+        }
+
+        if !c::boot_go(&mut flash, &self.areadesc, None, None, false).success() {
+            warn!("Failed first boot");
+            fails += 1;
+        }
+
+        for image_index in 0 .. self.images.len() {
+            if c::pre_erase(&mut flash, &self.areadesc, image_index, None) != Some(BOOT_EBADSTATUS) {
+                warn!("Pre-erase should fail before the image is confirmed");
+                fails += 1;
+            }
+        }
+
+        self.mark_permanent_upgrades(&mut flash, 0);
+        let confirmed = flash.clone();
+
+        api::start_journal();
+        for image_index in 0 .. self.images.len() {
+            let rc = c::pre_erase(&mut flash, &self.areadesc, image_index, None);
+            if rc != Some(0) {
+                warn!("Pre-erase failed with {:?}", rc);
+                fails += 1;
+            }
+        }
+        let count = api::take_journal().len();
+
+        if !self.verify_images(&flash, 0, 1) {
+            warn!("Pre-erase damaged the image in the primary slot");
+            fails += 1;
+        }
+
+        if !self.verify_trailers(&flash, 0, BOOT_MAGIC_GOOD,
+                                 BOOT_FLAG_SET, BOOT_FLAG_SET) {
+            warn!("Mismatched trailer for the primary slot");
+            fails += 1;
+        }
+
+        // The next upgrade has the erased flash to start from, and skips the recorded erase.
+        let (pre_fails, pre_erases) = self.run_staged_upgrade(&mut flash);
+        let mut plain = confirmed.clone();
+        let (plain_fails, plain_erases) = self.run_staged_upgrade(&mut plain);
+        fails += pre_fails + plain_fails;
+
+        info!("Next upgrade: {} erases after the pre-erase, {} without", pre_erases, plain_erases);
+        let skips = Caps::SkipPreErased.present() &&
+            (Caps::SwapUsingOffset.present() ||
+             (Caps::SwapUsingScratch.present() && Caps::get_num_images() == 1));
+        if (skips && pre_erases >= plain_erases) || (!skips && pre_erases > plain_erases) {
+            warn!("Unexpected number of erases after the pre-erase");
+            fails += 1;
+        }
+
+        // An interrupted pre-erase leaves no record behind.
+        for stop in 1 ..= count as i32 {
+            let mut flash = confirmed.clone();
+            let mut counter = stop;
+            for image_index in 0 .. self.images.len() {
+                if c::pre_erase(&mut flash, &self.areadesc, image_index, Some(&mut counter)).is_none() {
+                    break;
+                }
+            }
+            let (stop_fails, _) = self.run_staged_upgrade(&mut flash);
+            if stop_fails > 0 {
+                warn!("Upgrade failed after pre-erase interrupted at {}", stop);
+                fails += stop_fails;
+            }
+        }
+
+        // Flash which reads as erased, but was programmed, has to be erased all the same.
+        if let Some((dev_id, off, size)) = self.pre_erased_range() {
+            let mut flash = confirmed.clone();
+            let dev = flash.get_mut(&dev_id).unwrap();
+            let erased = vec![dev.erased_val(); size];
+            dev.erase(off, size).unwrap();
+            dev.write(off, &erased).unwrap();
+            let (erased_fails, _) = self.run_staged_upgrade(&mut flash);
+            if erased_fails > 0 {
+                warn!("Upgrade failed with flash programmed with the erased value");
+                fails += erased_fails;
+            }
+        }
+
+        if fails > 0 {
+            error!("Expected the pre-erased flash to be ready for the next upgrade");
+        }
+
+        fails > 0
+    }
+
+    /// Stage the next upgrade of every image with the image writer, and run it.  Returns the
+    /// number of failures and the number of erases of the bootloader.
+    fn run_staged_upgrade(&self, flash: &mut SimMultiFlash) -> (usize, usize) {
+        let mut fails = 0;
+
+        for (image_index, image) in self.images.iter().enumerate() {
+            let data = image.upgrades.find(1);
+            let rc = c::image_writer(flash, &self.areadesc, image_index, data,
+                                     image_index as u32 + 1, false);
+            if rc != 0 {
+                warn!("Image writer failed with {}", rc);
+                fails += 1;
+            }
+        }
+
+        let (result, journal) = c::boot_go_journaled(flash, &self.areadesc, None);
+        if !result.success() {
+            warn!("Failed boot of the staged upgrade");
+            fails += 1;
+        }
+
+        if !self.verify_images(flash, 0, 1) {
+            warn!("Failed image verification after the staged upgrade");
+            fails += 1;
+        }
+
+        if !self.verify_trailers(flash, 0, BOOT_MAGIC_GOOD,
+                                 BOOT_FLAG_UNSET, BOOT_FLAG_SET) {
+            warn!("Mismatched trailer for the primary slot after the staged upgrade");
+            fails += 1;
+        }
+
+        let erases = journal.iter().filter(|(_, op)| matches!(op, FlashOp::Erase { .. })).count();
+        (fails, erases)
+    }
+
+    /// The device, offset and size of the range the bootloader erases first during an upgrade,
+    /// which the pre-erase records: the scratch area, or the first sector of the secondary slot
+    /// with swap using offset.
+    fn pre_erased_range(&self) -> Option<(u8, usize, usize)> {
+        if Caps::SwapUsingOffset.present() {
+            let sector = &self.areadesc.get_area_sectors(FlashId::Image1)?[0];
+            Some((sector.device_id, sector.off as usize, sector.size as usize))
+        } else if Caps::SwapUsingScratch.present() {
+            let (off, size, dev_id) = self.areadesc.find(FlashId::ImageScratch)?;
+            Some((dev_id, off, size))
+        } else {
+            None
+        }
+    }
+
+    /// Without the backup of permanent upgrades, a test upgrade still keeps the previous image in
+    /// the secondary slot to revert to, until the update image is confirmed: confirming it
+    /// reclaims the secondary slot, as the pre-erase does, once the image is committed.
+    pub fn run_confirm_reclaim(&self) -> bool {
+        if !Caps::SwapOffsetNoBackup.present() || !Caps::modifies_flash() {
+            return false;
+        }
+
+        let mut flash = self.flash.clone();
+        let mut fails = 0;
+
+        info!("Try confirming a test upgrade without the backup of permanent upgrades");
+
+        if !c::boot_go(&mut flash, &self.areadesc, None, None, false).success() {
+            warn!("Failed first boot");
+            fails += 1;
+        }
+
+        if !self.verify_images(&flash, 1, 0) {
+            warn!("The test upgrade did not keep the previous image");
+            fails += 1;
+        }
+        let tested = flash.clone();
+
+        api::start_journal();
+        for image_index in 0 .. self.images.len() {
+            let rc = c::set_confirmed(&mut flash, &self.areadesc, image_index, None);
+            if rc != Some(0) {
+                warn!("Confirm failed with {:?}", rc);
+                fails += 1;
+            }
+        }
+        let count = api::take_journal().len();
+
+        if !self.verify_images(&flash, 0, 1) {
+            warn!("Confirm damaged the image in the primary slot");
+            fails += 1;
+        }
+
+        if !self.verify_trailers(&flash, 0, BOOT_MAGIC_GOOD,
+                                 BOOT_FLAG_SET, BOOT_FLAG_SET) {
+            warn!("Mismatched trailer for the primary slot");
+            fails += 1;
+        }
+
+        if !self.verify_trailers(&flash, 1, BOOT_MAGIC_UNSET,
+                                 BOOT_FLAG_UNSET, BOOT_FLAG_UNSET) {
+            warn!("Mismatched trailer for the secondary slot");
+            fails += 1;
+        }
+
+        // The header of the previous image went with the first sector of the secondary slot.
+        for image in &self.images {
+            let slot = &image.slots[1];
+            let dev = flash.get(&slot.dev_id).unwrap();
+            let mut magic = [0u8; 4];
+            dev.read(slot.base_off, &mut magic).unwrap();
+            if magic.iter().any(|&b| b != dev.erased_val()) {
+                warn!("The previous image was not reclaimed");
+                fails += 1;
+            }
+        }
+
+        // Confirming again reclaims nothing, and the next upgrade goes through.
+        api::start_journal();
+        for image_index in 0 .. self.images.len() {
+            if c::set_confirmed(&mut flash, &self.areadesc, image_index, None) != Some(0) {
+                warn!("Second confirm failed");
+                fails += 1;
+            }
+        }
+        if !api::take_journal().is_empty() {
+            warn!("Second confirm wrote to the flash");
+            fails += 1;
+        }
+
+        let (staged_fails, _) = self.run_staged_upgrade(&mut flash);
+        fails += staged_fails;
+
+        // Once the image is committed, by the first write, an interrupted reclaim leaves the
+        // update image in place, and the next upgrade going through.  With several images, the
+        // ones not confirmed yet would be reverted.
+        let stops = if self.images.len() == 1 { count as i32 } else { 0 };
+        for stop in 2 ..= stops {
+            let mut flash = tested.clone();
+            let mut counter = stop;
+            if c::set_confirmed(&mut flash, &self.areadesc, 0, Some(&mut counter)).is_some() {
+                continue;
+            }
+
+            if !c::boot_go(&mut flash, &self.areadesc, None, None, false).success() ||
+                !self.verify_images(&flash, 0, 1) {
+                warn!("Confirm interrupted at {} did not keep the update image", stop);
+                fails += 1;
+            }
+
+            let (stop_fails, _) = self.run_staged_upgrade(&mut flash);
+            if stop_fails > 0 {
+                warn!("Upgrade failed after confirm interrupted at {}", stop);
+                fails += stop_fails;
+            }
+        }
+
+        if fails > 0 {
+            error!("Expected the confirm to reclaim the previous image");
+        }
+
+        fails > 0
+    }
+
+    /// The swap status takes a write unit per state, or a bit per state when it is packed.  Each
+    /// state is recorded with a single write either way; when packed, a write unit holds the
+    /// states of several sectors, and is written with the bits of the states before the new one
+    /// rather than read back first.
+    pub fn run_status_writes(&self) -> bool {
+        if !self.is_swap_upgrade() || !Caps::modifies_flash() {
+            return false;
+        }
+
+        let mut flash = self.flash.clone();
+        let mut fails = 0;
+
+        info!("Try counting the swap status writes");
+
+        self.mark_permanent_upgrades(&mut flash, 1);
+        let (result, journal) = c::boot_go_journaled(&mut flash, &self.areadesc, None);
+        if !result.success() {
+            warn!("Failed upgrade");
+            fails += 1;
+        }
+
+        if !self.verify_images(&flash, 0, 1) {
+            warn!("Failed image verification");
+            fails += 1;
+        }
+
+        let packed = Caps::SwapStatusPacked.present();
+        let states = if Caps::SwapUsingOffset.present() { 2 } else { 3 };
+        let entries = c::boot_max_img_sectors() * states;
+
+        for image in &self.images {
+            let slot = &image.slots[0];
+            let dev = &flash[&slot.dev_id];
+            let align = dev.align();
+            let erased_val = dev.erased_val();
+
+            let status_sz = self.status_sz(align);
+            let expected_sz = if packed {
+                align_up(((entries + 7) / 8) as u32, align as u32) as usize
+            } else {
+                entries * align
+            };
+            if status_sz != expected_sz || (packed && status_sz >= entries * align) {
+                warn!("Status area of {} bytes, expected {}", status_sz, expected_sz);
+                fails += 1;
+            }
+
+            // The writes to each write unit, and the end of the bits of the last one.
+            let status_off = slot.base_off + slot.len - self.trailer_sz(align);
+            let mut units: BTreeMap<usize, usize> = BTreeMap::new();
+            let mut writes = 0;
+            let mut last_end = 0;
+            for (dev_id, op) in &journal {
+                let (offset, data) = match op {
+                    FlashOp::Write { offset, data } => (offset, data),
+                    _ => continue,
+                };
+                if *dev_id != slot.dev_id || *offset < status_off ||
+                    *offset >= status_off + status_sz {
+                    continue;
+                }
+
+                writes += 1;
+                for unit in (*offset .. *offset + data.len()).step_by(align) {
+                    *units.entry(unit).or_default() += 1;
+                }
+
+                if packed {
+                    // The bits from the start of the unit up to the one of the new state.
+                    let bits: Vec<bool> = data.iter()
+                        .flat_map(|b| (0..8).map(move |i| (b ^ erased_val) & (1 << i) != 0))
+                        .collect();
+                    let count = bits.iter().rposition(|&bit| bit).map_or(0, |i| i + 1);
+                    let end = (offset - status_off) * 8 + count;
+                    if count == 0 || bits[.. count].contains(&false) || end <= last_end {
+                        warn!("Unexpected status write at 0x{:x}: {:x?}", offset, data);
+                        fails += 1;
+                    }
+                    last_end = end;
+                }
+            }
+
+            info!("{} status writes to {} write units, status area of {} bytes",
+                  writes, units.len(), status_sz);
+
+            let bad = if packed {
+                units.len() >= writes || units.values().any(|&n| n > 8 * align)
+            } else {
+                units.values().any(|&n| n != 1)
+            };
+            if bad {
+                warn!("Unexpected status writes: {:?}", units);
+                fails += 1;
+            }
+        }
+
+        if fails > 0 {
+            error!("Expected one status write per state, to fewer write units when packed");
+        }
+
+        fails > 0
+    }
+
+    /// Each encryption key is unwrapped at most once per boot, including when an interrupted
+    /// upgrade is resumed, and a boot after a new upload unwraps the key of the new image.
+    pub fn run_enc_key_cache(&self) -> bool {
+        let encrypted = Caps::EncRsa.present() || Caps::EncKw.present() ||
+            Caps::EncEc256.present() || Caps::EncX25519.present();
+        if !encrypted || !Caps::modifies_flash() {
+            return false;
+        }
+
+        let images = self.images.len() as u32;
+        let mut fails = 0;
+
+        info!("Try an encrypted upgrade, counting the keys unwrapped");
+
+        let mut flash = self.flash.clone();
+        let before = c::enc_unwrap_count();
+        if !c::boot_go(&mut flash, &self.areadesc, None, None, false).success() {
+            warn!("Failed first boot");
+            fails += 1;
+        }
+        let unwraps = c::enc_unwrap_count() - before;
+        if unwraps == 0 || unwraps > images {
+            warn!("{} keys unwrapped for {} images", unwraps, images);
+            fails += 1;
+        }
+
+        // A new upload of the image, which the next boot must unwrap the key of again.
+        for (image_index, image) in self.images.iter().enumerate() {
+            let rc = c::image_writer(&mut flash, &self.areadesc, image_index,
+                                     image.upgrades.find(1), 1, true);
+            if rc != 0 {
+                warn!("Image writer failed with {}", rc);
+                fails += 1;
+            }
+        }
+        let before = c::enc_unwrap_count();
+        if !c::boot_go(&mut flash, &self.areadesc, None, None, false).success() {
+            warn!("Failed boot after a new upload");
+            fails += 1;
+        }
+        let unwraps = c::enc_unwrap_count() - before;
+        if unwraps == 0 || unwraps > images {
+            warn!("{} keys unwrapped after a new upload of {} images", unwraps, images);
+            fails += 1;
+        }
+        if !self.verify_images(&flash, 0, 1) {
+            warn!("Primary slot image verification FAIL after a new upload");
+            fails += 1;
+        }
+
+        // The boot resuming an interrupted upgrade has a cache of its own.
+        let total = self.total_count.unwrap();
+        for stop in [total / 3, total / 2, 2 * total / 3] {
+            if stop == 0 {
+                continue;
+            }
+            let mut flash = self.flash.clone();
+            let mut counter = stop;
+            let before = c::enc_unwrap_count();
+            if !c::boot_go(&mut flash, &self.areadesc, Some(&mut counter), None,
+                           false).interrupted() {
+                continue;
+            }
+            let interrupted = c::enc_unwrap_count() - before;
+
+            let before = c::enc_unwrap_count();
+            if !c::boot_go(&mut flash, &self.areadesc, None, None, false).success() {
+                warn!("Failed boot after interruption at {}", stop);
+                fails += 1;
+            }
+            let resumed = c::enc_unwrap_count() - before;
+            if interrupted > images || resumed > images {
+                warn!("{} and {} keys unwrapped by the boots interrupted at {}", interrupted,
+                      resumed, stop);
+                fails += 1;
+            }
+            if !self.verify_images(&flash, 0, 1) {
+                warn!("Primary slot image verification FAIL after interruption at {}", stop);
+                fails += 1;
+            }
+        }
+
+        if fails > 0 {
+            error!("Expected each key to be unwrapped once per boot");
+        }
+
+        fails > 0
+    }
+
     fn trailer_sz(&self, align: usize) -> usize {
         c::boot_trailer_sz(align as u32) as usize
     }
@@ -1258,6 +1890,9 @@ impl Images {
 
         // Clone the flash so we can tell if unchanged.
         let mut flash = self.flash.clone();
+        for dev in flash.values() {
+            dev.reset_bytes_read();
+        }
 
         let result = c::boot_go(&mut flash, &self.areadesc, None, None, true);
 
@@ -1275,6 +1910,20 @@ impl Images {
         } else {
             panic!("Unable to find upgrade image");
         }
+
+        // Only the selected (upgrade) images should be read in full.  The other slots should only
+        // have their headers and trailers read, which is well within the allowance below.
+        let bytes_read: usize = flash.values().map(|dev| dev.bytes_read()).sum();
+        let selected: usize = self.images.iter().map(|image| image.upgrades.plain.len()).sum();
+        let others: usize = self.images.iter().map(|image| image.primaries.plain.len()).sum();
+        info!("Direct-XIP boot read {} bytes, selected images {} bytes, other images {} bytes",
+              bytes_read, selected, others);
+        if bytes_read > selected + DIRECT_XIP_READ_ALLOWANCE * self.images.len() {
+            error!("Direct-XIP boot read {} bytes, expected at most {} more than the {} bytes \
+                    of the selected images", bytes_read,
+                   DIRECT_XIP_READ_ALLOWANCE * self.images.len(), selected);
+            return true;
+        }
         false
     }
 
@@ -1519,6 +2168,21 @@ impl Images {
         (flash, count - counter)
     }
 
+    /// Like `try_upgrade` with a stop, but start from the state recorded in `checkpoints` instead
+    /// of running the bootloader up to the interruption.
+    fn try_upgrade_from(&self, checkpoints: &FlashCheckpoints, stop: i32) -> (SimMultiFlash, i32) {
+        let mut flash = checkpoints.interrupted_at(stop);
+
+        let mut counter = 0;
+        match c::boot_go(&mut flash, &self.areadesc, Some(&mut counter), None, false) {
+            x if x.interrupted() => panic!("Shouldn't stop again"),
+            x if x.success() => (),
+            x => panic!("Unknown return: {:?}", x),
+        }
+
+        (flash, stop - counter)
+    }
+
     fn try_revert(&self, count: usize) -> SimMultiFlash {
         let mut flash = self.flash.clone();
 
@@ -1530,16 +2194,14 @@ impl Images {
         flash
     }
 
-    fn try_revert_with_fail_at(&self, stop: i32) -> bool {
-        let mut flash = self.flash.clone();
+    fn try_revert_with_fail_at(&self, checkpoints: &FlashCheckpoints, stop: i32) -> bool {
         let mut fails = 0;
 
-        let mut counter = stop;
-        if !c::boot_go(&mut flash, &self.areadesc, Some(&mut counter), None,
-                       false).interrupted() {
+        if stop as usize > checkpoints.len() {
             warn!("Should have stopped test at interruption point");
-            fails += 1;
+            return true;
         }
+        let mut flash = checkpoints.interrupted_at(stop);
 
         // In a multi-image setup, copy done might be set if any number of
         // images was already successfully swapped.
@@ -1828,7 +2490,11 @@ fn estimate_swap_scratch_trailer_size(dev: &dyn Flash, areadesc: &AreaDesc, slot
     // scratch trailer.
     if trailer_sz_in_fw_sector != 0 {
         // The scratch contains a single boot status entry
-        let boot_status_entry_sz = 3 * dev.align();
+        let boot_status_entry_sz = if Caps::SwapStatusPacked.present() {
+            dev.align()
+        } else {
+            3 * dev.align()
+        };
         let trailer_info_sz = trailer_sz - c::boot_status_sz(dev.align() as u32) as usize;
         let scratch_trailer_sz = boot_status_entry_sz + trailer_info_sz;
 
@@ -2402,6 +3068,9 @@ const MAGIC: &[u8] = &[0x20, 0x00, 0x2d, 0xe1,
 const BOOT_MAGIC_GOOD: Option<u8> = Some(1);
 const BOOT_MAGIC_UNSET: Option<u8> = Some(3);
 
+/// Error returned by the bootloader when the trailers don't allow an operation.
+const BOOT_EBADSTATUS: i32 = 5;
+
 const BOOT_FLAG_SET: Option<u8> = Some(1);
 const BOOT_FLAG_UNSET: Option<u8> = Some(3);
 
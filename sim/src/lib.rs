@@ -12,9 +12,21 @@ use std::{
 };
 use serde_derive::Deserialize;
 
+pub mod boot_request;
+#[cfg(feature = "ecdsa-comb")]
+pub mod ecdsa_comb;
+#[cfg(feature = "ed25519-tables")]
+pub mod ed25519_tables;
+#[cfg(feature = "fih-profiling")]
+pub mod fih_profile;
+#[cfg(feature = "rsa-tables")]
+pub mod rsa_tables;
+#[cfg(feature = "sha-kernels")]
+pub mod sha_kernels;
 mod caps;
 mod depends;
 mod image;
+pub mod pool;
 mod tlv;
 mod utils;
 pub mod testlog;
@@ -35,6 +47,9 @@ pub use crate::{
     },
 };
 
+#[cfg(feature = "multiimage")]
+pub use crate::depends::run_dependency_resolver;
+
 const USAGE: &str = "
 Mcuboot simulator
 
@@ -155,13 +170,19 @@ pub fn main() {
     }
 
     if args.cmd_runall {
+        let mut jobs = Vec::new();
         for &dev in ALL_DEVICES {
             for &align in &[1, 2, 4, 8] {
                 for &erased_val in &[0, 0xff] {
-                    status.run_single(dev, align, erased_val);
+                    jobs.push((dev, align, erased_val));
                 }
             }
         }
+        for result in pool::run(&jobs, |&(dev, align, erased_val)| {
+            RunStatus::run_one(dev, align, erased_val)
+        }) {
+            status.record(result);
+        }
     }
 
     if status.failures > 0 {
@@ -188,13 +209,29 @@ impl RunStatus {
     }
 
     pub fn run_single(&mut self, device: DeviceName, align: usize, erased_val: u8) {
+        let result = Self::run_one(device, align, erased_val);
+        self.record(result);
+    }
+
+    /// Record the result of `run_one`.
+    fn record(&mut self, result: Option<bool>) {
+        match result {
+            Some(true) => self.failures += 1,
+            Some(false) => self.passes += 1,
+            None => (),
+        }
+    }
+
+    /// Run the tests on a single device, without touching any shared state, so that devices can be
+    /// run in parallel.  Returns whether any test failed, or None if the device was skipped.
+    fn run_one(device: DeviceName, align: usize, erased_val: u8) -> Option<bool> {
         warn!("Running on device {} with alignment {}", device, align);
 
         let run = match ImagesBuilder::new(device, align, erased_val) {
             Ok(builder) => builder,
             Err(msg) => {
                 warn!("Skipping {}: {}", device, msg);
-                return;
+                return None;
             }
         };
 
@@ -222,11 +259,7 @@ impl RunStatus {
 
         //show_flash(&flash);
 
-        if failed {
-            self.failures += 1;
-        } else {
-            self.passes += 1;
-        }
+        Some(failed)
     }
 
     pub fn failures(&self) -> usize {
@@ -0,0 +1,169 @@
+// Copyright (c) 2026 Linaro LTD
+//
+// SPDX-License-Identifier: Apache-2.0
+
+//! Run independent simulations on a pool of worker threads.
+//!
+//! Everything a simulation touches is kept per thread: the flash devices and the flash area table
+//! (`THREAD_CTX`), the C simulator context (`SIM_CTX`), the RAM description and the security
+//! counters.  The C code keeps any large buffers on the stack when built for the simulator (see
+//! `TARGET_STATIC`).  This means that scenarios for different devices can run at the same time, as
+//! long as each one is built and run entirely on a single thread.
+//!
+//! Two environment variables control how the work is spread out:
+//!
+//! - `MCUBOOT_SIM_JOBS=<n>` sets the number of worker threads.  It defaults to the number of
+//!   available cores.  Setting it to 1 runs everything serially on the calling thread.
+//! - `MCUBOOT_SIM_SHARD=<index>/<count>` only runs every `count`th job, starting at `index`
+//!   (counting from 0).  The job order is fixed, so running all of the shards, for example on
+//!   separate CI machines, covers every job exactly once.
+
+use log::warn;
+use std::{
+    env,
+    sync::atomic::{AtomicUsize, Ordering},
+    thread,
+};
+
+/// A subset of the jobs to run, selected by position.
+#[derive(Clone, Copy, Debug, Eq, PartialEq)]
+pub struct Shard {
+    pub index: usize,
+    pub count: usize,
+}
+
+impl Shard {
+    /// Parse a shard description of the form `index/count`.
+    pub fn parse(text: &str) -> Result<Shard, String> {
+        let (index, count) = text.split_once('/')
+            .ok_or_else(|| format!("Invalid shard {:?}, expecting index/count", text))?;
+        let index = index.trim().parse::<usize>().map_err(|e| e.to_string())?;
+        let count = count.trim().parse::<usize>().map_err(|e| e.to_string())?;
+        if count == 0 || index >= count {
+            return Err(format!("Invalid shard {:?}, index must be less than count", text));
+        }
+        Ok(Shard { index, count })
+    }
+
+    /// Does this shard contain the job at the given position.
+    pub fn contains(&self, position: usize) -> bool {
+        position % self.count == self.index
+    }
+}
+
+/// The shard selected by `MCUBOOT_SIM_SHARD`, if any.
+fn env_shard() -> Option<Shard> {
+    let text = env::var("MCUBOOT_SIM_SHARD").ok()?;
+    match Shard::parse(&text) {
+        Ok(shard) => Some(shard),
+        Err(msg) => panic!("MCUBOOT_SIM_SHARD: {}", msg),
+    }
+}
+
+/// The number of worker threads to use.
+fn env_jobs() -> usize {
+    match env::var("MCUBOOT_SIM_JOBS") {
+        Ok(text) => match text.trim().parse::<usize>() {
+            Ok(n) if n > 0 => n,
+            _ => panic!("MCUBOOT_SIM_JOBS: invalid job count {:?}", text),
+        },
+        Err(_) => thread::available_parallelism().map(|n| n.get()).unwrap_or(1),
+    }
+}
+
+/// Run `f` on each of the jobs in this process's shard, using the configured number of worker
+/// threads.  The results are returned in job order, for the jobs that were run.  A panic in any
+/// job is propagated once all of the workers have finished.
+pub fn run<T, R, F>(jobs: &[T], f: F) -> Vec<R>
+    where T: Sync,
+          R: Send,
+          F: Fn(&T) -> R + Sync,
+{
+    run_with(jobs, env_jobs(), env_shard(), f)
+}
+
+/// Like `run`, but with an explicit number of workers and shard.
+pub fn run_with<T, R, F>(jobs: &[T], workers: usize, shard: Option<Shard>, f: F) -> Vec<R>
+    where T: Sync,
+          R: Send,
+          F: Fn(&T) -> R + Sync,
+{
+    let selected: Vec<&T> = jobs.iter().enumerate()
+        .filter(|(pos, _)| shard.map_or(true, |s| s.contains(*pos)))
+        .map(|(_, job)| job)
+        .collect();
+
+    if let Some(shard) = shard {
+        warn!("Running shard {}/{}: {} of {} jobs", shard.index, shard.count,
+              selected.len(), jobs.len());
+    }
+
+    let workers = workers.min(selected.len());
+    if workers <= 1 {
+        return selected.into_iter().map(f).collect();
+    }
+
+    // Workers take the next job from a shared counter, so a few slow jobs don't hold up the
+    // others.
+    let next = AtomicUsize::new(0);
+    let mut results: Vec<(usize, R)> = thread::scope(|scope| {
+        let handles: Vec<_> = (0 .. workers).map(|_| {
+            scope.spawn(|| {
+                let mut done = Vec::new();
+                loop {
+                    let pos = next.fetch_add(1, Ordering::Relaxed);
+                    if pos >= selected.len() {
+                        break;
+                    }
+                    done.push((pos, f(selected[pos])));
+                }
+                done
+            })
+        }).collect();
+
+        let mut all = Vec::new();
+        let mut panic = None;
+        for handle in handles {
+            match handle.join() {
+                Ok(done) => all.extend(done),
+                Err(e) => panic = Some(e),
+            }
+        }
+        if let Some(e) = panic {
+            std::panic::resume_unwind(e);
+        }
+        all
+    });
+
+    results.sort_by_key(|&(pos, _)| pos);
+    results.into_iter().map(|(_, r)| r).collect()
+}
+
+#[cfg(test)]
+mod test {
+    use super::{Shard, run_with};
+
+    #[test]
+    fn test_shard() {
+        assert_eq!(Shard::parse("1/4"), Ok(Shard { index: 1, count: 4 }));
+        assert!(Shard::parse("4/4").is_err());
+        assert!(Shard::parse("0/0").is_err());
+        assert!(Shard::parse("1").is_err());
+
+        // Running every shard covers each job exactly once.
+        let jobs: Vec<usize> = (0 .. 37).collect();
+        let mut seen = Vec::new();
+        for index in 0 .. 5 {
+            seen.extend(run_with(&jobs, 3, Some(Shard { index, count: 5 }), |&j| j));
+        }
+        seen.sort();
+        assert_eq!(seen, jobs);
+    }
+
+    #[test]
+    fn test_order() {
+        let jobs: Vec<usize> = (0 .. 100).collect();
+        let result = run_with(&jobs, 8, None, |&j| j * 2);
+        assert_eq!(result, jobs.iter().map(|j| j * 2).collect::<Vec<_>>());
+    }
+}
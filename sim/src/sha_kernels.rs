@@ -0,0 +1,63 @@
+// Copyright (c) 2026 Linaro LTD
+//
+// SPDX-License-Identifier: Apache-2.0
+
+//! Tests for the optimized SHA-256 kernels.
+//!
+//! Random messages, with lengths around the block and padding boundaries as well as longer ones,
+//! are hashed both by TinyCrypt's own implementation and by the kernel selected for the build, and
+//! compared against ring.  The throughput of both is logged in ticks per byte, and the kernel must
+//! be faster.
+
+use log::{info, error};
+use mcuboot_sys::c;
+use rand::Rng;
+use ring::digest;
+
+/// Length of the message used to measure the throughput.
+const BENCH_LEN: usize = 64 * 1024;
+
+/// Hashes timed for each implementation.
+const ITERATIONS: u32 = 16;
+
+/// Run the kernel tests, returning true on failure.
+pub fn run_sha_kernels() -> bool {
+    let mut rng = rand::thread_rng();
+    let mut fails = 0;
+
+    let mut lengths: Vec<usize> = (0 .. 200).collect();
+    lengths.extend((0 .. 50).map(|_| rng.gen_range(200 .. 20000)));
+
+    for len in lengths {
+        let mut data = vec![0u8; len];
+        rng.fill(&mut data[..]);
+        let expected = digest::digest(&digest::SHA256, &data);
+
+        for &use_kernel in &[false, true] {
+            match c::sha256_bench(use_kernel, &data, 1).0 {
+                Some(d) if d[..] == *expected.as_ref() => (),
+                d => {
+                    error!("Length {}, kernel {}: got {:?}", len, use_kernel, d);
+                    fails += 1;
+                }
+            }
+        }
+    }
+
+    let mut data = vec![0u8; BENCH_LEN];
+    rng.fill(&mut data[..]);
+    let (_, reference_ticks) = c::sha256_bench(false, &data, ITERATIONS);
+    let (_, kernel_ticks) = c::sha256_bench(true, &data, ITERATIONS);
+
+    let bytes = (BENCH_LEN as f64) * (ITERATIONS as f64);
+    info!("SHA-256: TinyCrypt {:.2} ticks/byte, kernel {:.2} ticks/byte ({:.2}x)",
+          reference_ticks as f64 / bytes, kernel_ticks as f64 / bytes,
+          reference_ticks as f64 / kernel_ticks.max(1) as f64);
+
+    if kernel_ticks >= reference_ticks {
+        error!("SHA kernel is not faster than TinyCrypt");
+        fails += 1;
+    }
+
+    fails > 0
+}
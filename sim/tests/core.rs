@@ -54,11 +54,53 @@ sim_test!(secondary_trailer_leftover, make_erased_secondary_image(), run_seconda
 sim_test!(bootstrap, make_bootstrap_image(), run_bootstrap());
 sim_test!(oversized_bootstrap, make_oversized_bootstrap_image(), run_oversized_bootstrap());
 sim_test!(norevert_newimage, make_no_upgrade_image(&NO_DEPS, ImageManipulation::None), run_norevert_newimage());
+sim_test!(image_writer, make_no_upgrade_image(&NO_DEPS, ImageManipulation::None), run_image_writer());
+sim_test!(pre_erase, make_image(&NO_DEPS, false), run_pre_erase());
+sim_test!(confirm_reclaim, make_image(&NO_DEPS, false), run_confirm_reclaim());
+sim_test!(status_writes, make_image(&NO_DEPS, true), run_status_writes());
+sim_test!(enc_key_cache, make_image(&NO_DEPS, true), run_enc_key_cache());
 sim_test!(basic_revert, make_image(&NO_DEPS, true), run_basic_revert());
 sim_test!(revert_with_fails, make_image(&NO_DEPS, false), run_revert_with_fails());
 sim_test!(perm_with_fails, make_image(&NO_DEPS, true), run_perm_with_fails());
 sim_test!(perm_with_random_fails, make_image(&NO_DEPS, true), run_perm_with_random_fails(5));
 sim_test!(norevert, make_image(&NO_DEPS, true), run_norevert());
+test_shell!(scratch_arena, r, {
+    let image = r.make_image(&NO_DEPS, true);
+    assert!(!image.run_norevert());
+
+    // The arena is larger than the 256 byte validation buffer when images are copied between
+    // slots, and then both validation and copy read the flash through all of it.
+    let size = c::boot_scratch_sz();
+    let validate = c::boot_scratch_high_water(c::ScratchPhase::Validate);
+    let copy = c::boot_scratch_high_water(c::ScratchPhase::Copy);
+    assert!(validate <= size && copy <= size);
+    if size > 256 {
+        assert!(validate > 256, "validation used {} of {} bytes", validate, size);
+        assert!(copy > 256, "copy used {} of {} bytes", copy, size);
+    }
+
+    // A power failure in the middle of a copy leaves the arena held, until the next boot.
+    assert!(!image.run_scratch_interrupted());
+});
+#[cfg(feature = "log-binary")]
+test_shell!(log_binary, r, {
+    let image = r.make_image(&NO_DEPS, true);
+    c::boot_log_binary_init();
+    assert!(!image.run_norevert());
+
+    // The records follow each other, and each one has as many arguments as its format string
+    // has conversions.
+    let (records, dropped) = c::boot_log_binary();
+    assert!(!records.is_empty());
+    let mut seq = dropped as u16;
+    for rec in &records {
+        let convs = rec.fmt.matches('%').count() - 2 * rec.fmt.matches("%%").count();
+        assert!(rec.level >= 1 && rec.level <= 4, "{:?}", rec);
+        assert_eq!(rec.seq, seq, "{:?}", rec);
+        assert_eq!(rec.args.len(), convs, "{:?}", rec);
+        seq = seq.wrapping_add(1);
+    }
+});
 sim_test!(oversized_secondary_slot, make_oversized_secondary_slot_image(), run_fail_upgrade_primary_intact());
 #[cfg(feature = "check-load-addr")]
 sim_test!(wrong_load_addr, make_bad_secondary_slot_image(ImageManipulation::WrongOffset), run_fail_upgrade_primary_intact());
@@ -190,6 +232,54 @@ pub static TEST_DEPS: &[DepTest] = &[
     },
 ];
 
+#[test]
+fn boot_request_log() {
+    testlog::setup();
+    assert!(!bootsim::boot_request::run_boot_request_log());
+}
+
+#[cfg(feature = "ecdsa-comb")]
+#[test]
+fn ecdsa_comb() {
+    testlog::setup();
+    assert!(!bootsim::ecdsa_comb::run_ecdsa_comb());
+}
+
+#[cfg(feature = "ed25519-tables")]
+#[test]
+fn ed25519_tables() {
+    testlog::setup();
+    assert!(!bootsim::ed25519_tables::run_ed25519_tables());
+}
+
+#[cfg(feature = "rsa-tables")]
+#[test]
+fn rsa_tables() {
+    testlog::setup();
+    assert!(!bootsim::rsa_tables::run_rsa_tables());
+}
+
+#[cfg(feature = "sha-kernels")]
+#[test]
+fn sha_kernels() {
+    testlog::setup();
+    assert!(!bootsim::sha_kernels::run_sha_kernels());
+}
+
+#[cfg(feature = "fih-profiling")]
+#[test]
+fn fih_profile() {
+    testlog::setup();
+    assert!(!bootsim::fih_profile::run_fih_profile());
+}
+
+#[cfg(feature = "multiimage")]
+#[test]
+fn dependency_resolver() {
+    testlog::setup();
+    assert!(!bootsim::run_dependency_resolver());
+}
+
 /// Counter for the image number.
 static IMAGE_NUMBER: AtomicUsize = AtomicUsize::new(0);
 